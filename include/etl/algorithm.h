@@ -42,10 +42,14 @@ SOFTWARE.
 #include "stl/functional.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 #include "iterator.h"
 #include "type_traits.h"
+#include "static_assert.h"
+
+#include "private/algorithm_simd.h"
 
 namespace etl
 {
@@ -87,14 +91,245 @@ namespace etl
   ///<a href="http://en.cppreference.com/w/cpp/algorithm/minmax_element"></a>
   //***************************************************************************
   template <typename TIterator>
-  std::pair<TIterator, TIterator> minmax_element(TIterator begin,
-                                                 TIterator end)
+  typename etl::enable_if<!private_algorithm_simd::is_min_max_vectorisable<TIterator>::value, std::pair<TIterator, TIterator> >::type
+    minmax_element(TIterator begin,
+                   TIterator end)
   {
       typedef typename std::iterator_traits<TIterator>::value_type value_t;
 
       return etl::minmax_element(begin, end, std::less<value_t>());
   }
 
+#if ETL_SIMD_SUPPORTED
+  //***************************************************************************
+  /// minmax_element
+  /// Vectorised for pointers to integral types up to 32 bits.
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/minmax_element"></a>
+  //***************************************************************************
+  template <typename TIterator>
+  typename etl::enable_if<private_algorithm_simd::is_min_max_vectorisable<TIterator>::value, std::pair<TIterator, TIterator> >::type
+    minmax_element(TIterator begin,
+                   TIterator end)
+  {
+    size_t index_min;
+    size_t index_max;
+
+    private_algorithm_simd::minmax_element(begin, end, index_min, index_max);
+
+    return std::pair<TIterator, TIterator>(begin + index_min, begin + index_max);
+  }
+#endif
+
+  //***************************************************************************
+  /// min_element
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/min_element"></a>
+  //***************************************************************************
+  template <typename TIterator>
+  typename etl::enable_if<!private_algorithm_simd::is_min_max_vectorisable<TIterator>::value, TIterator>::type
+    min_element(TIterator begin,
+                TIterator end)
+  {
+    TIterator minimum = begin;
+
+    while (begin != end)
+    {
+      if (*begin < *minimum)
+      {
+        minimum = begin;
+      }
+
+      ++begin;
+    }
+
+    return minimum;
+  }
+
+  //***************************************************************************
+  /// max_element
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/max_element"></a>
+  //***************************************************************************
+  template <typename TIterator>
+  typename etl::enable_if<!private_algorithm_simd::is_min_max_vectorisable<TIterator>::value, TIterator>::type
+    max_element(TIterator begin,
+                TIterator end)
+  {
+    TIterator maximum = begin;
+
+    while (begin != end)
+    {
+      if (*maximum < *begin)
+      {
+        maximum = begin;
+      }
+
+      ++begin;
+    }
+
+    return maximum;
+  }
+
+#if ETL_SIMD_SUPPORTED
+  //***************************************************************************
+  /// min_element
+  /// Vectorised for pointers to integral types up to 32 bits.
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/min_element"></a>
+  //***************************************************************************
+  template <typename TIterator>
+  typename etl::enable_if<private_algorithm_simd::is_min_max_vectorisable<TIterator>::value, TIterator>::type
+    min_element(TIterator begin,
+                TIterator end)
+  {
+    return begin + private_algorithm_simd::min_element(begin, end);
+  }
+
+  //***************************************************************************
+  /// max_element
+  /// Vectorised for pointers to integral types up to 32 bits.
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/max_element"></a>
+  //***************************************************************************
+  template <typename TIterator>
+  typename etl::enable_if<private_algorithm_simd::is_min_max_vectorisable<TIterator>::value, TIterator>::type
+    max_element(TIterator begin,
+                TIterator end)
+  {
+    return begin + private_algorithm_simd::max_element(begin, end);
+  }
+#endif
+
+  //***************************************************************************
+  /// find
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/find"></a>
+  //***************************************************************************
+  template <typename TIterator, typename T>
+  typename etl::enable_if<!private_algorithm_simd::is_vectorisable<TIterator, T>::value, TIterator>::type
+    find(TIterator begin,
+         TIterator end,
+         const T&  value)
+  {
+    while ((begin != end) && !(*begin == value))
+    {
+      ++begin;
+    }
+
+    return begin;
+  }
+
+  //***************************************************************************
+  /// count
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/count"></a>
+  //***************************************************************************
+  template <typename TIterator, typename T>
+  typename etl::enable_if<!private_algorithm_simd::is_vectorisable<TIterator, T>::value, typename std::iterator_traits<TIterator>::difference_type>::type
+    count(TIterator begin,
+          TIterator end,
+          const T&  value)
+  {
+    typename std::iterator_traits<TIterator>::difference_type n = 0;
+
+    while (begin != end)
+    {
+      if (*begin == value)
+      {
+        ++n;
+      }
+
+      ++begin;
+    }
+
+    return n;
+  }
+
+  //***************************************************************************
+  /// mismatch
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/mismatch"></a>
+  //***************************************************************************
+  template <typename TIterator1, typename TIterator2>
+  typename etl::enable_if<!private_algorithm_simd::are_vectorisable<TIterator1, TIterator2>::value, std::pair<TIterator1, TIterator2> >::type
+    mismatch(TIterator1 begin1,
+             TIterator1 end1,
+             TIterator2 begin2)
+  {
+    while ((begin1 != end1) && (*begin1 == *begin2))
+    {
+      ++begin1;
+      ++begin2;
+    }
+
+    return std::pair<TIterator1, TIterator2>(begin1, begin2);
+  }
+
+#if ETL_SIMD_SUPPORTED
+  //***************************************************************************
+  /// find
+  /// Vectorised for pointers to arithmetic types when 'value' is the same type.
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/find"></a>
+  //***************************************************************************
+  template <typename TIterator, typename T>
+  typename etl::enable_if<private_algorithm_simd::is_vectorisable<TIterator, T>::value, TIterator>::type
+    find(TIterator begin,
+         TIterator end,
+         const T&  value)
+  {
+    return begin + private_algorithm_simd::find<typename etl::remove_cv<T>::type>(begin, end, value);
+  }
+
+  //***************************************************************************
+  /// count
+  /// Vectorised for pointers to arithmetic types when 'value' is the same type.
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/count"></a>
+  //***************************************************************************
+  template <typename TIterator, typename T>
+  typename etl::enable_if<private_algorithm_simd::is_vectorisable<TIterator, T>::value, typename std::iterator_traits<TIterator>::difference_type>::type
+    count(TIterator begin,
+          TIterator end,
+          const T&  value)
+  {
+    typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+    return difference_t(private_algorithm_simd::count<typename etl::remove_cv<T>::type>(begin, end, value));
+  }
+
+  //***************************************************************************
+  /// mismatch
+  /// Vectorised for pointers to the same arithmetic type.
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/mismatch"></a>
+  //***************************************************************************
+  template <typename TIterator1, typename TIterator2>
+  typename etl::enable_if<private_algorithm_simd::are_vectorisable<TIterator1, TIterator2>::value, std::pair<TIterator1, TIterator2> >::type
+    mismatch(TIterator1 begin1,
+             TIterator1 end1,
+             TIterator2 begin2)
+  {
+    const size_t index = private_algorithm_simd::mismatch<typename private_algorithm_simd::value_type<TIterator1>::type>(begin1, end1, begin2);
+
+    return std::pair<TIterator1, TIterator2>(begin1 + index, begin2 + index);
+  }
+#endif
+
+  //***************************************************************************
+  /// equal
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/equal"></a>
+  //***************************************************************************
+  template <typename TIterator1, typename TIterator2>
+  bool equal(TIterator1 begin1,
+             TIterator1 end1,
+             TIterator2 begin2)
+  {
+    return etl::mismatch(begin1, end1, begin2).first == end1;
+  }
+
   //***************************************************************************
   /// minmax
   ///\ingroup algorithm
@@ -1122,47 +1357,973 @@ namespace etl
     return std::pair<TDestinationTrue, TDestinationFalse>(destination_true, destination_false);
   }
 
+  namespace private_sort
+  {
+    //*************************************************************************
+    /// Tuning parameters.
+    //*************************************************************************
+    static const size_t NETWORK_SORT_LIMIT           = 16;
+    static const size_t NINTHER_THRESHOLD            = 128;
+    static const size_t PARTIAL_INSERTION_SORT_LIMIT = 8;
+    static const size_t BLOCK_SIZE                   = 64;
+
+    //*************************************************************************
+    /// Moves the value, if move semantics are supported.
+    //*************************************************************************
+#if ETL_CPP11_SUPPORTED
+    template <typename T>
+    typename etl::remove_reference<T>::type&& move_value(T& value)
+    {
+      return static_cast<typename etl::remove_reference<T>::type&&>(value);
+    }
+#else
+    template <typename T>
+    T& move_value(T& value)
+    {
+      return value;
+    }
+#endif
+
+    //*************************************************************************
+    /// Branchless partitioning and compare/exchange are only used for
+    /// arithmetic types with the standard comparisons.
+    //*************************************************************************
+    template <typename T, typename TCompare>
+    struct is_branchless
+    {
+      static const bool value = etl::is_arithmetic<T>::value &&
+                                (etl::is_same<TCompare, std::less<T> >::value || etl::is_same<TCompare, std::greater<T> >::value);
+    };
+
+    //*************************************************************************
+    /// Sorting network comparator tables for 2 to NETWORK_SORT_LIMIT elements.
+    /// Batcher odd-even merge networks, pruned for sizes that are not a power of 2.
+    /// The comparators for 'n' elements are in the range [offsets[n], offsets[n + 1]).
+    //*************************************************************************
+    template <typename T = void>
+    struct sorting_network
+    {
+      static const uint8_t  pairs[428][2];
+      static const uint16_t offsets[NETWORK_SORT_LIMIT + 2];
+    };
+
+    template <typename T>
+    const uint8_t sorting_network<T>::pairs[428][2] =
+    {
+      {  0,  1 },
+      {  0,  1 }, {  0,  2 }, {  1,  2 },
+      {  0,  1 }, {  2,  3 }, {  0,  2 }, {  1,  3 }, {  1,  2 },
+      {  0,  1 }, {  2,  3 }, {  0,  2 }, {  1,  3 }, {  1,  2 }, {  0,  4 }, {  2,  4 }, {  1,  2 },
+      {  3,  4 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  0,  2 }, {  1,  3 }, {  1,  2 }, {  0,  4 }, {  1,  5 },
+      {  2,  4 }, {  3,  5 }, {  1,  2 }, {  3,  4 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  0,  2 }, {  1,  3 }, {  4,  6 }, {  1,  2 }, {  5,  6 },
+      {  0,  4 }, {  1,  5 }, {  2,  6 }, {  2,  4 }, {  3,  5 }, {  1,  2 }, {  3,  4 }, {  5,  6 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  0,  2 }, {  1,  3 }, {  4,  6 }, {  5,  7 },
+      {  1,  2 }, {  5,  6 }, {  0,  4 }, {  1,  5 }, {  2,  6 }, {  3,  7 }, {  2,  4 }, {  3,  5 },
+      {  1,  2 }, {  3,  4 }, {  5,  6 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  0,  2 }, {  1,  3 }, {  4,  6 }, {  5,  7 },
+      {  1,  2 }, {  5,  6 }, {  0,  4 }, {  1,  5 }, {  2,  6 }, {  3,  7 }, {  2,  4 }, {  3,  5 },
+      {  1,  2 }, {  3,  4 }, {  5,  6 }, {  0,  8 }, {  4,  8 }, {  2,  4 }, {  3,  5 }, {  6,  8 },
+      {  1,  2 }, {  3,  4 }, {  5,  6 }, {  7,  8 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  8,  9 }, {  0,  2 }, {  1,  3 }, {  4,  6 },
+      {  5,  7 }, {  1,  2 }, {  5,  6 }, {  0,  4 }, {  1,  5 }, {  2,  6 }, {  3,  7 }, {  2,  4 },
+      {  3,  5 }, {  1,  2 }, {  3,  4 }, {  5,  6 }, {  0,  8 }, {  1,  9 }, {  4,  8 }, {  5,  9 },
+      {  2,  4 }, {  3,  5 }, {  6,  8 }, {  7,  9 }, {  1,  2 }, {  3,  4 }, {  5,  6 }, {  7,  8 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  8,  9 }, {  0,  2 }, {  1,  3 }, {  4,  6 },
+      {  5,  7 }, {  8, 10 }, {  1,  2 }, {  5,  6 }, {  9, 10 }, {  0,  4 }, {  1,  5 }, {  2,  6 },
+      {  3,  7 }, {  2,  4 }, {  3,  5 }, {  1,  2 }, {  3,  4 }, {  5,  6 }, {  9, 10 }, {  0,  8 },
+      {  1,  9 }, {  2, 10 }, {  4,  8 }, {  5,  9 }, {  6, 10 }, {  2,  4 }, {  3,  5 }, {  6,  8 },
+      {  7,  9 }, {  1,  2 }, {  3,  4 }, {  5,  6 }, {  7,  8 }, {  9, 10 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  8,  9 }, { 10, 11 }, {  0,  2 }, {  1,  3 },
+      {  4,  6 }, {  5,  7 }, {  8, 10 }, {  9, 11 }, {  1,  2 }, {  5,  6 }, {  9, 10 }, {  0,  4 },
+      {  1,  5 }, {  2,  6 }, {  3,  7 }, {  2,  4 }, {  3,  5 }, {  1,  2 }, {  3,  4 }, {  5,  6 },
+      {  9, 10 }, {  0,  8 }, {  1,  9 }, {  2, 10 }, {  3, 11 }, {  4,  8 }, {  5,  9 }, {  6, 10 },
+      {  7, 11 }, {  2,  4 }, {  3,  5 }, {  6,  8 }, {  7,  9 }, {  1,  2 }, {  3,  4 }, {  5,  6 },
+      {  7,  8 }, {  9, 10 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  8,  9 }, { 10, 11 }, {  0,  2 }, {  1,  3 },
+      {  4,  6 }, {  5,  7 }, {  8, 10 }, {  9, 11 }, {  1,  2 }, {  5,  6 }, {  9, 10 }, {  0,  4 },
+      {  1,  5 }, {  2,  6 }, {  3,  7 }, {  8, 12 }, {  2,  4 }, {  3,  5 }, { 10, 12 }, {  1,  2 },
+      {  3,  4 }, {  5,  6 }, {  9, 10 }, { 11, 12 }, {  0,  8 }, {  1,  9 }, {  2, 10 }, {  3, 11 },
+      {  4, 12 }, {  4,  8 }, {  5,  9 }, {  6, 10 }, {  7, 11 }, {  2,  4 }, {  3,  5 }, {  6,  8 },
+      {  7,  9 }, { 10, 12 }, {  1,  2 }, {  3,  4 }, {  5,  6 }, {  7,  8 }, {  9, 10 }, { 11, 12 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  8,  9 }, { 10, 11 }, { 12, 13 }, {  0,  2 },
+      {  1,  3 }, {  4,  6 }, {  5,  7 }, {  8, 10 }, {  9, 11 }, {  1,  2 }, {  5,  6 }, {  9, 10 },
+      {  0,  4 }, {  1,  5 }, {  2,  6 }, {  3,  7 }, {  8, 12 }, {  9, 13 }, {  2,  4 }, {  3,  5 },
+      { 10, 12 }, { 11, 13 }, {  1,  2 }, {  3,  4 }, {  5,  6 }, {  9, 10 }, { 11, 12 }, {  0,  8 },
+      {  1,  9 }, {  2, 10 }, {  3, 11 }, {  4, 12 }, {  5, 13 }, {  4,  8 }, {  5,  9 }, {  6, 10 },
+      {  7, 11 }, {  2,  4 }, {  3,  5 }, {  6,  8 }, {  7,  9 }, { 10, 12 }, { 11, 13 }, {  1,  2 },
+      {  3,  4 }, {  5,  6 }, {  7,  8 }, {  9, 10 }, { 11, 12 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  8,  9 }, { 10, 11 }, { 12, 13 }, {  0,  2 },
+      {  1,  3 }, {  4,  6 }, {  5,  7 }, {  8, 10 }, {  9, 11 }, { 12, 14 }, {  1,  2 }, {  5,  6 },
+      {  9, 10 }, { 13, 14 }, {  0,  4 }, {  1,  5 }, {  2,  6 }, {  3,  7 }, {  8, 12 }, {  9, 13 },
+      { 10, 14 }, {  2,  4 }, {  3,  5 }, { 10, 12 }, { 11, 13 }, {  1,  2 }, {  3,  4 }, {  5,  6 },
+      {  9, 10 }, { 11, 12 }, { 13, 14 }, {  0,  8 }, {  1,  9 }, {  2, 10 }, {  3, 11 }, {  4, 12 },
+      {  5, 13 }, {  6, 14 }, {  4,  8 }, {  5,  9 }, {  6, 10 }, {  7, 11 }, {  2,  4 }, {  3,  5 },
+      {  6,  8 }, {  7,  9 }, { 10, 12 }, { 11, 13 }, {  1,  2 }, {  3,  4 }, {  5,  6 }, {  7,  8 },
+      {  9, 10 }, { 11, 12 }, { 13, 14 },
+      {  0,  1 }, {  2,  3 }, {  4,  5 }, {  6,  7 }, {  8,  9 }, { 10, 11 }, { 12, 13 }, { 14, 15 },
+      {  0,  2 }, {  1,  3 }, {  4,  6 }, {  5,  7 }, {  8, 10 }, {  9, 11 }, { 12, 14 }, { 13, 15 },
+      {  1,  2 }, {  5,  6 }, {  9, 10 }, { 13, 14 }, {  0,  4 }, {  1,  5 }, {  2,  6 }, {  3,  7 },
+      {  8, 12 }, {  9, 13 }, { 10, 14 }, { 11, 15 }, {  2,  4 }, {  3,  5 }, { 10, 12 }, { 11, 13 },
+      {  1,  2 }, {  3,  4 }, {  5,  6 }, {  9, 10 }, { 11, 12 }, { 13, 14 }, {  0,  8 }, {  1,  9 },
+      {  2, 10 }, {  3, 11 }, {  4, 12 }, {  5, 13 }, {  6, 14 }, {  7, 15 }, {  4,  8 }, {  5,  9 },
+      {  6, 10 }, {  7, 11 }, {  2,  4 }, {  3,  5 }, {  6,  8 }, {  7,  9 }, { 10, 12 }, { 11, 13 },
+      {  1,  2 }, {  3,  4 }, {  5,  6 }, {  7,  8 }, {  9, 10 }, { 11, 12 }, { 13, 14 }
+    };
+
+    template <typename T>
+    const uint16_t sorting_network<T>::offsets[NETWORK_SORT_LIMIT + 2] =
+    {
+      0, 0, 0, 1, 4, 9, 18, 30, 46, 65, 93, 125, 163, 205, 253, 306, 365, 428
+    };
+
+    //*************************************************************************
+    /// Compare and exchange.
+    //*************************************************************************
+    template <const bool BRANCHLESS, typename TIterator, typename TCompare>
+    typename etl::enable_if<BRANCHLESS, void>::type
+      compare_exchange(TIterator a, TIterator b, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      const value_t va = *a;
+      const value_t vb = *b;
+      const bool    swap = compare(vb, va);
+
+      *a = swap ? vb : va;
+      *b = swap ? va : vb;
+    }
+
+    template <const bool BRANCHLESS, typename TIterator, typename TCompare>
+    typename etl::enable_if<!BRANCHLESS, void>::type
+      compare_exchange(TIterator a, TIterator b, TCompare compare)
+    {
+      if (compare(*b, *a))
+      {
+        std::iter_swap(a, b);
+      }
+    }
+
+    //*************************************************************************
+    /// Sorts up to NETWORK_SORT_LIMIT elements with a fixed sorting network.
+    //*************************************************************************
+    template <const bool BRANCHLESS, typename TIterator, typename TCompare>
+    void network_sort(TIterator first, size_t n, TCompare compare)
+    {
+      typedef private_sort::sorting_network<> network;
+
+      const uint16_t end = network::offsets[n + 1];
+
+      for (uint16_t i = network::offsets[n]; i < end; ++i)
+      {
+        compare_exchange<BRANCHLESS>(first + network::pairs[i][0], first + network::pairs[i][1], compare);
+      }
+    }
+
+    //*************************************************************************
+    /// Sorts the three values.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void sort3(TIterator a, TIterator b, TIterator c, TCompare compare)
+    {
+      compare_exchange<false>(a, b, compare);
+      compare_exchange<false>(b, c, compare);
+      compare_exchange<false>(a, b, compare);
+    }
+
+    //*************************************************************************
+    /// Insertion sort that gives up after PARTIAL_INSERTION_SORT_LIMIT moves.
+    /// Returns true if the range was sorted.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    bool partial_insertion_sort(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      if (begin == end)
+      {
+        return true;
+      }
+
+      size_t limit = 0;
+
+      for (TIterator current = begin + 1; current != end; ++current)
+      {
+        if (limit > PARTIAL_INSERTION_SORT_LIMIT)
+        {
+          return false;
+        }
+
+        TIterator sift   = current;
+        TIterator sift_1 = current - 1;
+
+        if (compare(*sift, *sift_1))
+        {
+          value_t temp = move_value(*sift);
+
+          do
+          {
+            *sift-- = move_value(*sift_1);
+          } while ((sift != begin) && compare(temp, *--sift_1));
+
+          *sift = move_value(temp);
+          limit += size_t(current - sift);
+        }
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Partitions [begin, end) around the pivot *begin.
+    /// Elements equal to the pivot go to the right.
+    /// Returns the pivot position and whether the range was already partitioned.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    std::pair<TIterator, bool> partition_right(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      value_t   pivot = move_value(*begin);
+      TIterator first = begin;
+      TIterator last  = end;
+
+      // The median of 3 guarantees that these searches terminate.
+      while (compare(*++first, pivot));
+
+      if ((first - 1) == begin)
+      {
+        while ((first < last) && !compare(*--last, pivot));
+      }
+      else
+      {
+        while (!compare(*--last, pivot));
+      }
+
+      const bool already_partitioned = !(first < last);
+
+      while (first < last)
+      {
+        std::iter_swap(first, last);
+        while (compare(*++first, pivot));
+        while (!compare(*--last, pivot));
+      }
+
+      TIterator pivot_position = first - 1;
+      *begin          = move_value(*pivot_position);
+      *pivot_position = move_value(pivot);
+
+      return std::pair<TIterator, bool>(pivot_position, already_partitioned);
+    }
+
+    //*************************************************************************
+    /// Swaps the elements at the offsets for partition_right_branchless.
+    //*************************************************************************
+    template <typename TIterator>
+    void swap_offsets(TIterator first, TIterator last, const uint8_t* offsets_l, const uint8_t* offsets_r, size_t n, bool use_swaps)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      if (use_swaps)
+      {
+        // Needed for descending sequences to stay O(n).
+        for (size_t i = 0; i < n; ++i)
+        {
+          std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+      }
+      else if (n > 0)
+      {
+        TIterator l = first + offsets_l[0];
+        TIterator r = last - offsets_r[0];
+
+        value_t temp = move_value(*l);
+        *l = move_value(*r);
+
+        for (size_t i = 1; i < n; ++i)
+        {
+          l  = first + offsets_l[i];
+          *r = move_value(*l);
+          r  = last - offsets_r[i];
+          *l = move_value(*r);
+        }
+
+        *r = move_value(temp);
+      }
+    }
+
+    //*************************************************************************
+    /// As partition_right, but the comparisons in each block are converted to
+    /// offsets without branching, then the misplaced elements are swapped.
+    /// From 'BlockQuicksort' by Edelkamp & Weiss and 'pdqsort' by Orson Peters.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    std::pair<TIterator, bool> partition_right_branchless(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      value_t   pivot = move_value(*begin);
+      TIterator first = begin;
+      TIterator last  = end;
+
+      while (compare(*++first, pivot));
+
+      if ((first - 1) == begin)
+      {
+        while ((first < last) && !compare(*--last, pivot));
+      }
+      else
+      {
+        while (!compare(*--last, pivot));
+      }
+
+      const bool already_partitioned = !(first < last);
+
+      if (!already_partitioned)
+      {
+        std::iter_swap(first, last);
+        ++first;
+
+        uint8_t offsets_l[BLOCK_SIZE];
+        uint8_t offsets_r[BLOCK_SIZE];
+
+        TIterator offsets_l_base = first;
+        TIterator offsets_r_base = last;
+        size_t    num_l   = 0;
+        size_t    num_r   = 0;
+        size_t    start_l = 0;
+        size_t    start_r = 0;
+
+        while (first < last)
+        {
+          // Decide how many elements to examine on each side.
+          const size_t num_unknown = size_t(last - first);
+          const size_t left_split  = (num_l == 0) ? ((num_r == 0) ? num_unknown / 2 : num_unknown) : 0;
+          const size_t right_split = (num_r == 0) ? (num_unknown - left_split) : 0;
+
+          // Record the offsets of the elements on the wrong side.
+          const size_t left_count = (left_split >= BLOCK_SIZE) ? BLOCK_SIZE : left_split;
+
+          for (size_t i = 0; i < left_count;)
+          {
+            offsets_l[num_l] = uint8_t(i++);
+            num_l += !compare(*first, pivot);
+            ++first;
+          }
+
+          const size_t right_count = (right_split >= BLOCK_SIZE) ? BLOCK_SIZE : right_split;
+
+          for (size_t i = 0; i < right_count;)
+          {
+            offsets_r[num_r] = uint8_t(++i);
+            num_r += compare(*--last, pivot);
+          }
+
+          // Swap the pairs and update the block boundaries.
+          const size_t n = (num_l < num_r) ? num_l : num_r;
+          swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, n, num_l == num_r);
+
+          num_l   -= n;
+          num_r   -= n;
+          start_l += n;
+          start_r += n;
+
+          if (num_l == 0)
+          {
+            start_l        = 0;
+            offsets_l_base = first;
+          }
+
+          if (num_r == 0)
+          {
+            start_r        = 0;
+            offsets_r_base = last;
+          }
+        }
+
+        // Move the remaining misplaced elements of the unfinished block.
+        if (num_l != 0)
+        {
+          const uint8_t* offsets = offsets_l + start_l;
+
+          while (num_l-- != 0)
+          {
+            std::iter_swap(offsets_l_base + offsets[num_l], --last);
+          }
+
+          first = last;
+        }
+
+        if (num_r != 0)
+        {
+          const uint8_t* offsets = offsets_r + start_r;
+
+          while (num_r-- != 0)
+          {
+            std::iter_swap(offsets_r_base - offsets[num_r], first);
+            ++first;
+          }
+
+          last = first;
+        }
+      }
+
+      TIterator pivot_position = first - 1;
+      *begin          = move_value(*pivot_position);
+      *pivot_position = move_value(pivot);
+
+      return std::pair<TIterator, bool>(pivot_position, already_partitioned);
+    }
+
+    //*************************************************************************
+    /// Partitions [begin, end) around the pivot *begin.
+    /// Elements equal to the pivot go to the left.
+    /// Used when the pivot equals the element before the range.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    TIterator partition_left(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      value_t   pivot = move_value(*begin);
+      TIterator first = begin;
+      TIterator last  = end;
+
+      while (compare(pivot, *--last));
+
+      if ((last + 1) == end)
+      {
+        while ((first < last) && !compare(pivot, *++first));
+      }
+      else
+      {
+        while (!compare(pivot, *++first));
+      }
+
+      while (first < last)
+      {
+        std::iter_swap(first, last);
+        while (compare(pivot, *--last));
+        while (!compare(pivot, *++first));
+      }
+
+      TIterator pivot_position = last;
+      *begin          = move_value(*pivot_position);
+      *pivot_position = move_value(pivot);
+
+      return pivot_position;
+    }
+
+    //*************************************************************************
+    /// Heap sort.
+    /// Fallback for when too many bad partitions have been found.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void heap_sort(TIterator begin, TIterator end, TCompare compare)
+    {
+      std::make_heap(begin, end, compare);
+
+      while ((end - begin) > 1)
+      {
+        std::pop_heap(begin, end, compare);
+        --end;
+      }
+    }
+
+    //*************************************************************************
+    /// Chooses a pivot and moves it to *begin.
+    /// Median of 3, or the pseudo median of 9 for large ranges.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void choose_pivot(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+      const difference_t size = end - begin;
+      const difference_t s2   = size / 2;
+
+      if (size_t(size) > NINTHER_THRESHOLD)
+      {
+        sort3(begin,            begin + s2,       end - 1, compare);
+        sort3(begin + 1,        begin + (s2 - 1), end - 2, compare);
+        sort3(begin + 2,        begin + (s2 + 1), end - 3, compare);
+        sort3(begin + (s2 - 1), begin + s2,       begin + (s2 + 1), compare);
+        std::iter_swap(begin, begin + s2);
+      }
+      else
+      {
+        sort3(begin + s2, begin, end - 1, compare);
+      }
+    }
+
+    //*************************************************************************
+    /// Swaps some elements to break up patterns after a bad partition.
+    //*************************************************************************
+    template <typename TIterator>
+    void break_patterns(TIterator begin, TIterator pivot_position, TIterator end)
+    {
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+      const difference_t l_size = pivot_position - begin;
+      const difference_t r_size = end - (pivot_position + 1);
+
+      if (size_t(l_size) > NETWORK_SORT_LIMIT)
+      {
+        std::iter_swap(begin,              begin + l_size / 4);
+        std::iter_swap(pivot_position - 1, pivot_position - l_size / 4);
+
+        if (size_t(l_size) > NINTHER_THRESHOLD)
+        {
+          std::iter_swap(begin + 1,          begin + (l_size / 4 + 1));
+          std::iter_swap(begin + 2,          begin + (l_size / 4 + 2));
+          std::iter_swap(pivot_position - 2, pivot_position - (l_size / 4 + 1));
+          std::iter_swap(pivot_position - 3, pivot_position - (l_size / 4 + 2));
+        }
+      }
+
+      if (size_t(r_size) > NETWORK_SORT_LIMIT)
+      {
+        std::iter_swap(pivot_position + 1, pivot_position + (1 + r_size / 4));
+        std::iter_swap(end - 1,            end - r_size / 4);
+
+        if (size_t(r_size) > NINTHER_THRESHOLD)
+        {
+          std::iter_swap(pivot_position + 2, pivot_position + (2 + r_size / 4));
+          std::iter_swap(pivot_position + 3, pivot_position + (3 + r_size / 4));
+          std::iter_swap(end - 2,            end - (1 + r_size / 4));
+          std::iter_swap(end - 3,            end - (2 + r_size / 4));
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// The number of bad partitions allowed before falling back to heap sort.
+    //*************************************************************************
+    inline int log2(size_t n)
+    {
+      int log = 0;
+
+      while (n >>= 1)
+      {
+        ++log;
+      }
+
+      return log;
+    }
+
+    //*************************************************************************
+    /// Pattern defeating quicksort.
+    /// https://github.com/orlp/pdqsort
+    //*************************************************************************
+    template <const bool BRANCHLESS, typename TIterator, typename TCompare>
+    void pdq_sort(TIterator begin, TIterator end, TCompare compare, int bad_allowed, bool leftmost)
+    {
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+      while (true)
+      {
+        const difference_t size = end - begin;
+
+        if (size_t(size) <= NETWORK_SORT_LIMIT)
+        {
+          network_sort<BRANCHLESS>(begin, size_t(size), compare);
+          return;
+        }
+
+        choose_pivot(begin, end, compare);
+
+        // If the pivot equals the element before the range then it is the
+        // smallest value in the range; put all of its equals to the left.
+        if (!leftmost && !compare(*(begin - 1), *begin))
+        {
+          begin = partition_left(begin, end, compare) + 1;
+          continue;
+        }
+
+        std::pair<TIterator, bool> result = BRANCHLESS ? partition_right_branchless(begin, end, compare)
+                                                       : partition_right(begin, end, compare);
+
+        TIterator    pivot_position      = result.first;
+        const bool   already_partitioned = result.second;
+        difference_t l_size              = pivot_position - begin;
+        difference_t r_size              = end - (pivot_position + 1);
+
+        if ((l_size < (size / 8)) || (r_size < (size / 8)))
+        {
+          // Highly unbalanced.
+          if (--bad_allowed == 0)
+          {
+            heap_sort(begin, end, compare);
+            return;
+          }
+
+          break_patterns(begin, pivot_position, end);
+        }
+        else if (already_partitioned &&
+                 partial_insertion_sort(begin, pivot_position, compare) &&
+                 partial_insertion_sort(pivot_position + 1, end, compare))
+        {
+          return;
+        }
+
+        // Recurse into the left, loop for the right.
+        pdq_sort<BRANCHLESS>(begin, pivot_position, compare, bad_allowed, leftmost);
+        begin    = pivot_position + 1;
+        leftmost = false;
+      }
+    }
+
+    //*************************************************************************
+    /// Introselect.
+    //*************************************************************************
+    template <const bool BRANCHLESS, typename TIterator, typename TCompare>
+    void nth_element(TIterator begin, TIterator nth, TIterator end, TCompare compare)
+    {
+      int bad_allowed = private_sort::log2(size_t(end - begin));
+
+      while (size_t(end - begin) > NETWORK_SORT_LIMIT)
+      {
+        choose_pivot(begin, end, compare);
+
+        std::pair<TIterator, bool> result = BRANCHLESS ? partition_right_branchless(begin, end, compare)
+                                                       : partition_right(begin, end, compare);
+
+        TIterator pivot_position = result.first;
+
+        if (pivot_position == nth)
+        {
+          return;
+        }
+
+        if (((pivot_position - begin) < ((end - begin) / 8)) || ((end - (pivot_position + 1)) < ((end - begin) / 8)))
+        {
+          if (--bad_allowed == 0)
+          {
+            heap_sort(begin, end, compare);
+            return;
+          }
+
+          break_patterns(begin, pivot_position, end);
+        }
+
+        if (nth < pivot_position)
+        {
+          end = pivot_position;
+        }
+        else
+        {
+          begin = pivot_position + 1;
+        }
+      }
+
+      network_sort<BRANCHLESS>(begin, size_t(end - begin), compare);
+    }
+  }
+
   //***************************************************************************
-  /// Sorts the elements using shell sort.
+  /// Sorts the elements using pattern defeating quicksort.
+  /// Ranges of up to 16 elements are sorted with fixed sorting networks.
+  /// Arithmetic types with std::less or std::greater use branchless partitioning.
+  /// Falls back to heap sort to guarantee O(n log n).
+  /// Requires random access iterators.
   /// Uses users defined comparison.
   ///\ingroup algorithm
   //***************************************************************************
   template <typename TIterator, typename TCompare>
   void sort(TIterator first, TIterator last, TCompare compare)
   {
-    typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+    typedef typename std::iterator_traits<TIterator>::value_type value_t;
 
-    difference_t n = std::distance(first, last);
+    if (first != last)
+    {
+      private_sort::pdq_sort<private_sort::is_branchless<value_t, TCompare>::value>(first, last, compare, private_sort::log2(size_t(last - first)), true);
+    }
+  }
 
-    for (difference_t i = n / 2; i > 0; i /= 2)
+  //***************************************************************************
+  /// Sorts the elements using pattern defeating quicksort.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator>
+  void sort(TIterator first, TIterator last)
+  {
+    etl::sort(first, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
+  }
+
+  //***************************************************************************
+  /// Rearranges the elements so that [first, middle) contains the smallest
+  /// elements in sorted order. Uses a heap select.
+  /// Uses users defined comparison.
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/partial_sort"></a>
+  //***************************************************************************
+  template <typename TIterator, typename TCompare>
+  void partial_sort(TIterator first, TIterator middle, TIterator last, TCompare compare)
+  {
+    if (first == middle)
+    {
+      return;
+    }
+
+    std::make_heap(first, middle, compare);
+
+    for (TIterator i = middle; i != last; ++i)
+    {
+      if (compare(*i, *first))
+      {
+        // Replace the largest of the heap.
+        std::pop_heap(first, middle, compare);
+        std::iter_swap(middle - 1, i);
+        std::push_heap(first, middle, compare);
+      }
+    }
+
+    private_sort::heap_sort(first, middle, compare);
+  }
+
+  //***************************************************************************
+  /// partial_sort
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/partial_sort"></a>
+  //***************************************************************************
+  template <typename TIterator>
+  void partial_sort(TIterator first, TIterator middle, TIterator last)
+  {
+    etl::partial_sort(first, middle, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
+  }
+
+  //***************************************************************************
+  /// Partially sorts so that *nth is the element that would be there if the
+  /// range was sorted, with no greater elements before and no lesser after.
+  /// Uses introselect.
+  /// Uses users defined comparison.
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/nth_element"></a>
+  //***************************************************************************
+  template <typename TIterator, typename TCompare>
+  void nth_element(TIterator first, TIterator nth, TIterator last, TCompare compare)
+  {
+    typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+    if ((first != last) && (nth != last))
+    {
+      private_sort::nth_element<private_sort::is_branchless<value_t, TCompare>::value>(first, nth, last, compare);
+    }
+  }
+
+  //***************************************************************************
+  /// nth_element
+  ///\ingroup algorithm
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/nth_element"></a>
+  //***************************************************************************
+  template <typename TIterator>
+  void nth_element(TIterator first, TIterator nth, TIterator last)
+  {
+    etl::nth_element(first, nth, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
+  }
+
+  namespace private_radix_sort
+  {
+    //*************************************************************************
+    /// Maps a key to an unsigned integral with the same ordering.
+    /// Unsigned integrals.
+    //*************************************************************************
+    template <typename T,
+              const bool IS_FLOAT  = etl::is_floating_point<T>::value,
+              const bool IS_SIGNED = etl::is_signed<T>::value>
+    struct key_traits
+    {
+      typedef T unsigned_type;
+
+      static unsigned_type to_unsigned(T key)
+      {
+        return key;
+      }
+    };
+
+    //*************************************************************************
+    /// Signed integrals.
+    /// The sign bit is inverted.
+    //*************************************************************************
+    template <typename T>
+    struct key_traits<T, false, true>
+    {
+      typedef typename etl::make_unsigned<T>::type unsigned_type;
+
+      static unsigned_type to_unsigned(T key)
+      {
+        return static_cast<unsigned_type>(key) ^ (unsigned_type(1) << ((sizeof(T) * CHAR_BIT) - 1));
+      }
+    };
+
+    //*************************************************************************
+    /// Floating point.
+    /// Negative values have all bits inverted, positive values the sign bit.
+    //*************************************************************************
+    template <typename T>
+    struct key_traits<T, true, true>
+    {
+      ETL_STATIC_ASSERT((sizeof(T) == sizeof(uint32_t)) || (sizeof(T) == sizeof(uint64_t)), "Unsupported floating point type");
+
+      typedef typename etl::conditional<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>::type unsigned_type;
+
+      static unsigned_type to_unsigned(T key)
+      {
+        static const unsigned_type SIGN_BIT = unsigned_type(1) << ((sizeof(T) * CHAR_BIT) - 1);
+
+        unsigned_type bits;
+        memcpy(&bits, &key, sizeof(bits));
+
+        return (bits & SIGN_BIT) ? unsigned_type(~bits) : unsigned_type(bits | SIGN_BIT);
+      }
+    };
+
+    //*************************************************************************
+    /// The default key extractor.
+    //*************************************************************************
+    template <typename T>
+    struct identity
+    {
+      const T& operator()(const T& value) const
+      {
+        return value;
+      }
+    };
+
+    //*************************************************************************
+    /// One counting sort pass over the digit at 'shift'.
+    /// Returns false, without moving anything, if every key has the same digit.
+    //*************************************************************************
+    template <const size_t RADIX_BITS, typename TSource, typename TDestination, typename TKeyExtractor, typename TKey>
+    bool pass(TSource source, TDestination destination, size_t n, TKeyExtractor& key, size_t shift, size_t* counts)
     {
-      for (difference_t j = i; j < n; ++j)
+      typedef private_radix_sort::key_traits<TKey> traits;
+      typedef typename traits::unsigned_type       unsigned_type;
+
+      static const size_t        BUCKETS = size_t(1) << RADIX_BITS;
+      static const unsigned_type MASK    = unsigned_type(BUCKETS - 1);
+
+      for (size_t i = 0; i < BUCKETS; ++i)
+      {
+        counts[i] = 0;
+      }
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        ++counts[size_t((traits::to_unsigned(key(source[i])) >> shift) & MASK)];
+      }
+
+      size_t total = 0;
+
+      for (size_t i = 0; i < BUCKETS; ++i)
       {
-        for (difference_t k = j - i; k >= 0; k -= i)
+        if (counts[i] == n)
         {
-          TIterator itr1 = first;
-          TIterator itr2 = first;
+          return false;
+        }
 
-          std::advance(itr1, k);
-          std::advance(itr2, k + i);
+        size_t count = counts[i];
+        counts[i] = total;
+        total += count;
+      }
 
-          if (compare(*itr2, *itr1))
-          {
-            std::iter_swap(itr1, itr2);
-          }
+      for (size_t i = 0; i < n; ++i)
+      {
+        destination[counts[size_t((traits::to_unsigned(key(source[i])) >> shift) & MASK)]++] = source[i];
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// LSD radix sort.
+    /// The last parameter is only used to deduce the key type.
+    //*************************************************************************
+    template <const size_t RADIX_BITS, typename TIterator, typename TScratchIterator, typename TKeyExtractor, typename TKey>
+    void sort(TIterator first, TScratchIterator scratch, size_t n, TKeyExtractor& key, const TKey&)
+    {
+      static const size_t KEY_BITS = sizeof(typename private_radix_sort::key_traits<TKey>::unsigned_type) * CHAR_BIT;
+
+      size_t counts[size_t(1) << RADIX_BITS];
+      bool   in_scratch = false;
+
+      for (size_t shift = 0; shift < KEY_BITS; shift += RADIX_BITS)
+      {
+        bool moved = in_scratch ? pass<RADIX_BITS, TScratchIterator, TIterator, TKeyExtractor, TKey>(scratch, first, n, key, shift, counts)
+                                : pass<RADIX_BITS, TIterator, TScratchIterator, TKeyExtractor, TKey>(first, scratch, n, key, shift, counts);
+
+        if (moved)
+        {
+          in_scratch = !in_scratch;
+        }
+      }
+
+      if (in_scratch)
+      {
+        for (size_t i = 0; i < n; ++i)
+        {
+          first[i] = scratch[i];
         }
       }
     }
   }
 
   //***************************************************************************
-  /// Sorts the elements using shell sort.
+  /// Sorts the elements using an LSD radix sort with RADIX_BITS per digit.
+  /// Stable, O(n) and does not allocate.
+  /// Keys may be signed or unsigned integrals, float or double.
+  ///\tparam RADIX_BITS The number of bits per digit, 1 to 11. Typically 8 or 11.
+  ///                   The digit counts are held on the stack, 2^RADIX_BITS of them.
+  ///\param first   Beginning of the range. Must be random access.
+  ///\param last    End of the range.
+  ///\param scratch Beginning of a scratch buffer of at least the same size as the range.
+  ///\param key     Functor that extracts an arithmetic key from an element.
   ///\ingroup algorithm
   //***************************************************************************
-  template <typename TIterator>
-  void sort(TIterator first, TIterator last)
+  template <const size_t RADIX_BITS, typename TIterator, typename TScratchIterator, typename TKeyExtractor>
+  void radix_sort(TIterator first, TIterator last, TScratchIterator scratch, TKeyExtractor key)
   {
-    etl::sort(first, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
+    ETL_STATIC_ASSERT((RADIX_BITS > 0) && (RADIX_BITS <= 11), "RADIX_BITS must be 1 to 11");
+
+    const size_t n = size_t(std::distance(first, last));
+
+    if (n > 1)
+    {
+      private_radix_sort::sort<RADIX_BITS>(first, scratch, n, key, key(*first));
+    }
+  }
+
+  //***************************************************************************
+  /// Sorts arithmetic elements using an LSD radix sort with RADIX_BITS per digit.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <const size_t RADIX_BITS, typename TIterator, typename TScratchIterator>
+  void radix_sort(TIterator first, TIterator last, TScratchIterator scratch)
+  {
+    typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+    etl::radix_sort<RADIX_BITS>(first, last, scratch, private_radix_sort::identity<value_t>());
+  }
+
+  //***************************************************************************
+  /// Sorts the elements using an LSD radix sort with 8 bits per digit.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TScratchIterator, typename TKeyExtractor>
+  void radix_sort(TIterator first, TIterator last, TScratchIterator scratch, TKeyExtractor key)
+  {
+    etl::radix_sort<8>(first, last, scratch, key);
+  }
+
+  //***************************************************************************
+  /// Sorts arithmetic elements using an LSD radix sort with 8 bits per digit.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TScratchIterator>
+  void radix_sort(TIterator first, TIterator last, TScratchIterator scratch)
+  {
+    etl::radix_sort<8>(first, last, scratch);
   }
 
 #if ETL_CPP11_SUPPORTED
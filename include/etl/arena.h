@@ -0,0 +1,448 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_ARENA_INCLUDED
+#define ETL_ARENA_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "exception.h"
+#include "error_handler.h"
+#include "alignment.h"
+#include "nullptr.h"
+#include "vector.h"
+
+#undef ETL_FILE
+#define ETL_FILE "54"
+
+//*****************************************************************************
+///\defgroup arena arena
+/// A monotonic allocator over a user supplied buffer.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base class for arena exceptions.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena_exception : public exception
+  {
+  public:
+
+    arena_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {}
+  };
+
+  //***************************************************************************
+  /// The exception thrown when the arena does not have enough free space.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena_no_allocation : public arena_exception
+  {
+  public:
+
+    arena_no_allocation(string_type file_name_, numeric_type line_number_)
+      : arena_exception(ETL_ERROR_TEXT("arena:allocation", ETL_FILE"A"), file_name_, line_number_)
+    {}
+  };
+
+  //***************************************************************************
+  /// The exception thrown when rewinding to a marker that is not in use.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena_invalid_marker : public arena_exception
+  {
+  public:
+
+    arena_invalid_marker(string_type file_name_, numeric_type line_number_)
+      : arena_exception(ETL_ERROR_TEXT("arena:invalid marker", ETL_FILE"B"), file_name_, line_number_)
+    {}
+  };
+
+  //***************************************************************************
+  /// A monotonic (bump) allocator over a user supplied buffer.
+  /// Allocation moves a pointer forward. Memory is not freed individually, but
+  /// all at once with reset(), or back to a point recorded with mark().
+  /// Destructors of objects in the arena are not called.
+  /// Not thread safe.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena
+  {
+  public:
+
+    /// Records the amount of the arena in use.
+    typedef size_t marker;
+
+    //*************************************************************************
+    /// Constructor.
+    /// \param buffer      The memory to allocate from.
+    /// \param buffer_size The size of the memory in bytes.
+    //*************************************************************************
+    arena(void* buffer, size_t buffer_size)
+      : p_buffer(static_cast<char*>(buffer)),
+        used(0U),
+        CAPACITY(buffer_size)
+    {
+    }
+
+    //*************************************************************************
+    /// Allocate memory from the arena.
+    /// If asserts or exceptions are enabled and there is not enough space an
+    /// etl::arena_no_allocation is thrown, otherwise a nullptr is returned.
+    /// \param size      The number of bytes required.
+    /// \param alignment The alignment required. Must be a power of two.
+    //*************************************************************************
+    void* allocate(size_t size, size_t alignment)
+    {
+      const uintptr_t base   = reinterpret_cast<uintptr_t>(p_buffer);
+      const uintptr_t first  = (base + used + (alignment - 1U)) & ~uintptr_t(alignment - 1U);
+      const size_t    offset = size_t(first - base);
+
+      if ((offset > CAPACITY) || (size > (CAPACITY - offset)))
+      {
+        ETL_ASSERT(false, ETL_ERROR(arena_no_allocation));
+        return nullptr;
+      }
+
+      used = offset + size;
+
+      return p_buffer + offset;
+    }
+
+    //*************************************************************************
+    /// Allocate uninitialised memory for 'n' objects of type T.
+    //*************************************************************************
+    template <typename T>
+    T* allocate(size_t n = 1U)
+    {
+      if (n > (CAPACITY / sizeof(T)))
+      {
+        ETL_ASSERT(false, ETL_ERROR(arena_no_allocation));
+        return nullptr;
+      }
+
+      return static_cast<T*>(allocate(n * sizeof(T), etl::alignment_of<T>::value));
+    }
+
+    //*************************************************************************
+    /// Return memory to the arena.
+    /// Only the most recent allocation is reclaimed; anything else is kept until
+    /// the arena is rewound or reset.
+    /// \param p    The memory to release.
+    /// \param size The size that was passed to allocate.
+    //*************************************************************************
+    void deallocate(const void* p, size_t size)
+    {
+      const char* p_first = static_cast<const char*>(p);
+
+      if ((p_first + size) == (p_buffer + used))
+      {
+        used = size_t(p_first - p_buffer);
+      }
+    }
+
+    //*************************************************************************
+    /// Returns a marker for the current position in the arena.
+    //*************************************************************************
+    marker mark() const
+    {
+      return used;
+    }
+
+    //*************************************************************************
+    /// Frees everything that was allocated after the marker was taken.
+    /// If asserts or exceptions are enabled and the marker is after the current
+    /// position an etl::arena_invalid_marker is thrown.
+    //*************************************************************************
+    void rewind(marker position)
+    {
+      ETL_ASSERT(position <= used, ETL_ERROR(arena_invalid_marker));
+
+      if (position <= used)
+      {
+        used = position;
+      }
+    }
+
+    //*************************************************************************
+    /// Frees everything in the arena.
+    //*************************************************************************
+    void reset()
+    {
+      used = 0U;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the memory belongs to the arena.
+    //*************************************************************************
+    bool is_in_arena(const void* p) const
+    {
+      const char* p_char = static_cast<const char*>(p);
+
+      return (p_char >= p_buffer) && (p_char < (p_buffer + CAPACITY));
+    }
+
+    //*************************************************************************
+    /// Returns the number of bytes in use, including alignment padding.
+    //*************************************************************************
+    size_t size() const
+    {
+      return used;
+    }
+
+    //*************************************************************************
+    /// Returns the size of the arena in bytes.
+    //*************************************************************************
+    size_t capacity() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the number of bytes free, before alignment.
+    //*************************************************************************
+    size_t available() const
+    {
+      return CAPACITY - used;
+    }
+
+    //*************************************************************************
+    /// Checks to see if nothing is allocated.
+    //*************************************************************************
+    bool empty() const
+    {
+      return used == 0U;
+    }
+
+  private:
+
+    // Disable copy construction and assignment.
+    arena(const arena&);
+    arena& operator =(const arena&);
+
+    char*        p_buffer;
+    size_t       used;     ///< The number of bytes in use.
+    const size_t CAPACITY; ///< The size of the buffer.
+  };
+
+  //***************************************************************************
+  /// An arena with an internal buffer.
+  ///\tparam SIZE_ The size of the buffer in bytes.
+  ///\ingroup arena
+  //***************************************************************************
+  template <const size_t SIZE_>
+  class arena_buffer : public etl::arena
+  {
+  public:
+
+    static const size_t SIZE = SIZE_;
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    arena_buffer()
+      : etl::arena(&buffer, SIZE)
+    {
+    }
+
+  private:
+
+    typename etl::aligned_storage<SIZE, etl::alignment_of<typename etl::type_with_alignment<8U>::type>::value>::type buffer;
+  };
+
+  template <const size_t SIZE_>
+  const size_t arena_buffer<SIZE_>::SIZE;
+
+  //***************************************************************************
+  /// An allocator that takes its memory from an etl::arena.
+  /// Meets the allocator requirements of the standard containers.
+  /// deallocate only reclaims the most recent allocation.
+  ///\code
+  /// std::vector<int, etl::arena_allocator<int>> v(etl::arena_allocator<int>(arena));
+  ///\endcode
+  ///\ingroup arena
+  //***************************************************************************
+  template <typename T>
+  class arena_allocator
+  {
+  public:
+
+    typedef T         value_type;
+    typedef T*        pointer;
+    typedef const T*  const_pointer;
+    typedef T&        reference;
+    typedef const T&  const_reference;
+    typedef size_t    size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+      typedef arena_allocator<U> other;
+    };
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    explicit arena_allocator(etl::arena& arena_)
+      : p_arena(&arena_)
+    {
+    }
+
+    //*************************************************************************
+    /// Converting constructor.
+    //*************************************************************************
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other)
+      : p_arena(&other.get_arena())
+    {
+    }
+
+    //*************************************************************************
+    /// Allocate memory for 'n' objects.
+    //*************************************************************************
+    T* allocate(size_t n)
+    {
+      return p_arena->template allocate<T>(n);
+    }
+
+    //*************************************************************************
+    /// Return the memory for 'n' objects.
+    //*************************************************************************
+    void deallocate(T* p, size_t n)
+    {
+      p_arena->deallocate(p, n * sizeof(T));
+    }
+
+#if !ETL_CPP11_SUPPORTED
+    //*************************************************************************
+    /// C++03 allocator requirements.
+    //*************************************************************************
+    size_t max_size() const
+    {
+      return p_arena->capacity() / sizeof(T);
+    }
+
+    void construct(T* p, const T& value)
+    {
+      ::new (p) T(value);
+    }
+
+    void destroy(T* p)
+    {
+      p->~T();
+    }
+#endif
+
+    //*************************************************************************
+    /// Returns the arena.
+    //*************************************************************************
+    etl::arena& get_arena() const
+    {
+      return *p_arena;
+    }
+
+  private:
+
+    etl::arena* p_arena;
+  };
+
+  //***************************************************************************
+  /// Allocators are equal if they use the same arena.
+  //***************************************************************************
+  template <typename T, typename U>
+  bool operator ==(const etl::arena_allocator<T>& lhs, const etl::arena_allocator<U>& rhs)
+  {
+    return &lhs.get_arena() == &rhs.get_arena();
+  }
+
+  template <typename T, typename U>
+  bool operator !=(const etl::arena_allocator<T>& lhs, const etl::arena_allocator<U>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //***************************************************************************
+  /// An external buffer etl::vector whose buffer is allocated from an arena.
+  /// The buffer is not returned to the arena when the vector is destroyed.
+  ///\code
+  /// etl::arena_vector<int> v(arena, 100);
+  ///\endcode
+  ///\ingroup arena
+  //***************************************************************************
+  template <typename T>
+  class arena_vector : public etl::vector<T, 0>
+  {
+  public:
+
+    //*************************************************************************
+    /// Constructor.
+    /// \param arena_   The arena to allocate the buffer from.
+    /// \param max_size The maximum number of elements.
+    //*************************************************************************
+    arena_vector(etl::arena& arena_, size_t max_size)
+      : etl::vector<T, 0>(arena_.template allocate<T>(max_size), max_size)
+    {
+    }
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    //*************************************************************************
+    template <typename TIterator>
+    arena_vector(etl::arena& arena_, size_t max_size, TIterator first, TIterator last)
+      : etl::vector<T, 0>(first, last, arena_.template allocate<T>(max_size), max_size)
+    {
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    arena_vector& operator = (const arena_vector& rhs)
+    {
+      etl::vector<T, 0>::operator =(rhs);
+
+      return *this;
+    }
+
+  private:
+
+    arena_vector(const arena_vector&);
+  };
+}
+
+#undef ETL_FILE
+
+#endif
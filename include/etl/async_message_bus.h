@@ -0,0 +1,685 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_ASYNC_MESSAGE_BUS_INCLUDED
+#define ETL_ASYNC_MESSAGE_BUS_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "algorithm.h"
+#include "atomic.h"
+#include "vector.h"
+#include "nullptr.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "message.h"
+#include "message_router.h"
+#include "message_bus.h"
+#include "message_pool.h"
+#include "queue_mpmc_atomic.h"
+#include "task.h"
+
+#undef ETL_FILE
+#define ETL_FILE "58"
+
+#if ETL_HAS_ATOMIC && ETL_CPP11_SUPPORTED && !defined(ETL_NO_STL)
+
+#include <thread>
+
+//*****************************************************************************
+///\defgroup async_message_bus async_message_bus
+/// A message bus that queues messages in a mailbox for each subscriber, to be
+/// handled on the subscriber's own thread.
+///\ingroup messaging
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// What a mailbox does with a message when it is full.
+  ///\ingroup async_message_bus
+  //***************************************************************************
+  struct mailbox_policy
+  {
+    enum enum_type
+    {
+      DROP,     ///< Drops the new message.
+      BLOCK,    ///< Waits for the subscriber to make space.
+      OVERWRITE ///< Drops the oldest message to make space.
+    };
+  };
+
+  //***************************************************************************
+  /// The base of all mailboxes.
+  /// A mailbox queues messages for a router, which handles them when the
+  /// mailbox is processed. Messages may be posted from any thread. process()
+  /// may only be called from one thread at a time, usually the subscriber's.
+  /// A mailbox is also an etl::task, so it may be processed by a scheduler;
+  /// posting a message notifies the scheduler.
+  /// The BLOCK policy waits for the mailbox to be processed, so must not be
+  /// used by a thread that processes the mailbox itself.
+  ///\ingroup async_message_bus
+  //***************************************************************************
+  class imailbox : public etl::task
+  {
+  public:
+
+    //*************************************************************************
+    /// Queues a share of a pooled message, applying the mailbox policy if it
+    /// is full.
+    /// \return <b>true</b> if the message was queued, <b>false</b> if it was dropped.
+    //*************************************************************************
+    bool post(etl::imessage_router& source, const etl::message_handle& handle)
+    {
+      entry new_entry = { handle.share().release(), &source };
+
+      bool queued = queue.push(new_entry);
+
+      if (!queued)
+      {
+        switch (policy)
+        {
+          case etl::mailbox_policy::BLOCK:
+          {
+            while (!queue.push(new_entry))
+            {
+              std::this_thread::yield();
+            }
+
+            queued = true;
+            break;
+          }
+
+          case etl::mailbox_policy::OVERWRITE:
+          {
+            while (!queue.push(new_entry))
+            {
+              entry oldest;
+
+              if (queue.pop(oldest))
+              {
+                release(oldest);
+                n_dropped.fetch_add(1U, etl::memory_order_relaxed);
+              }
+            }
+
+            queued = true;
+            break;
+          }
+
+          case etl::mailbox_policy::DROP:
+          default:
+          {
+            release(new_entry);
+            n_dropped.fetch_add(1U, etl::memory_order_relaxed);
+            break;
+          }
+        }
+      }
+
+      if (queued)
+      {
+        notify();
+      }
+
+      return queued;
+    }
+
+    //*************************************************************************
+    /// Passes the queued messages to the router.
+    /// \return The number of messages processed.
+    //*************************************************************************
+    size_t process()
+    {
+      size_t count = 0U;
+
+      entry current;
+
+      while (queue.pop(current))
+      {
+        router.receive(*current.p_source, *current.p_node->p_message);
+        release(current);
+
+        ++count;
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Releases the queued messages without handling them.
+    //*************************************************************************
+    void clear()
+    {
+      entry current;
+
+      while (queue.pop(current))
+      {
+        release(current);
+      }
+    }
+
+    //*************************************************************************
+    /// Returns the router that handles the messages.
+    //*************************************************************************
+    etl::imessage_router& get_router() const
+    {
+      return router;
+    }
+
+    //*************************************************************************
+    /// Returns the policy for a full mailbox.
+    //*************************************************************************
+    etl::mailbox_policy::enum_type get_policy() const
+    {
+      return policy;
+    }
+
+    //*************************************************************************
+    /// Returns the number of messages that have been dropped.
+    //*************************************************************************
+    uint32_t dropped() const
+    {
+      return n_dropped.load(etl::memory_order_relaxed);
+    }
+
+    //*************************************************************************
+    /// Returns the number of queued messages.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_t size() const
+    {
+      return queue.size();
+    }
+
+    //*************************************************************************
+    /// Checks to see if there are no queued messages.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool empty() const
+    {
+      return queue.empty();
+    }
+
+    //*************************************************************************
+    /// The task has work while messages are queued.
+    //*************************************************************************
+    uint32_t task_request_work() const
+    {
+      return uint32_t(queue.size());
+    }
+
+    //*************************************************************************
+    /// The task processes the queued messages.
+    //*************************************************************************
+    void task_process_work()
+    {
+      process();
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// A queued share of a message.
+    //*************************************************************************
+    struct entry
+    {
+      etl::message_node*    p_node;
+      etl::imessage_router* p_source;
+    };
+
+    typedef etl::iqueue_mpmc_atomic<entry> queue_t;
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    imailbox(queue_t&                       queue_,
+             etl::imessage_router&          router_,
+             etl::mailbox_policy::enum_type policy_,
+             etl::task_priority_t           priority_)
+      : etl::task(priority_),
+        queue(queue_),
+        router(router_),
+        policy(policy_),
+        n_dropped(0U)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~imailbox()
+    {
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Gives up the entry's share of the message.
+    //*************************************************************************
+    static void release(const entry& e)
+    {
+      etl::message_handle(e.p_node).reset();
+    }
+
+    // Disable copy construction and assignment.
+    imailbox(const imailbox&);
+    imailbox& operator =(const imailbox&);
+
+    queue_t&                             queue;
+    etl::imessage_router&                router;
+    const etl::mailbox_policy::enum_type policy;
+    etl::atomic<uint32_t>                n_dropped;
+  };
+
+  //***************************************************************************
+  /// A mailbox that holds up to SIZE_ messages.
+  ///\tparam SIZE_ The capacity of the mailbox. Must be a power of two.
+  ///\ingroup async_message_bus
+  //***************************************************************************
+  template <size_t SIZE_>
+  class mailbox : public etl::imailbox
+  {
+  public:
+
+    static const size_t SIZE = SIZE_;
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    mailbox(etl::imessage_router&          router_,
+            etl::mailbox_policy::enum_type policy_   = etl::mailbox_policy::DROP,
+            etl::task_priority_t           priority_ = 0)
+      : imailbox(queue, router_, policy_, priority_)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    /// Releases any messages that have not been processed.
+    //*************************************************************************
+    ~mailbox()
+    {
+      clear();
+    }
+
+  private:
+
+    etl::queue_mpmc_atomic<entry, SIZE> queue;
+  };
+
+  template <size_t SIZE_>
+  const size_t mailbox<SIZE_>::SIZE;
+
+  //***************************************************************************
+  /// The base of all asynchronous message buses.
+  /// Each message is copied in to the message pool once, and a share of it is
+  /// posted to the mailbox of every subscriber whose router accepts it. A
+  /// slow subscriber only fills its own mailbox.
+  /// Messages may be sent from any thread. Subscribers must not be added or
+  /// removed while messages are being sent.
+  ///\ingroup async_message_bus
+  //***************************************************************************
+  class iasync_message_bus : public etl::imessage_router
+  {
+  private:
+
+    typedef etl::ivector<etl::imailbox*> mailbox_list_t;
+
+  public:
+
+    using etl::imessage_router::receive;
+
+    //*******************************************
+    /// Subscribe a mailbox to the bus.
+    //*******************************************
+    bool subscribe(etl::imailbox& mailbox)
+    {
+      bool ok = !mailbox_list.full();
+
+      ETL_ASSERT(ok, ETL_ERROR(etl::message_bus_too_many_subscribers));
+
+      if (ok)
+      {
+        mailbox_list.push_back(&mailbox);
+      }
+
+      return ok;
+    }
+
+    //*******************************************
+    /// Unsubscribe the mailboxes for a router id.
+    //*******************************************
+    void unsubscribe(etl::message_router_id_t id)
+    {
+      if (id == etl::imessage_router::ALL_MESSAGE_ROUTERS)
+      {
+        clear();
+      }
+      else
+      {
+        mailbox_list_t::iterator itr = mailbox_list.begin();
+
+        while (itr != mailbox_list.end())
+        {
+          if ((*itr)->get_router().get_message_router_id() == id)
+          {
+            itr = mailbox_list.erase(itr);
+          }
+          else
+          {
+            ++itr;
+          }
+        }
+      }
+    }
+
+    //*******************************************
+    /// Unsubscribe a mailbox.
+    //*******************************************
+    void unsubscribe(etl::imailbox& mailbox)
+    {
+      mailbox_list_t::iterator itr = std::find(mailbox_list.begin(), mailbox_list.end(), &mailbox);
+
+      if (itr != mailbox_list.end())
+      {
+        mailbox_list.erase(itr);
+      }
+    }
+
+    //*******************************************
+    void receive(const etl::imessage& message)
+    {
+      receive(etl::null_message_router::instance(), etl::imessage_router::ALL_MESSAGE_ROUTERS, message);
+    }
+
+    //*******************************************
+    void receive(etl::message_router_id_t destination_router_id, const etl::imessage& message)
+    {
+      receive(etl::null_message_router::instance(), destination_router_id, message);
+    }
+
+    //*******************************************
+    void receive(etl::imessage_router& source, const etl::imessage& message)
+    {
+      receive(source, etl::imessage_router::ALL_MESSAGE_ROUTERS, message);
+    }
+
+    //*******************************************
+    /// Copies the message in to the pool, if any subscriber accepts it, and
+    /// posts it to their mailboxes.
+    //*******************************************
+    void receive(etl::imessage_router&    source,
+                 etl::message_router_id_t destination_router_id,
+                 const etl::imessage&     message)
+    {
+      etl::message_handle handle;
+
+      for (size_t i = 0U; i < mailbox_list.size(); ++i)
+      {
+        etl::imailbox& mailbox = *mailbox_list[i];
+
+        if (is_destination(mailbox, destination_router_id, message.message_id))
+        {
+          if (!handle.has_value())
+          {
+            handle = clone(message);
+
+            if (!handle.has_value())
+            {
+              return;
+            }
+          }
+
+          mailbox.post(source, handle);
+        }
+      }
+    }
+
+    //*******************************************
+    /// Posts a message that is already in a pool to the mailboxes of the
+    /// subscribers that accept it, without copying it.
+    /// \return The number of mailboxes that queued the message.
+    //*******************************************
+    size_t publish(const etl::message_handle& handle)
+    {
+      return publish(etl::null_message_router::instance(), etl::imessage_router::ALL_MESSAGE_ROUTERS, handle);
+    }
+
+    //*******************************************
+    size_t publish(etl::imessage_router& source, const etl::message_handle& handle)
+    {
+      return publish(source, etl::imessage_router::ALL_MESSAGE_ROUTERS, handle);
+    }
+
+    //*******************************************
+    size_t publish(etl::imessage_router&      source,
+                   etl::message_router_id_t   destination_router_id,
+                   const etl::message_handle& handle)
+    {
+      size_t count = 0U;
+
+      for (size_t i = 0U; i < mailbox_list.size(); ++i)
+      {
+        etl::imailbox& mailbox = *mailbox_list[i];
+
+        if (is_destination(mailbox, destination_router_id, handle.get().message_id) && mailbox.post(source, handle))
+        {
+          ++count;
+        }
+      }
+
+      return count;
+    }
+
+    //*******************************************
+    /// Returns the message pool.
+    //*******************************************
+    etl::imessage_pool& get_pool()
+    {
+      return pool;
+    }
+
+    //*******************************************
+    size_t size() const
+    {
+      return mailbox_list.size();
+    }
+
+    //*******************************************
+    void clear()
+    {
+      mailbox_list.clear();
+    }
+
+    //********************************************
+    bool is_null_router() const
+    {
+      return false;
+    }
+
+  protected:
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    iasync_message_bus(mailbox_list_t& list, etl::imessage_pool& pool_)
+      : imessage_router(etl::imessage_router::MESSAGE_BUS),
+        mailbox_list(list),
+        pool(pool_)
+    {
+    }
+
+    //*******************************************
+    /// Copies a message in to the pool as its own type.
+    //*******************************************
+    virtual etl::message_handle clone(const etl::imessage& message) = 0;
+
+  private:
+
+    //*******************************************
+    /// Does the message go to this mailbox?
+    //*******************************************
+    static bool is_destination(const etl::imailbox& mailbox, etl::message_router_id_t destination_router_id, etl::message_id_t id)
+    {
+      const etl::imessage_router& router = mailbox.get_router();
+
+      return ((destination_router_id == etl::imessage_router::ALL_MESSAGE_ROUTERS) ||
+              (destination_router_id == router.get_message_router_id())) &&
+             router.accepts(id);
+    }
+
+    mailbox_list_t&     mailbox_list;
+    etl::imessage_pool& pool;
+  };
+
+  //***************************************************************************
+  /// The asynchronous message bus.
+  ///\code
+  /// etl::message_pool<etl::generic_atomic_pool<64, 8, 32>> pool;
+  /// etl::async_message_bus<4, Message1, Message2> bus(pool);
+  ///
+  /// etl::mailbox<16> mailbox(router, etl::mailbox_policy::OVERWRITE);
+  /// bus.subscribe(mailbox);
+  ///
+  /// // On any thread.
+  /// etl::send_message(bus, Message1());
+  ///
+  /// // On the subscriber's thread.
+  /// mailbox.process();
+  ///\endcode
+  ///\tparam MAX_SUBSCRIBERS_ The maximum number of mailboxes.
+  ///\tparam TMessageTypes    The types of message that may be sent on the bus.
+  ///\ingroup async_message_bus
+  //***************************************************************************
+  template <uint_least8_t MAX_SUBSCRIBERS_, typename... TMessageTypes>
+  class async_message_bus : public etl::iasync_message_bus
+  {
+  public:
+
+    ETL_STATIC_ASSERT(sizeof...(TMessageTypes) != 0U, "No message types");
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    explicit async_message_bus(etl::imessage_pool& pool_)
+      : iasync_message_bus(mailbox_list, pool_)
+    {
+    }
+
+    using iasync_message_bus::accepts;
+
+    //*******************************************
+    /// Accepts the message types that it can copy.
+    //*******************************************
+    bool accepts(etl::message_id_t id) const
+    {
+      return is_one_of<TMessageTypes...>(id);
+    }
+
+  protected:
+
+    //*******************************************
+    etl::message_handle clone(const etl::imessage& message)
+    {
+      etl::message_handle handle = get_pool().template clone<TMessageTypes...>(message);
+
+      ETL_ASSERT(handle.has_value() || accepts(message.message_id), ETL_ERROR(etl::unhandled_message_exception));
+
+      return handle;
+    }
+
+  private:
+
+    //*******************************************
+    template <typename T1, typename... TRest>
+    static bool is_one_of(etl::message_id_t id)
+    {
+      return (id == T1::ID) || is_one_of<TRest...>(id);
+    }
+
+    template <typename... TRest>
+    static typename etl::enable_if<sizeof...(TRest) == 0U, bool>::type
+      is_one_of(etl::message_id_t)
+    {
+      return false;
+    }
+
+    etl::vector<etl::imailbox*, MAX_SUBSCRIBERS_> mailbox_list;
+  };
+
+  //***************************************************************************
+  /// Send a message to an asynchronous bus.
+  //***************************************************************************
+  inline static void send_message(etl::iasync_message_bus& bus,
+                                  const etl::imessage&     message)
+  {
+    bus.receive(message);
+  }
+
+  //***************************************************************************
+  /// Send a message to an asynchronous bus.
+  //***************************************************************************
+  inline static void send_message(etl::iasync_message_bus& bus,
+                                  etl::message_router_id_t id,
+                                  const etl::imessage&     message)
+  {
+    bus.receive(id, message);
+  }
+
+  //***************************************************************************
+  /// Send a message to an asynchronous bus.
+  //***************************************************************************
+  inline static void send_message(etl::imessage_router&    source,
+                                  etl::iasync_message_bus& bus,
+                                  const etl::imessage&     message)
+  {
+    bus.receive(source, message);
+  }
+
+  //***************************************************************************
+  /// Send a message to an asynchronous bus.
+  //***************************************************************************
+  inline static void send_message(etl::imessage_router&    source,
+                                  etl::iasync_message_bus& bus,
+                                  etl::message_router_id_t id,
+                                  const etl::imessage&     message)
+  {
+    bus.receive(source, id, message);
+  }
+}
+
+#endif
+
+#undef ETL_FILE
+
+#endif
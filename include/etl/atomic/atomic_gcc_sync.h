@@ -738,7 +738,7 @@ namespace etl
     atomic& operator =(const atomic&);
     atomic& operator =(const atomic&) volatile;
 
-    mutable volatile T* value;
+    mutable T* volatile value;
   };
 
   typedef etl::atomic<char>                atomic_char;
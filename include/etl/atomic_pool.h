@@ -0,0 +1,676 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_ATOMIC_POOL_INCLUDED
+#define ETL_ATOMIC_POOL_INCLUDED
+
+#include <stdint.h>
+
+#include <new>
+
+#include "platform.h"
+#include "atomic.h"
+#include "alignment.h"
+#include "static_assert.h"
+#include "error_handler.h"
+#include "nullptr.h"
+#include "pool.h"
+
+#if ETL_HAS_ATOMIC
+
+#undef ETL_FILE
+#define ETL_FILE "51"
+
+//*****************************************************************************
+///\defgroup atomic_pool atomic_pool
+/// A fixed capacity pool that may be shared between threads without locks.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base of the lock free pools.
+  /// The free list is a Treiber stack of item indexes.
+  /// The head holds the index of the first free item in the low 32 bits and a
+  /// generation tag in the high 32 bits, so that one 64 bit compare and swap
+  /// detects the head having been popped and pushed back (the ABA problem).
+  /// allocate, release, create and destroy may be called from any thread.
+  /// Errors are reported with the etl::pool exceptions.
+  ///\ingroup atomic_pool
+  //***************************************************************************
+  class iatomic_pool
+  {
+  public:
+
+    typedef size_t size_type;
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T>
+    T* allocate()
+    {
+      if (sizeof(T) > ITEM_SIZE)
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::pool_element_size));
+      }
+
+      return reinterpret_cast<T*>(allocate_item());
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_POOL_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create default.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T>
+    T* create()
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T();
+      }
+
+      return p;
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 1 parameter.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T, typename T1>
+    T* create(const T1& value1)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2>
+    T* create(const T1& value1, const T2& value2)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3>
+    T* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3, typename T4>
+    T* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3, value4);
+      }
+
+      return p;
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(std::forward<Args>(args)...);
+      }
+
+      return p;
+    }
+#endif
+
+    //*************************************************************************
+    /// Destroys the object.
+    /// Undefined behaviour if the pool does not contain a 'T'.
+    /// \param p_object A pointer to the object to be destroyed.
+    //*************************************************************************
+    template <typename T>
+    void destroy(const void* const p_object)
+    {
+      if (sizeof(T) > ITEM_SIZE)
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::pool_element_size));
+      }
+
+      reinterpret_cast<T*>((const_cast<void*>(p_object)))->~T();
+      release(p_object);
+    }
+
+    //*************************************************************************
+    /// Release an object in the pool.
+    /// If asserts or exceptions are enabled and the object does not belong to this
+    /// pool then an etl::pool_object_not_in_pool is thrown.
+    /// \param p_object A pointer to the object to be released.
+    //*************************************************************************
+    void release(const void* const p_object)
+    {
+      release_item(static_cast<const char*>(p_object));
+    }
+
+    //*************************************************************************
+    /// Allocate up to 'n' items from the pool with a single swap of the head.
+    /// Does not assert if the pool runs out of items.
+    /// \param p_items Where to write the pointers to the allocated items.
+    /// \param n       The number of items wanted.
+    /// \return The number of items allocated.
+    //*************************************************************************
+    size_t allocate_batch(void** p_items, size_t n)
+    {
+      uint64_t current = head.load(etl::memory_order_acquire);
+      uint32_t next;
+      size_t   count;
+
+      do
+      {
+        // Walk the chain. Links may be stale, but then the tag will have changed and the swap fails.
+        next  = uint32_t(current);
+        count = 0U;
+
+        while ((count < n) && (next != Nil))
+        {
+          p_items[count++] = p_buffer + (size_t(next) * ITEM_SIZE);
+          next = p_next_index[next].load(etl::memory_order_relaxed);
+        }
+
+        if (count == 0U)
+        {
+          return 0U;
+        }
+      } while (!head.compare_exchange_weak(current,
+                                           make_head(next_tag(current), next),
+                                           etl::memory_order_acquire,
+                                           etl::memory_order_acquire));
+
+      items_allocated.fetch_add(uint32_t(count), etl::memory_order_relaxed);
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Release 'n' items back to the pool with a single swap of the head.
+    /// \param p_items The pointers to the items to release.
+    /// \param n       The number of items.
+    //*************************************************************************
+    void release_batch(void* const* p_items, size_t n)
+    {
+      if (n == 0U)
+      {
+        return;
+      }
+
+      // Link the items together before publishing them.
+      for (size_t i = 0U; i < n; ++i)
+      {
+        ETL_ASSERT(is_item_in_pool(static_cast<const char*>(p_items[i])), ETL_ERROR(pool_object_not_in_pool));
+
+        if (i != 0U)
+        {
+          p_next_index[index_of(p_items[i - 1U])].store(index_of(p_items[i]), etl::memory_order_relaxed);
+        }
+      }
+
+      const uint32_t first = index_of(p_items[0]);
+      const uint32_t last  = index_of(p_items[n - 1U]);
+
+      // Count the items as free before they can be allocated again, so that the count never exceeds MAX_SIZE.
+      items_allocated.fetch_sub(uint32_t(n), etl::memory_order_relaxed);
+
+      uint64_t current = head.load(etl::memory_order_relaxed);
+
+      do
+      {
+        p_next_index[last].store(uint32_t(current), etl::memory_order_relaxed);
+      } while (!head.compare_exchange_weak(current,
+                                           make_head(next_tag(current), first),
+                                           etl::memory_order_release,
+                                           etl::memory_order_relaxed));
+    }
+
+    //*************************************************************************
+    /// Check to see if the object belongs to the pool.
+    /// \param p_object A pointer to the object to be checked.
+    /// \return <b>true<\b> if it does, otherwise <b>false</b>
+    //*************************************************************************
+    bool is_in_pool(const void* p_object) const
+    {
+      return is_item_in_pool(static_cast<const char*>(p_object));
+    }
+
+    //*************************************************************************
+    /// Returns the size of the items in the pool.
+    //*************************************************************************
+    size_t get_item_size() const
+    {
+      return ITEM_SIZE;
+    }
+
+    //*************************************************************************
+    /// Returns the maximum number of items in the pool.
+    //*************************************************************************
+    size_t max_size() const
+    {
+      return MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// Returns the number of free items in the pool.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_t available() const
+    {
+      return MAX_SIZE - size();
+    }
+
+    //*************************************************************************
+    /// Returns the number of allocated items in the pool.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_t size() const
+    {
+      return items_allocated.load(etl::memory_order_relaxed);
+    }
+
+    //*************************************************************************
+    /// Checks to see if there are no allocated items in the pool.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool empty() const
+    {
+      return size() == 0U;
+    }
+
+    //*************************************************************************
+    /// Checks to see if there are no free items in the pool.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool full() const
+    {
+      return size() == MAX_SIZE;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    iatomic_pool(char* p_buffer_, etl::atomic<uint32_t>* p_next_index_, uint32_t item_size_, uint32_t max_size_)
+      : p_buffer(p_buffer_),
+        p_next_index(p_next_index_),
+        head(Nil),
+        items_allocated(0U),
+        ITEM_SIZE(item_size_),
+        MAX_SIZE(max_size_)
+    {
+    }
+
+    //*************************************************************************
+    /// Links every item into the free list.
+    /// Called by the derived class once the links have been constructed.
+    //*************************************************************************
+    void initialise()
+    {
+      if (MAX_SIZE != 0U)
+      {
+        for (uint32_t i = 0U; i < (MAX_SIZE - 1U); ++i)
+        {
+          p_next_index[i].store(i + 1U, etl::memory_order_relaxed);
+        }
+
+        p_next_index[MAX_SIZE - 1U].store(Nil, etl::memory_order_relaxed);
+        head.store(make_head(0U, 0U), etl::memory_order_relaxed);
+      }
+    }
+
+  private:
+
+    static const uint32_t Nil = 0xFFFFFFFFUL;
+
+    //*************************************************************************
+    /// Pop an item from the free list.
+    //*************************************************************************
+    char* allocate_item()
+    {
+      uint64_t current = head.load(etl::memory_order_acquire);
+      uint32_t index;
+
+      do
+      {
+        index = uint32_t(current);
+
+        if (index == Nil)
+        {
+          ETL_ASSERT(false, ETL_ERROR(pool_no_allocation));
+          return nullptr;
+        }
+
+        // May read a stale link if another thread pops this item first, but then the tag will have changed and the swap fails.
+      } while (!head.compare_exchange_weak(current,
+                                           make_head(next_tag(current), p_next_index[index].load(etl::memory_order_relaxed)),
+                                           etl::memory_order_acquire,
+                                           etl::memory_order_acquire));
+
+      items_allocated.fetch_add(1U, etl::memory_order_relaxed);
+
+      return p_buffer + (size_t(index) * ITEM_SIZE);
+    }
+
+    //*************************************************************************
+    /// Push an item on to the free list.
+    //*************************************************************************
+    void release_item(const char* p_value)
+    {
+      // Does it belong to us?
+      ETL_ASSERT(is_item_in_pool(p_value), ETL_ERROR(pool_object_not_in_pool));
+
+      const uint32_t index = index_of(p_value);
+
+      // Count the item as free before it can be allocated again, so that the count never exceeds MAX_SIZE.
+      items_allocated.fetch_sub(1U, etl::memory_order_relaxed);
+
+      uint64_t current = head.load(etl::memory_order_relaxed);
+
+      do
+      {
+        p_next_index[index].store(uint32_t(current), etl::memory_order_relaxed);
+      } while (!head.compare_exchange_weak(current,
+                                           make_head(next_tag(current), index),
+                                           etl::memory_order_release,
+                                           etl::memory_order_relaxed));
+    }
+
+    //*************************************************************************
+    /// Check if the item belongs to this pool.
+    //*************************************************************************
+    bool is_item_in_pool(const char* p) const
+    {
+      // Within the range of the buffer?
+      intptr_t distance = p - p_buffer;
+      bool is_within_range = (distance >= 0) && (distance <= intptr_t((ITEM_SIZE * MAX_SIZE) - ITEM_SIZE));
+
+      // Modulus and division can be slow on some architectures, so only do this in debug.
+#if defined(ETL_DEBUG)
+      // Is the address on a valid object boundary?
+      bool is_valid_address = ((distance % ITEM_SIZE) == 0);
+#else
+      bool is_valid_address = true;
+#endif
+
+      return is_within_range && is_valid_address;
+    }
+
+    uint32_t index_of(const void* p) const
+    {
+      return uint32_t((static_cast<const char*>(p) - p_buffer) / ITEM_SIZE);
+    }
+
+    static uint32_t next_tag(uint64_t value)
+    {
+      return uint32_t(value >> 32) + 1U;
+    }
+
+    static uint64_t make_head(uint32_t tag, uint32_t index)
+    {
+      return (uint64_t(tag) << 32) | index;
+    }
+
+    // Disable copy construction and assignment.
+    iatomic_pool(const iatomic_pool&);
+    iatomic_pool& operator =(const iatomic_pool&);
+
+    char*                  p_buffer;
+    etl::atomic<uint32_t>* p_next_index;    ///< The free list links, one per item.
+    etl::atomic<uint64_t>  head;            ///< Tag and index of the first free item.
+    etl::atomic<uint32_t>  items_allocated; ///< The number of items allocated.
+
+    const uint32_t ITEM_SIZE; ///< The size of allocated items.
+    const uint32_t MAX_SIZE;  ///< The maximum number of objects that can be allocated.
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_POOL) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iatomic_pool()
+    {
+    }
+#else
+  protected:
+    ~iatomic_pool()
+    {
+    }
+#endif
+  };
+
+  //*************************************************************************
+  /// A templated abstract lock free pool implementation that uses a fixed size pool.
+  ///\ingroup atomic_pool
+  //*************************************************************************
+  template <const size_t TYPE_SIZE_, const size_t ALIGNMENT_, const size_t SIZE_>
+  class generic_atomic_pool : public etl::iatomic_pool
+  {
+  public:
+
+    static const size_t SIZE      = SIZE_;
+    static const size_t ALIGNMENT = ALIGNMENT_;
+    static const size_t TYPE_SIZE = TYPE_SIZE_;
+
+    ETL_STATIC_ASSERT(SIZE_ < 0xFFFFFFFFUL, "Too many items for 32 bit indexes");
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    generic_atomic_pool()
+      : etl::iatomic_pool(reinterpret_cast<char*>(&buffer[0]), next_index, ELEMENT_SIZE, SIZE)
+    {
+      iatomic_pool::initialise();
+    }
+
+    //*************************************************************************
+    /// Allocate an object from the pool.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    /// Static asserts if the specified type is too large for the pool.
+    //*************************************************************************
+    template <typename U>
+    U* allocate()
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return iatomic_pool::allocate<U>();
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_POOL_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with default.
+    //*************************************************************************
+    template <typename U>
+    U* create()
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return iatomic_pool::create<U>();
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 1 parameter.
+    //*************************************************************************
+    template <typename U, typename T1>
+    U* create(const T1& value1)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return iatomic_pool::create<U>(value1);
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 2 parameters.
+    //*************************************************************************
+    template <typename U, typename T1, typename T2>
+    U* create(const T1& value1, const T2& value2)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return iatomic_pool::create<U>(value1, value2);
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 3 parameters.
+    //*************************************************************************
+    template <typename U, typename T1, typename T2, typename T3>
+    U* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return iatomic_pool::create<U>(value1, value2, value3);
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 4 parameters.
+    //*************************************************************************
+    template <typename U, typename T1, typename T2, typename T3, typename T4>
+    U* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return iatomic_pool::create<U>(value1, value2, value3, value4);
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename U, typename... Args>
+    U* create(Args&&... args)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return iatomic_pool::create<U>(std::forward<Args>(args)...);
+    }
+#endif
+
+    //*************************************************************************
+    /// Destroys the object.
+    /// Undefined behaviour if the pool does not contain a 'U'.
+    /// \param p_object A pointer to the object to be destroyed.
+    //*************************************************************************
+    template <typename U>
+    void destroy(const void* const p_object)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      reinterpret_cast<U*>((const_cast<void*>(p_object)))->~U();
+      iatomic_pool::release(p_object);
+    }
+
+  private:
+
+    // The pool element.
+    union Element
+    {
+      char     value[TYPE_SIZE_]; ///< Storage for value type.
+      typename etl::type_with_alignment<ALIGNMENT_>::type dummy; ///< Dummy item to get correct alignment.
+    };
+
+    ///< The memory for the pool of objects.
+    typename etl::aligned_storage<sizeof(Element), etl::alignment_of<Element>::value>::type buffer[SIZE];
+
+    ///< The free list links.
+    etl::atomic<uint32_t> next_index[SIZE];
+
+    static const uint32_t ELEMENT_SIZE = sizeof(Element);
+
+    // Should not be copied.
+    generic_atomic_pool(const generic_atomic_pool&);
+    generic_atomic_pool& operator =(const generic_atomic_pool&);
+  };
+
+  //*************************************************************************
+  /// A templated lock free pool implementation that uses a fixed size pool.
+  ///\ingroup atomic_pool
+  //*************************************************************************
+  template <typename T, const size_t SIZE_>
+  class atomic_pool : public etl::generic_atomic_pool<sizeof(T), etl::alignment_of<T>::value, SIZE_>
+  {
+  public:
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    atomic_pool()
+    {
+    }
+
+  private:
+
+    // Should not be copied.
+    atomic_pool(const atomic_pool&);
+    atomic_pool& operator =(const atomic_pool&);
+  };
+}
+
+#undef ETL_FILE
+
+#endif
+
+#endif
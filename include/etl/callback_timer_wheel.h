@@ -0,0 +1,640 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_CALLBACK_TIMER_WHEEL_INCLUDED
+#define ETL_CALLBACK_TIMER_WHEEL_INCLUDED
+
+#include <stdint.h>
+#include <new>
+
+#include "platform.h"
+#include "nullptr.h"
+#include "function.h"
+#include "static_assert.h"
+#include "log.h"
+#include "timer.h"
+#include "atomic.h"
+#include "private/timer_wheel.h"
+
+#if !defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK) && !defined(ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK)
+  #error ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK or ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK not defined
+#endif
+
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK) && defined(ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK)
+  #error Only define one of ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK or ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK
+#endif
+
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK)
+  #define ETL_DISABLE_TIMER_UPDATES (++process_semaphore)
+  #define ETL_ENABLE_TIMER_UPDATES  (release_timer_updates())
+  #define ETL_TIMER_UPDATES_ENABLED (process_semaphore.load() == 0)
+#endif
+
+#if defined(ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK)
+  #if !defined(ETL_CALLBACK_TIMER_DISABLE_INTERRUPTS) || !defined(ETL_CALLBACK_TIMER_ENABLE_INTERRUPTS)
+    #error ETL_CALLBACK_TIMER_DISABLE_INTERRUPTS and/or ETL_CALLBACK_TIMER_ENABLE_INTERRUPTS not defined
+  #endif
+
+  #define ETL_DISABLE_TIMER_UPDATES (ETL_CALLBACK_TIMER_DISABLE_INTERRUPTS)
+  #define ETL_ENABLE_TIMER_UPDATES  (ETL_CALLBACK_TIMER_ENABLE_INTERRUPTS)
+  #define ETL_TIMER_UPDATES_ENABLED true
+#endif
+
+namespace etl
+{
+  //*************************************************************************
+  /// The configuration of a timer in a timer wheel.
+  struct callback_timer_wheel_data
+  {
+    //*******************************************
+    callback_timer_wheel_data()
+      : p_callback(nullptr),
+        period(0),
+        expiry(0),
+        slack(0),
+        id(etl::timer::wheel_id::NO_TIMER),
+        previous(etl::timer::wheel_id::NO_TIMER),
+        next(etl::timer::wheel_id::NO_TIMER),
+        slot(private_timer_wheel::wheel<callback_timer_wheel_data>::NO_SLOT),
+        repeating(true),
+        has_c_callback(true)
+    {
+    }
+
+    //*******************************************
+    /// C function callback
+    //*******************************************
+    callback_timer_wheel_data(etl::timer::wheel_id::type id_,
+                              void                       (*p_callback_)(),
+                              uint32_t                   period_,
+                              bool                       repeating_)
+      : p_callback(reinterpret_cast<void*>(p_callback_)),
+        period(period_),
+        expiry(0),
+        slack(0),
+        id(id_),
+        previous(etl::timer::wheel_id::NO_TIMER),
+        next(etl::timer::wheel_id::NO_TIMER),
+        slot(private_timer_wheel::wheel<callback_timer_wheel_data>::NO_SLOT),
+        repeating(repeating_),
+        has_c_callback(true)
+    {
+    }
+
+    //*******************************************
+    /// ETL function callback
+    //*******************************************
+    callback_timer_wheel_data(etl::timer::wheel_id::type id_,
+                              etl::ifunction<void>&      callback_,
+                              uint32_t                   period_,
+                              bool                       repeating_)
+      : p_callback(reinterpret_cast<void*>(&callback_)),
+        period(period_),
+        expiry(0),
+        slack(0),
+        id(id_),
+        previous(etl::timer::wheel_id::NO_TIMER),
+        next(etl::timer::wheel_id::NO_TIMER),
+        slot(private_timer_wheel::wheel<callback_timer_wheel_data>::NO_SLOT),
+        repeating(repeating_),
+        has_c_callback(false)
+    {
+    }
+
+    //*******************************************
+    /// Returns true if the timer is active.
+    //*******************************************
+    bool is_active() const
+    {
+      return slot != private_timer_wheel::wheel<callback_timer_wheel_data>::NO_SLOT;
+    }
+
+    void*                      p_callback;
+    uint32_t                   period;
+    uint32_t                   expiry;
+    uint32_t                   slack;
+    etl::timer::wheel_id::type id;
+    uint32_t                   previous;
+    uint32_t                   next;
+    uint32_t                   slot;
+    bool                       repeating;
+    bool                       has_c_callback;
+
+  private:
+
+    // Disabled.
+    callback_timer_wheel_data(const callback_timer_wheel_data& other);
+    callback_timer_wheel_data& operator =(const callback_timer_wheel_data& other);
+  };
+
+  //***************************************************************************
+  /// Interface for callback timer wheel.
+  /// Has the same interface as etl::icallback_timer, but the active timers are
+  /// kept in a hierarchical timing wheel, so starting and stopping a timer is
+  /// O(1) whatever the number of active timers.
+  /// Ids are etl::timer::wheel_id::type, so that there may be more than 254 timers.
+  //***************************************************************************
+  class icallback_timer_wheel
+  {
+  public:
+
+    //*******************************************
+    /// Register a timer.
+    //*******************************************
+    etl::timer::wheel_id::type register_timer(void     (*p_callback_)(),
+                                              uint32_t period_,
+                                              bool     repeating_)
+    {
+      etl::timer::wheel_id::type id = allocate_id();
+
+      if (id != etl::timer::wheel_id::NO_TIMER)
+      {
+        // Create in-place.
+        new (&timer_array[id]) callback_timer_wheel_data(id, p_callback_, period_, repeating_);
+      }
+
+      return id;
+    }
+
+    //*******************************************
+    /// Register a timer.
+    //*******************************************
+    etl::timer::wheel_id::type register_timer(etl::ifunction<void>& callback_,
+                                              uint32_t              period_,
+                                              bool                  repeating_)
+    {
+      etl::timer::wheel_id::type id = allocate_id();
+
+      if (id != etl::timer::wheel_id::NO_TIMER)
+      {
+        // Create in-place.
+        new (&timer_array[id]) callback_timer_wheel_data(id, callback_, period_, repeating_);
+      }
+
+      return id;
+    }
+
+    //*******************************************
+    /// Unregister a timer.
+    //*******************************************
+    bool unregister_timer(etl::timer::wheel_id::type id_)
+    {
+      bool result = false;
+
+      if (id_ < MAX_TIMERS)
+      {
+        etl::callback_timer_wheel_data& timer = timer_array[id_];
+
+        if (timer.id != etl::timer::wheel_id::NO_TIMER)
+        {
+          if (timer.is_active())
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            active_wheel.remove(timer.id);
+            ETL_ENABLE_TIMER_UPDATES;
+          }
+
+          // Reset in-place.
+          new (&timer) callback_timer_wheel_data();
+          release_id(id_);
+
+          result = true;
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Enable/disable the timer.
+    //*******************************************
+    void enable(bool state_)
+    {
+      enabled = state_;
+    }
+
+    //*******************************************
+    /// Get the enable/disable state.
+    //*******************************************
+    bool is_running() const
+    {
+      return enabled;
+    }
+
+    //*******************************************
+    /// Clears the timer of data.
+    //*******************************************
+    void clear()
+    {
+      ETL_DISABLE_TIMER_UPDATES;
+      active_wheel.clear();
+      ETL_ENABLE_TIMER_UPDATES;
+
+      initialise();
+    }
+
+    //*******************************************
+    // Called by the timer service to indicate the
+    // amount of time that has elapsed since the last successful call to 'tick'.
+    // Returns true if the tick was accepted,
+    // false if the timers are disabled.
+    // If another thread is updating the timers then the ticks
+    // are held, and are processed when the update is complete.
+    //*******************************************
+    bool tick(uint32_t count)
+    {
+      if (enabled)
+      {
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK)
+        pending_ticks += count;
+        process_pending_ticks();
+#else
+        process_ticks(count);
+#endif
+        return true;
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Returns the number of ticks until 'tick' must next be called, or
+    /// etl::timer::interval::NO_ACTIVE_INTERVAL if no timers are active.
+    /// A timer with slack may be serviced up to 'slack' ticks late, so that
+    /// deadlines that are close together are handled by one call to 'tick'.
+    /// Returns 0 if the timers are being updated.
+    //*******************************************
+    uint32_t time_to_next_expiry() const
+    {
+      if (ETL_TIMER_UPDATES_ENABLED)
+      {
+        return active_wheel.next_expiry();
+      }
+
+      return 0;
+    }
+
+    //*******************************************
+    /// Starts a timer.
+    //*******************************************
+    bool start(etl::timer::wheel_id::type id_, bool immediate_ = false)
+    {
+      bool result = false;
+
+      // Valid timer id?
+      if (id_ < MAX_TIMERS)
+      {
+        etl::callback_timer_wheel_data& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != etl::timer::wheel_id::NO_TIMER)
+        {
+          // Has a valid period.
+          if (timer.period != etl::timer::state::INACTIVE)
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            if (timer.is_active())
+            {
+              active_wheel.remove(timer.id);
+            }
+
+            active_wheel.insert(timer.id, immediate_ ? 0 : timer.period);
+            ETL_ENABLE_TIMER_UPDATES;
+
+            result = true;
+          }
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Stops a timer.
+    //*******************************************
+    bool stop(etl::timer::wheel_id::type id_)
+    {
+      bool result = false;
+
+      // Valid timer id?
+      if (id_ < MAX_TIMERS)
+      {
+        etl::callback_timer_wheel_data& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != etl::timer::wheel_id::NO_TIMER)
+        {
+          if (timer.is_active())
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            active_wheel.remove(timer.id);
+            ETL_ENABLE_TIMER_UPDATES;
+          }
+
+          result = true;
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Sets a timer's period.
+    //*******************************************
+    bool set_period(etl::timer::wheel_id::type id_, uint32_t period_)
+    {
+      if (stop(id_))
+      {
+        timer_array[id_].period = period_;
+        return true;
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Sets a timer's mode.
+    //*******************************************
+    bool set_mode(etl::timer::wheel_id::type id_, bool repeating_)
+    {
+      if (stop(id_))
+      {
+        timer_array[id_].repeating = repeating_;
+        return true;
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Sets the number of ticks that a timer may be serviced late.
+    /// Used by time_to_next_expiry to coalesce deadlines.
+    //*******************************************
+    bool set_slack(etl::timer::wheel_id::type id_, uint32_t slack_)
+    {
+      // Valid timer id?
+      if (id_ < MAX_TIMERS)
+      {
+        etl::callback_timer_wheel_data& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != etl::timer::wheel_id::NO_TIMER)
+        {
+          timer.slack = slack_;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+  protected:
+
+    typedef private_timer_wheel::wheel<callback_timer_wheel_data> wheel_t;
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    icallback_timer_wheel(callback_timer_wheel_data* const timer_array_,
+                          uint32_t* const                  slots_,
+                          uint32_t* const                  level_counts_,
+                          const uint32_t                   MAX_TIMERS_,
+                          const uint_least8_t              LEVELS_,
+                          const uint_least8_t              SLOT_BITS_)
+      : timer_array(timer_array_),
+        active_wheel(timer_array_, slots_, level_counts_, LEVELS_, SLOT_BITS_),
+        expire(*this),
+        enabled(false),
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK)
+        process_semaphore(0),
+        pending_ticks(0),
+#endif
+        registered_timers(0),
+        free_head(etl::timer::wheel_id::NO_TIMER),
+        MAX_TIMERS(MAX_TIMERS_)
+    {
+    }
+
+    //*******************************************
+    /// Resets the timers and the wheel.
+    /// Called by the derived class once its arrays have been constructed.
+    //*******************************************
+    void initialise()
+    {
+      active_wheel.clear();
+
+      // Chain the free timers through their 'next' links.
+      for (uint32_t i = 0; i < MAX_TIMERS; ++i)
+      {
+        new (&timer_array[i]) callback_timer_wheel_data();
+        timer_array[i].next = i + 1;
+      }
+
+      timer_array[MAX_TIMERS - 1].next = etl::timer::wheel_id::NO_TIMER;
+
+      free_head         = 0;
+      registered_timers = 0;
+    }
+
+  private:
+
+    //*******************************************
+    /// Processes the elapsed ticks.
+    //*******************************************
+    void process_ticks(uint32_t count)
+    {
+      active_wheel.tick(count, expire);
+    }
+
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK)
+    //*******************************************
+    /// Processes the pending ticks if no other thread is updating the
+    /// timers. If one is, then it will process them when it has finished.
+    //*******************************************
+    void process_pending_ticks()
+    {
+      bool retry = true;
+
+      while (retry)
+      {
+        if (++process_semaphore == 1)
+        {
+          process_ticks(pending_ticks.exchange(0));
+        }
+
+        // Ticks that arrived while the timers were being updated.
+        retry = (--process_semaphore == 0) && (pending_ticks.load() != 0);
+      }
+    }
+
+    //*******************************************
+    /// Ends an update, processing any ticks that arrived during it.
+    //*******************************************
+    void release_timer_updates()
+    {
+      if ((--process_semaphore == 0) && (pending_ticks.load() != 0))
+      {
+        process_pending_ticks();
+      }
+    }
+#endif
+
+    //*******************************************
+    /// Called by the wheel for each timer that expires.
+    //*******************************************
+    struct expire_action
+    {
+      expire_action(icallback_timer_wheel& owner_)
+        : owner(owner_)
+      {
+      }
+
+      void operator ()(etl::timer::wheel_id::type id)
+      {
+        etl::callback_timer_wheel_data& timer = owner.timer_array[id];
+
+        if (timer.repeating)
+        {
+          // Reinsert the timer.
+          owner.active_wheel.insert(id, (timer.period == 0) ? 1 : timer.period);
+        }
+
+        if (timer.p_callback != nullptr)
+        {
+          if (timer.has_c_callback)
+          {
+            // Call the C callback.
+            reinterpret_cast<void(*)()>(timer.p_callback)();
+          }
+          else
+          {
+            // Call the function wrapper callback.
+            (*reinterpret_cast<etl::ifunction<void>*>(timer.p_callback))();
+          }
+        }
+      }
+
+      icallback_timer_wheel& owner;
+    };
+
+    //*******************************************
+    /// Takes an id from the free list.
+    //*******************************************
+    etl::timer::wheel_id::type allocate_id()
+    {
+      etl::timer::wheel_id::type id = free_head;
+
+      if (id != etl::timer::wheel_id::NO_TIMER)
+      {
+        free_head = timer_array[id].next;
+        ++registered_timers;
+      }
+
+      return id;
+    }
+
+    //*******************************************
+    /// Returns an id to the free list.
+    //*******************************************
+    void release_id(etl::timer::wheel_id::type id)
+    {
+      timer_array[id].next = free_head;
+      free_head = id;
+      --registered_timers;
+    }
+
+    // Disabled.
+    icallback_timer_wheel(const icallback_timer_wheel&);
+    icallback_timer_wheel& operator =(const icallback_timer_wheel&);
+
+    // The array of timer data structures.
+    callback_timer_wheel_data* const timer_array;
+
+    // The wheel of active timers.
+    wheel_t active_wheel;
+
+    expire_action expire;
+
+    volatile bool enabled;
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK)
+    volatile etl::timer_semaphore_t process_semaphore;
+    etl::atomic_uint32_t pending_ticks;
+#endif
+    volatile uint32_t registered_timers;
+
+    // The first unregistered timer.
+    etl::timer::wheel_id::type free_head;
+
+  public:
+
+    const uint32_t MAX_TIMERS;
+  };
+
+  //***************************************************************************
+  /// The callback timer wheel.
+  /// \tparam MAX_TIMERS_ The maximum number of timers.
+  /// \tparam LEVELS_     The number of levels in the wheel. At least two.
+  /// \tparam SLOTS_      The number of slots in each level. Must be a power of 2.
+  /// Timers up to SLOTS_^LEVELS_ ticks away are placed directly. Longer ones
+  /// are placed again each time the top level turns.
+  //***************************************************************************
+  template <const uint32_t MAX_TIMERS_, const uint_least8_t LEVELS_ = 4, const uint32_t SLOTS_ = 64>
+  class callback_timer_wheel : public etl::icallback_timer_wheel
+  {
+  public:
+
+    ETL_STATIC_ASSERT((MAX_TIMERS_ > 0), "MAX_TIMERS_ must be greater than zero");
+    ETL_STATIC_ASSERT((MAX_TIMERS_ < etl::timer::wheel_id::NO_TIMER), "Too many timers");
+    ETL_STATIC_ASSERT((LEVELS_ > 1), "LEVELS_ must be at least two");
+    ETL_STATIC_ASSERT((SLOTS_ > 1) && ((SLOTS_ & (SLOTS_ - 1)) == 0), "SLOTS_ must be a power of 2");
+    ETL_STATIC_ASSERT((LEVELS_ * etl::log2<SLOTS_>::value) <= 32, "The wheel covers more than 32 bits of ticks");
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    callback_timer_wheel()
+      : icallback_timer_wheel(timer_array, slots, level_counts, MAX_TIMERS_, LEVELS_, etl::log2<SLOTS_>::value)
+    {
+      this->initialise();
+    }
+
+  private:
+
+    callback_timer_wheel_data timer_array[MAX_TIMERS_];
+    uint32_t                  slots[LEVELS_ * SLOTS_];
+    uint32_t                  level_counts[LEVELS_];
+  };
+}
+
+#undef ETL_DISABLE_TIMER_UPDATES
+#undef ETL_ENABLE_TIMER_UPDATES
+#undef ETL_TIMER_UPDATES_ENABLED
+
+#endif
@@ -0,0 +1,403 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_CONSTEXPR_HASH_INCLUDED
+#define ETL_CONSTEXPR_HASH_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+///\defgroup constexpr_hash Compile time hash & CRC calculations
+/// constexpr versions of the FNV-1, FNV-1a, CRC and Murmur3 calculators.
+/// The results are identical to those of etl::fnv_1_32, etl::crc32, etl::murmur3 etc.
+/// Allows string tags to be used as case labels or message ids.
+/// The CRC functions are computed bitwise so that no tables are required; at run time
+/// the table driven classes will be faster.
+///\ingroup maths
+
+namespace etl
+{
+#if ETL_CPP11_SUPPORTED
+
+  namespace private_constexpr_hash
+  {
+    //*************************************************************************
+    /// The length of a null terminated string.
+    //*************************************************************************
+    constexpr size_t length(const char* text, size_t count = 0)
+    {
+      return (*text == 0) ? count : length(text + 1, count + 1);
+    }
+
+    //*************************************************************************
+    /// FNV-1
+    //*************************************************************************
+    template <typename T>
+    constexpr T fnv_1(const char* text, size_t length, T hash, T prime)
+    {
+      return (length == 0) ? hash : fnv_1<T>(text + 1, length - 1, T(T(hash * prime) ^ uint8_t(*text)), prime);
+    }
+
+    //*************************************************************************
+    /// FNV-1a
+    //*************************************************************************
+    template <typename T>
+    constexpr T fnv_1a(const char* text, size_t length, T hash, T prime)
+    {
+      return (length == 0) ? hash : fnv_1a<T>(text + 1, length - 1, T(T(hash ^ uint8_t(*text)) * prime), prime);
+    }
+
+    //*************************************************************************
+    /// The table entry for a reflected (LSB first) CRC.
+    //*************************************************************************
+    template <typename T>
+    constexpr T crc_reflected_entry(T value, T polynomial, int bits = 8)
+    {
+      return (bits == 0) ? value : crc_reflected_entry<T>(T((value & 1U) ? T(value >> 1U) ^ polynomial : T(value >> 1U)), polynomial, bits - 1);
+    }
+
+    //*************************************************************************
+    /// The table entry for a normal (MSB first) CRC.
+    //*************************************************************************
+    template <typename T>
+    constexpr T crc_normal_entry(T value, T polynomial, int bits = 8)
+    {
+      return (bits == 0) ? value : crc_normal_entry<T>(T((value >> ((sizeof(T) * CHAR_BIT) - 1U)) ? T(value << 1U) ^ polynomial : T(value << 1U)), polynomial, bits - 1);
+    }
+
+    //*************************************************************************
+    /// Reflected (LSB first) CRC.
+    //*************************************************************************
+    template <typename T>
+    constexpr T crc_reflected(const char* text, size_t length, T crc, T polynomial)
+    {
+      return (length == 0) ? crc
+                           : crc_reflected<T>(text + 1, length - 1, T(T(crc >> 8U) ^ crc_reflected_entry<T>(T((crc ^ uint8_t(*text)) & 0xFFU), polynomial)), polynomial);
+    }
+
+    //*************************************************************************
+    /// Normal (MSB first) CRC.
+    //*************************************************************************
+    template <typename T>
+    constexpr T crc_normal(const char* text, size_t length, T crc, T polynomial)
+    {
+      return (length == 0) ? crc
+                           : crc_normal<T>(text + 1, length - 1, T(T(crc << 8U) ^ crc_normal_entry<T>(T(T(((crc >> ((sizeof(T) - 1U) * CHAR_BIT)) ^ uint8_t(*text)) & 0xFFU) << ((sizeof(T) - 1U) * CHAR_BIT)), polynomial)), polynomial);
+    }
+
+    //*************************************************************************
+    /// Rotate left.
+    //*************************************************************************
+    template <typename T>
+    constexpr T rotate_left(T value, size_t distance)
+    {
+      return T(value << distance) | T(value >> ((sizeof(T) * CHAR_BIT) - distance));
+    }
+
+    //*************************************************************************
+    /// Murmur3 block mix.
+    //*************************************************************************
+    template <typename T>
+    constexpr T murmur3_mix(T block)
+    {
+      return T(rotate_left<T>(T(block * 0xCC9E2D51UL), 15U) * 0x1B873593UL);
+    }
+
+    //*************************************************************************
+    /// Murmur3 hash update.
+    //*************************************************************************
+    template <typename T>
+    constexpr T murmur3_add_block(T hash, T block)
+    {
+      return T(T(rotate_left<T>(T(hash ^ murmur3_mix<T>(block)), 13U) * 5U) + 0xE6546B64UL);
+    }
+
+    //*************************************************************************
+    /// Murmur3 little endian block from up to 4 characters.
+    //*************************************************************************
+    template <typename T>
+    constexpr T murmur3_block(const char* text, size_t length, size_t shift = 0)
+    {
+      return (length == 0) ? T(0) : T(T(T(uint8_t(*text)) << shift) | murmur3_block<T>(text + 1, length - 1, shift + 8U));
+    }
+
+    //*************************************************************************
+    /// Murmur3 final avalanche.
+    //*************************************************************************
+    template <typename T>
+    constexpr T murmur3_avalanche_3(T hash)
+    {
+      return T(hash ^ (hash >> 16U));
+    }
+
+    template <typename T>
+    constexpr T murmur3_avalanche_2(T hash)
+    {
+      return murmur3_avalanche_3<T>(T(T(hash ^ (hash >> 13U)) * 0xC2B2AE35UL));
+    }
+
+    template <typename T>
+    constexpr T murmur3_avalanche_1(T hash)
+    {
+      return murmur3_avalanche_2<T>(T(T(hash ^ (hash >> 16U)) * 0x85EBCA6BUL));
+    }
+
+    //*************************************************************************
+    /// Murmur3
+    //*************************************************************************
+    template <typename T>
+    constexpr T murmur3(const char* text, size_t remaining, size_t total, T hash)
+    {
+      return (remaining >= 4U) ? murmur3<T>(text + 4, remaining - 4U, total, murmur3_add_block<T>(hash, murmur3_block<T>(text, 4U)))
+                               : murmur3_avalanche_1<T>(T(T(hash ^ murmur3_mix<T>(murmur3_block<T>(text, remaining))) ^ T(total)));
+    }
+  }
+
+  namespace constexpr_hash
+  {
+    //*************************************************************************
+    /// FNV-1 32 bit. Matches etl::fnv_1_32.
+    //*************************************************************************
+    constexpr uint32_t fnv_1_32(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::fnv_1<uint32_t>(text, length, 0x811C9DC5UL, 0x01000193UL);
+    }
+
+    constexpr uint32_t fnv_1_32(const char* text)
+    {
+      return fnv_1_32(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// FNV-1a 32 bit. Matches etl::fnv_1a_32.
+    //*************************************************************************
+    constexpr uint32_t fnv_1a_32(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::fnv_1a<uint32_t>(text, length, 0x811C9DC5UL, 0x01000193UL);
+    }
+
+    constexpr uint32_t fnv_1a_32(const char* text)
+    {
+      return fnv_1a_32(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// FNV-1 64 bit. Matches etl::fnv_1_64.
+    //*************************************************************************
+    constexpr uint64_t fnv_1_64(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::fnv_1<uint64_t>(text, length, 0xCBF29CE484222325ULL, 0x00000100000001B3ULL);
+    }
+
+    constexpr uint64_t fnv_1_64(const char* text)
+    {
+      return fnv_1_64(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// FNV-1a 64 bit. Matches etl::fnv_1a_64.
+    //*************************************************************************
+    constexpr uint64_t fnv_1a_64(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::fnv_1a<uint64_t>(text, length, 0xCBF29CE484222325ULL, 0x00000100000001B3ULL);
+    }
+
+    constexpr uint64_t fnv_1a_64(const char* text)
+    {
+      return fnv_1a_64(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// CRC8 CCITT. Matches etl::crc8_ccitt.
+    //*************************************************************************
+    constexpr uint8_t crc8_ccitt(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::crc_normal<uint8_t>(text, length, 0x00U, 0x07U);
+    }
+
+    constexpr uint8_t crc8_ccitt(const char* text)
+    {
+      return crc8_ccitt(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// CRC16. Matches etl::crc16.
+    //*************************************************************************
+    constexpr uint16_t crc16(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::crc_reflected<uint16_t>(text, length, 0x0000U, 0xA001U);
+    }
+
+    constexpr uint16_t crc16(const char* text)
+    {
+      return crc16(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// CRC16 CCITT. Matches etl::crc16_ccitt.
+    //*************************************************************************
+    constexpr uint16_t crc16_ccitt(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::crc_normal<uint16_t>(text, length, 0xFFFFU, 0x1021U);
+    }
+
+    constexpr uint16_t crc16_ccitt(const char* text)
+    {
+      return crc16_ccitt(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// CRC16 Kermit. Matches etl::crc16_kermit.
+    //*************************************************************************
+    constexpr uint16_t crc16_kermit(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::crc_reflected<uint16_t>(text, length, 0x0000U, 0x8408U);
+    }
+
+    constexpr uint16_t crc16_kermit(const char* text)
+    {
+      return crc16_kermit(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// CRC16 Modbus. Matches etl::crc16_modbus.
+    //*************************************************************************
+    constexpr uint16_t crc16_modbus(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::crc_reflected<uint16_t>(text, length, 0xFFFFU, 0xA001U);
+    }
+
+    constexpr uint16_t crc16_modbus(const char* text)
+    {
+      return crc16_modbus(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// CRC32. Matches etl::crc32.
+    //*************************************************************************
+    constexpr uint32_t crc32(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::crc_reflected<uint32_t>(text, length, 0xFFFFFFFFUL, 0xEDB88320UL) ^ 0xFFFFFFFFUL;
+    }
+
+    constexpr uint32_t crc32(const char* text)
+    {
+      return crc32(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// CRC32 C. Matches etl::crc32_c.
+    //*************************************************************************
+    constexpr uint32_t crc32_c(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::crc_reflected<uint32_t>(text, length, 0xFFFFFFFFUL, 0x82F63B78UL) ^ 0xFFFFFFFFUL;
+    }
+
+    constexpr uint32_t crc32_c(const char* text)
+    {
+      return crc32_c(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// CRC64 ECMA. Matches etl::crc64_ecma.
+    //*************************************************************************
+    constexpr uint64_t crc64_ecma(const char* text, size_t length)
+    {
+      return etl::private_constexpr_hash::crc_normal<uint64_t>(text, length, 0x0000000000000000ULL, 0x42F0E1EBA9EA3693ULL);
+    }
+
+    constexpr uint64_t crc64_ecma(const char* text)
+    {
+      return crc64_ecma(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// Murmur3 32 bit. Matches etl::murmur3<uint32_t>.
+    //*************************************************************************
+    constexpr uint32_t murmur3_32(const char* text, size_t length, uint32_t seed = 0)
+    {
+      return etl::private_constexpr_hash::murmur3<uint32_t>(text, length, length, seed);
+    }
+
+    constexpr uint32_t murmur3_32(const char* text)
+    {
+      return murmur3_32(text, etl::private_constexpr_hash::length(text));
+    }
+
+    //*************************************************************************
+    /// Murmur3 64 bit. Matches etl::murmur3<uint64_t>.
+    //*************************************************************************
+    constexpr uint64_t murmur3_64(const char* text, size_t length, uint64_t seed = 0)
+    {
+      return etl::private_constexpr_hash::murmur3<uint64_t>(text, length, length, seed);
+    }
+
+    constexpr uint64_t murmur3_64(const char* text)
+    {
+      return murmur3_64(text, etl::private_constexpr_hash::length(text));
+    }
+  }
+
+  namespace literals
+  {
+    //*************************************************************************
+    /// "text"_hash
+    /// 32 bit FNV-1a hash of the string literal.
+    //*************************************************************************
+    constexpr uint32_t operator "" _hash(const char* text, size_t length)
+    {
+      return etl::constexpr_hash::fnv_1a_32(text, length);
+    }
+
+    //*************************************************************************
+    /// "text"_hash64
+    /// 64 bit FNV-1a hash of the string literal.
+    //*************************************************************************
+    constexpr uint64_t operator "" _hash64(const char* text, size_t length)
+    {
+      return etl::constexpr_hash::fnv_1a_64(text, length);
+    }
+
+    //*************************************************************************
+    /// "text"_crc32
+    /// CRC32 of the string literal.
+    //*************************************************************************
+    constexpr uint32_t operator "" _crc32(const char* text, size_t length)
+    {
+      return etl::constexpr_hash::crc32(text, length);
+    }
+  }
+
+#endif
+}
+
+#endif
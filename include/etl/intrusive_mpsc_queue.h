@@ -0,0 +1,208 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_INTRUSIVE_MPSC_QUEUE_INCLUDED
+#define ETL_INTRUSIVE_MPSC_QUEUE_INCLUDED
+
+#include <stddef.h>
+
+#include "platform.h"
+#include "atomic.h"
+#include "nullptr.h"
+#include "type_traits.h"
+#include "static_assert.h"
+#include "intrusive_links.h"
+
+#if ETL_HAS_ATOMIC
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup queue
+  /// An intrusive queue for many producer threads and one consumer thread.
+  /// Stores elements derived from an etl::forward_link.
+  /// Based on Dmitry Vyukov's node based MPSC queue.
+  /// push is wait free; it is one atomic exchange and one store, and may be
+  /// called from any thread.
+  /// pop and pop_into may only be called from the single consumer thread.
+  /// The queue never allocates or copies the linked objects, which must stay
+  /// alive until they have been popped.
+  /// \tparam TValue The type of value that the queue holds.
+  /// \tparam TLink  The forward link type that the value is derived from.
+  //***************************************************************************
+  template <typename TValue, typename TLink>
+  class intrusive_mpsc_queue
+  {
+  public:
+
+    // Node typedef.
+    typedef TLink link_type;
+
+    // STL style typedefs.
+    typedef TValue            value_type;
+    typedef value_type*       pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type&       reference;
+    typedef const value_type& const_reference;
+    typedef size_t            size_type;
+
+    ETL_STATIC_ASSERT((etl::is_same<TLink, etl::forward_link<TLink::ID> >::value), "TLink must be an etl::forward_link");
+    ETL_STATIC_ASSERT((sizeof(etl::atomic<link_type*>) == sizeof(link_type*)), "etl::atomic<link_type*> must have the same layout as link_type*");
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    intrusive_mpsc_queue()
+      : p_head(&stub),
+        p_tail(&stub)
+    {
+      stub.clear();
+    }
+
+    //*************************************************************************
+    /// Adds a value to the back of the queue.
+    /// May be called from any thread.
+    ///\param value The value to push to the queue.
+    //*************************************************************************
+    void push(link_type& value)
+    {
+      value.clear();
+
+      link_type* p_previous = p_head.exchange(&value, etl::memory_order_acq_rel);
+
+      // The value is not visible to the consumer until this store.
+      next_of(p_previous).store(&value, etl::memory_order_release);
+    }
+
+    //*************************************************************************
+    /// Removes the value at the front of the queue.
+    /// May only be called from the consumer thread.
+    /// \return A pointer to the value, or nullptr if the queue is empty, or if
+    /// a producer is part way through pushing the next value.
+    //*************************************************************************
+    pointer pop()
+    {
+      link_type* p_front = p_tail;
+      link_type* p_next  = next_of(p_front).load(etl::memory_order_acquire);
+
+      // Skip over the stub.
+      if (p_front == &stub)
+      {
+        if (p_next == nullptr)
+        {
+          return nullptr;
+        }
+
+        p_tail  = p_next;
+        p_front = p_next;
+        p_next  = next_of(p_front).load(etl::memory_order_acquire);
+      }
+
+      if (p_next != nullptr)
+      {
+        p_tail = p_next;
+        return static_cast<pointer>(p_front);
+      }
+
+      // The front is the last value, unless a producer has exchanged the head
+      // but not yet linked its value.
+      if (p_front != p_head.load(etl::memory_order_acquire))
+      {
+        return nullptr;
+      }
+
+      // Push the stub back so that the last value can be unlinked.
+      push(stub);
+
+      p_next = next_of(p_front).load(etl::memory_order_acquire);
+
+      if (p_next != nullptr)
+      {
+        p_tail = p_next;
+        return static_cast<pointer>(p_front);
+      }
+
+      return nullptr;
+    }
+
+    //*************************************************************************
+    /// Removes the value at the front of the queue and pushes it to the destination.
+    /// May only be called from the consumer thread.
+    /// NOTE: The destination must be an intrusive container that supports a push(TLink) member function.
+    /// \return <b>true</b> if a value was moved.
+    //*************************************************************************
+    template <typename TContainer>
+    bool pop_into(TContainer& destination)
+    {
+      pointer p_value = pop();
+
+      if (p_value != nullptr)
+      {
+        destination.push(*p_value);
+      }
+
+      return p_value != nullptr;
+    }
+
+    //*************************************************************************
+    /// Checks if there is nothing for the consumer to pop, and no producer is
+    /// part way through pushing a value.
+    /// May only be called from the consumer thread.
+    //*************************************************************************
+    bool empty() const
+    {
+      return (p_tail == &stub) &&
+             (next_of(p_tail).load(etl::memory_order_acquire) == nullptr) &&
+             (p_head.load(etl::memory_order_acquire) == &stub);
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Accesses the link's 'etl_next' pointer atomically.
+    //*************************************************************************
+    static etl::atomic<link_type*>& next_of(link_type* p_link)
+    {
+      return *reinterpret_cast<etl::atomic<link_type*>*>(&p_link->etl_next);
+    }
+
+    // Disable copy construction and assignment.
+    intrusive_mpsc_queue(const intrusive_mpsc_queue&);
+    intrusive_mpsc_queue& operator = (const intrusive_mpsc_queue& rhs);
+
+    etl::atomic<link_type*> p_head; ///< The most recently pushed link. Shared by the producers.
+    link_type*              p_tail; ///< The next link to pop. Owned by the consumer.
+    link_type               stub;   ///< Keeps the list non-empty.
+  };
+}
+
+#endif
+
+#endif
@@ -0,0 +1,799 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_MDSPAN_INCLUDED
+#define ETL_MDSPAN_INCLUDED
+
+#include <stddef.h>
+
+#include "platform.h"
+#include "type_traits.h"
+#include "static_assert.h"
+#include "exception.h"
+#include "error_handler.h"
+#include "array.h"
+#include "multi_array.h"
+
+#undef ETL_FILE
+#define ETL_FILE "60"
+
+///\defgroup mdspan mdspan
+/// Non-owning multi-dimensional views with compile time extents and strides.
+///\ingroup containers
+
+namespace etl
+{
+#if ETL_CPP11_SUPPORTED
+
+  //***************************************************************************
+  /// The base class for mdspan exceptions.
+  ///\ingroup mdspan
+  //***************************************************************************
+  class mdspan_exception : public exception
+  {
+  public:
+
+    mdspan_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {}
+  };
+
+  //***************************************************************************
+  /// The exception thrown when a run time slice offset or index is outside the extent.
+  ///\ingroup mdspan
+  //***************************************************************************
+  class mdspan_out_of_range : public mdspan_exception
+  {
+  public:
+
+    mdspan_out_of_range(string_type file_name_, numeric_type line_number_)
+      : mdspan_exception(ETL_ERROR_TEXT("mdspan:range", ETL_FILE"A"), file_name_, line_number_)
+    {}
+  };
+
+  namespace private_mdspan
+  {
+    //*************************************************************************
+    /// A compile time list of sizes.
+    //*************************************************************************
+    template <size_t... Nx>
+    struct size_list
+    {
+    };
+
+    template <size_t N, typename TList>
+    struct prepend;
+
+    template <size_t N, size_t... Nx>
+    struct prepend<N, size_list<Nx...>>
+    {
+      using type = size_list<N, Nx...>;
+    };
+
+    template <size_t N, typename TList>
+    struct append;
+
+    template <size_t N, size_t... Nx>
+    struct append<N, size_list<Nx...>>
+    {
+      using type = size_list<Nx..., N>;
+    };
+
+    //*************************************************************************
+    /// The product of the sizes.
+    //*************************************************************************
+    template <size_t... Nx>
+    struct product;
+
+    template <>
+    struct product<>
+    {
+      static constexpr size_t value = 1U;
+    };
+
+    template <size_t N, size_t... Nx>
+    struct product<N, Nx...>
+    {
+      static constexpr size_t value = N * product<Nx...>::value;
+    };
+
+    //*************************************************************************
+    /// Element 'index' of the list.
+    //*************************************************************************
+    constexpr size_t get(size_list<>, size_t)
+    {
+      return 0U;
+    }
+
+    template <size_t N, size_t... Nx>
+    constexpr size_t get(size_list<N, Nx...>, size_t index)
+    {
+      return (index == 0U) ? N : get(size_list<Nx...>(), index - 1U);
+    }
+
+    //*************************************************************************
+    /// The sum of indices[i] * strides[i].
+    //*************************************************************************
+    constexpr size_t dot(size_list<>, const size_t*)
+    {
+      return 0U;
+    }
+
+    template <size_t S, size_t... Sx>
+    constexpr size_t dot(size_list<S, Sx...>, const size_t* indices)
+    {
+      return (S * indices[0]) + dot(size_list<Sx...>(), indices + 1);
+    }
+
+    //*************************************************************************
+    /// The largest offset + 1 reachable with the extents and strides.
+    //*************************************************************************
+    constexpr size_t span_size(size_list<>, size_list<>)
+    {
+      return 1U;
+    }
+
+    template <size_t E, size_t... Ex, size_t S, size_t... Sx>
+    constexpr size_t span_size(size_list<E, Ex...>, size_list<S, Sx...>)
+    {
+      return (E == 0U) ? 0U : ((E - 1U) * S) + span_size(size_list<Ex...>(), size_list<Sx...>());
+    }
+
+    //*************************************************************************
+    /// Row major strides. The last extent varies fastest.
+    //*************************************************************************
+    template <size_t... Ex>
+    struct right_strides;
+
+    template <>
+    struct right_strides<>
+    {
+      using type = size_list<>;
+    };
+
+    template <size_t E, size_t... Ex>
+    struct right_strides<E, Ex...>
+    {
+      using type = typename prepend<product<Ex...>::value, typename right_strides<Ex...>::type>::type;
+    };
+
+    //*************************************************************************
+    /// Column major strides. The first extent varies fastest.
+    //*************************************************************************
+    template <size_t STRIDE, size_t... Ex>
+    struct left_strides;
+
+    template <size_t STRIDE>
+    struct left_strides<STRIDE>
+    {
+      using type = size_list<>;
+    };
+
+    template <size_t STRIDE, size_t E, size_t... Ex>
+    struct left_strides<STRIDE, E, Ex...>
+    {
+      using type = typename prepend<STRIDE, typename left_strides<STRIDE * E, Ex...>::type>::type;
+    };
+  }
+
+  //***************************************************************************
+  /// Compile time extents.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <const size_t... Ex>
+  struct extents
+  {
+    using list_type = private_mdspan::size_list<Ex...>;
+
+    static constexpr size_t rank()
+    {
+      return sizeof...(Ex);
+    }
+
+    static constexpr size_t extent(size_t r)
+    {
+      return private_mdspan::get(list_type(), r);
+    }
+
+    static constexpr size_t size()
+    {
+      return private_mdspan::product<Ex...>::value;
+    }
+  };
+
+  //***************************************************************************
+  /// Strided mapping common to the strided layouts.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename TExtents, typename TStrides>
+  struct strided_mapping
+  {
+    using extents_type = TExtents;
+    using strides_type = TStrides;
+
+    static constexpr bool is_strided = true;
+
+    static constexpr size_t index(const size_t* indices)
+    {
+      return private_mdspan::dot(strides_type(), indices);
+    }
+
+    static constexpr size_t stride(size_t r)
+    {
+      return private_mdspan::get(strides_type(), r);
+    }
+
+    static constexpr size_t required_span_size()
+    {
+      return private_mdspan::span_size(typename extents_type::list_type(), strides_type());
+    }
+  };
+
+  //***************************************************************************
+  /// Row major layout, as multi_array.
+  ///\ingroup mdspan
+  //***************************************************************************
+  struct layout_right
+  {
+    template <typename TExtents>
+    struct mapping;
+
+    template <size_t... Ex>
+    struct mapping<etl::extents<Ex...>>
+      : public strided_mapping<etl::extents<Ex...>, typename private_mdspan::right_strides<Ex...>::type>
+    {
+    };
+  };
+
+  //***************************************************************************
+  /// Column major layout.
+  ///\ingroup mdspan
+  //***************************************************************************
+  struct layout_left
+  {
+    template <typename TExtents>
+    struct mapping;
+
+    template <size_t... Ex>
+    struct mapping<etl::extents<Ex...>>
+      : public strided_mapping<etl::extents<Ex...>, typename private_mdspan::left_strides<1U, Ex...>::type>
+    {
+    };
+  };
+
+  //***************************************************************************
+  /// Layout with explicit compile time strides, one per extent.
+  /// The result of slicing and transposing.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <const size_t... Sx>
+  struct layout_stride
+  {
+    template <typename TExtents>
+    struct mapping;
+
+    template <size_t... Ex>
+    struct mapping<etl::extents<Ex...>>
+      : public strided_mapping<etl::extents<Ex...>, private_mdspan::size_list<Sx...>>
+    {
+      ETL_STATIC_ASSERT(sizeof...(Ex) == sizeof...(Sx), "One stride per extent");
+    };
+  };
+
+  //***************************************************************************
+  /// Blocked layout for two dimensional extents.
+  /// The elements of each TILE_ROWS x TILE_COLUMNS tile are contiguous and row major.
+  /// The tiles are stored in row major order.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <const size_t TILE_ROWS, const size_t TILE_COLUMNS>
+  struct layout_tiled
+  {
+    static constexpr size_t Tile_Rows    = TILE_ROWS;
+    static constexpr size_t Tile_Columns = TILE_COLUMNS;
+    static constexpr size_t Tile_Size    = TILE_ROWS * TILE_COLUMNS;
+
+    template <typename TExtents>
+    struct mapping;
+
+    template <size_t ROWS, size_t COLUMNS>
+    struct mapping<etl::extents<ROWS, COLUMNS>>
+    {
+      ETL_STATIC_ASSERT((TILE_ROWS > 0U) && (TILE_COLUMNS > 0U), "Tiles cannot be empty");
+      ETL_STATIC_ASSERT(((ROWS % TILE_ROWS) == 0U) && ((COLUMNS % TILE_COLUMNS) == 0U), "Extents must be a whole number of tiles");
+
+      using extents_type = etl::extents<ROWS, COLUMNS>;
+
+      static constexpr bool   is_strided    = false;
+      static constexpr size_t Tiles_Per_Row = COLUMNS / TILE_COLUMNS;
+
+      static constexpr size_t index(const size_t* indices)
+      {
+        return (tile_index(indices[0] / TILE_ROWS, indices[1] / TILE_COLUMNS) * Tile_Size) +
+               ((indices[0] % TILE_ROWS) * TILE_COLUMNS) +
+               (indices[1] % TILE_COLUMNS);
+      }
+
+      static constexpr size_t tile_index(size_t tile_row, size_t tile_column)
+      {
+        return (tile_row * Tiles_Per_Row) + tile_column;
+      }
+
+      static constexpr size_t required_span_size()
+      {
+        return ROWS * COLUMNS;
+      }
+    };
+  };
+
+  //***************************************************************************
+  /// A non-owning view of contiguous memory as a multi-dimensional array.
+  /// Extents and strides are compile time constants; only the pointer is stored.
+  ///\tparam T        The element type. May be const.
+  ///\tparam TExtents etl::extents<...>
+  ///\tparam TLayout  layout_right, layout_left, layout_stride<...> or layout_tiled<...>.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename T, typename TExtents, typename TLayout = etl::layout_right>
+  class mdspan
+  {
+  public:
+
+    using element_type = T;
+    using value_type   = typename etl::remove_cv<T>::type;
+    using size_type    = size_t;
+    using pointer      = T*;
+    using reference    = T&;
+    using extents_type = TExtents;
+    using layout_type  = TLayout;
+    using mapping_type = typename TLayout::template mapping<TExtents>;
+
+    //*************************************************************************
+    /// Constructs an empty view.
+    //*************************************************************************
+    constexpr mdspan()
+      : p_data(nullptr)
+    {
+    }
+
+    //*************************************************************************
+    /// Constructs a view of 'data', which must hold required_span_size() elements.
+    //*************************************************************************
+    constexpr explicit mdspan(pointer data_)
+      : p_data(data_)
+    {
+    }
+
+    //*************************************************************************
+    /// Conversion from a view of non-const to const.
+    //*************************************************************************
+    template <typename U, typename = typename etl::enable_if<etl::is_same<const U, T>::value && !etl::is_same<U, T>::value>::type>
+    constexpr mdspan(const mdspan<U, TExtents, TLayout>& other)
+      : p_data(other.data())
+    {
+    }
+
+    //*************************************************************************
+    /// The element at the indices, one per extent.
+    //*************************************************************************
+    template <typename... TIndices>
+    reference operator()(TIndices... indices) const
+    {
+      ETL_STATIC_ASSERT(sizeof...(TIndices) == TExtents::rank(), "One index per extent");
+
+      const size_t index_list[] = { size_t(indices)... };
+
+      return p_data[mapping_type::index(index_list)];
+    }
+
+    //*************************************************************************
+    /// The element at the indices in 'index_list'.
+    //*************************************************************************
+    reference operator[](const etl::array<size_t, TExtents::rank()>& index_list) const
+    {
+      return p_data[mapping_type::index(index_list.data())];
+    }
+
+    pointer data() const
+    {
+      return p_data;
+    }
+
+    static constexpr size_t rank()
+    {
+      return TExtents::rank();
+    }
+
+    static constexpr size_t extent(size_t r)
+    {
+      return TExtents::extent(r);
+    }
+
+    //*************************************************************************
+    /// The distance between elements along extent 'r'.
+    /// Strided layouts only.
+    //*************************************************************************
+    static constexpr size_t stride(size_t r)
+    {
+      return mapping_type::stride(r);
+    }
+
+    //*************************************************************************
+    /// The number of elements in the view.
+    //*************************************************************************
+    static constexpr size_t size()
+    {
+      return TExtents::size();
+    }
+
+    static constexpr bool empty()
+    {
+      return TExtents::size() == 0U;
+    }
+
+    //*************************************************************************
+    /// The number of elements the underlying memory must hold.
+    //*************************************************************************
+    static constexpr size_t required_span_size()
+    {
+      return mapping_type::required_span_size();
+    }
+
+    static constexpr bool is_strided()
+    {
+      return mapping_type::is_strided;
+    }
+
+  private:
+
+    pointer p_data;
+  };
+
+  //***************************************************************************
+  /// Slice specifier that keeps the whole of an extent.
+  ///\ingroup mdspan
+  //***************************************************************************
+  struct full_extent_t
+  {
+  };
+
+  constexpr full_extent_t full_extent = full_extent_t();
+
+  //***************************************************************************
+  /// Slice specifier for EXTENT elements from OFFSET, every STRIDE elements.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <const size_t OFFSET, const size_t EXTENT, const size_t STRIDE = 1U>
+  struct strided_slice
+  {
+    ETL_STATIC_ASSERT(STRIDE > 0U, "Stride cannot be zero");
+  };
+
+  //***************************************************************************
+  /// Slice specifier for EXTENT elements from a run time offset.
+  /// For walking blocks of a larger view.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <const size_t EXTENT>
+  struct extent_slice
+  {
+    constexpr explicit extent_slice(size_t offset_)
+      : offset(offset_)
+    {
+    }
+
+    size_t offset;
+  };
+
+  namespace private_mdspan
+  {
+    //*************************************************************************
+    /// The extents and strides left after applying the slice specifiers.
+    /// An integral index removes its extent.
+    //*************************************************************************
+    template <typename TExtentsOut, typename TStridesOut, typename TExtentsIn, typename TStridesIn, typename... TSlices>
+    struct sliced;
+
+    template <typename TExtentsOut, typename TStridesOut>
+    struct sliced<TExtentsOut, TStridesOut, size_list<>, size_list<>>
+    {
+      using extents_list = TExtentsOut;
+      using strides_list = TStridesOut;
+    };
+
+    template <typename TExtentsOut, typename TStridesOut, size_t E, size_t... Ex, size_t S, size_t... Sx, typename... TSlices>
+    struct sliced<TExtentsOut, TStridesOut, size_list<E, Ex...>, size_list<S, Sx...>, full_extent_t, TSlices...>
+      : sliced<typename append<E, TExtentsOut>::type, typename append<S, TStridesOut>::type, size_list<Ex...>, size_list<Sx...>, TSlices...>
+    {
+    };
+
+    template <typename TExtentsOut, typename TStridesOut, size_t E, size_t... Ex, size_t S, size_t... Sx, size_t OFFSET, size_t EXTENT, size_t STRIDE, typename... TSlices>
+    struct sliced<TExtentsOut, TStridesOut, size_list<E, Ex...>, size_list<S, Sx...>, strided_slice<OFFSET, EXTENT, STRIDE>, TSlices...>
+      : sliced<typename append<EXTENT, TExtentsOut>::type, typename append<S * STRIDE, TStridesOut>::type, size_list<Ex...>, size_list<Sx...>, TSlices...>
+    {
+      ETL_STATIC_ASSERT((EXTENT == 0U) || ((OFFSET + ((EXTENT - 1U) * STRIDE)) < E), "Slice is out of range");
+    };
+
+    template <typename TExtentsOut, typename TStridesOut, size_t E, size_t... Ex, size_t S, size_t... Sx, size_t EXTENT, typename... TSlices>
+    struct sliced<TExtentsOut, TStridesOut, size_list<E, Ex...>, size_list<S, Sx...>, extent_slice<EXTENT>, TSlices...>
+      : sliced<typename append<EXTENT, TExtentsOut>::type, typename append<S, TStridesOut>::type, size_list<Ex...>, size_list<Sx...>, TSlices...>
+    {
+      ETL_STATIC_ASSERT(EXTENT <= E, "Slice is out of range");
+    };
+
+    template <typename TExtentsOut, typename TStridesOut, size_t E, size_t... Ex, size_t S, size_t... Sx, typename TSlice, typename... TSlices>
+    struct sliced<TExtentsOut, TStridesOut, size_list<E, Ex...>, size_list<S, Sx...>, TSlice, TSlices...>
+      : sliced<TExtentsOut, TStridesOut, size_list<Ex...>, size_list<Sx...>, TSlices...>
+    {
+      ETL_STATIC_ASSERT(etl::is_integral<TSlice>::value, "Slice specifiers are full_extent, strided_slice, extent_slice or an index");
+    };
+
+    //*************************************************************************
+    /// The offset of the first element of a slice along one extent.
+    /// Run time offsets and indexes are checked against the extent.
+    //*************************************************************************
+    inline size_t slice_offset(full_extent_t, size_t, size_t)
+    {
+      return 0U;
+    }
+
+    template <size_t OFFSET, size_t EXTENT, size_t STRIDE>
+    size_t slice_offset(strided_slice<OFFSET, EXTENT, STRIDE>, size_t, size_t stride)
+    {
+      return OFFSET * stride;
+    }
+
+    template <size_t EXTENT>
+    size_t slice_offset(extent_slice<EXTENT> slice, size_t extent, size_t stride)
+    {
+      ETL_ASSERT((slice.offset <= extent) && (EXTENT <= (extent - slice.offset)), ETL_ERROR(mdspan_out_of_range));
+
+      return slice.offset * stride;
+    }
+
+    template <typename TIndex>
+    size_t slice_offset(TIndex index, size_t extent, size_t stride)
+    {
+      ETL_ASSERT(size_t(index) < extent, ETL_ERROR(mdspan_out_of_range));
+
+      return size_t(index) * stride;
+    }
+
+    inline size_t offset(size_list<>, size_list<>)
+    {
+      return 0U;
+    }
+
+    template <size_t E, size_t... Ex, size_t S, size_t... Sx, typename TSlice, typename... TSlices>
+    size_t offset(size_list<E, Ex...>, size_list<S, Sx...>, TSlice slice, TSlices... slices)
+    {
+      return slice_offset(slice, E, S) + offset(size_list<Ex...>(), size_list<Sx...>(), slices...);
+    }
+
+    template <typename TList>
+    struct to_extents;
+
+    template <size_t... Ex>
+    struct to_extents<size_list<Ex...>>
+    {
+      using type = etl::extents<Ex...>;
+    };
+
+    template <typename TList>
+    struct to_layout;
+
+    template <size_t... Sx>
+    struct to_layout<size_list<Sx...>>
+    {
+      using type = etl::layout_stride<Sx...>;
+    };
+
+    //*************************************************************************
+    /// The element type and extents of a multi_array.
+    //*************************************************************************
+    template <typename T>
+    struct multi_array_traits
+    {
+      using value_type   = T;
+      using extents_list = size_list<>;
+    };
+
+    template <typename T, size_t N>
+    struct multi_array_traits<etl::array<T, N>>
+    {
+      using value_type   = typename multi_array_traits<T>::value_type;
+      using extents_list = typename prepend<N, typename multi_array_traits<T>::extents_list>::type;
+    };
+  }
+
+  //***************************************************************************
+  /// The type of a view sliced with TSlices.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename TMdspan, typename... TSlices>
+  struct submdspan_type
+  {
+    ETL_STATIC_ASSERT(TMdspan::mapping_type::is_strided, "Only strided layouts can be sliced");
+    ETL_STATIC_ASSERT(sizeof...(TSlices) == TMdspan::rank(), "One slice specifier per extent");
+
+    using sliced_t = private_mdspan::sliced<private_mdspan::size_list<>,
+                                            private_mdspan::size_list<>,
+                                            typename TMdspan::extents_type::list_type,
+                                            typename TMdspan::mapping_type::strides_type,
+                                            typename etl::remove_cv<TSlices>::type...>;
+
+    using type = etl::mdspan<typename TMdspan::element_type,
+                             typename private_mdspan::to_extents<typename sliced_t::extents_list>::type,
+                             typename private_mdspan::to_layout<typename sliced_t::strides_list>::type>;
+  };
+
+  //***************************************************************************
+  /// A view of part of a strided view. No elements are copied.
+  /// One slice specifier per extent:
+  /// full_extent keeps the extent, strided_slice<OFFSET, EXTENT, STRIDE> and
+  /// extent_slice<EXTENT>(offset) select a range, an index removes the extent.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename T, typename TExtents, typename TLayout, typename... TSlices>
+  typename etl::submdspan_type<etl::mdspan<T, TExtents, TLayout>, TSlices...>::type
+    submdspan(const etl::mdspan<T, TExtents, TLayout>& view, TSlices... slices)
+  {
+    using result_t  = typename etl::submdspan_type<etl::mdspan<T, TExtents, TLayout>, TSlices...>::type;
+    using extents_t = typename TExtents::list_type;
+    using strides_t = typename etl::mdspan<T, TExtents, TLayout>::mapping_type::strides_type;
+
+    return result_t(view.data() + private_mdspan::offset(extents_t(), strides_t(), slices...));
+  }
+
+  //***************************************************************************
+  /// The transpose of a two dimensional strided view. No elements are copied.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename T, size_t ROWS, size_t COLUMNS, typename TLayout>
+  etl::mdspan<T, etl::extents<COLUMNS, ROWS>, etl::layout_stride<etl::mdspan<T, etl::extents<ROWS, COLUMNS>, TLayout>::stride(1),
+                                                                 etl::mdspan<T, etl::extents<ROWS, COLUMNS>, TLayout>::stride(0)>>
+    transpose(const etl::mdspan<T, etl::extents<ROWS, COLUMNS>, TLayout>& view)
+  {
+    using source_t = etl::mdspan<T, etl::extents<ROWS, COLUMNS>, TLayout>;
+
+    return etl::mdspan<T, etl::extents<COLUMNS, ROWS>, etl::layout_stride<source_t::stride(1), source_t::stride(0)>>(view.data());
+  }
+
+  //***************************************************************************
+  /// A row major view of tile (tile_row, tile_column) of a tiled view.
+  /// The tile's elements are contiguous.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename T, size_t ROWS, size_t COLUMNS, size_t TILE_ROWS, size_t TILE_COLUMNS>
+  etl::mdspan<T, etl::extents<TILE_ROWS, TILE_COLUMNS>>
+    tile(const etl::mdspan<T, etl::extents<ROWS, COLUMNS>, etl::layout_tiled<TILE_ROWS, TILE_COLUMNS>>& view, size_t tile_row, size_t tile_column)
+  {
+    using mapping_t = typename etl::layout_tiled<TILE_ROWS, TILE_COLUMNS>::template mapping<etl::extents<ROWS, COLUMNS>>;
+
+    return etl::mdspan<T, etl::extents<TILE_ROWS, TILE_COLUMNS>>(view.data() + (mapping_t::tile_index(tile_row, tile_column) * (TILE_ROWS * TILE_COLUMNS)));
+  }
+
+  namespace private_mdspan
+  {
+    //*************************************************************************
+    /// The row major view type of a multi_array.
+    //*************************************************************************
+    template <typename TArray>
+    struct multi_array_mdspan
+    {
+      using value_type   = typename multi_array_traits<TArray>::value_type;
+      using extents_type = typename to_extents<typename multi_array_traits<TArray>::extents_list>::type;
+
+      ETL_STATIC_ASSERT(sizeof(TArray) == (extents_type::size() * sizeof(value_type)), "multi_array elements are not contiguous");
+
+      using type       = etl::mdspan<value_type, extents_type>;
+      using const_type = etl::mdspan<const value_type, extents_type>;
+    };
+
+    //*************************************************************************
+    /// The address of the first element of a multi_array.
+    //*************************************************************************
+    template <typename T>
+    T* first_element(T& value)
+    {
+      return &value;
+    }
+
+    template <typename T, size_t N>
+    typename multi_array_traits<etl::array<T, N>>::value_type* first_element(etl::array<T, N>& a)
+    {
+      return first_element(a[0]);
+    }
+
+    template <typename T>
+    const T* first_element(const T& value)
+    {
+      return &value;
+    }
+
+    template <typename T, size_t N>
+    const typename multi_array_traits<etl::array<T, N>>::value_type* first_element(const etl::array<T, N>& a)
+    {
+      return first_element(a[0]);
+    }
+  }
+
+  //***************************************************************************
+  /// A row major view of a multi_array.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename T, size_t N>
+  typename private_mdspan::multi_array_mdspan<etl::array<T, N>>::type make_mdspan(etl::array<T, N>& a)
+  {
+    return typename private_mdspan::multi_array_mdspan<etl::array<T, N>>::type(private_mdspan::first_element(a));
+  }
+
+  //***************************************************************************
+  /// A row major const view of a multi_array.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename T, size_t N>
+  typename private_mdspan::multi_array_mdspan<etl::array<T, N>>::const_type make_mdspan(const etl::array<T, N>& a)
+  {
+    return typename private_mdspan::multi_array_mdspan<etl::array<T, N>>::const_type(private_mdspan::first_element(a));
+  }
+
+  //***************************************************************************
+  /// Copies the elements of 'source' to 'destination', which must have the same extents.
+  /// For changing layout, such as from row major to tiled.
+  ///\ingroup mdspan
+  //***************************************************************************
+  template <typename T1, typename TLayout1, typename T2, typename TLayout2, size_t... Ex>
+  void copy(const etl::mdspan<T1, etl::extents<Ex...>, TLayout1>& source,
+            const etl::mdspan<T2, etl::extents<Ex...>, TLayout2>& destination)
+  {
+    etl::array<size_t, sizeof...(Ex)> indices;
+    indices.fill(0U);
+
+    // Walk the indices in row major order.
+    for (size_t n = 0U; n < etl::extents<Ex...>::size(); ++n)
+    {
+      destination[indices] = source[indices];
+
+      size_t r = sizeof...(Ex);
+
+      while ((r-- != 0U) && (++indices[r] == etl::extents<Ex...>::extent(r)))
+      {
+        indices[r] = 0U;
+      }
+    }
+  }
+
+#endif
+}
+
+#undef ETL_FILE
+
+#endif
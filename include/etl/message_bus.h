@@ -75,9 +75,26 @@ namespace etl
 
   //***************************************************************************
   /// Interface for message bus
+  /// Broadcasts use an index from message id to the routers that accept it.
+  /// The index is built when routers subscribe or unsubscribe, from the
+  /// message ids that each router lists with get_message_ids().
   //***************************************************************************
   class imessage_bus : public etl::imessage_router
   {
+  protected:
+
+    //*******************************************
+    /// An entry in the index of message ids to routers.
+    //*******************************************
+    struct subscription
+    {
+      etl::message_id_t message_id;
+      uint_least8_t     position; ///< The router's position in the router list.
+    };
+
+    typedef etl::ivector<subscription>  subscription_index_t;
+    typedef etl::ivector<uint_least8_t> position_list_t;
+
   private:
 
     typedef etl::ivector<etl::imessage_router*> router_list_t;
@@ -108,6 +125,7 @@ namespace etl
                                                              compare_router_id());
 
           router_list.insert(irouter, &router);
+          build_index();
         }
       }
 
@@ -131,6 +149,7 @@ namespace etl
                                                                                              compare_router_id());
 
         router_list.erase(range.first, range.second);
+        build_index();
       }
     }
 
@@ -144,6 +163,7 @@ namespace etl
       if (irouter != router_list.end())
       {
         router_list.erase(irouter);
+        build_index();
       }
     }
 
@@ -187,19 +207,34 @@ namespace etl
         // Broadcast to all routers.
         case etl::imessage_router::ALL_MESSAGE_ROUTERS:
         {
-          router_list_t::iterator irouter = router_list.begin();
+          // The indexed routers that accept the message.
+          std::pair<subscription_index_t::const_iterator, subscription_index_t::const_iterator> indexed = std::equal_range(subscription_index.begin(),
+                                                                                                                           subscription_index.end(),
+                                                                                                                           message.message_id,
+                                                                                                                           compare_subscription());
 
-          // Broadcast to everyone.
-          while (irouter != router_list.end())
-          {
-            etl::imessage_router& router = **irouter;
+          position_list_t::const_iterator iunindexed = unindexed_routers.begin();
 
-            if (router.accepts(message.message_id))
+          // Broadcast to everyone that accepts the message, in router list order.
+          while ((indexed.first != indexed.second) || (iunindexed != unindexed_routers.end()))
+          {
+            if ((iunindexed == unindexed_routers.end()) ||
+                ((indexed.first != indexed.second) && (indexed.first->position < *iunindexed)))
             {
-              router.receive(source, destination_router_id, message);
+              router_list[indexed.first->position]->receive(source, destination_router_id, message);
+              ++indexed.first;
             }
+            else
+            {
+              etl::imessage_router& router = *router_list[*iunindexed];
 
-            ++irouter;
+              if (router.accepts(message.message_id))
+              {
+                router.receive(source, destination_router_id, message);
+              }
+
+              ++iunindexed;
+            }
           }
 
           break;
@@ -268,7 +303,9 @@ namespace etl
     //*******************************************
     void clear()
     {
-      return router_list.clear();
+      router_list.clear();
+      subscription_index.clear();
+      unindexed_routers.clear();
     }
 
     //********************************************
@@ -282,14 +319,52 @@ namespace etl
     //*******************************************
     /// Constructor.
     //*******************************************
-    imessage_bus(router_list_t& list)
+    imessage_bus(router_list_t& list, subscription_index_t& index, position_list_t& unindexed)
       : imessage_router(etl::imessage_router::MESSAGE_BUS),
-        router_list(list)
+        router_list(list),
+        subscription_index(index),
+        unindexed_routers(unindexed)
     {
     }
 
   private:
 
+    //*******************************************
+    /// Rebuilds the index of message ids to routers.
+    /// Routers that cannot list their message ids, or whose ids do not fit
+    /// in the index, are asked with accepts() for each message instead.
+    //*******************************************
+    void build_index()
+    {
+      subscription_index.clear();
+      unindexed_routers.clear();
+
+      for (size_t position = 0; position < router_list.size(); ++position)
+      {
+        const etl::message_id_t* p_ids = nullptr;
+        size_t n_ids = 0;
+
+        if (router_list[position]->get_message_ids(p_ids, n_ids) && (n_ids <= subscription_index.available()))
+        {
+          for (size_t i = 0; i < n_ids; ++i)
+          {
+            subscription entry = { p_ids[i], uint_least8_t(position) };
+            subscription_index.push_back(entry);
+          }
+        }
+        else
+        {
+          unindexed_routers.push_back(uint_least8_t(position));
+        }
+      }
+
+      // Order by message id, then router list position.
+      std::sort(subscription_index.begin(), subscription_index.end(), compare_subscription());
+
+      subscription_index.erase(std::unique(subscription_index.begin(), subscription_index.end(), equal_subscription()),
+                               subscription_index.end());
+    }
+
     //*******************************************
     // How to compare routers to router ids.
     //*******************************************
@@ -306,13 +381,48 @@ namespace etl
       }
     };
 
-    router_list_t& router_list;
+    //*******************************************
+    // How to order the index.
+    //*******************************************
+    struct compare_subscription
+    {
+      bool operator()(const subscription& lhs, const subscription& rhs) const
+      {
+        return (lhs.message_id < rhs.message_id) ||
+               ((lhs.message_id == rhs.message_id) && (lhs.position < rhs.position));
+      }
+
+      bool operator()(const subscription& lhs, etl::message_id_t id) const
+      {
+        return lhs.message_id < id;
+      }
+
+      bool operator()(etl::message_id_t id, const subscription& rhs) const
+      {
+        return id < rhs.message_id;
+      }
+    };
+
+    //*******************************************
+    struct equal_subscription
+    {
+      bool operator()(const subscription& lhs, const subscription& rhs) const
+      {
+        return (lhs.message_id == rhs.message_id) && (lhs.position == rhs.position);
+      }
+    };
+
+    router_list_t&        router_list;
+    subscription_index_t& subscription_index;
+    position_list_t&      unindexed_routers;
   };
 
   //***************************************************************************
   /// The message bus
+  /// MAX_SUBSCRIPTIONS_ is the number of message ids, over all of the
+  /// routers, that the broadcast index can hold.
   //***************************************************************************
-  template <uint_least8_t MAX_ROUTERS_>
+  template <uint_least8_t MAX_ROUTERS_, size_t MAX_SUBSCRIPTIONS_ = 4U * MAX_ROUTERS_>
   class message_bus : public etl::imessage_bus
   {
   public:
@@ -321,13 +431,15 @@ namespace etl
     /// Constructor.
     //*******************************************
     message_bus()
-      : imessage_bus(router_list)
+      : imessage_bus(router_list, subscription_index, unindexed_routers)
     {
     }
 
   private:
 
     etl::vector<etl::imessage_router*, MAX_ROUTERS_> router_list;
+    etl::vector<subscription, MAX_SUBSCRIPTIONS_>    subscription_index;
+    etl::vector<uint_least8_t, MAX_ROUTERS_>         unindexed_routers;
   };
 
   //***************************************************************************
@@ -0,0 +1,582 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_MESSAGE_POOL_INCLUDED
+#define ETL_MESSAGE_POOL_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+
+#include "platform.h"
+#include "atomic.h"
+#include "message.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "nullptr.h"
+#include "static_assert.h"
+#include "alignment.h"
+#include "intrusive_links.h"
+#include "atomic_pool.h"
+#include "type_traits.h"
+
+#undef ETL_FILE
+#define ETL_FILE "56"
+
+#if ETL_HAS_ATOMIC && ETL_CPP11_SUPPORTED && !defined(ETL_NO_STL)
+
+#include <utility>
+
+//*****************************************************************************
+///\defgroup message_pool message_pool
+/// Lock free storage for messages that are passed between threads.
+///\ingroup messaging
+//*****************************************************************************
+
+namespace etl
+{
+  class imessage_router;
+  class imessage_pool;
+
+  //***************************************************************************
+  /// Base exception class for message pool
+  //***************************************************************************
+  class message_pool_exception : public etl::exception
+  {
+  public:
+
+    message_pool_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// All of the size classes large enough for the message are exhausted.
+  //***************************************************************************
+  class message_pool_no_allocation : public etl::message_pool_exception
+  {
+  public:
+
+    message_pool_no_allocation(string_type file_name_, numeric_type line_number_)
+      : message_pool_exception(ETL_ERROR_TEXT("message pool:no allocation", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The memory was not allocated from the message pool.
+  //***************************************************************************
+  class message_pool_not_in_pool : public etl::message_pool_exception
+  {
+  public:
+
+    message_pool_not_in_pool(string_type file_name_, numeric_type line_number_)
+      : message_pool_exception(ETL_ERROR_TEXT("message pool:not in pool", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The header in front of every message allocated from a message pool.
+  /// The link lets the message be queued without any further storage.
+  ///\ingroup message_pool
+  //***************************************************************************
+  struct message_node : public etl::forward_link<0>
+  {
+    typedef etl::forward_link<0> link_type;
+
+    etl::imessage*        p_message; ///< The message that follows the header.
+    etl::imessage_router* p_source;  ///< The router that sent it, if queued.
+    etl::imessage_pool*   p_pool;    ///< The pool that it came from.
+
+    etl::atomic<uint32_t> n_references; ///< The number of handles that share the message.
+
+    void (*p_destroy)(message_node*); ///< Destroys the message and releases the node.
+  };
+
+  namespace private_message_pool
+  {
+    //*************************************************************************
+    /// A message and its header, as stored in the pool.
+    //*************************************************************************
+    template <typename TMessage>
+    struct pooled_message : public etl::message_node
+    {
+      template <typename... TArgs>
+      explicit pooled_message(TArgs&&... args)
+        : message(std::forward<TArgs>(args)...)
+      {
+      }
+
+      TMessage message;
+    };
+  }
+
+  //***************************************************************************
+  /// Owns a message allocated from a message pool.
+  /// Moving the handle moves the ownership; the message itself is never copied.
+  /// share() gives another handle to the same message, for passing to several
+  /// receivers. The message is destroyed and returned to its pool when the
+  /// last handle to it is reset or destroyed.
+  ///\ingroup message_pool
+  //***************************************************************************
+  class message_handle
+  {
+  public:
+
+    //*************************************************************************
+    /// Constructs an empty handle.
+    //*************************************************************************
+    message_handle()
+      : p_node(nullptr)
+    {
+    }
+
+    //*************************************************************************
+    /// Takes ownership of a node.
+    //*************************************************************************
+    explicit message_handle(etl::message_node* p_node_)
+      : p_node(p_node_)
+    {
+    }
+
+    //*************************************************************************
+    /// Move constructor.
+    //*************************************************************************
+    message_handle(message_handle&& other)
+      : p_node(other.p_node)
+    {
+      other.p_node = nullptr;
+    }
+
+    //*************************************************************************
+    /// Move assignment.
+    //*************************************************************************
+    message_handle& operator =(message_handle&& other)
+    {
+      if (this != &other)
+      {
+        reset();
+        p_node       = other.p_node;
+        other.p_node = nullptr;
+      }
+
+      return *this;
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~message_handle()
+    {
+      reset();
+    }
+
+    //*************************************************************************
+    /// Returns <b>true</b> if the handle owns a message.
+    //*************************************************************************
+    bool has_value() const
+    {
+      return p_node != nullptr;
+    }
+
+    //*************************************************************************
+    /// Returns <b>true</b> if the handle owns a message.
+    //*************************************************************************
+    explicit operator bool() const
+    {
+      return has_value();
+    }
+
+    //*************************************************************************
+    /// Returns <b>true</b> if this is the only handle to the message.
+    //*************************************************************************
+    bool is_unique() const
+    {
+      return (p_node != nullptr) && (p_node->n_references.load(etl::memory_order_acquire) == 1U);
+    }
+
+    //*************************************************************************
+    /// Returns another handle to the same message.
+    /// The handle must own a message.
+    /// A shared message may be published to several mailboxes, but cannot be
+    /// posted to a queued_message_router until it is no longer shared.
+    //*************************************************************************
+    message_handle share() const
+    {
+      p_node->n_references.fetch_add(1U, etl::memory_order_relaxed);
+
+      return message_handle(p_node);
+    }
+
+    //*************************************************************************
+    /// Gets the message.
+    //*************************************************************************
+    etl::imessage& get()
+    {
+      return *p_node->p_message;
+    }
+
+    //*************************************************************************
+    /// Gets the message.
+    //*************************************************************************
+    const etl::imessage& get() const
+    {
+      return *p_node->p_message;
+    }
+
+    //*************************************************************************
+    /// Gives up this handle's share of the message. The last one destroys the
+    /// message and returns it to its pool.
+    //*************************************************************************
+    void reset()
+    {
+      if (p_node != nullptr)
+      {
+        // A sole owner cannot be shared by anyone else, so needs no decrement.
+        if ((p_node->n_references.load(etl::memory_order_acquire) == 1U) ||
+            (p_node->n_references.fetch_sub(1U, etl::memory_order_acq_rel) == 1U))
+        {
+          p_node->p_destroy(p_node);
+        }
+
+        p_node = nullptr;
+      }
+    }
+
+    //*************************************************************************
+    /// Gives up this handle's share of the node without destroying the message.
+    //*************************************************************************
+    etl::message_node* release()
+    {
+      etl::message_node* p = p_node;
+      p_node = nullptr;
+
+      return p;
+    }
+
+  private:
+
+    // Handles are moved, not copied.
+    message_handle(const message_handle&);
+    message_handle& operator =(const message_handle&);
+
+    etl::message_node* p_node;
+  };
+
+  //***************************************************************************
+  /// The base of all message pools.
+  /// A message is taken from the smallest size class that will hold it. If that
+  /// class is exhausted, the next larger class is tried.
+  /// create and release may be called from any thread.
+  ///\ingroup message_pool
+  //***************************************************************************
+  class imessage_pool
+  {
+  public:
+
+    //*************************************************************************
+    /// Constructs a message in the pool.
+    /// If asserts or exceptions are enabled and all of the suitable size
+    /// classes are exhausted an etl::message_pool_no_allocation is thrown.
+    /// Otherwise an empty handle is returned.
+    //*************************************************************************
+    template <typename TMessage, typename... TArgs>
+    etl::message_handle create(TArgs&&... args)
+    {
+      typedef private_message_pool::pooled_message<TMessage> pooled_t;
+
+      void* p = allocate(sizeof(pooled_t), etl::alignment_of<pooled_t>::value);
+
+      if (p == nullptr)
+      {
+        ETL_ASSERT(false, ETL_ERROR(message_pool_no_allocation));
+        return etl::message_handle();
+      }
+
+      pooled_t* p_pooled = ::new (p) pooled_t(std::forward<TArgs>(args)...);
+
+      p_pooled->p_message = &p_pooled->message;
+      p_pooled->p_source  = nullptr;
+      p_pooled->p_pool    = this;
+      p_pooled->p_destroy = &destroy<TMessage>;
+      p_pooled->n_references.store(1U, etl::memory_order_relaxed);
+
+      return etl::message_handle(p_pooled);
+    }
+
+    //*************************************************************************
+    /// Copies a message in to the pool as its own type, which is found from its
+    /// id in the list of message types.
+    /// Returns an empty handle if the id is not in the list.
+    //*************************************************************************
+    template <typename T1, typename... TRest>
+    etl::message_handle clone(const etl::imessage& msg)
+    {
+      return (msg.message_id == T1::ID) ? create<T1>(static_cast<const T1&>(msg))
+                                        : clone<TRest...>(msg);
+    }
+
+    //*************************************************************************
+    /// Returns the number of size classes.
+    //*************************************************************************
+    size_t size_classes() const
+    {
+      return N_CLASSES;
+    }
+
+    //*************************************************************************
+    /// Returns the pool for a size class.
+    //*************************************************************************
+    etl::iatomic_pool& get_pool(size_t index)
+    {
+      return *p_pools[index];
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor.
+    /// The arrays are filled in by the derived class.
+    //*************************************************************************
+    imessage_pool(etl::iatomic_pool** p_pools_,
+                  size_t*             p_sizes_,
+                  size_t*             p_alignments_,
+                  size_t              n_classes_)
+      : p_pools(p_pools_),
+        p_sizes(p_sizes_),
+        p_alignments(p_alignments_),
+        N_CLASSES(n_classes_)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~imessage_pool()
+    {
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Allocates from the smallest class that will hold the size.
+    /// Returns nullptr if every suitable class is exhausted.
+    //*************************************************************************
+    void* allocate(size_t size, size_t alignment)
+    {
+      for (size_t i = 0; i < N_CLASSES; ++i)
+      {
+        if ((size <= p_sizes[i]) && (alignment <= p_alignments[i]))
+        {
+          void* p;
+
+          if (p_pools[i]->allocate_batch(&p, 1U) == 1U)
+          {
+            return p;
+          }
+        }
+      }
+
+      return nullptr;
+    }
+
+    //*************************************************************************
+    /// The end of the list of message types.
+    //*************************************************************************
+    template <typename... TRest>
+    typename etl::enable_if<sizeof...(TRest) == 0U, etl::message_handle>::type
+      clone(const etl::imessage&)
+    {
+      return etl::message_handle();
+    }
+
+    //*************************************************************************
+    /// Returns memory to the class that it came from.
+    //*************************************************************************
+    void release(const void* p)
+    {
+      etl::iatomic_pool* p_pool = find_pool(p);
+
+      ETL_ASSERT(p_pool != nullptr, ETL_ERROR(message_pool_not_in_pool));
+
+      if (p_pool != nullptr)
+      {
+        p_pool->release(p);
+      }
+    }
+
+    //*************************************************************************
+    /// The pool that the memory came from, or nullptr.
+    //*************************************************************************
+    etl::iatomic_pool* find_pool(const void* p) const
+    {
+      for (size_t i = 0; i < N_CLASSES; ++i)
+      {
+        if (p_pools[i]->is_in_pool(p))
+        {
+          return p_pools[i];
+        }
+      }
+
+      return nullptr;
+    }
+
+    //*************************************************************************
+    /// Destroys a message and returns it to its pool.
+    //*************************************************************************
+    template <typename TMessage>
+    static void destroy(etl::message_node* p_node)
+    {
+      typedef private_message_pool::pooled_message<TMessage> pooled_t;
+
+      pooled_t*           p_pooled = static_cast<pooled_t*>(p_node);
+      etl::imessage_pool* p_pool   = p_pooled->p_pool;
+
+      p_pooled->~pooled_t();
+      p_pool->release(p_pooled);
+    }
+
+    // Disable copy construction and assignment.
+    imessage_pool(const imessage_pool&);
+    imessage_pool& operator =(const imessage_pool&);
+
+    etl::iatomic_pool** p_pools;      ///< The pool for each size class.
+    size_t*             p_sizes;      ///< The item size of each size class.
+    size_t*             p_alignments; ///< The alignment of each size class.
+
+    const size_t N_CLASSES; ///< The number of size classes.
+  };
+
+  namespace private_message_pool
+  {
+    //*************************************************************************
+    /// Holds one of each of the pools.
+    //*************************************************************************
+    template <typename... TPools>
+    struct pool_list;
+
+    template <typename THead, typename... TTail>
+    struct pool_list<THead, TTail...>
+    {
+      // The alignment that the pool can actually provide.
+      static const size_t ALIGNMENT = etl::alignment_of<typename etl::type_with_alignment<THead::ALIGNMENT>::type>::value;
+
+      template <size_t PREVIOUS_SIZE>
+      struct is_valid_tail
+      {
+        static const bool value = (THead::TYPE_SIZE > PREVIOUS_SIZE) &&
+                                  pool_list<TTail...>::template is_valid_tail<THead::TYPE_SIZE>::value;
+      };
+
+      void get(etl::iatomic_pool** p_pools, size_t* p_sizes, size_t* p_alignments)
+      {
+        *p_pools      = &head;
+        *p_sizes      = THead::TYPE_SIZE;
+        *p_alignments = ALIGNMENT;
+
+        tail.get(p_pools + 1, p_sizes + 1, p_alignments + 1);
+      }
+
+      THead               head;
+      pool_list<TTail...> tail;
+    };
+
+    template <>
+    struct pool_list<>
+    {
+      template <size_t PREVIOUS_SIZE>
+      struct is_valid_tail
+      {
+        static const bool value = true;
+      };
+
+      void get(etl::iatomic_pool**, size_t*, size_t*)
+      {
+      }
+    };
+  }
+
+  //***************************************************************************
+  /// A message pool built from a list of etl::generic_atomic_pool size classes.
+  /// The pools must be listed in ascending size.
+  /// Each message only takes an item of the smallest class that will hold it
+  /// and its header, rather than one sized for the largest message.
+  ///\code
+  /// etl::message_pool<etl::generic_atomic_pool<32,  8, 64>,
+  ///                   etl::generic_atomic_pool<128, 8, 8>> pool;
+  ///
+  /// etl::message_handle handle = pool.create<Message1>(1);
+  ///\endcode
+  ///\tparam TPools The size class pools.
+  ///\ingroup message_pool
+  //***************************************************************************
+  template <typename... TPools>
+  class message_pool : public etl::imessage_pool
+  {
+  private:
+
+    typedef private_message_pool::pool_list<TPools...> pool_list_t;
+
+  public:
+
+    static const size_t SIZE_CLASSES = sizeof...(TPools);
+
+    ETL_STATIC_ASSERT(SIZE_CLASSES != 0U, "No size classes");
+    ETL_STATIC_ASSERT(pool_list_t::template is_valid_tail<0U>::value, "Size classes must be in ascending order of size");
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    message_pool()
+      : imessage_pool(pool_pointers, sizes, alignments, SIZE_CLASSES)
+    {
+      pools.get(pool_pointers, sizes, alignments);
+    }
+
+  private:
+
+    pool_list_t        pools;
+    etl::iatomic_pool* pool_pointers[SIZE_CLASSES];
+    size_t             sizes[SIZE_CLASSES];
+    size_t             alignments[SIZE_CLASSES];
+  };
+
+  template <typename... TPools>
+  const size_t message_pool<TPools...>::SIZE_CLASSES;
+}
+
+#endif
+
+#undef ETL_FILE
+
+#endif
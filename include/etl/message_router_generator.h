@@ -73,11 +73,21 @@ cog.outl("//********************************************************************
 #include "error_handler.h"
 #include "exception.h"
 #include "largest.h"
+#include "smallest.h"
+#include "type_traits.h"
+#include "static_assert.h"
 #include "nullptr.h"
 
 #undef ETL_FILE
 #define ETL_FILE "35"
 
+#if !defined(ETL_MESSAGE_ROUTER_MAX_TABLE_SIZE)
+  // The largest span of message ids that the variadic router will
+  // dispatch through a table. Wider spans are hashed in to a table of at most
+  // this many more entries than there are ids, or searched if none is found.
+  #define ETL_MESSAGE_ROUTER_MAX_TABLE_SIZE 256
+#endif
+
 namespace etl
 {
   //***************************************************************************
@@ -124,6 +134,16 @@ namespace etl
       return accepts(msg.message_id);
     }
 
+    //********************************************
+    /// Gets the ids of the messages that the router accepts.
+    /// Returns false if the router cannot list them, in which case
+    /// accepts() must be called for each message.
+    //********************************************
+    virtual bool get_message_ids(const etl::message_id_t*& /*p_ids*/, size_t& /*n_ids*/) const
+    {
+      return false;
+    }
+
     //********************************************
     etl::message_router_id_t get_message_router_id() const
     {
@@ -250,6 +270,579 @@ namespace etl
     destination.receive(source, message);
   }
 
+#if ETL_CPP11_SUPPORTED && !defined(ETL_MESSAGE_ROUTER_FORCE_CPP03)
+  namespace private_message_router
+  {
+    //*************************************************************************
+    /// A compile time sequence of indexes.
+    //*************************************************************************
+    template <size_t... Indexes>
+    struct index_sequence
+    {
+    };
+
+    template <size_t N, size_t... Indexes>
+    struct make_index_sequence : make_index_sequence<N - 1, N - 1, Indexes...>
+    {
+    };
+
+    template <size_t... Indexes>
+    struct make_index_sequence<0, Indexes...>
+    {
+      typedef index_sequence<Indexes...> type;
+    };
+
+    //*************************************************************************
+    /// The position of 'id' in the list of ids, or the length of the list
+    /// if it is not there.
+    //*************************************************************************
+    constexpr size_t index_of(etl::message_id_t, size_t index)
+    {
+      return index;
+    }
+
+    template <typename... TIds>
+    constexpr size_t index_of(etl::message_id_t id, size_t index, etl::message_id_t first, TIds... rest)
+    {
+      return (id == first) ? index : index_of(id, index + 1, rest...);
+    }
+
+    //*************************************************************************
+    constexpr etl::message_id_t min_id(etl::message_id_t id)
+    {
+      return id;
+    }
+
+    template <typename... TIds>
+    constexpr etl::message_id_t min_id(etl::message_id_t a, etl::message_id_t b, TIds... rest)
+    {
+      return min_id((a < b) ? a : b, rest...);
+    }
+
+    //*************************************************************************
+    constexpr etl::message_id_t max_id(etl::message_id_t id)
+    {
+      return id;
+    }
+
+    template <typename... TIds>
+    constexpr etl::message_id_t max_id(etl::message_id_t a, etl::message_id_t b, TIds... rest)
+    {
+      return max_id((a > b) ? a : b, rest...);
+    }
+
+    //*************************************************************************
+    constexpr bool is_unique()
+    {
+      return true;
+    }
+
+    template <typename... TIds>
+    constexpr bool is_unique(etl::message_id_t first, TIds... rest)
+    {
+      return (index_of(first, 0, rest...) == sizeof...(rest)) && is_unique(rest...);
+    }
+
+    //*************************************************************************
+    constexpr bool all_of()
+    {
+      return true;
+    }
+
+    template <typename... TBools>
+    constexpr bool all_of(bool first, TBools... rest)
+    {
+      return first && all_of(rest...);
+    }
+
+    //*************************************************************************
+    /// A table of the position of each id from MIN_ID onwards.
+    //*************************************************************************
+    template <typename TIndex, etl::message_id_t MIN_ID, typename TSequence, etl::message_id_t... Ids>
+    struct dense_table;
+
+    template <typename TIndex, etl::message_id_t MIN_ID, size_t... Indexes, etl::message_id_t... Ids>
+    struct dense_table<TIndex, MIN_ID, index_sequence<Indexes...>, Ids...>
+    {
+      static constexpr TIndex table[sizeof...(Indexes)] = { TIndex(index_of(etl::message_id_t(MIN_ID + Indexes), 0, Ids...))... };
+    };
+
+    template <typename TIndex, etl::message_id_t MIN_ID, size_t... Indexes, etl::message_id_t... Ids>
+    constexpr TIndex dense_table<TIndex, MIN_ID, index_sequence<Indexes...>, Ids...>::table[sizeof...(Indexes)];
+
+    //*************************************************************************
+    /// Does any of the ids leave 'remainder' when divided by 'modulus'?
+    //*************************************************************************
+    constexpr bool has_remainder(size_t, size_t)
+    {
+      return false;
+    }
+
+    template <typename... TIds>
+    constexpr bool has_remainder(size_t modulus, size_t remainder, etl::message_id_t first, TIds... rest)
+    {
+      return ((size_t(first) % modulus) == remainder) || has_remainder(modulus, remainder, rest...);
+    }
+
+    //*************************************************************************
+    /// Does each id leave a different remainder when divided by 'modulus'?
+    //*************************************************************************
+    constexpr bool unique_remainders(size_t)
+    {
+      return true;
+    }
+
+    template <typename... TIds>
+    constexpr bool unique_remainders(size_t modulus, etl::message_id_t first, TIds... rest)
+    {
+      return !has_remainder(modulus, size_t(first) % modulus, rest...) && unique_remainders(modulus, rest...);
+    }
+
+    //*************************************************************************
+    /// The position of the id that leaves 'remainder' when divided by
+    /// 'modulus', or the length of the list if there is none.
+    //*************************************************************************
+    constexpr size_t index_of_remainder(size_t, size_t, size_t index)
+    {
+      return index;
+    }
+
+    template <typename... TIds>
+    constexpr size_t index_of_remainder(size_t modulus, size_t remainder, size_t index, etl::message_id_t first, TIds... rest)
+    {
+      return ((size_t(first) % modulus) == remainder) ? index : index_of_remainder(modulus, remainder, index + 1, rest...);
+    }
+
+    //*************************************************************************
+    /// The smallest modulus in [first, last) that gives each id a different
+    /// remainder, or zero if there is none.
+    /// The range is halved at each step to limit the depth of recursion.
+    //*************************************************************************
+    constexpr size_t first_non_zero(size_t a, size_t b)
+    {
+      return (a != 0U) ? a : b;
+    }
+
+    template <typename... TIds>
+    constexpr size_t find_modulus(size_t first, size_t last, TIds... ids)
+    {
+      return ((last - first) == 1U) ? (unique_remainders(first, ids...) ? first : 0U)
+                                    : first_non_zero(find_modulus(first, first + ((last - first) / 2U), ids...),
+                                                     find_modulus(first + ((last - first) / 2U), last, ids...));
+    }
+
+    //*************************************************************************
+    /// A table of the position of the id for each remainder of MODULUS.
+    //*************************************************************************
+    template <typename TIndex, size_t MODULUS, typename TSequence, etl::message_id_t... Ids>
+    struct hash_table;
+
+    template <typename TIndex, size_t MODULUS, size_t... Indexes, etl::message_id_t... Ids>
+    struct hash_table<TIndex, MODULUS, index_sequence<Indexes...>, Ids...>
+    {
+      static constexpr TIndex            table[sizeof...(Indexes)] = { TIndex(index_of_remainder(MODULUS, Indexes, 0, Ids...))... };
+      static constexpr etl::message_id_t ids[sizeof...(Ids)]       = { Ids... };
+    };
+
+    template <typename TIndex, size_t MODULUS, size_t... Indexes, etl::message_id_t... Ids>
+    constexpr TIndex hash_table<TIndex, MODULUS, index_sequence<Indexes...>, Ids...>::table[sizeof...(Indexes)];
+
+    template <typename TIndex, size_t MODULUS, size_t... Indexes, etl::message_id_t... Ids>
+    constexpr etl::message_id_t hash_table<TIndex, MODULUS, index_sequence<Indexes...>, Ids...>::ids[sizeof...(Ids)];
+
+    //*************************************************************************
+    /// Finds the position of a message id from its remainder when divided by
+    /// MODULUS. A MODULUS of zero means that none was found, so the ids are
+    /// searched.
+    //*************************************************************************
+    template <size_t MODULUS, etl::message_id_t... Ids>
+    struct hashed_lookup
+    {
+      typedef typename etl::smallest_uint_for_value<sizeof...(Ids)>::type index_t;
+      typedef hash_table<index_t, MODULUS, typename make_index_sequence<MODULUS>::type, Ids...> table_t;
+
+      static size_t find(etl::message_id_t id)
+      {
+        const size_t index = table_t::table[size_t(id) % MODULUS];
+
+        // An id that is not in the list may leave the same remainder.
+        return ((index < sizeof...(Ids)) && (table_t::ids[index] == id)) ? index : sizeof...(Ids);
+      }
+    };
+
+    template <etl::message_id_t... Ids>
+    struct hashed_lookup<0U, Ids...>
+    {
+      static size_t find(etl::message_id_t id)
+      {
+        return index_of(id, 0, Ids...);
+      }
+    };
+
+    //*************************************************************************
+    /// Finds the position of a message id in the list of ids.
+    /// Returns the number of ids if it is not found.
+    /// Ids that span a small range use a table indexed by id, others are hashed.
+    //*************************************************************************
+    template <bool DENSE, etl::message_id_t... Ids>
+    struct id_lookup : public hashed_lookup<find_modulus(sizeof...(Ids), sizeof...(Ids) + ETL_MESSAGE_ROUTER_MAX_TABLE_SIZE, Ids...), Ids...>
+    {
+    };
+
+    template <etl::message_id_t... Ids>
+    struct id_lookup<true, Ids...>
+    {
+      static constexpr etl::message_id_t MIN_ID = min_id(Ids...);
+      static constexpr size_t            RANGE  = size_t(max_id(Ids...) - MIN_ID) + 1;
+
+      typedef typename etl::smallest_uint_for_value<sizeof...(Ids)>::type index_t;
+      typedef dense_table<index_t, MIN_ID, typename make_index_sequence<RANGE>::type, Ids...> table_t;
+
+      static size_t find(etl::message_id_t id)
+      {
+        const size_t offset = size_t(id) - size_t(MIN_ID);
+
+        return (offset < RANGE) ? table_t::table[offset] : sizeof...(Ids);
+      }
+    };
+
+    template <etl::message_id_t... Ids>
+    struct id_index : public id_lookup<(size_t(max_id(Ids...) - min_id(Ids...)) < ETL_MESSAGE_ROUTER_MAX_TABLE_SIZE), Ids...>
+    {
+    };
+
+    //*************************************************************************
+    /// The type at a position in a list.
+    //*************************************************************************
+    template <size_t INDEX, typename T1, typename... TRest>
+    struct type_at
+    {
+      typedef typename type_at<INDEX - 1U, TRest...>::type type;
+    };
+
+    template <typename T1, typename... TRest>
+    struct type_at<0U, T1, TRest...>
+    {
+      typedef T1 type;
+    };
+
+    //*************************************************************************
+    /// A case of type_switch. Its label is the id of the type at INDEX.
+    //*************************************************************************
+    template <size_t INDEX, bool IN_LIST, typename... TTypes>
+    struct switch_case
+    {
+      typedef typename type_at<INDEX, TTypes...>::type type;
+
+      static constexpr size_t ID = size_t(type::ID);
+
+      template <typename TAction, typename... TArgs>
+      static void apply(TArgs&... args)
+      {
+        TAction::template apply<type>(args...);
+      }
+    };
+
+    //*************************************************************************
+    /// A case past the end of the list. Its label is larger than any id in
+    /// the list, so it is never taken.
+    //*************************************************************************
+    template <size_t INDEX, typename... TTypes>
+    struct switch_case<INDEX, false, TTypes...>
+    {
+      static constexpr size_t ID = size_t(max_id(etl::message_id_t(TTypes::ID)...)) + 1U + INDEX;
+
+      template <typename TAction, typename... TArgs>
+      static void apply(TArgs&...)
+      {
+      }
+    };
+
+    //*************************************************************************
+    /// Calls TAction::apply<T>(args...) for the type T whose id matches,
+    /// with a switch on the ids, as the generated router does. The cases are
+    /// constants, so the compiler can inline each one and build a jump table.
+    /// Lists of more than 16 types continue in the switch of the next 16.
+    /// Returns false if no type has the id.
+    //*************************************************************************
+    template <size_t BASE, bool IN_LIST, typename... TTypes>
+    struct type_switch
+    {
+      template <size_t INDEX>
+      struct at : public switch_case<BASE + INDEX, ((BASE + INDEX) < sizeof...(TTypes)), TTypes...>
+      {
+      };
+
+      typedef type_switch<BASE + 16U, ((BASE + 16U) < sizeof...(TTypes)), TTypes...> next_t;
+
+      template <typename TAction, typename... TArgs>
+      static bool apply(size_t id, TArgs&... args)
+      {
+        switch (id)
+        {
+          case at<0>::ID:  at<0>::template apply<TAction>(args...);  return true;
+          case at<1>::ID:  at<1>::template apply<TAction>(args...);  return true;
+          case at<2>::ID:  at<2>::template apply<TAction>(args...);  return true;
+          case at<3>::ID:  at<3>::template apply<TAction>(args...);  return true;
+          case at<4>::ID:  at<4>::template apply<TAction>(args...);  return true;
+          case at<5>::ID:  at<5>::template apply<TAction>(args...);  return true;
+          case at<6>::ID:  at<6>::template apply<TAction>(args...);  return true;
+          case at<7>::ID:  at<7>::template apply<TAction>(args...);  return true;
+          case at<8>::ID:  at<8>::template apply<TAction>(args...);  return true;
+          case at<9>::ID:  at<9>::template apply<TAction>(args...);  return true;
+          case at<10>::ID: at<10>::template apply<TAction>(args...); return true;
+          case at<11>::ID: at<11>::template apply<TAction>(args...); return true;
+          case at<12>::ID: at<12>::template apply<TAction>(args...); return true;
+          case at<13>::ID: at<13>::template apply<TAction>(args...); return true;
+          case at<14>::ID: at<14>::template apply<TAction>(args...); return true;
+          case at<15>::ID: at<15>::template apply<TAction>(args...); return true;
+          default:         return next_t::template apply<TAction>(id, args...);
+        }
+      }
+    };
+
+    //*************************************************************************
+    /// Past the end of the list.
+    //*************************************************************************
+    template <size_t BASE, typename... TTypes>
+    struct type_switch<BASE, false, TTypes...>
+    {
+      template <typename TAction, typename... TArgs>
+      static bool apply(size_t, TArgs&...)
+      {
+        return false;
+      }
+    };
+  }
+
+  //***************************************************************************
+  /// The message router for any number of message types.
+  /// Dispatch and accepts are table lookups on the message id; message_packet
+  /// copy and destroy switch on the id, as the generated router does.
+  //***************************************************************************
+  template <typename TDerived, typename... TMessageTypes>
+  class message_router : public imessage_router
+  {
+  private:
+
+    ETL_STATIC_ASSERT(sizeof...(TMessageTypes) != 0, "No message types");
+    ETL_STATIC_ASSERT(private_message_router::is_unique(etl::message_id_t(TMessageTypes::ID)...), "Message ids must be unique");
+
+    static constexpr size_t N_MESSAGE_TYPES = sizeof...(TMessageTypes);
+    static constexpr bool   TRIVIAL_DESTROY = private_message_router::all_of(etl::is_trivially_destructible<TMessageTypes>::value...);
+
+    typedef private_message_router::id_index<etl::message_id_t(TMessageTypes::ID)...> id_index_t;
+    typedef private_message_router::type_switch<0U, true, TMessageTypes...>         type_switch_t;
+
+  public:
+
+    //**********************************************
+    class message_packet
+    {
+    public:
+
+      //********************************************
+      explicit message_packet(const etl::imessage& msg)
+      {
+        copy_construct(msg);
+      }
+
+      //********************************************
+      template <typename T>
+      explicit message_packet(const T& msg)
+      {
+        ETL_STATIC_ASSERT((etl::is_one_of<T, TMessageTypes...>::value), "Unsupported type for this message packet");
+
+        void* p = data;
+        ::new (p) T(static_cast<const T&>(msg));
+      }
+
+      //********************************************
+      message_packet(const message_packet& other)
+      {
+        copy_construct(other.get());
+      }
+
+      //********************************************
+      message_packet& operator =(const message_packet& other)
+      {
+        if (this != &other)
+        {
+          destroy();
+          copy_construct(other.get());
+        }
+
+        return *this;
+      }
+
+      //********************************************
+      ~message_packet()
+      {
+        destroy();
+      }
+
+      //********************************************
+      etl::imessage& get()
+      {
+        return *static_cast<etl::imessage*>(data);
+      }
+
+      //********************************************
+      const etl::imessage& get() const
+      {
+        return *static_cast<const etl::imessage*>(data);
+      }
+
+      enum
+      {
+        SIZE      = etl::largest<TMessageTypes...>::size,
+        ALIGNMENT = etl::largest<TMessageTypes...>::alignment
+      };
+
+    private:
+
+      //********************************************
+      // The actions for type_switch_t.
+      //********************************************
+      struct copy_message
+      {
+        template <typename T>
+        static void apply(void*& p, const etl::imessage& msg)
+        {
+          ::new (p) T(static_cast<const T&>(msg));
+        }
+      };
+
+      //********************************************
+      struct destroy_message
+      {
+        template <typename T>
+        static void apply(etl::imessage*& pmsg)
+        {
+          static_cast<T*>(pmsg)->~T();
+        }
+      };
+
+      //********************************************
+      void copy_construct(const etl::imessage& msg)
+      {
+        void* p = data;
+
+        const bool copied = type_switch_t::template apply<copy_message>(msg.message_id, p, msg);
+
+        ETL_ASSERT(copied, ETL_ERROR(unhandled_message_exception));
+        (void)copied;
+      }
+
+      //********************************************
+      void destroy()
+      {
+        etl::imessage* pmsg = static_cast<etl::imessage*>(data);
+
+  #if defined(ETL_MESSAGES_ARE_VIRTUAL) || defined(ETL_POLYMORPHIC_MESSAGES)
+        pmsg->~imessage();
+  #else
+        // Nothing to do if none of the message types have a destructor.
+        if (!TRIVIAL_DESTROY)
+        {
+          type_switch_t::template apply<destroy_message>(pmsg->message_id, pmsg);
+        }
+  #endif
+      }
+
+      typename etl::aligned_storage<SIZE, ALIGNMENT>::type data;
+    };
+
+    //**********************************************
+    message_router(etl::message_router_id_t id_)
+      : imessage_router(id_)
+    {
+      ETL_ASSERT(id_ <= etl::imessage_router::MAX_MESSAGE_ROUTER, ETL_ERROR(etl::message_router_illegal_id));
+    }
+
+    //**********************************************
+    message_router(etl::message_router_id_t id_, etl::imessage_router& successor_)
+      : imessage_router(id_, successor_)
+    {
+      ETL_ASSERT(id_ <= etl::imessage_router::MAX_MESSAGE_ROUTER, ETL_ERROR(etl::message_router_illegal_id));
+    }
+
+    //**********************************************
+    void receive(const etl::imessage& msg)
+    {
+      receive(etl::null_message_router::instance(), msg);
+    }
+
+    //**********************************************
+    void receive(etl::imessage_router& source, etl::message_router_id_t destination_router_id, const etl::imessage& msg)
+    {
+      if ((destination_router_id == get_message_router_id()) || (destination_router_id == imessage_router::ALL_MESSAGE_ROUTERS))
+      {
+        receive(source, msg);
+      }
+    }
+
+    //**********************************************
+    void receive(etl::imessage_router& source, const etl::imessage& msg)
+    {
+      typedef void (*handler_t)(TDerived&, etl::imessage_router&, const etl::imessage&);
+
+      static const handler_t handlers[] = { &message_router::template dispatch<TMessageTypes>... };
+
+      const size_t index = id_index_t::find(msg.message_id);
+
+      if (index < N_MESSAGE_TYPES)
+      {
+        handlers[index](*static_cast<TDerived*>(this), source, msg);
+      }
+      else
+      {
+        if (has_successor())
+        {
+          get_successor().receive(source, msg);
+        }
+        else
+        {
+          static_cast<TDerived*>(this)->on_receive_unknown(source, msg);
+        }
+      }
+    }
+
+    using imessage_router::accepts;
+
+    //**********************************************
+    bool accepts(etl::message_id_t id) const
+    {
+      return id_index_t::find(id) < N_MESSAGE_TYPES;
+    }
+
+    //********************************************
+    bool get_message_ids(const etl::message_id_t*& p_ids, size_t& n_ids) const
+    {
+      static const etl::message_id_t ids[] = { TMessageTypes::ID... };
+
+      p_ids = ids;
+      n_ids = N_MESSAGE_TYPES;
+
+      return true;
+    }
+
+    //********************************************
+    bool is_null_router() const
+    {
+      return false;
+    }
+
+  private:
+
+    //**********************************************
+    template <typename T>
+    static void dispatch(TDerived& derived, etl::imessage_router& source, const etl::imessage& msg)
+    {
+      derived.on_receive(source, static_cast<const T&>(msg));
+    }
+  };
+#else
   /*[[[cog
       import cog
       ################################################
@@ -431,6 +1024,25 @@ namespace etl
       cog.outl("  }")
       cog.outl("")
       cog.outl("  //********************************************")
+      cog.outl("  bool get_message_ids(const etl::message_id_t*& p_ids, size_t& n_ids) const")
+      cog.outl("  {")
+      cog.out("    static const etl::message_id_t ids[] = { ")
+      for n in range(1, int(Handlers) + 1):
+          cog.out("T%d::ID" % n)
+          if n < int(Handlers):
+              cog.out(", ")
+          if (n % 8 == 0) and (n < int(Handlers)):
+              cog.outl("")
+              cog.out("                                             ")
+      cog.outl(" };")
+      cog.outl("")
+      cog.outl("    p_ids = ids;")
+      cog.outl("    n_ids = sizeof(ids) / sizeof(ids[0]);")
+      cog.outl("")
+      cog.outl("    return true;")
+      cog.outl("  }")
+      cog.outl("")
+      cog.outl("  //********************************************")
       cog.outl("  bool is_null_router() const")
       cog.outl("  {")
       cog.outl("    return false;")
@@ -632,6 +1244,25 @@ namespace etl
           cog.outl("  }")
           cog.outl("")
           cog.outl("  //********************************************")
+          cog.outl("  bool get_message_ids(const etl::message_id_t*& p_ids, size_t& n_ids) const")
+          cog.outl("  {")
+          cog.out("    static const etl::message_id_t ids[] = { ")
+          for t in range(1, n + 1):
+              cog.out("T%d::ID" % t)
+              if t < n:
+                  cog.out(", ")
+              if (t % 8 == 0) and (t < n):
+                  cog.outl("")
+                  cog.out("                                             ")
+          cog.outl(" };")
+          cog.outl("")
+          cog.outl("    p_ids = ids;")
+          cog.outl("    n_ids = sizeof(ids) / sizeof(ids[0]);")
+          cog.outl("")
+          cog.outl("    return true;")
+          cog.outl("  }")
+          cog.outl("")
+          cog.outl("  //********************************************")
           cog.outl("  bool is_null_router() const")
           cog.outl("  {")
           cog.outl("    return false;")
@@ -639,6 +1270,7 @@ namespace etl
           cog.outl("};")
   ]]]*/
   /*[[[end]]]*/
+#endif
 }
 
 #undef ETL_FILE
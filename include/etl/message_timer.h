@@ -55,7 +55,7 @@ SOFTWARE.
 
 #if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK)
   #define ETL_DISABLE_TIMER_UPDATES (++process_semaphore)
-  #define ETL_ENABLE_TIMER_UPDATES  (--process_semaphore)
+  #define ETL_ENABLE_TIMER_UPDATES  (release_timer_updates())
   #define ETL_TIMER_UPDATES_ENABLED (process_semaphore.load() == 0)
 #endif
 
@@ -81,6 +81,7 @@ namespace etl
         p_router(nullptr),
         period(0),
         delta(etl::timer::state::INACTIVE),
+        slack(0),
         destination_router_id(etl::imessage_bus::ALL_MESSAGE_ROUTERS),
         id(etl::timer::id::NO_TIMER),
         previous(etl::timer::id::NO_TIMER),
@@ -100,6 +101,7 @@ namespace etl
         p_router(&irouter_),
         period(period_),
         delta(etl::timer::state::INACTIVE),
+        slack(0),
         destination_router_id(destination_router_id_),
         id(id_),
         previous(etl::timer::id::NO_TIMER),
@@ -128,6 +130,7 @@ namespace etl
     etl::imessage_router*    p_router;
     uint32_t                 period;
     uint32_t                 delta;
+    uint32_t                 slack;
     etl::message_router_id_t destination_router_id;
     etl::timer::id::type     id;
     uint_least8_t            previous;
@@ -268,6 +271,40 @@ namespace etl
         timer.delta    = etl::timer::state::INACTIVE;
       }
 
+      //*******************************
+      // The ticks until the list must be serviced, allowing each
+      // timer to be late by up to its slack.
+      //*******************************
+      uint32_t next_expiry() const
+      {
+        uint32_t best = etl::timer::interval::NO_ACTIVE_INTERVAL;
+        uint32_t time = 0;
+
+        etl::timer::id::type id = head;
+
+        while (id != etl::timer::id::NO_TIMER)
+        {
+          const etl::message_timer_data& timer = ptimers[id];
+
+          time += timer.delta;
+
+          // Later timers cannot be due any earlier.
+          if (time >= best)
+          {
+            break;
+          }
+
+          if ((best - time) > timer.slack)
+          {
+            best = time + timer.slack;
+          }
+
+          id = timer.next;
+        }
+
+        return best;
+      }
+
       //*******************************
       etl::message_timer_data& front()
       {
@@ -434,55 +471,44 @@ namespace etl
     //*******************************************
     // Called by the timer service to indicate the
     // amount of time that has elapsed since the last successful call to 'tick'.
-    // Returns true if the tick was processed,
-    // false if not.
+    // Returns true if the tick was accepted,
+    // false if the timers are disabled.
+    // If another thread is updating the timers then the ticks
+    // are held, and are processed when the update is complete.
     //*******************************************
     bool tick(uint32_t count)
     {
       if (enabled)
       {
-        if ETL_IF_CONSTEXPR(ETL_TIMER_UPDATES_ENABLED)
-        {
-          // We have something to do?
-          bool has_active = !active_list.empty();
-
-          if (has_active)
-          {
-            while (has_active && (count >= active_list.front().delta))
-            {
-              etl::message_timer_data& timer = active_list.front();
-
-              count -= timer.delta;
-
-              active_list.remove(timer.id, true);
-
-              if (timer.repeating)
-              {
-                timer.delta = timer.period;
-                active_list.insert(timer.id);
-              }
-
-              if (timer.p_router != nullptr)
-              {
-                static etl::null_message_router nmr;
-                timer.p_router->receive(nmr, timer.destination_router_id, *(timer.p_message));
-              }
-
-              has_active = !active_list.empty();
-            }
+#if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK)
+        pending_ticks += count;
+        process_pending_ticks();
+#else
+        process_ticks(count);
+#endif
+        return true;
+      }
 
-            if (has_active)
-            {
-              // Subtract any remainder from the next due timeout.
-              active_list.front().delta -= count;
-            }
-          }
+      return false;
+    }
 
-          return true;
-        }
+    //*******************************************
+    /// Returns the number of ticks until 'tick' must next be called, or
+    /// etl::timer::interval::NO_ACTIVE_INTERVAL if no timers are active.
+    /// A timer with slack may be serviced up to 'slack' ticks late, so that
+    /// deadlines that are close together are handled by one call to 'tick'.
+    /// Returns 0 if the timers are being updated.
+    /// If a timer is started while the timer service is waiting then the
+    /// service should be woken to ask again.
+    //*******************************************
+    uint32_t time_to_next_expiry() const
+    {
+      if (ETL_TIMER_UPDATES_ENABLED)
+      {
+        return active_list.next_expiry();
       }
 
-      return false;
+      return 0;
     }
 
     //*******************************************
@@ -578,6 +604,28 @@ namespace etl
       return false;
     }
 
+    //*******************************************
+    /// Sets the number of ticks that a timer may be serviced late.
+    /// Used by time_to_next_expiry to coalesce deadlines.
+    //*******************************************
+    bool set_slack(etl::timer::id::type id_, uint32_t slack_)
+    {
+      // Valid timer id?
+      if (id_ != etl::timer::id::NO_TIMER)
+      {
+        etl::message_timer_data& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != etl::timer::id::NO_TIMER)
+        {
+          timer.slack = slack_;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
   protected:
 
     //*******************************************
@@ -589,6 +637,7 @@ namespace etl
         enabled(false),
 #if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK)
         process_semaphore(0),
+        pending_ticks(0),
 #endif
         registered_timers(0),
         MAX_TIMERS(MAX_TIMERS_)
@@ -604,6 +653,80 @@ namespace etl
 
   private:
 
+    //*******************************************
+    /// Processes the elapsed ticks.
+    //*******************************************
+    void process_ticks(uint32_t count)
+    {
+      // We have something to do?
+      bool has_active = !active_list.empty();
+
+      if (has_active)
+      {
+        while (has_active && (count >= active_list.front().delta))
+        {
+          etl::message_timer_data& timer = active_list.front();
+
+          count -= timer.delta;
+
+          active_list.remove(timer.id, true);
+
+          if (timer.repeating)
+          {
+            timer.delta = timer.period;
+            active_list.insert(timer.id);
+          }
+
+          if (timer.p_router != nullptr)
+          {
+            static etl::null_message_router nmr;
+            timer.p_router->receive(nmr, timer.destination_router_id, *(timer.p_message));
+          }
+
+          has_active = !active_list.empty();
+        }
+
+        if (has_active)
+        {
+          // Subtract any remainder from the next due timeout.
+          active_list.front().delta -= count;
+        }
+      }
+    }
+
+#if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK)
+    //*******************************************
+    /// Processes the pending ticks if no other thread is updating the
+    /// timers. If one is, then it will process them when it has finished.
+    //*******************************************
+    void process_pending_ticks()
+    {
+      bool retry = true;
+
+      while (retry)
+      {
+        if (++process_semaphore == 1)
+        {
+          process_ticks(pending_ticks.exchange(0));
+        }
+
+        // Ticks that arrived while the timers were being updated.
+        retry = (--process_semaphore == 0) && (pending_ticks.load() != 0);
+      }
+    }
+
+    //*******************************************
+    /// Ends an update, processing any ticks that arrived during it.
+    //*******************************************
+    void release_timer_updates()
+    {
+      if ((--process_semaphore == 0) && (pending_ticks.load() != 0))
+      {
+        process_pending_ticks();
+      }
+    }
+#endif
+
     // The array of timer data structures.
     message_timer_data* const timer_array;
 
@@ -614,6 +737,7 @@ namespace etl
 
 #if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK)
     volatile etl::timer_semaphore_t process_semaphore;
+    etl::atomic_uint32_t pending_ticks;
 #endif
     volatile uint_least8_t registered_timers;
 
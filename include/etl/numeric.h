@@ -32,6 +32,13 @@ SOFTWARE.
 #define ETL_NUMERIC_INCLUDED
 
 #include "platform.h"
+#include "type_traits.h"
+#include "static_assert.h"
+#include "iterator.h"
+
+#include "stl/iterator.h"
+
+#include "private/algorithm_simd.h"
 
 ///\defgroup numeric numeric
 ///\ingroup utilities
@@ -54,7 +61,732 @@ namespace etl
       *first++ = value++;
     }
   }
-}
 
+  namespace execution
+  {
+    //*************************************************************************
+    /// Strict left to right evaluation, as std::accumulate and std::partial_sum.
+    /// Floating point results are reproducible.
+    ///\ingroup numeric
+    //*************************************************************************
+    struct sequenced_policy
+    {
+    };
+
+    //*************************************************************************
+    /// The operation may be reordered.
+    /// Unrolled with multiple accumulators and, for the default operations
+    /// over arithmetic types, vectorised. The same as the overloads without a policy.
+    ///\ingroup numeric
+    //*************************************************************************
+    struct unsequenced_policy
+    {
+    };
+
+    //*************************************************************************
+    /// The range is split into chunks of CHUNK_SIZE elements. Each is evaluated
+    /// as unsequenced_policy and the partial results are combined in order.
+    /// Floating point rounding error grows with the chunk size, not the range length.
+    ///\ingroup numeric
+    //*************************************************************************
+    template <const size_t CHUNK_SIZE = 1024U>
+    struct chunked_policy
+    {
+      ETL_STATIC_ASSERT(CHUNK_SIZE > 0U, "Chunk size must be greater than zero");
+
+      static const size_t Chunk_Size = CHUNK_SIZE;
+    };
+
+    const sequenced_policy   seq     = sequenced_policy();
+    const unsequenced_policy unseq   = unsequenced_policy();
+    const chunked_policy<>   chunked = chunked_policy<>();
+
+    //*************************************************************************
+    /// is_execution_policy
+    ///\ingroup numeric
+    //*************************************************************************
+    template <typename T>
+    struct is_execution_policy : etl::false_type {};
+
+    template <>
+    struct is_execution_policy<sequenced_policy> : etl::true_type {};
+
+    template <>
+    struct is_execution_policy<unsequenced_policy> : etl::true_type {};
+
+    template <const size_t CHUNK_SIZE>
+    struct is_execution_policy<chunked_policy<CHUNK_SIZE> > : etl::true_type {};
+  }
+
+  namespace private_numeric
+  {
+    //*************************************************************************
+    /// The default reduction. Vectorised when it is the operation.
+    //*************************************************************************
+    template <typename T>
+    struct plus
+    {
+      template <typename U>
+      T operator()(const T& lhs, const U& rhs) const
+      {
+        return T(lhs + rhs);
+      }
+    };
+
+    //*************************************************************************
+    /// The default transform for transform_reduce.
+    //*************************************************************************
+    template <typename T>
+    struct multiplies
+    {
+      template <typename U1, typename U2>
+      T operator()(const U1& lhs, const U2& rhs) const
+      {
+        return T(lhs * rhs);
+      }
+    };
+
+    //*************************************************************************
+    /// The transform for reduce.
+    //*************************************************************************
+    struct identity
+    {
+      template <typename U>
+      const U& operator()(const U& value) const
+      {
+        return value;
+      }
+    };
+
+    //*************************************************************************
+    /// The iterator after 'itr'.
+    //*************************************************************************
+    template <typename TIterator>
+    TIterator successor(TIterator itr)
+    {
+      return ++itr;
+    }
+
+    //*************************************************************************
+    /// Advance 'itr' by up to 'n' elements, stopping at 'last'.
+    //*************************************************************************
+    template <typename TIterator>
+    TIterator advance_up_to(TIterator itr, TIterator last, size_t n, std::random_access_iterator_tag)
+    {
+      return (size_t(last - itr) < n) ? last : itr + n;
+    }
+
+    template <typename TIterator>
+    TIterator advance_up_to(TIterator itr, TIterator last, size_t n, std::input_iterator_tag)
+    {
+      while ((n-- != 0U) && (itr != last))
+      {
+        ++itr;
+      }
+
+      return itr;
+    }
+
+    template <typename TIterator>
+    TIterator advance_up_to(TIterator itr, TIterator last, size_t n)
+    {
+      return advance_up_to(itr, last, n, typename std::iterator_traits<TIterator>::iterator_category());
+    }
+
+    //*************************************************************************
+    /// Strict left to right transform_reduce.
+    //*************************************************************************
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_sequential(TIterator first, TIterator last, T init, TReduce reduce, TTransform transform)
+    {
+      while (first != last)
+      {
+        init = reduce(init, transform(*first));
+        ++first;
+      }
+
+      return init;
+    }
+
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_sequential(TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform)
+    {
+      while (first1 != last1)
+      {
+        init = reduce(init, transform(*first1, *first2));
+        ++first1;
+        ++first2;
+      }
+
+      return init;
+    }
+
+    //*************************************************************************
+    /// transform_reduce with four independent accumulators.
+    //*************************************************************************
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unrolled(TIterator first, TIterator last, T init, TReduce reduce, TTransform transform, std::random_access_iterator_tag)
+    {
+      if ((last - first) >= 4)
+      {
+        T sum0 = reduce(init, transform(*first));
+        T sum1 = transform(*(first + 1));
+        T sum2 = transform(*(first + 2));
+        T sum3 = transform(*(first + 3));
+        first += 4;
+
+        while ((last - first) >= 4)
+        {
+          sum0 = reduce(sum0, transform(*first));
+          sum1 = reduce(sum1, transform(*(first + 1)));
+          sum2 = reduce(sum2, transform(*(first + 2)));
+          sum3 = reduce(sum3, transform(*(first + 3)));
+          first += 4;
+        }
+
+        init = reduce(reduce(sum0, sum1), reduce(sum2, sum3));
+      }
+
+      return transform_reduce_sequential(first, last, init, reduce, transform);
+    }
+
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unrolled(TIterator first, TIterator last, T init, TReduce reduce, TTransform transform, std::input_iterator_tag)
+    {
+      return transform_reduce_sequential(first, last, init, reduce, transform);
+    }
+
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unrolled(TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform, std::random_access_iterator_tag)
+    {
+      if ((last1 - first1) >= 4)
+      {
+        T sum0 = reduce(init, transform(*first1, *first2));
+        T sum1 = transform(*(first1 + 1), *(first2 + 1));
+        T sum2 = transform(*(first1 + 2), *(first2 + 2));
+        T sum3 = transform(*(first1 + 3), *(first2 + 3));
+        first1 += 4;
+        first2 += 4;
+
+        while ((last1 - first1) >= 4)
+        {
+          sum0 = reduce(sum0, transform(*first1,       *first2));
+          sum1 = reduce(sum1, transform(*(first1 + 1), *(first2 + 1)));
+          sum2 = reduce(sum2, transform(*(first1 + 2), *(first2 + 2)));
+          sum3 = reduce(sum3, transform(*(first1 + 3), *(first2 + 3)));
+          first1 += 4;
+          first2 += 4;
+        }
+
+        init = reduce(reduce(sum0, sum1), reduce(sum2, sum3));
+      }
+
+      return transform_reduce_sequential(first1, last1, first2, init, reduce, transform);
+    }
+
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unrolled(TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform, std::input_iterator_tag)
+    {
+      return transform_reduce_sequential(first1, last1, first2, init, reduce, transform);
+    }
+
+    //*************************************************************************
+    /// True if the default reduction of TIterator into a T is vectorised.
+    //*************************************************************************
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    struct is_sum_vectorisable
+      : etl::integral_constant<bool, private_algorithm_simd::is_vectorisable<TIterator, T>::value &&
+                                     etl::is_same<TReduce, plus<T> >::value &&
+                                     etl::is_same<TTransform, identity>::value>
+    {
+    };
+
+    //*************************************************************************
+    /// True if the default inner product of TIterator1 and TIterator2 into a T is vectorised.
+    //*************************************************************************
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    struct is_inner_product_vectorisable
+      : etl::integral_constant<bool, private_algorithm_simd::are_vectorisable<TIterator1, TIterator2>::value &&
+                                     private_algorithm_simd::is_vectorisable<TIterator1, T>::value &&
+                                     etl::is_floating_point<T>::value &&
+                                     etl::is_same<TReduce, plus<T> >::value &&
+                                     etl::is_same<TTransform, multiplies<T> >::value>
+    {
+    };
+
+    //*************************************************************************
+    /// True if the default scan from TInputIterator to TOutputIterator with a T is vectorised.
+    //*************************************************************************
+    template <typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+    struct is_scan_vectorisable
+      : etl::integral_constant<bool, private_algorithm_simd::is_vectorisable<TInputIterator, T>::value &&
+                                     etl::is_same<TOutputIterator, T*>::value &&
+                                     etl::is_integral<T>::value &&
+                                     (sizeof(T) == 4U) &&
+                                     etl::is_same<TBinaryOp, plus<T> >::value>
+    {
+    };
+
+    //*************************************************************************
+    /// Unsequenced transform_reduce.
+    //*************************************************************************
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unsequenced(TIterator first, TIterator last, T init, TReduce reduce, TTransform transform, etl::false_type /*vectorised*/)
+    {
+      return transform_reduce_unrolled(first, last, init, reduce, transform, typename std::iterator_traits<TIterator>::iterator_category());
+    }
+
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unsequenced(TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform, etl::false_type /*vectorised*/)
+    {
+      return transform_reduce_unrolled(first1, last1, first2, init, reduce, transform, typename std::iterator_traits<TIterator1>::iterator_category());
+    }
+
+#if ETL_SIMD_SUPPORTED
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unsequenced(TIterator first, TIterator last, T init, TReduce, TTransform, etl::true_type /*vectorised*/)
+    {
+      return private_algorithm_simd::sum<T>(first, last, init);
+    }
+
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unsequenced(TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce, TTransform, etl::true_type /*vectorised*/)
+    {
+      return private_algorithm_simd::inner_product<T>(first1, last1, first2, init);
+    }
 #endif
 
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unsequenced(TIterator first, TIterator last, T init, TReduce reduce, TTransform transform)
+    {
+      typedef etl::integral_constant<bool, is_sum_vectorisable<TIterator, T, TReduce, TTransform>::value> vectorised;
+
+      return transform_reduce_unsequenced(first, last, init, reduce, transform, vectorised());
+    }
+
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce_unsequenced(TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform)
+    {
+      typedef etl::integral_constant<bool, is_inner_product_vectorisable<TIterator1, TIterator2, T, TReduce, TTransform>::value> vectorised;
+
+      return transform_reduce_unsequenced(first1, last1, first2, init, reduce, transform, vectorised());
+    }
+
+    //*************************************************************************
+    /// transform_reduce for each execution policy.
+    //*************************************************************************
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce(const etl::execution::sequenced_policy&, TIterator first, TIterator last, T init, TReduce reduce, TTransform transform)
+    {
+      return transform_reduce_sequential(first, last, init, reduce, transform);
+    }
+
+    template <typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce(const etl::execution::unsequenced_policy&, TIterator first, TIterator last, T init, TReduce reduce, TTransform transform)
+    {
+      return transform_reduce_unsequenced(first, last, init, reduce, transform);
+    }
+
+    template <const size_t CHUNK_SIZE, typename TIterator, typename T, typename TReduce, typename TTransform>
+    T transform_reduce(const etl::execution::chunked_policy<CHUNK_SIZE>&, TIterator first, TIterator last, T init, TReduce reduce, TTransform transform)
+    {
+      while (first != last)
+      {
+        const TIterator chunk_last = advance_up_to(first, last, CHUNK_SIZE);
+
+        // Each chunk is seeded with its first element, as the operation need not have an identity.
+        const T partial = transform_reduce_unsequenced(successor(first), chunk_last, T(transform(*first)), reduce, transform);
+        init  = reduce(init, partial);
+        first = chunk_last;
+      }
+
+      return init;
+    }
+
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce(const etl::execution::sequenced_policy&, TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform)
+    {
+      return transform_reduce_sequential(first1, last1, first2, init, reduce, transform);
+    }
+
+    template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce(const etl::execution::unsequenced_policy&, TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform)
+    {
+      return transform_reduce_unsequenced(first1, last1, first2, init, reduce, transform);
+    }
+
+    template <const size_t CHUNK_SIZE, typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+    T transform_reduce(const etl::execution::chunked_policy<CHUNK_SIZE>&, TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform)
+    {
+      while (first1 != last1)
+      {
+        const TIterator1 chunk_last = advance_up_to(first1, last1, CHUNK_SIZE);
+
+        const T partial = transform_reduce_unsequenced(successor(first1), chunk_last, successor(first2), T(transform(*first1, *first2)), reduce, transform);
+        init = reduce(init, partial);
+
+        std::advance(first2, std::distance(first1, chunk_last));
+        first1 = chunk_last;
+      }
+
+      return init;
+    }
+
+    //*************************************************************************
+    /// Strict left to right scan, starting from 'carry'.
+    /// 'carry' is updated to the reduction of the range.
+    //*************************************************************************
+    template <bool EXCLUSIVE, typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+    TOutputIterator scan_sequential(TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op, T& carry)
+    {
+      while (first != last)
+      {
+        // Read before writing, as the scan may be in place.
+        const T next = op(carry, *first);
+
+        *d_first = EXCLUSIVE ? carry : next;
+        carry    = next;
+
+        ++first;
+        ++d_first;
+      }
+
+      return d_first;
+    }
+
+    template <bool EXCLUSIVE, typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+    TOutputIterator scan_unsequenced(TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op, T& carry, etl::false_type /*vectorised*/)
+    {
+      return scan_sequential<EXCLUSIVE>(first, last, d_first, op, carry);
+    }
+
+#if ETL_SIMD_SUPPORTED
+    template <bool EXCLUSIVE, typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+    TOutputIterator scan_unsequenced(TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp, T& carry, etl::true_type /*vectorised*/)
+    {
+      return private_algorithm_simd::scan<EXCLUSIVE, T>(first, last, d_first, carry);
+    }
+#endif
+
+    template <bool EXCLUSIVE, typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+    TOutputIterator scan_unsequenced(TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op, T& carry)
+    {
+      typedef etl::integral_constant<bool, is_scan_vectorisable<TInputIterator, TOutputIterator, T, TBinaryOp>::value> vectorised;
+
+      return scan_unsequenced<EXCLUSIVE>(first, last, d_first, op, carry, vectorised());
+    }
+
+    //*************************************************************************
+    /// Scan for each execution policy.
+    //*************************************************************************
+    template <bool EXCLUSIVE, typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+    TOutputIterator scan(const etl::execution::sequenced_policy&, TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op, T carry)
+    {
+      return scan_sequential<EXCLUSIVE>(first, last, d_first, op, carry);
+    }
+
+    template <bool EXCLUSIVE, typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+    TOutputIterator scan(const etl::execution::unsequenced_policy&, TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op, T carry)
+    {
+      return scan_unsequenced<EXCLUSIVE>(first, last, d_first, op, carry);
+    }
+
+    template <bool EXCLUSIVE, const size_t CHUNK_SIZE, typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+    TOutputIterator scan(const etl::execution::chunked_policy<CHUNK_SIZE>&, TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op, T carry)
+    {
+      // The carry out of each chunk is the partial result passed to the next.
+      while (first != last)
+      {
+        const TInputIterator chunk_last = advance_up_to(first, last, CHUNK_SIZE);
+
+        d_first = scan_unsequenced<EXCLUSIVE>(first, chunk_last, d_first, op, carry);
+        first   = chunk_last;
+      }
+
+      return d_first;
+    }
+
+    //*************************************************************************
+    /// Inclusive scan without an initial value.
+    /// The first element starts the scan.
+    //*************************************************************************
+    template <typename TPolicy, typename TInputIterator, typename TOutputIterator, typename TBinaryOp>
+    TOutputIterator inclusive_scan(const TPolicy& policy, TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op)
+    {
+      typedef typename std::iterator_traits<TInputIterator>::value_type value_t;
+
+      if (first == last)
+      {
+        return d_first;
+      }
+
+      const value_t init = *first;
+      *d_first = init;
+
+      return scan<false>(policy, successor(first), last, successor(d_first), op, init);
+    }
+  }
+
+  //***************************************************************************
+  /// Computes the inclusive prefix sums of the range.
+  /// Vectorised for pointers to 32 bit integral types.
+  ///\param first   An iterator to the first element.
+  ///\param last    An iterator to the last + 1 element.
+  ///\param d_first The destination. May be 'first'.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TInputIterator, typename TOutputIterator>
+  TOutputIterator inclusive_scan(TInputIterator first, TInputIterator last, TOutputIterator d_first)
+  {
+    typedef typename std::iterator_traits<TInputIterator>::value_type value_t;
+
+    return private_numeric::inclusive_scan(etl::execution::unseq, first, last, d_first, private_numeric::plus<value_t>());
+  }
+
+  //***************************************************************************
+  /// Computes the inclusive scan of the range with 'op'.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TInputIterator, typename TOutputIterator, typename TBinaryOp>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TInputIterator>::value, TOutputIterator>::type
+    inclusive_scan(TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op)
+  {
+    return private_numeric::inclusive_scan(etl::execution::unseq, first, last, d_first, op);
+  }
+
+  //***************************************************************************
+  /// Computes the inclusive scan of the range with 'op', starting from 'init'.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TInputIterator, typename TOutputIterator, typename TBinaryOp, typename T>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TInputIterator>::value, TOutputIterator>::type
+    inclusive_scan(TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op, T init)
+  {
+    return private_numeric::scan<false>(etl::execution::unseq, first, last, d_first, op, init);
+  }
+
+  //***************************************************************************
+  /// Computes the inclusive prefix sums of the range under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TInputIterator, typename TOutputIterator>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, TOutputIterator>::type
+    inclusive_scan(const TPolicy& policy, TInputIterator first, TInputIterator last, TOutputIterator d_first)
+  {
+    typedef typename std::iterator_traits<TInputIterator>::value_type value_t;
+
+    return private_numeric::inclusive_scan(policy, first, last, d_first, private_numeric::plus<value_t>());
+  }
+
+  //***************************************************************************
+  /// Computes the inclusive scan of the range with 'op' under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TInputIterator, typename TOutputIterator, typename TBinaryOp>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, TOutputIterator>::type
+    inclusive_scan(const TPolicy& policy, TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op)
+  {
+    return private_numeric::inclusive_scan(policy, first, last, d_first, op);
+  }
+
+  //***************************************************************************
+  /// Computes the inclusive scan of the range with 'op', starting from 'init', under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TInputIterator, typename TOutputIterator, typename TBinaryOp, typename T>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, TOutputIterator>::type
+    inclusive_scan(const TPolicy& policy, TInputIterator first, TInputIterator last, TOutputIterator d_first, TBinaryOp op, T init)
+  {
+    return private_numeric::scan<false>(policy, first, last, d_first, op, init);
+  }
+
+  //***************************************************************************
+  /// Computes the exclusive prefix sums of the range, starting from 'init'.
+  /// Vectorised for pointers to 32 bit integral types.
+  ///\param first   An iterator to the first element.
+  ///\param last    An iterator to the last + 1 element.
+  ///\param d_first The destination. May be 'first'.
+  ///\param init    The first output value.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TInputIterator, typename TOutputIterator, typename T>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TInputIterator>::value, TOutputIterator>::type
+    exclusive_scan(TInputIterator first, TInputIterator last, TOutputIterator d_first, T init)
+  {
+    return private_numeric::scan<true>(etl::execution::unseq, first, last, d_first, private_numeric::plus<T>(), init);
+  }
+
+  //***************************************************************************
+  /// Computes the exclusive scan of the range with 'op', starting from 'init'.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TInputIterator>::value, TOutputIterator>::type
+    exclusive_scan(TInputIterator first, TInputIterator last, TOutputIterator d_first, T init, TBinaryOp op)
+  {
+    return private_numeric::scan<true>(etl::execution::unseq, first, last, d_first, op, init);
+  }
+
+  //***************************************************************************
+  /// Computes the exclusive prefix sums of the range, starting from 'init', under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TInputIterator, typename TOutputIterator, typename T>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, TOutputIterator>::type
+    exclusive_scan(const TPolicy& policy, TInputIterator first, TInputIterator last, TOutputIterator d_first, T init)
+  {
+    return private_numeric::scan<true>(policy, first, last, d_first, private_numeric::plus<T>(), init);
+  }
+
+  //***************************************************************************
+  /// Computes the exclusive scan of the range with 'op', starting from 'init', under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TInputIterator, typename TOutputIterator, typename T, typename TBinaryOp>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, TOutputIterator>::type
+    exclusive_scan(const TPolicy& policy, TInputIterator first, TInputIterator last, TOutputIterator d_first, T init, TBinaryOp op)
+  {
+    return private_numeric::scan<true>(policy, first, last, d_first, op, init);
+  }
+
+  //***************************************************************************
+  /// Sums the range.
+  /// The additions may be reordered. Vectorised for pointers to arithmetic types.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TIterator>
+  typename std::iterator_traits<TIterator>::value_type reduce(TIterator first, TIterator last)
+  {
+    typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+    return private_numeric::transform_reduce_unsequenced(first, last, value_t(), private_numeric::plus<value_t>(), private_numeric::identity());
+  }
+
+  //***************************************************************************
+  /// Sums the range, starting from 'init'.
+  /// The additions may be reordered. Vectorised for pointers to arithmetic types the same as 'init'.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TIterator, typename T>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TIterator>::value, T>::type
+    reduce(TIterator first, TIterator last, T init)
+  {
+    return private_numeric::transform_reduce_unsequenced(first, last, init, private_numeric::plus<T>(), private_numeric::identity());
+  }
+
+  //***************************************************************************
+  /// Reduces the range with 'op', starting from 'init'.
+  /// 'op' must be associative and commutative.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TIterator, typename T, typename TBinaryOp>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TIterator>::value, T>::type
+    reduce(TIterator first, TIterator last, T init, TBinaryOp op)
+  {
+    return private_numeric::transform_reduce_unsequenced(first, last, init, op, private_numeric::identity());
+  }
+
+  //***************************************************************************
+  /// Sums the range under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TIterator>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, typename std::iterator_traits<TIterator>::value_type>::type
+    reduce(const TPolicy& policy, TIterator first, TIterator last)
+  {
+    typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+    return private_numeric::transform_reduce(policy, first, last, value_t(), private_numeric::plus<value_t>(), private_numeric::identity());
+  }
+
+  //***************************************************************************
+  /// Sums the range, starting from 'init', under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TIterator, typename T>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, T>::type
+    reduce(const TPolicy& policy, TIterator first, TIterator last, T init)
+  {
+    return private_numeric::transform_reduce(policy, first, last, init, private_numeric::plus<T>(), private_numeric::identity());
+  }
+
+  //***************************************************************************
+  /// Reduces the range with 'op', starting from 'init', under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TIterator, typename T, typename TBinaryOp>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, T>::type
+    reduce(const TPolicy& policy, TIterator first, TIterator last, T init, TBinaryOp op)
+  {
+    return private_numeric::transform_reduce(policy, first, last, init, op, private_numeric::identity());
+  }
+
+  //***************************************************************************
+  /// The inner product of two ranges, starting from 'init'.
+  /// The additions may be reordered. Vectorised for pointers to float or double the same as 'init'.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TIterator1, typename TIterator2, typename T>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TIterator1>::value, T>::type
+    transform_reduce(TIterator1 first1, TIterator1 last1, TIterator2 first2, T init)
+  {
+    return private_numeric::transform_reduce_unsequenced(first1, last1, first2, init, private_numeric::plus<T>(), private_numeric::multiplies<T>());
+  }
+
+  //***************************************************************************
+  /// Reduces the results of 'transform' over two ranges with 'reduce', starting from 'init'.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TIterator1>::value, T>::type
+    transform_reduce(TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform)
+  {
+    return private_numeric::transform_reduce_unsequenced(first1, last1, first2, init, reduce, transform);
+  }
+
+  //***************************************************************************
+  /// Reduces the results of 'transform' over the range with 'reduce', starting from 'init'.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TIterator, typename T, typename TReduce, typename TTransform>
+  typename etl::enable_if<!etl::execution::is_execution_policy<TIterator>::value, T>::type
+    transform_reduce(TIterator first, TIterator last, T init, TReduce reduce, TTransform transform)
+  {
+    return private_numeric::transform_reduce_unsequenced(first, last, init, reduce, transform);
+  }
+
+  //***************************************************************************
+  /// The inner product of two ranges, starting from 'init', under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TIterator1, typename TIterator2, typename T>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, T>::type
+    transform_reduce(const TPolicy& policy, TIterator1 first1, TIterator1 last1, TIterator2 first2, T init)
+  {
+    return private_numeric::transform_reduce(policy, first1, last1, first2, init, private_numeric::plus<T>(), private_numeric::multiplies<T>());
+  }
+
+  //***************************************************************************
+  /// Reduces the results of 'transform' over two ranges with 'reduce', starting from 'init', under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TIterator1, typename TIterator2, typename T, typename TReduce, typename TTransform>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, T>::type
+    transform_reduce(const TPolicy& policy, TIterator1 first1, TIterator1 last1, TIterator2 first2, T init, TReduce reduce, TTransform transform)
+  {
+    return private_numeric::transform_reduce(policy, first1, last1, first2, init, reduce, transform);
+  }
+
+  //***************************************************************************
+  /// Reduces the results of 'transform' over the range with 'reduce', starting from 'init', under an execution policy.
+  ///\ingroup numeric
+  //***************************************************************************
+  template <typename TPolicy, typename TIterator, typename T, typename TReduce, typename TTransform>
+  typename etl::enable_if<etl::execution::is_execution_policy<TPolicy>::value, T>::type
+    transform_reduce(const TPolicy& policy, TIterator first, TIterator last, T init, TReduce reduce, TTransform transform)
+  {
+    return private_numeric::transform_reduce(policy, first, last, init, reduce, transform);
+  }
+}
+
+#endif
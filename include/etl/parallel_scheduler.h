@@ -0,0 +1,496 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_PARALLEL_SCHEDULER_INCLUDED
+#define ETL_PARALLEL_SCHEDULER_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "scheduler.h"
+#include "task.h"
+#include "vector.h"
+#include "power.h"
+#include "nullptr.h"
+#include "function.h"
+#include "static_assert.h"
+#include "error_handler.h"
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_NO_STL)
+  #define ETL_HAS_PARALLEL_SCHEDULER 1
+#else
+  #define ETL_HAS_PARALLEL_SCHEDULER 0
+#endif
+
+#if ETL_HAS_PARALLEL_SCHEDULER
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#undef ETL_FILE
+#define ETL_FILE "55"
+
+namespace etl
+{
+  namespace private_parallel_scheduler
+  {
+    //*************************************************************************
+    /// A fixed capacity Chase-Lev work stealing deque.
+    /// The owning thread pushes and pops at the bottom.
+    /// Any other thread may steal from the top.
+    /// \tparam T    The type of pointer held.
+    /// \tparam SIZE The capacity. Must be a power of two.
+    //*************************************************************************
+    template <typename T, const size_t SIZE>
+    class work_stealing_deque
+    {
+    public:
+
+      ETL_STATIC_ASSERT(((SIZE & (SIZE - 1)) == 0), "SIZE must be a power of two");
+
+      work_stealing_deque()
+        : top(0),
+          bottom(0)
+      {
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+          buffer[i].store(nullptr, std::memory_order_relaxed);
+        }
+      }
+
+      //***********************************************************************
+      /// Pushes to the bottom. Owner only.
+      /// \return <b>false</b> if the deque is full.
+      //***********************************************************************
+      bool push(T* p)
+      {
+        ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+        ptrdiff_t t = top.load(std::memory_order_acquire);
+
+        if ((b - t) >= ptrdiff_t(SIZE))
+        {
+          return false;
+        }
+
+        buffer[b & MASK].store(p, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+
+        return true;
+      }
+
+      //***********************************************************************
+      /// Pops from the bottom. Owner only.
+      /// \return The item, or nullptr if the deque is empty.
+      //***********************************************************************
+      T* pop()
+      {
+        ptrdiff_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_seq_cst);
+        ptrdiff_t t = top.load(std::memory_order_seq_cst);
+
+        T* p = nullptr;
+
+        if (t <= b)
+        {
+          p = buffer[b & MASK].load(std::memory_order_relaxed);
+
+          if (t == b)
+          {
+            // The last item. Race any thieves for it.
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+              p = nullptr;
+            }
+
+            bottom.store(b + 1, std::memory_order_relaxed);
+          }
+        }
+        else
+        {
+          bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return p;
+      }
+
+      //***********************************************************************
+      /// Steals from the top. Any thread.
+      /// \return The item, or nullptr if the deque is empty or the steal lost a race.
+      //***********************************************************************
+      T* steal()
+      {
+        ptrdiff_t t = top.load(std::memory_order_seq_cst);
+        ptrdiff_t b = bottom.load(std::memory_order_seq_cst);
+
+        if (t < b)
+        {
+          T* p = buffer[t & MASK].load(std::memory_order_relaxed);
+
+          if (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          {
+            return p;
+          }
+        }
+
+        return nullptr;
+      }
+
+    private:
+
+      static const ptrdiff_t MASK = ptrdiff_t(SIZE - 1);
+
+      work_stealing_deque(const work_stealing_deque&);
+      work_stealing_deque& operator =(const work_stealing_deque&);
+
+      char                   padding0[ETL_CACHE_LINE_SIZE];
+      std::atomic<ptrdiff_t> top;    ///< Where thieves steal from.
+      char                   padding1[ETL_CACHE_LINE_SIZE];
+      std::atomic<ptrdiff_t> bottom; ///< Where the owner pushes and pops.
+      char                   padding2[ETL_CACHE_LINE_SIZE];
+      std::atomic<T*>        buffer[SIZE];
+    };
+  }
+
+  //***************************************************************************
+  /// A scheduler that runs its tasks on a fixed set of worker threads.
+  /// Each worker owns a work stealing deque of ready tasks. A worker runs the
+  /// tasks in its own deque, highest priority first, then steals from the other
+  /// workers, and when there is nothing to steal it polls the tasks that are not
+  /// owned by any worker with task_request_work, highest priority first, and
+  /// takes those that have work.
+  /// A task is owned by at most one worker at a time, so task_request_work and
+  /// task_process_work are never called concurrently for the same task, though
+  /// they may be called from any of the worker threads.
+  /// Each ready task has task_process_work called once before it is polled again.
+  /// start() runs worker 0 on the calling thread and starts the others.
+  /// The idle and watchdog callbacks are only called from the thread that called start().
+  /// \tparam MAX_TASKS_ The maximum number of tasks.
+  /// \tparam N_WORKERS_ The number of worker threads, including the thread that calls start().
+  //***************************************************************************
+  template <const size_t MAX_TASKS_, const size_t N_WORKERS_>
+  class parallel_scheduler
+  {
+  public:
+
+    enum
+    {
+      MAX_TASKS = MAX_TASKS_,
+      N_WORKERS = N_WORKERS_
+    };
+
+    ETL_STATIC_ASSERT((MAX_TASKS > 0), "MAX_TASKS must be greater than zero");
+    ETL_STATIC_ASSERT((N_WORKERS > 0), "N_WORKERS must be greater than zero");
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    parallel_scheduler()
+      : scheduler_running(false),
+        scheduler_exit(false),
+        p_idle_callback(nullptr),
+        p_watchdog_callback(nullptr)
+    {
+    }
+
+    //*******************************************
+    /// Set the idle callback.
+    /// Called when worker 0 finds no task with work.
+    //*******************************************
+    void set_idle_callback(etl::ifunction<void>& callback)
+    {
+      p_idle_callback = &callback;
+    }
+
+    //*******************************************
+    /// Set the watchdog callback.
+    /// Called by worker 0 after each pass.
+    //*******************************************
+    void set_watchdog_callback(etl::ifunction<void>& callback)
+    {
+      p_watchdog_callback = &callback;
+    }
+
+    //*******************************************
+    /// Set the running state for the scheduler.
+    /// The workers pause while it is not running.
+    //*******************************************
+    void set_scheduler_running(bool scheduler_running_)
+    {
+      scheduler_running.store(scheduler_running_, std::memory_order_relaxed);
+    }
+
+    //*******************************************
+    /// Get the running state for the scheduler.
+    //*******************************************
+    bool scheduler_is_running() const
+    {
+      return scheduler_running.load(std::memory_order_relaxed);
+    }
+
+    //*******************************************
+    /// Force the scheduler to exit.
+    /// May be called from any thread, including from a task.
+    //*******************************************
+    void exit_scheduler()
+    {
+      scheduler_exit.store(true, std::memory_order_relaxed);
+    }
+
+    //*******************************************
+    /// Add a task.
+    /// Add to the task list in priority order.
+    /// Tasks must be added before start() is called.
+    //*******************************************
+    void add_task(etl::task& task)
+    {
+      ETL_ASSERT(!task_list.full(), ETL_ERROR(etl::scheduler_too_many_tasks_exception));
+
+      if (!task_list.full())
+      {
+        typename task_list_t::iterator itask = std::upper_bound(task_list.begin(),
+                                                                task_list.end(),
+                                                                task.get_task_priority(),
+                                                                compare_priority());
+
+        task_list.insert(itask, &task);
+      }
+    }
+
+    //*******************************************
+    /// Add a task list.
+    /// Adds to the tasks to the internal task list in priority order.
+    /// Input order is ignored.
+    //*******************************************
+    template <typename TSize>
+    void add_task_list(etl::task** p_tasks, TSize size)
+    {
+      for (TSize i = 0; i < size; ++i)
+      {
+        ETL_ASSERT((p_tasks[i] != nullptr), ETL_ERROR(etl::scheduler_null_task_exception));
+        add_task(*(p_tasks[i]));
+      }
+    }
+
+    //*******************************************
+    /// Start the scheduler.
+    /// Returns when exit_scheduler() has been called and all of the workers have stopped.
+    //*******************************************
+    void start()
+    {
+      ETL_ASSERT(task_list.size() > 0, ETL_ERROR(etl::scheduler_no_tasks_exception));
+
+      for (size_t index = 0; index < task_list.size(); ++index)
+      {
+        slots[index].p_task = task_list[index];
+        slots[index].owned.store(false, std::memory_order_relaxed);
+      }
+
+      scheduler_running.store(true, std::memory_order_relaxed);
+
+      std::thread threads[N_WORKERS];
+
+      for (size_t w = 1; w < N_WORKERS; ++w)
+      {
+        threads[w] = std::thread(&parallel_scheduler::run_worker, this, w);
+      }
+
+      run_worker(0);
+
+      for (size_t w = 1; w < N_WORKERS; ++w)
+      {
+        threads[w].join();
+      }
+    }
+
+  private:
+
+    //*******************************************
+    /// A task and whether a worker owns it.
+    //*******************************************
+    struct slot
+    {
+      etl::task*        p_task;
+      std::atomic<bool> owned;
+    };
+
+    typedef private_parallel_scheduler::work_stealing_deque<slot, etl::power_of_2_round_up<MAX_TASKS>::value> deque_t;
+
+    //*******************************************
+    /// The loop run by each worker.
+    //*******************************************
+    void run_worker(size_t worker)
+    {
+      while (!scheduler_exit.load(std::memory_order_relaxed))
+      {
+        if (!scheduler_running.load(std::memory_order_relaxed))
+        {
+          std::this_thread::yield();
+          continue;
+        }
+
+        slot* p_slot = deques[worker].pop();
+
+        if (p_slot == nullptr)
+        {
+          p_slot = steal(worker);
+        }
+
+        if ((p_slot == nullptr) && poll_tasks(worker))
+        {
+          p_slot = deques[worker].pop();
+        }
+
+        bool idle = (p_slot == nullptr);
+
+        if (!idle)
+        {
+          p_slot->p_task->task_process_work();
+
+          // Let the task be polled again.
+          p_slot->owned.store(false, std::memory_order_release);
+        }
+
+        if (worker == 0)
+        {
+          if (p_watchdog_callback)
+          {
+            (*p_watchdog_callback)();
+          }
+
+          if (idle && p_idle_callback)
+          {
+            (*p_idle_callback)();
+          }
+        }
+
+        if (idle)
+        {
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    //*******************************************
+    /// Tries to steal a task from each of the other workers in turn.
+    //*******************************************
+    slot* steal(size_t worker)
+    {
+      for (size_t i = 1; i < N_WORKERS; ++i)
+      {
+        slot* p_slot = deques[(worker + i) % N_WORKERS].steal();
+
+        if (p_slot != nullptr)
+        {
+          return p_slot;
+        }
+      }
+
+      return nullptr;
+    }
+
+    //*******************************************
+    /// Takes ownership of the unowned tasks that have work and pushes them to
+    /// the worker's deque, so that the highest priority is popped first.
+    /// \return <b>true</b> if any tasks were taken.
+    //*******************************************
+    bool poll_tasks(size_t worker)
+    {
+      slot*  ready[MAX_TASKS];
+      size_t n_ready = 0;
+
+      for (size_t index = 0; index < task_list.size(); ++index)
+      {
+        slot& s = slots[index];
+
+        bool expected = false;
+
+        if (!s.owned.load(std::memory_order_relaxed) &&
+            s.owned.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+          if (s.p_task->task_request_work() > 0)
+          {
+            ready[n_ready++] = &s;
+          }
+          else
+          {
+            s.owned.store(false, std::memory_order_release);
+          }
+        }
+      }
+
+      // Lowest priority first, so that the highest is popped first and the
+      // lowest is at the top for thieves.
+      for (size_t i = n_ready; i > 0; --i)
+      {
+        deques[worker].push(ready[i - 1]);
+      }
+
+      return n_ready != 0;
+    }
+
+    //*******************************************
+    // Used to order tasks in descending priority.
+    //*******************************************
+    struct compare_priority
+    {
+      bool operator()(etl::task* ptask, etl::task_priority_t priority) const
+      {
+        return ptask->get_task_priority() > priority;
+      }
+
+      bool operator()(etl::task_priority_t priority, etl::task* ptask) const
+      {
+        return priority > ptask->get_task_priority();
+      }
+    };
+
+    // Disable copy construction and assignment.
+    parallel_scheduler(const parallel_scheduler&);
+    parallel_scheduler& operator =(const parallel_scheduler&);
+
+    typedef etl::vector<etl::task*, MAX_TASKS> task_list_t;
+
+    std::atomic<bool>     scheduler_running;
+    std::atomic<bool>     scheduler_exit;
+    etl::ifunction<void>* p_idle_callback;
+    etl::ifunction<void>* p_watchdog_callback;
+    task_list_t           task_list;
+    slot                  slots[MAX_TASKS]; ///< The tasks in priority order, built by start().
+    deque_t               deques[N_WORKERS];
+  };
+}
+
+#undef ETL_FILE
+
+#endif
+
+#endif
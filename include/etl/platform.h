@@ -102,4 +102,9 @@ SOFTWARE.
   #define ETL_NOEXCEPT_EXPR(expression)
 #endif
 
+// The size of a cache line, used to keep data written by different threads apart.
+#if !defined(ETL_CACHE_LINE_SIZE)
+  #define ETL_CACHE_LINE_SIZE 64
+#endif
+
 #endif
@@ -259,6 +259,38 @@ namespace etl
       release_item((char*)p_object);
     }
 
+    //*************************************************************************
+    /// Allocate up to 'n' items from the pool.
+    /// Does not assert if the pool runs out of items.
+    /// \param p_items Where to write the pointers to the allocated items.
+    /// \param n       The number of items wanted.
+    /// \return The number of items allocated.
+    //*************************************************************************
+    size_t allocate_batch(void** p_items, size_t n)
+    {
+      size_t count = (n < available()) ? n : available();
+
+      for (size_t i = 0U; i < count; ++i)
+      {
+        p_items[i] = allocate_item();
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Release 'n' items back to the pool.
+    /// \param p_items The pointers to the items to release.
+    /// \param n       The number of items.
+    //*************************************************************************
+    void release_batch(void* const* p_items, size_t n)
+    {
+      for (size_t i = 0U; i < n; ++i)
+      {
+        release_item(static_cast<char*>(p_items[i]));
+      }
+    }
+
     //*************************************************************************
     /// Release all objects in the pool.
     //*************************************************************************
@@ -280,6 +312,14 @@ namespace etl
       return is_item_in_pool((const char*)p_object);
     }
 
+    //*************************************************************************
+    /// Returns the size of the items in the pool.
+    //*************************************************************************
+    size_t get_item_size() const
+    {
+      return ITEM_SIZE;
+    }
+
     //*************************************************************************
     /// Returns the maximum number of items in the pool.
     //*************************************************************************
@@ -0,0 +1,401 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_POOL_CACHE_INCLUDED
+#define ETL_POOL_CACHE_INCLUDED
+
+#include <stddef.h>
+
+#include <new>
+
+#include "platform.h"
+#include "error_handler.h"
+#include "nullptr.h"
+#include "static_assert.h"
+#include "pool.h"
+
+#undef ETL_FILE
+#define ETL_FILE "52"
+
+//*****************************************************************************
+///\defgroup pool_cache pool_cache
+/// A per-thread cache of free items in front of a shared pool.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// A cache of free items that sits in front of a shared pool.
+  /// Each thread owns its own pool_cache; a cache must not be shared between threads.
+  /// Free items are held in two magazines of MAGAZINE_SIZE_ items. Allocations and
+  /// releases are served from the magazines without touching the shared pool.
+  /// Only when both magazines are empty (or full) is a whole magazine moved from
+  /// (or to) the pool in one batch. At least MAGAZINE_SIZE_ operations are served
+  /// locally between each access to the pool.
+  /// TPool must supply allocate_batch, release_batch, is_in_pool and get_item_size, as etl::ipool
+  /// and etl::iatomic_pool do. Use etl::iatomic_pool when caches on several threads
+  /// share the pool; etl::ipool does no locking of its own.
+  /// Types allocated from the cache must fit in the items of the pool.
+  ///\ingroup pool_cache
+  //***************************************************************************
+  template <typename TPool, const size_t MAGAZINE_SIZE_>
+  class pool_cache
+  {
+  public:
+
+    ETL_STATIC_ASSERT(MAGAZINE_SIZE_ != 0U, "Magazine size must not be zero");
+
+    typedef TPool  pool_type;
+    typedef size_t size_type;
+
+    static const size_t MAGAZINE_SIZE = MAGAZINE_SIZE_;
+
+    //*************************************************************************
+    /// Constructor.
+    /// \param pool_ The pool that supplies the items.
+    //*************************************************************************
+    explicit pool_cache(TPool& pool_)
+      : pool(pool_),
+        p_loaded(&magazines[0]),
+        p_previous(&magazines[1]),
+        allocate_hit_count(0U),
+        allocate_miss_count(0U),
+        release_hit_count(0U),
+        release_miss_count(0U)
+    {
+      magazines[0].count = 0U;
+      magazines[1].count = 0U;
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    /// Returns any cached items to the pool.
+    //*************************************************************************
+    ~pool_cache()
+    {
+      flush();
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the cache.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    /// If T is larger than the items of the pool an etl::pool_element_size is raised.
+    //*************************************************************************
+    template <typename T>
+    T* allocate()
+    {
+      if (sizeof(T) > pool.get_item_size())
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::pool_element_size));
+      }
+
+      return reinterpret_cast<T*>(allocate_item());
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_POOL_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object from the cache and create default.
+    //*************************************************************************
+    template <typename T>
+    T* create()
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T();
+      }
+
+      return p;
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the cache and create with 1 parameter.
+    //*************************************************************************
+    template <typename T, typename T1>
+    T* create(const T1& value1)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2>
+    T* create(const T1& value1, const T2& value2)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3>
+    T* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3, typename T4>
+    T* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3, value4);
+      }
+
+      return p;
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(std::forward<Args>(args)...);
+      }
+
+      return p;
+    }
+#endif
+
+    //*************************************************************************
+    /// Destroys the object.
+    /// \param p_object A pointer to the object to be destroyed.
+    //*************************************************************************
+    template <typename T>
+    void destroy(const void* const p_object)
+    {
+      reinterpret_cast<T*>((const_cast<void*>(p_object)))->~T();
+      release(p_object);
+    }
+
+    //*************************************************************************
+    /// Release an object to the cache.
+    /// If asserts or exceptions are enabled and the object does not belong to the
+    /// pool then an etl::pool_object_not_in_pool is thrown.
+    /// \param p_object A pointer to the object to be released.
+    //*************************************************************************
+    void release(const void* const p_object)
+    {
+      ETL_ASSERT(pool.is_in_pool(p_object), ETL_ERROR(pool_object_not_in_pool));
+
+      if (p_loaded->count == MAGAZINE_SIZE)
+      {
+        if (p_previous->count != 0U)
+        {
+          // Both magazines are full; return one to the pool.
+          pool.release_batch(p_previous->items, p_previous->count);
+          p_previous->count = 0U;
+          ++release_miss_count;
+        }
+        else
+        {
+          ++release_hit_count;
+        }
+
+        swap_magazines();
+      }
+      else
+      {
+        ++release_hit_count;
+      }
+
+      p_loaded->items[p_loaded->count++] = const_cast<void*>(p_object);
+    }
+
+    //*************************************************************************
+    /// Returns all of the cached items to the pool.
+    //*************************************************************************
+    void flush()
+    {
+      pool.release_batch(p_loaded->items, p_loaded->count);
+      pool.release_batch(p_previous->items, p_previous->count);
+      p_loaded->count   = 0U;
+      p_previous->count = 0U;
+    }
+
+    //*************************************************************************
+    /// Returns the number of free items held by the cache.
+    //*************************************************************************
+    size_t cached() const
+    {
+      return p_loaded->count + p_previous->count;
+    }
+
+    //*************************************************************************
+    /// Returns the pool that supplies the items.
+    //*************************************************************************
+    TPool& get_pool()
+    {
+      return pool;
+    }
+
+    //*************************************************************************
+    /// The number of allocations served from the cache.
+    //*************************************************************************
+    size_t allocate_hits() const
+    {
+      return allocate_hit_count;
+    }
+
+    //*************************************************************************
+    /// The number of allocations that had to fetch a magazine from the pool.
+    //*************************************************************************
+    size_t allocate_misses() const
+    {
+      return allocate_miss_count;
+    }
+
+    //*************************************************************************
+    /// The number of releases kept in the cache.
+    //*************************************************************************
+    size_t release_hits() const
+    {
+      return release_hit_count;
+    }
+
+    //*************************************************************************
+    /// The number of releases that had to return a magazine to the pool.
+    //*************************************************************************
+    size_t release_misses() const
+    {
+      return release_miss_count;
+    }
+
+    //*************************************************************************
+    /// Sets the hit and miss counters to zero.
+    //*************************************************************************
+    void clear_statistics()
+    {
+      allocate_hit_count  = 0U;
+      allocate_miss_count = 0U;
+      release_hit_count   = 0U;
+      release_miss_count  = 0U;
+    }
+
+  private:
+
+    //*************************************************************************
+    /// A stack of free items.
+    //*************************************************************************
+    struct magazine
+    {
+      size_t count;
+      void*  items[MAGAZINE_SIZE_];
+    };
+
+    //*************************************************************************
+    /// Allocate an item from the magazines, refilling from the pool if empty.
+    //*************************************************************************
+    void* allocate_item()
+    {
+      if (p_loaded->count == 0U)
+      {
+        if (p_previous->count == 0U)
+        {
+          // Both magazines are empty; fetch one from the pool.
+          ++allocate_miss_count;
+
+          p_loaded->count = pool.allocate_batch(p_loaded->items, MAGAZINE_SIZE);
+
+          if (p_loaded->count == 0U)
+          {
+            ETL_ASSERT(false, ETL_ERROR(pool_no_allocation));
+            return nullptr;
+          }
+
+          return p_loaded->items[--p_loaded->count];
+        }
+
+        swap_magazines();
+      }
+
+      ++allocate_hit_count;
+
+      return p_loaded->items[--p_loaded->count];
+    }
+
+    //*************************************************************************
+    /// Exchange the loaded and previous magazines.
+    //*************************************************************************
+    void swap_magazines()
+    {
+      magazine* p_temp = p_loaded;
+      p_loaded   = p_previous;
+      p_previous = p_temp;
+    }
+
+    // Disable copy construction and assignment.
+    pool_cache(const pool_cache&);
+    pool_cache& operator =(const pool_cache&);
+
+    TPool&    pool;
+    magazine  magazines[2];
+    magazine* p_loaded;   ///< The magazine that allocations and releases use.
+    magazine* p_previous; ///< Either empty or full.
+
+    size_t allocate_hit_count;
+    size_t allocate_miss_count;
+    size_t release_hit_count;
+    size_t release_miss_count;
+  };
+
+  template <typename TPool, const size_t MAGAZINE_SIZE_>
+  const size_t pool_cache<TPool, MAGAZINE_SIZE_>::MAGAZINE_SIZE;
+}
+
+#undef ETL_FILE
+
+#endif
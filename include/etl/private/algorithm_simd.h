@@ -0,0 +1,759 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_ALGORITHM_SIMD_INCLUDED
+#define ETL_ALGORITHM_SIMD_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../platform.h"
+#include "../type_traits.h"
+
+//*****************************************************************************
+// Vectorised kernels for the non-predicate forms of find, count, equal,
+// mismatch, min_element, max_element and minmax_element, and for the default
+// operation forms of reduce, transform_reduce and the scans in numeric.h.
+// SSE2 is used when the target supports it, AVX2 when enabled by the compiler.
+// Define ETL_NO_SIMD to force the scalar algorithms.
+//*****************************************************************************
+#if !defined(ETL_NO_SIMD) && defined(__AVX2__)
+  #define ETL_SIMD_AVX2_SUPPORTED 1
+#else
+  #define ETL_SIMD_AVX2_SUPPORTED 0
+#endif
+
+#if !defined(ETL_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+  #define ETL_SIMD_SSE2_SUPPORTED 1
+#else
+  #define ETL_SIMD_SSE2_SUPPORTED 0
+#endif
+
+#if ETL_SIMD_AVX2_SUPPORTED
+  #include <immintrin.h>
+#elif ETL_SIMD_SSE2_SUPPORTED
+  #include <emmintrin.h>
+#endif
+
+#if (ETL_SIMD_AVX2_SUPPORTED || ETL_SIMD_SSE2_SUPPORTED) && defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+#define ETL_SIMD_SUPPORTED (ETL_SIMD_AVX2_SUPPORTED || ETL_SIMD_SSE2_SUPPORTED)
+
+namespace etl
+{
+  namespace private_algorithm_simd
+  {
+    //*************************************************************************
+    /// The value type of a contiguous iterator that the kernels can handle.
+    //*************************************************************************
+    template <typename TIterator>
+    struct value_type
+    {
+      typedef typename etl::remove_cv<typename etl::remove_pointer<TIterator>::type>::type type;
+
+      static const bool is_lane = etl::is_pointer<TIterator>::value &&
+                                  etl::is_arithmetic<type>::value    &&
+                                  !etl::is_same<type, bool>::value   &&
+                                  ((sizeof(type) == 1U) || (sizeof(type) == 2U) || (sizeof(type) == 4U) || (sizeof(type) == 8U));
+    };
+
+    //*************************************************************************
+    /// True if find and count over TIterator for a T value are vectorised.
+    //*************************************************************************
+    template <typename TIterator, typename T>
+    struct is_vectorisable
+      : etl::integral_constant<bool, ETL_SIMD_SUPPORTED &&
+                                     value_type<TIterator>::is_lane &&
+                                     etl::is_same<typename value_type<TIterator>::type, typename etl::remove_cv<T>::type>::value>
+    {
+    };
+
+    //*************************************************************************
+    /// True if equal and mismatch over two iterators are vectorised.
+    //*************************************************************************
+    template <typename TIterator1, typename TIterator2>
+    struct are_vectorisable
+      : etl::integral_constant<bool, is_vectorisable<TIterator1, typename value_type<TIterator2>::type>::value &&
+                                     etl::is_pointer<TIterator2>::value>
+    {
+    };
+
+    //*************************************************************************
+    /// True if min_element, max_element and minmax_element are vectorised.
+    //*************************************************************************
+    template <typename TIterator>
+    struct is_min_max_vectorisable
+      : etl::integral_constant<bool, ETL_SIMD_SUPPORTED &&
+                                     value_type<TIterator>::is_lane &&
+                                     etl::is_integral<typename value_type<TIterator>::type>::value &&
+                                     (sizeof(typename value_type<TIterator>::type) <= 4U)>
+    {
+    };
+
+#if ETL_SIMD_AVX2_SUPPORTED
+    //*************************************************************************
+    /// AVX2 instructions.
+    //*************************************************************************
+    struct isa
+    {
+      typedef __m256i  vector_t;
+      typedef uint32_t mask_t;
+
+      enum
+      {
+        Bytes = 32
+      };
+
+      static const mask_t All_Lanes = 0xFFFFFFFFUL;
+
+      static vector_t load(const void* p)                         { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+      static void     store(void* p, vector_t v)                  { _mm256_storeu_si256(static_cast<__m256i*>(p), v); }
+      static mask_t   mask(vector_t v)                            { return mask_t(_mm256_movemask_epi8(v)); }
+      static vector_t select(vector_t m, vector_t a, vector_t b)  { return _mm256_blendv_epi8(b, a, m); }
+      static vector_t bitwise_xor(vector_t a, vector_t b)         { return _mm256_xor_si256(a, b); }
+
+      static vector_t splat8(int8_t v)                            { return _mm256_set1_epi8(char(v)); }
+      static vector_t splat16(int16_t v)                          { return _mm256_set1_epi16(v); }
+      static vector_t splat32(int32_t v)                          { return _mm256_set1_epi32(v); }
+      static vector_t splat64(int64_t v)                          { return _mm256_set1_epi64x(v); }
+      static vector_t splat_f32(float v)                          { return _mm256_castps_si256(_mm256_set1_ps(v)); }
+      static vector_t splat_f64(double v)                         { return _mm256_castpd_si256(_mm256_set1_pd(v)); }
+
+      static vector_t equal8(vector_t a, vector_t b)              { return _mm256_cmpeq_epi8(a, b); }
+      static vector_t equal16(vector_t a, vector_t b)             { return _mm256_cmpeq_epi16(a, b); }
+      static vector_t equal32(vector_t a, vector_t b)             { return _mm256_cmpeq_epi32(a, b); }
+      static vector_t equal64(vector_t a, vector_t b)             { return _mm256_cmpeq_epi64(a, b); }
+      static vector_t equal_f32(vector_t a, vector_t b)           { return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ)); }
+      static vector_t equal_f64(vector_t a, vector_t b)           { return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ)); }
+
+      static vector_t greater8(vector_t a, vector_t b)            { return _mm256_cmpgt_epi8(a, b); }
+      static vector_t greater16(vector_t a, vector_t b)           { return _mm256_cmpgt_epi16(a, b); }
+      static vector_t greater32(vector_t a, vector_t b)           { return _mm256_cmpgt_epi32(a, b); }
+
+      static vector_t add8(vector_t a, vector_t b)                { return _mm256_add_epi8(a, b); }
+      static vector_t add16(vector_t a, vector_t b)               { return _mm256_add_epi16(a, b); }
+      static vector_t add32(vector_t a, vector_t b)               { return _mm256_add_epi32(a, b); }
+      static vector_t add64(vector_t a, vector_t b)               { return _mm256_add_epi64(a, b); }
+      static vector_t add_f32(vector_t a, vector_t b)             { return _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+      static vector_t add_f64(vector_t a, vector_t b)             { return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+      static vector_t subtract32(vector_t a, vector_t b)          { return _mm256_sub_epi32(a, b); }
+      static vector_t multiply_f32(vector_t a, vector_t b)        { return _mm256_castps_si256(_mm256_mul_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+      static vector_t multiply_f64(vector_t a, vector_t b)        { return _mm256_castpd_si256(_mm256_mul_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+
+      // Running sum of the 32 bit lanes.
+      static vector_t prefix_sum32(vector_t v)
+      {
+        v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+        v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+
+        // The shifts stay within each 128 bit half, so carry the low half's total into the high half.
+        return _mm256_add_epi32(v, _mm256_shuffle_epi32(_mm256_permute2x128_si256(v, v, 0x08), 0xFF));
+      }
+
+      static vector_t broadcast_last32(vector_t v)                { return _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7)); }
+    };
+#elif ETL_SIMD_SSE2_SUPPORTED
+    //*************************************************************************
+    /// SSE2 instructions.
+    //*************************************************************************
+    struct isa
+    {
+      typedef __m128i  vector_t;
+      typedef uint32_t mask_t;
+
+      enum
+      {
+        Bytes = 16
+      };
+
+      static const mask_t All_Lanes = 0x0000FFFFUL;
+
+      static vector_t load(const void* p)                         { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+      static void     store(void* p, vector_t v)                  { _mm_storeu_si128(static_cast<__m128i*>(p), v); }
+      static mask_t   mask(vector_t v)                            { return mask_t(_mm_movemask_epi8(v)); }
+      static vector_t select(vector_t m, vector_t a, vector_t b)  { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+      static vector_t bitwise_xor(vector_t a, vector_t b)         { return _mm_xor_si128(a, b); }
+
+      static vector_t splat8(int8_t v)                            { return _mm_set1_epi8(char(v)); }
+      static vector_t splat16(int16_t v)                          { return _mm_set1_epi16(v); }
+      static vector_t splat32(int32_t v)                          { return _mm_set1_epi32(v); }
+      static vector_t splat64(int64_t v)                          { return _mm_set1_epi64x(v); }
+      static vector_t splat_f32(float v)                          { return _mm_castps_si128(_mm_set1_ps(v)); }
+      static vector_t splat_f64(double v)                         { return _mm_castpd_si128(_mm_set1_pd(v)); }
+
+      static vector_t equal8(vector_t a, vector_t b)              { return _mm_cmpeq_epi8(a, b); }
+      static vector_t equal16(vector_t a, vector_t b)             { return _mm_cmpeq_epi16(a, b); }
+      static vector_t equal32(vector_t a, vector_t b)             { return _mm_cmpeq_epi32(a, b); }
+      static vector_t equal_f32(vector_t a, vector_t b)           { return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+      static vector_t equal_f64(vector_t a, vector_t b)           { return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+
+      // No 64 bit compare in SSE2; both 32 bit halves must match.
+      static vector_t equal64(vector_t a, vector_t b)
+      {
+        vector_t halves = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+      }
+
+      static vector_t greater8(vector_t a, vector_t b)            { return _mm_cmpgt_epi8(a, b); }
+      static vector_t greater16(vector_t a, vector_t b)           { return _mm_cmpgt_epi16(a, b); }
+      static vector_t greater32(vector_t a, vector_t b)           { return _mm_cmpgt_epi32(a, b); }
+
+      static vector_t add8(vector_t a, vector_t b)                { return _mm_add_epi8(a, b); }
+      static vector_t add16(vector_t a, vector_t b)               { return _mm_add_epi16(a, b); }
+      static vector_t add32(vector_t a, vector_t b)               { return _mm_add_epi32(a, b); }
+      static vector_t add64(vector_t a, vector_t b)               { return _mm_add_epi64(a, b); }
+      static vector_t add_f32(vector_t a, vector_t b)             { return _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+      static vector_t add_f64(vector_t a, vector_t b)             { return _mm_castpd_si128(_mm_add_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+      static vector_t subtract32(vector_t a, vector_t b)          { return _mm_sub_epi32(a, b); }
+      static vector_t multiply_f32(vector_t a, vector_t b)        { return _mm_castps_si128(_mm_mul_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+      static vector_t multiply_f64(vector_t a, vector_t b)        { return _mm_castpd_si128(_mm_mul_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+
+      // Running sum of the 32 bit lanes.
+      static vector_t prefix_sum32(vector_t v)
+      {
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        return _mm_add_epi32(v, _mm_slli_si128(v, 8));
+      }
+
+      static vector_t broadcast_last32(vector_t v)                { return _mm_shuffle_epi32(v, 0xFF); }
+    };
+#endif
+
+#if ETL_SIMD_SUPPORTED
+    typedef isa::vector_t vector_t;
+    typedef isa::mask_t   mask_t;
+
+    //*************************************************************************
+    /// The index of the lowest set bit. 'mask' must not be zero.
+    /// binary.h is not used as it includes algorithm.h when ETL_NO_STL is defined.
+    //*************************************************************************
+    inline uint_least8_t first_set(mask_t mask)
+    {
+#if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return uint_least8_t(index);
+#else
+      return uint_least8_t(__builtin_ctz(mask));
+#endif
+    }
+
+    //*************************************************************************
+    /// The number of set bits.
+    //*************************************************************************
+    inline uint_least8_t count_set(mask_t mask)
+    {
+      mask = mask - ((mask >> 1) & 0x55555555UL);
+      mask = (mask & 0x33333333UL) + ((mask >> 2) & 0x33333333UL);
+      mask = (mask + (mask >> 4)) & 0x0F0F0F0FUL;
+
+      return uint_least8_t(uint32_t(mask * 0x01010101UL) >> 24);
+    }
+
+    //*************************************************************************
+    /// Lane operations for each element type.
+    /// Comparisons return all ones in the lanes where they hold.
+    /// Unsigned values are biased so that the signed compare orders them.
+    //*************************************************************************
+    template <typename T, const size_t SIZE = sizeof(T), const bool IS_FLOAT = etl::is_floating_point<T>::value>
+    struct ops;
+
+    template <typename T>
+    struct ops<T, 1U, false>
+    {
+      static vector_t splat(T value)                    { return isa::splat8(int8_t(value)); }
+      static vector_t equal(vector_t a, vector_t b)     { return isa::equal8(a, b); }
+      static vector_t less(vector_t a, vector_t b)      { return isa::greater8(bias(b), bias(a)); }
+      static vector_t bias(vector_t v)                  { return etl::is_signed<T>::value ? v : isa::bitwise_xor(v, isa::splat8(int8_t(-128))); }
+      static vector_t add(vector_t a, vector_t b)       { return isa::add8(a, b); }
+    };
+
+    template <typename T>
+    struct ops<T, 2U, false>
+    {
+      static vector_t splat(T value)                    { return isa::splat16(int16_t(value)); }
+      static vector_t equal(vector_t a, vector_t b)     { return isa::equal16(a, b); }
+      static vector_t less(vector_t a, vector_t b)      { return isa::greater16(bias(b), bias(a)); }
+      static vector_t bias(vector_t v)                  { return etl::is_signed<T>::value ? v : isa::bitwise_xor(v, isa::splat16(int16_t(-32767 - 1))); }
+      static vector_t add(vector_t a, vector_t b)       { return isa::add16(a, b); }
+    };
+
+    template <typename T>
+    struct ops<T, 4U, false>
+    {
+      static vector_t splat(T value)                    { return isa::splat32(int32_t(value)); }
+      static vector_t equal(vector_t a, vector_t b)     { return isa::equal32(a, b); }
+      static vector_t less(vector_t a, vector_t b)      { return isa::greater32(bias(b), bias(a)); }
+      static vector_t bias(vector_t v)                  { return etl::is_signed<T>::value ? v : isa::bitwise_xor(v, isa::splat32(int32_t(-2147483647L - 1))); }
+      static vector_t add(vector_t a, vector_t b)       { return isa::add32(a, b); }
+    };
+
+    template <typename T>
+    struct ops<T, 8U, false>
+    {
+      static vector_t splat(T value)                    { return isa::splat64(int64_t(value)); }
+      static vector_t equal(vector_t a, vector_t b)     { return isa::equal64(a, b); }
+      static vector_t add(vector_t a, vector_t b)       { return isa::add64(a, b); }
+    };
+
+    template <typename T>
+    struct ops<T, 4U, true>
+    {
+      static vector_t splat(T value)                    { return isa::splat_f32(value); }
+      static vector_t equal(vector_t a, vector_t b)     { return isa::equal_f32(a, b); }
+      static vector_t add(vector_t a, vector_t b)       { return isa::add_f32(a, b); }
+      static vector_t multiply(vector_t a, vector_t b)  { return isa::multiply_f32(a, b); }
+    };
+
+    template <typename T>
+    struct ops<T, 8U, true>
+    {
+      static vector_t splat(T value)                    { return isa::splat_f64(value); }
+      static vector_t equal(vector_t a, vector_t b)     { return isa::equal_f64(a, b); }
+      static vector_t add(vector_t a, vector_t b)       { return isa::add_f64(a, b); }
+      static vector_t multiply(vector_t a, vector_t b)  { return isa::multiply_f64(a, b); }
+    };
+
+    //*************************************************************************
+    /// The index of the first element equal to 'value', or the length.
+    //*************************************************************************
+    template <typename T>
+    size_t find(const T* first, const T* last, T value)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      const T* const begin  = first;
+      const vector_t needle = ops<T>::splat(value);
+
+      while ((last - first) >= Lanes)
+      {
+        const mask_t matches = isa::mask(ops<T>::equal(isa::load(first), needle));
+
+        if (matches != 0U)
+        {
+          return size_t(first - begin) + (first_set(matches) / sizeof(T));
+        }
+
+        first += Lanes;
+      }
+
+      while ((first != last) && !(*first == value))
+      {
+        ++first;
+      }
+
+      return size_t(first - begin);
+    }
+
+    //*************************************************************************
+    /// The number of elements equal to 'value'.
+    //*************************************************************************
+    template <typename T>
+    size_t count(const T* first, const T* last, T value)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      const vector_t needle = ops<T>::splat(value);
+      size_t n = 0U;
+
+      while ((last - first) >= Lanes)
+      {
+        n += count_set(isa::mask(ops<T>::equal(isa::load(first), needle)));
+        first += Lanes;
+      }
+
+      n /= sizeof(T);
+
+      while (first != last)
+      {
+        if (*first == value)
+        {
+          ++n;
+        }
+
+        ++first;
+      }
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// The index of the first element where the ranges differ, or the length.
+    //*************************************************************************
+    template <typename T>
+    size_t mismatch(const T* first1, const T* last1, const T* first2)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      const T* const begin = first1;
+
+      while ((last1 - first1) >= Lanes)
+      {
+        const mask_t matches = isa::mask(ops<T>::equal(isa::load(first1), isa::load(first2)));
+
+        if (matches != isa::All_Lanes)
+        {
+          return size_t(first1 - begin) + (first_set(mask_t(~matches)) / sizeof(T));
+        }
+
+        first1 += Lanes;
+        first2 += Lanes;
+      }
+
+      while ((first1 != last1) && (*first1 == *first2))
+      {
+        ++first1;
+        ++first2;
+      }
+
+      return size_t(first1 - begin);
+    }
+
+    //*************************************************************************
+    /// Reduces the range to its smallest and/or largest value.
+    /// The range must hold at least one vector of elements.
+    //*************************************************************************
+    template <bool FIND_MIN, bool FIND_MAX, typename T>
+    void reduce(const T* first, const T* last, T& minimum, T& maximum)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      vector_t vmin = isa::load(first);
+      vector_t vmax = vmin;
+      first += Lanes;
+
+      while ((last - first) >= Lanes)
+      {
+        const vector_t v = isa::load(first);
+
+        if (FIND_MIN)
+        {
+          vmin = isa::select(ops<T>::less(v, vmin), v, vmin);
+        }
+
+        if (FIND_MAX)
+        {
+          vmax = isa::select(ops<T>::less(vmax, v), v, vmax);
+        }
+
+        first += Lanes;
+      }
+
+      T lanes_min[Lanes];
+      T lanes_max[Lanes];
+      isa::store(lanes_min, vmin);
+      isa::store(lanes_max, vmax);
+
+      minimum = lanes_min[0];
+      maximum = lanes_max[0];
+
+      for (ptrdiff_t i = 1; i < Lanes; ++i)
+      {
+        if (lanes_min[i] < minimum)
+        {
+          minimum = lanes_min[i];
+        }
+
+        if (maximum < lanes_max[i])
+        {
+          maximum = lanes_max[i];
+        }
+      }
+
+      while (first != last)
+      {
+        if (*first < minimum)
+        {
+          minimum = *first;
+        }
+
+        if (maximum < *first)
+        {
+          maximum = *first;
+        }
+
+        ++first;
+      }
+    }
+
+    //*************************************************************************
+    /// The index of the first smallest element.
+    //*************************************************************************
+    template <typename T>
+    size_t min_element(const T* first, const T* last)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      const T* const begin = first;
+
+      if ((last - first) < Lanes)
+      {
+        const T* minimum = first;
+
+        while (first != last)
+        {
+          if (*first < *minimum)
+          {
+            minimum = first;
+          }
+
+          ++first;
+        }
+
+        return size_t(minimum - begin);
+      }
+
+      T minimum;
+      T maximum;
+      reduce<true, false>(first, last, minimum, maximum);
+
+      return find(first, last, minimum);
+    }
+
+    //*************************************************************************
+    /// The index of the first largest element.
+    //*************************************************************************
+    template <typename T>
+    size_t max_element(const T* first, const T* last)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      const T* const begin = first;
+
+      if ((last - first) < Lanes)
+      {
+        const T* maximum = first;
+
+        while (first != last)
+        {
+          if (*maximum < *first)
+          {
+            maximum = first;
+          }
+
+          ++first;
+        }
+
+        return size_t(maximum - begin);
+      }
+
+      T minimum;
+      T maximum;
+      reduce<false, true>(first, last, minimum, maximum);
+
+      return find(first, last, maximum);
+    }
+
+    //*************************************************************************
+    /// The indexes of the first smallest and first largest elements.
+    //*************************************************************************
+    template <typename T>
+    void minmax_element(const T* first, const T* last, size_t& index_min, size_t& index_max)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      if ((last - first) < Lanes)
+      {
+        index_min = min_element(first, last);
+        index_max = max_element(first, last);
+        return;
+      }
+
+      T minimum;
+      T maximum;
+      reduce<true, true>(first, last, minimum, maximum);
+
+      index_min = find(first, last, minimum);
+      index_max = find(first, last, maximum);
+    }
+
+    //*************************************************************************
+    /// 'init' plus the sum of the range.
+    /// Four accumulators hide the latency of the adds.
+    //*************************************************************************
+    template <typename T>
+    T sum(const T* first, const T* last, T init)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      if ((last - first) >= (4 * Lanes))
+      {
+        vector_t sum0 = isa::load(first);
+        vector_t sum1 = isa::load(first + Lanes);
+        vector_t sum2 = isa::load(first + (2 * Lanes));
+        vector_t sum3 = isa::load(first + (3 * Lanes));
+        first += 4 * Lanes;
+
+        while ((last - first) >= (4 * Lanes))
+        {
+          sum0 = ops<T>::add(sum0, isa::load(first));
+          sum1 = ops<T>::add(sum1, isa::load(first + Lanes));
+          sum2 = ops<T>::add(sum2, isa::load(first + (2 * Lanes)));
+          sum3 = ops<T>::add(sum3, isa::load(first + (3 * Lanes)));
+          first += 4 * Lanes;
+        }
+
+        while ((last - first) >= Lanes)
+        {
+          sum0 = ops<T>::add(sum0, isa::load(first));
+          first += Lanes;
+        }
+
+        T lanes[Lanes];
+        isa::store(lanes, ops<T>::add(ops<T>::add(sum0, sum1), ops<T>::add(sum2, sum3)));
+
+        for (ptrdiff_t i = 0; i < Lanes; ++i)
+        {
+          init = T(init + lanes[i]);
+        }
+      }
+
+      while (first != last)
+      {
+        init = T(init + *first);
+        ++first;
+      }
+
+      return init;
+    }
+
+    //*************************************************************************
+    /// 'init' plus the inner product of the ranges.
+    /// Floating point types only.
+    //*************************************************************************
+    template <typename T>
+    T inner_product(const T* first1, const T* last1, const T* first2, T init)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      if ((last1 - first1) >= (4 * Lanes))
+      {
+        vector_t sum0 = ops<T>::multiply(isa::load(first1),               isa::load(first2));
+        vector_t sum1 = ops<T>::multiply(isa::load(first1 + Lanes),       isa::load(first2 + Lanes));
+        vector_t sum2 = ops<T>::multiply(isa::load(first1 + (2 * Lanes)), isa::load(first2 + (2 * Lanes)));
+        vector_t sum3 = ops<T>::multiply(isa::load(first1 + (3 * Lanes)), isa::load(first2 + (3 * Lanes)));
+        first1 += 4 * Lanes;
+        first2 += 4 * Lanes;
+
+        while ((last1 - first1) >= (4 * Lanes))
+        {
+          sum0 = ops<T>::add(sum0, ops<T>::multiply(isa::load(first1),               isa::load(first2)));
+          sum1 = ops<T>::add(sum1, ops<T>::multiply(isa::load(first1 + Lanes),       isa::load(first2 + Lanes)));
+          sum2 = ops<T>::add(sum2, ops<T>::multiply(isa::load(first1 + (2 * Lanes)), isa::load(first2 + (2 * Lanes))));
+          sum3 = ops<T>::add(sum3, ops<T>::multiply(isa::load(first1 + (3 * Lanes)), isa::load(first2 + (3 * Lanes))));
+          first1 += 4 * Lanes;
+          first2 += 4 * Lanes;
+        }
+
+        while ((last1 - first1) >= Lanes)
+        {
+          sum0 = ops<T>::add(sum0, ops<T>::multiply(isa::load(first1), isa::load(first2)));
+          first1 += Lanes;
+          first2 += Lanes;
+        }
+
+        T lanes[Lanes];
+        isa::store(lanes, ops<T>::add(ops<T>::add(sum0, sum1), ops<T>::add(sum2, sum3)));
+
+        for (ptrdiff_t i = 0; i < Lanes; ++i)
+        {
+          init = init + lanes[i];
+        }
+      }
+
+      while (first1 != last1)
+      {
+        init = init + (*first1 * *first2);
+        ++first1;
+        ++first2;
+      }
+
+      return init;
+    }
+
+    //*************************************************************************
+    /// Inclusive or exclusive running sum, starting from 'carry'.
+    /// 32 bit integral types only. May be used in place.
+    /// 'carry' is updated to the sum of the range.
+    //*************************************************************************
+    template <bool EXCLUSIVE, typename T>
+    T* scan(const T* first, const T* last, T* d_first, T& carry)
+    {
+      const ptrdiff_t Lanes = isa::Bytes / sizeof(T);
+
+      if ((last - first) >= Lanes)
+      {
+        vector_t running = ops<T>::splat(carry);
+
+        while ((last - first) >= Lanes)
+        {
+          const vector_t v   = isa::load(first);
+          const vector_t sum = isa::add32(isa::prefix_sum32(v), running);
+
+          isa::store(d_first, EXCLUSIVE ? isa::subtract32(sum, v) : sum);
+          running = isa::broadcast_last32(sum);
+
+          first   += Lanes;
+          d_first += Lanes;
+        }
+
+        T lanes[Lanes];
+        isa::store(lanes, running);
+        carry = lanes[0];
+      }
+
+      while (first != last)
+      {
+        const T value = *first;
+
+        if (EXCLUSIVE)
+        {
+          *d_first = carry;
+          carry    = T(carry + value);
+        }
+        else
+        {
+          carry    = T(carry + value);
+          *d_first = carry;
+        }
+
+        ++first;
+        ++d_first;
+      }
+
+      return d_first;
+    }
+#endif
+  }
+}
+
+#endif
@@ -0,0 +1,166 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_QUEUE_WAIT_INCLUDED
+#define ETL_QUEUE_WAIT_INCLUDED
+
+#include "../platform.h"
+
+//*****************************************************************************
+// Blocking waits for the thread safe queues.
+// A waiting thread first retries the operation ETL_QUEUE_WAIT_SPIN_COUNT times,
+// then parks on a condition variable. The other side only touches the
+// condition variable when a waiter has registered, so push and pop without
+// waiters make no system calls.
+// Opt in by defining ETL_QUEUE_WAIT. Without it the queues have no wait
+// members, and push and pop are unchanged. With it, every push and pop runs a
+// fence, and may lock a std::mutex when a waiter is registered, so a queue
+// that is pushed or popped from an ISR should not be used with it.
+// etl::queue_spsc_locked has no waits, as its ISR side could not wake a waiter.
+// Requires C++11 and the STL.
+//*****************************************************************************
+#if ETL_CPP11_SUPPORTED && !defined(ETL_NO_STL) && defined(ETL_QUEUE_WAIT)
+  #define ETL_HAS_QUEUE_WAIT 1
+#else
+  #define ETL_HAS_QUEUE_WAIT 0
+#endif
+
+#if !defined(ETL_QUEUE_WAIT_SPIN_COUNT)
+  #define ETL_QUEUE_WAIT_SPIN_COUNT 100
+#endif
+
+#if ETL_HAS_QUEUE_WAIT
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+namespace etl
+{
+  namespace private_queue_wait
+  {
+    //*************************************************************************
+    /// Threads wait on an event until an operation succeeds.
+    /// The operation is always tried outside the event's mutex, so it may
+    /// notify other events without imposing a lock order between them.
+    /// Each notification that may wake a waiter advances a count; a waiter
+    /// only sleeps if the count is unchanged since before its last try.
+    //*************************************************************************
+    class event
+    {
+    public:
+
+      event()
+        : n_waiters(0),
+          count(0U)
+      {
+      }
+
+      //***********************************************************************
+      /// Wakes any waiters. Call after a change that may let their operation succeed.
+      //***********************************************************************
+      void notify()
+      {
+        // Orders the change before the check for waiters, pairing with the fence in wait.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (n_waiters.load(std::memory_order_relaxed) != 0)
+        {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            count.fetch_add(1U, std::memory_order_release);
+          }
+
+          condition.notify_all();
+        }
+      }
+
+      //***********************************************************************
+      /// Retries the operation until it succeeds or the timeout expires.
+      /// \return <b>true</b> if the operation succeeded.
+      //***********************************************************************
+      template <typename TOperation, typename TRep, typename TPeriod>
+      bool wait(TOperation operation, const std::chrono::duration<TRep, TPeriod>& timeout)
+      {
+        for (int i = 0; i < ETL_QUEUE_WAIT_SPIN_COUNT; ++i)
+        {
+          if (operation())
+          {
+            return true;
+          }
+        }
+
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+
+        n_waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        bool result = false;
+
+        for (;;)
+        {
+          const unsigned int key = count.load(std::memory_order_acquire);
+
+          if (operation())
+          {
+            result = true;
+            break;
+          }
+
+          std::unique_lock<std::mutex> lock(mutex);
+
+          if (!condition.wait_until(lock, deadline, [&]() { return count.load(std::memory_order_relaxed) != key; }))
+          {
+            break;
+          }
+        }
+
+        n_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        return result;
+      }
+
+    private:
+
+      event(const event&);
+      event& operator =(const event&);
+
+      std::atomic<int>          n_waiters;
+      std::atomic<unsigned int> count;
+      std::mutex                mutex;
+      std::condition_variable   condition;
+    };
+  }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,370 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_TIMER_WHEEL_INCLUDED
+#define ETL_TIMER_WHEEL_INCLUDED
+
+#include <stdint.h>
+
+#include "../platform.h"
+#include "../timer.h"
+
+namespace etl
+{
+  namespace private_timer_wheel
+  {
+    //*************************************************************************
+    /// A hierarchical timing wheel of timer ids, shared by the timer wheels.
+    /// Level 0 has a slot for each of the next SLOTS ticks. Each slot of level
+    /// n covers SLOTS^n ticks. A timer is linked into the slot of the lowest
+    /// level that reaches its expiry, and moves down a level (cascades) when
+    /// the slot that holds it becomes current. Timers beyond the reach of the
+    /// top level wait in its farthest slot and are placed again when it cascades.
+    /// Level 0 never cascades, so there must be at least two levels.
+    /// Insert and remove are O(1). A tick is O(1) plus the timers that cascade
+    /// or expire, and runs of ticks with no timers are skipped.
+    /// TTimer must have 'expiry', 'slack', 'previous', 'next' and 'slot' members.
+    //*************************************************************************
+    template <typename TTimer>
+    class wheel
+    {
+    public:
+
+      typedef etl::timer::wheel_id::type id_type;
+
+      static const uint32_t NO_SLOT = 0xFFFFFFFF;
+
+      //*******************************
+      wheel(TTimer* ptimers_, uint32_t* pslots_, uint32_t* plevel_counts_, uint_least8_t levels_, uint_least8_t slot_bits_)
+        : ptimers(ptimers_),
+          pslots(pslots_),
+          plevel_counts(plevel_counts_),
+          levels(levels_),
+          slot_bits(slot_bits_),
+          slot_mask((uint32_t(1) << slot_bits_) - 1),
+          now(0),
+          n_active(0)
+      {
+      }
+
+      //*******************************
+      /// Empties the wheel. Does not touch the timers.
+      //*******************************
+      void clear()
+      {
+        for (uint32_t i = 0; i < (uint32_t(levels) << slot_bits); ++i)
+        {
+          pslots[i] = etl::timer::wheel_id::NO_TIMER;
+        }
+
+        for (uint_least8_t level = 0; level < levels; ++level)
+        {
+          plevel_counts[level] = 0;
+        }
+
+        n_active = 0;
+      }
+
+      //*******************************
+      bool empty() const
+      {
+        return n_active == 0;
+      }
+
+      //*******************************
+      /// The wheel's current time in ticks.
+      //*******************************
+      uint32_t time() const
+      {
+        return now;
+      }
+
+      //*******************************
+      /// The number of ticks until the wheel must be serviced, allowing each
+      /// timer to be late by up to its slack, or
+      /// etl::timer::interval::NO_ACTIVE_INTERVAL if the wheel is empty.
+      /// No timer expires before the start of its slot, so each level's
+      /// slots are searched in order until one starts after the best so far.
+      //*******************************
+      uint32_t next_expiry() const
+      {
+        uint32_t best = etl::timer::interval::NO_ACTIVE_INTERVAL;
+
+        for (uint_least8_t level = 0; level < levels; ++level)
+        {
+          if (plevel_counts[level] != 0)
+          {
+            const uint32_t shift = uint32_t(level) * slot_bits;
+
+            // The current slot of a higher level has already cascaded, so it comes last.
+            const uint32_t first = (now >> shift) + ((level == 0) ? 0 : 1);
+
+            for (uint32_t i = 0; i <= slot_mask; ++i)
+            {
+              const uint32_t position = first + i;
+              const uint32_t start    = (position << shift) - now;
+
+              if (start >= best)
+              {
+                break;
+              }
+
+              id_type id = pslots[(uint32_t(level) << slot_bits) + (position & slot_mask)];
+
+              while (id != etl::timer::wheel_id::NO_TIMER)
+              {
+                const uint32_t delta = ptimers[id].expiry - now;
+
+                if ((delta < best) && ((best - delta) > ptimers[id].slack))
+                {
+                  best = delta + ptimers[id].slack;
+                }
+
+                id = ptimers[id].next;
+              }
+            }
+          }
+        }
+
+        return best;
+      }
+
+      //*******************************
+      /// Inserts a timer that expires 'delay' ticks from now.
+      /// A delay of zero expires on the next call to tick.
+      //*******************************
+      void insert(id_type id, uint32_t delay)
+      {
+        ptimers[id].expiry = now + delay;
+        link(id);
+        ++n_active;
+      }
+
+      //*******************************
+      /// Removes an active timer.
+      //*******************************
+      void remove(id_type id)
+      {
+        unlink(id);
+        --n_active;
+      }
+
+      //*******************************
+      /// Advances the wheel by 'count' ticks, calling action(id) for each
+      /// timer that expires, in order of expiry. The timer has been removed
+      /// from the wheel before the action is called. Timers that are already
+      /// due are expired even if 'count' is zero.
+      //*******************************
+      template <typename TAction>
+      void tick(uint32_t count, TAction& action)
+      {
+        expire_current(action);
+
+        while (count > 0)
+        {
+          if (n_active == 0)
+          {
+            now += count;
+            break;
+          }
+
+          // Jump to the next slot boundary of the lowest level with timers.
+          // No timers are due before then.
+          uint_least8_t level = 0;
+
+          while (plevel_counts[level] == 0)
+          {
+            ++level;
+          }
+
+          const uint32_t shift = uint32_t(level) * slot_bits;
+          const uint32_t mask  = (uint32_t(1) << shift) - 1;
+
+          uint32_t step = (level == 0) ? 1 : ((mask - (now & mask)) + 1);
+
+          if (step > count)
+          {
+            step = count;
+          }
+
+          now   += step;
+          count -= step;
+
+          cascade();
+          expire_current(action);
+        }
+      }
+
+    private:
+
+      //*******************************
+      /// Links the timer into the slot that covers its expiry.
+      //*******************************
+      void link(id_type id)
+      {
+        TTimer& timer = ptimers[id];
+
+        const uint32_t delta = timer.expiry - now;
+
+        uint_least8_t level = 0;
+
+        while (((level + 1) < levels) && ((delta >> ((level + 1) * slot_bits)) != 0))
+        {
+          ++level;
+        }
+
+        const uint32_t shift = uint32_t(level) * slot_bits;
+
+        uint32_t index;
+
+        if (((shift + slot_bits) < 32) && ((delta >> (shift + slot_bits)) != 0))
+        {
+          // Beyond the top level. Wait in the farthest slot.
+          index = ((now >> shift) - 1) & slot_mask;
+        }
+        else
+        {
+          index = (timer.expiry >> shift) & slot_mask;
+        }
+
+        const uint32_t slot = (uint32_t(level) << slot_bits) + index;
+
+        timer.slot     = slot;
+        timer.previous = etl::timer::wheel_id::NO_TIMER;
+        timer.next     = pslots[slot];
+
+        if (timer.next != etl::timer::wheel_id::NO_TIMER)
+        {
+          ptimers[timer.next].previous = id;
+        }
+
+        pslots[slot] = id;
+        ++plevel_counts[level];
+      }
+
+      //*******************************
+      /// Unlinks the timer from its slot.
+      //*******************************
+      void unlink(id_type id)
+      {
+        TTimer& timer = ptimers[id];
+
+        if (timer.previous == etl::timer::wheel_id::NO_TIMER)
+        {
+          pslots[timer.slot] = timer.next;
+        }
+        else
+        {
+          ptimers[timer.previous].next = timer.next;
+        }
+
+        if (timer.next != etl::timer::wheel_id::NO_TIMER)
+        {
+          ptimers[timer.next].previous = timer.previous;
+        }
+
+        --plevel_counts[timer.slot >> slot_bits];
+
+        timer.previous = etl::timer::wheel_id::NO_TIMER;
+        timer.next     = etl::timer::wheel_id::NO_TIMER;
+        timer.slot     = NO_SLOT;
+      }
+
+      //*******************************
+      /// Moves the timers in the slots that have just become current down a
+      /// level, starting from the highest.
+      //*******************************
+      void cascade()
+      {
+        if ((now & slot_mask) != 0)
+        {
+          return;
+        }
+
+        uint_least8_t top = 1;
+
+        while (((top + 1) < levels) && ((now & ((uint32_t(1) << ((top + 1) * slot_bits)) - 1)) == 0))
+        {
+          ++top;
+        }
+
+        for (uint_least8_t level = top; level > 0; --level)
+        {
+          if (level < levels)
+          {
+            const uint32_t slot = (uint32_t(level) << slot_bits) + ((now >> (level * slot_bits)) & slot_mask);
+
+            id_type id = pslots[slot];
+
+            pslots[slot] = etl::timer::wheel_id::NO_TIMER;
+
+            while (id != etl::timer::wheel_id::NO_TIMER)
+            {
+              id_type next = ptimers[id].next;
+              --plevel_counts[level];
+              link(id);
+              id = next;
+            }
+          }
+        }
+      }
+
+      //*******************************
+      /// Expires the timers in the current level 0 slot.
+      //*******************************
+      template <typename TAction>
+      void expire_current(TAction& action)
+      {
+        if (plevel_counts[0] != 0)
+        {
+          uint32_t& head = pslots[now & slot_mask];
+
+          while (head != etl::timer::wheel_id::NO_TIMER)
+          {
+            id_type id = head;
+            remove(id);
+            action(id);
+          }
+        }
+      }
+
+      TTimer* const        ptimers;
+      uint32_t* const      pslots;        ///< The head of each slot's list, level by level.
+      uint32_t* const      plevel_counts; ///< The number of timers in each level.
+      const uint_least8_t  levels;
+      const uint_least8_t  slot_bits;
+      const uint32_t       slot_mask;
+      uint32_t             now;
+      uint32_t             n_active;
+    };
+  }
+}
+
+#endif
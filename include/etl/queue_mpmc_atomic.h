@@ -0,0 +1,552 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_MPMC_QUEUE_ATOMIC_INCLUDED
+#define ETL_MPMC_QUEUE_ATOMIC_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+
+#include "platform.h"
+#include "alignment.h"
+#include "parameter_type.h"
+#include "atomic.h"
+#include "memory_model.h"
+#include "integral_limits.h"
+#include "type_traits.h"
+#include "static_assert.h"
+#include "nullptr.h"
+
+#if ETL_HAS_ATOMIC
+
+namespace etl
+{
+  namespace private_queue_mpmc_atomic
+  {
+    //*************************************************************************
+    /// A slot in the queue.
+    /// The sequence number says whose turn it is to use the slot.
+    //*************************************************************************
+    template <typename T, typename TSize>
+    struct cell
+    {
+      etl::atomic<TSize> sequence;
+      typename etl::aligned_storage<sizeof(T), etl::alignment_of<T>::value>::type value;
+    };
+  }
+
+  //***************************************************************************
+  ///\ingroup queue_mpmc
+  ///\brief This is the base for all queue_mpmc_atomics that contain a particular type.
+  ///\details Normally a reference to this type will be taken from a derived queue_mpmc_atomic.
+  ///\code
+  /// etl::queue_mpmc_atomic<int, 16> myQueue;
+  /// etl::iqueue_mpmc_atomic<int>& iQueue = myQueue;
+  ///\endcode
+  /// This queue supports concurrent access by multiple producers and multiple
+  /// consumers without locks.
+  /// Each slot has a sequence number. A producer claims the slot at the write
+  /// position when its sequence number equals the position, and a consumer
+  /// claims the slot at the read position when its sequence number is one more.
+  /// \tparam T The type of value that the queue_mpmc_atomic holds.
+  //***************************************************************************
+  template <typename T, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class iqueue_mpmc_atomic
+  {
+  private:
+
+    typedef typename etl::parameter_type<T>::type parameter_t;
+
+  public:
+
+    typedef T                                                  value_type;      ///< The type stored in the queue.
+    typedef T&                                                 reference;       ///< A reference to the type used in the queue.
+    typedef const T&                                           const_reference; ///< A const reference to the type used in the queue.
+    typedef typename etl::size_type_lookup<MEMORY_MODEL>::type size_type;       ///< The type used for determining the size of the queue.
+
+    //*************************************************************************
+    /// Push a value to the queue.
+    //*************************************************************************
+    bool push(parameter_t value)
+    {
+      size_type position;
+      cell_t* p_cell = claim_write(position);
+
+      if (p_cell != nullptr)
+      {
+        ::new (&p_cell->value) T(value);
+        publish_write(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_QUEUE_MPMC_ATOMIC_FORCE_CPP03)
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename ... Args>
+    bool emplace(Args&&... args)
+    {
+      size_type position;
+      cell_t* p_cell = claim_write(position);
+
+      if (p_cell != nullptr)
+      {
+        ::new (&p_cell->value) T(std::forward<Args>(args)...);
+        publish_write(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#else
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1>
+    bool emplace(const T1& value1)
+    {
+      size_type position;
+      cell_t* p_cell = claim_write(position);
+
+      if (p_cell != nullptr)
+      {
+        ::new (&p_cell->value) T(value1);
+        publish_write(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    bool emplace(const T1& value1, const T2& value2)
+    {
+      size_type position;
+      cell_t* p_cell = claim_write(position);
+
+      if (p_cell != nullptr)
+      {
+        ::new (&p_cell->value) T(value1, value2);
+        publish_write(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3)
+    {
+      size_type position;
+      cell_t* p_cell = claim_write(position);
+
+      if (p_cell != nullptr)
+      {
+        ::new (&p_cell->value) T(value1, value2, value3);
+        publish_write(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      size_type position;
+      cell_t* p_cell = claim_write(position);
+
+      if (p_cell != nullptr)
+      {
+        ::new (&p_cell->value) T(value1, value2, value3, value4);
+        publish_write(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#endif
+
+    //*************************************************************************
+    /// Pop a value from the queue.
+    //*************************************************************************
+    bool pop(reference value)
+    {
+      size_type position;
+      cell_t* p_cell = claim_read(position);
+
+      if (p_cell != nullptr)
+      {
+        T& item = *reinterpret_cast<T*>(&p_cell->value);
+        value = item;
+        item.~T();
+        publish_read(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is empty.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue and discard.
+    //*************************************************************************
+    bool pop()
+    {
+      size_type position;
+      cell_t* p_cell = claim_read(position);
+
+      if (p_cell != nullptr)
+      {
+        reinterpret_cast<T*>(&p_cell->value)->~T();
+        publish_read(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is empty.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Clear the queue.
+    //*************************************************************************
+    void clear()
+    {
+      while (pop())
+      {
+        // Do nothing.
+      }
+    }
+
+    //*************************************************************************
+    /// Is the queue empty?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    //*************************************************************************
+    /// Is the queue full?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool full() const
+    {
+      return size() == MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items in the queue?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type size() const
+    {
+      size_type read_index  = read_position.load(etl::memory_order_acquire);
+      size_type write_index = write_position.load(etl::memory_order_acquire);
+
+      signed_size_type n = signed_size_type(size_type(write_index - read_index));
+
+      // Items being pushed and popped may make this briefly out of range.
+      if (n < 0)
+      {
+        return 0;
+      }
+      else if (size_type(n) > MAX_SIZE)
+      {
+        return MAX_SIZE;
+      }
+      else
+      {
+        return size_type(n);
+      }
+    }
+
+    //*************************************************************************
+    /// How much free space available in the queue.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type available() const
+    {
+      return MAX_SIZE - size();
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return MAX_SIZE;
+    }
+
+  protected:
+
+    typedef private_queue_mpmc_atomic::cell<T, size_type> cell_t;
+
+    //*************************************************************************
+    /// The constructor that is called from derived classes.
+    //*************************************************************************
+    iqueue_mpmc_atomic(cell_t* p_cells_, size_type max_size_)
+      : p_cells(p_cells_),
+        MAX_SIZE(max_size_),
+        write_position(0),
+        read_position(0)
+    {
+    }
+
+    //*************************************************************************
+    /// Sets each slot ready for the first push.
+    /// Called by the derived class once the slots have been constructed.
+    //*************************************************************************
+    void initialise()
+    {
+      for (size_type i = 0; i < MAX_SIZE; ++i)
+      {
+        p_cells[i].sequence.store(i, etl::memory_order_relaxed);
+      }
+    }
+
+  private:
+
+    typedef typename etl::make_signed<size_type>::type signed_size_type;
+
+    //*************************************************************************
+    /// Claims the slot at the write position.
+    /// Returns nullptr if the queue is full.
+    //*************************************************************************
+    cell_t* claim_write(size_type& position)
+    {
+      position = write_position.load(etl::memory_order_relaxed);
+
+      while (true)
+      {
+        cell_t& c = p_cells[position & (MAX_SIZE - 1)];
+
+        size_type        sequence   = c.sequence.load(etl::memory_order_acquire);
+        signed_size_type difference = signed_size_type(size_type(sequence - position));
+
+        if (difference == 0)
+        {
+          // The slot is free. Try to take it.
+          if (write_position.compare_exchange_weak(position, size_type(position + 1), etl::memory_order_relaxed))
+          {
+            return &c;
+          }
+        }
+        else if (difference < 0)
+        {
+          // The slot still holds an item from the previous lap.
+          return nullptr;
+        }
+        else
+        {
+          // Another producer took the slot.
+          position = write_position.load(etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Hands a written slot to the consumers.
+    //*************************************************************************
+    static void publish_write(cell_t* p_cell, size_type position)
+    {
+      p_cell->sequence.store(size_type(position + 1), etl::memory_order_release);
+    }
+
+    //*************************************************************************
+    /// Claims the slot at the read position.
+    /// Returns nullptr if the queue is empty.
+    //*************************************************************************
+    cell_t* claim_read(size_type& position)
+    {
+      position = read_position.load(etl::memory_order_relaxed);
+
+      while (true)
+      {
+        cell_t& c = p_cells[position & (MAX_SIZE - 1)];
+
+        size_type        sequence   = c.sequence.load(etl::memory_order_acquire);
+        signed_size_type difference = signed_size_type(size_type(sequence - size_type(position + 1)));
+
+        if (difference == 0)
+        {
+          // The slot has been written. Try to take it.
+          if (read_position.compare_exchange_weak(position, size_type(position + 1), etl::memory_order_relaxed))
+          {
+            return &c;
+          }
+        }
+        else if (difference < 0)
+        {
+          // The slot has not been written yet.
+          return nullptr;
+        }
+        else
+        {
+          // Another consumer took the slot.
+          position = read_position.load(etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Hands a read slot back to the producers for the next lap.
+    //*************************************************************************
+    void publish_read(cell_t* p_cell, size_type position)
+    {
+      p_cell->sequence.store(size_type(position + MAX_SIZE), etl::memory_order_release);
+    }
+
+    // Disable copy construction and assignment.
+    iqueue_mpmc_atomic(const iqueue_mpmc_atomic&);
+    iqueue_mpmc_atomic& operator =(const iqueue_mpmc_atomic&);
+
+    // Shared, read only.
+    cell_t* const   p_cells;  ///< The slots.
+    const size_type MAX_SIZE; ///< The number of slots. A power of two.
+
+    char padding0[ETL_CACHE_LINE_SIZE];
+
+    etl::atomic<size_type> write_position; ///< The next position to push to.
+
+    char padding1[ETL_CACHE_LINE_SIZE];
+
+    etl::atomic<size_type> read_position;  ///< The next position to pop from.
+
+    char padding2[ETL_CACHE_LINE_SIZE];
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_MPMC_QUEUE_ATOMIC) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iqueue_mpmc_atomic()
+    {
+    }
+#else
+  protected:
+    ~iqueue_mpmc_atomic()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  ///\ingroup queue_mpmc
+  /// A fixed capacity lock free mpmc queue.
+  /// This queue supports concurrent access by multiple producers and multiple consumers.
+  /// \tparam T            The type this queue should support.
+  /// \tparam SIZE         The maximum capacity of the queue. Must be a power of two.
+  /// \tparam MEMORY_MODEL The memory model for the queue. Determines the type of the internal counter variables.
+  //***************************************************************************
+  template <typename T, size_t SIZE, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_mpmc_atomic : public etl::iqueue_mpmc_atomic<T, MEMORY_MODEL>
+  {
+  private:
+
+    typedef etl::iqueue_mpmc_atomic<T, MEMORY_MODEL> base_t;
+
+  public:
+
+    typedef typename base_t::size_type size_type;
+
+    ETL_STATIC_ASSERT((SIZE != 0) && ((SIZE & (SIZE - 1)) == 0), "Size must be a power of two");
+    // The positions wrap, so must stay well within the range of size_type.
+    ETL_STATIC_ASSERT((SIZE <= ((etl::integral_limits<size_type>::max / 4) + 1)), "Size too large for memory model");
+
+    static const size_type MAX_SIZE = size_type(SIZE);
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    queue_mpmc_atomic()
+      : base_t(cells, MAX_SIZE)
+    {
+      base_t::initialise();
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~queue_mpmc_atomic()
+    {
+      base_t::clear();
+    }
+
+  private:
+
+    queue_mpmc_atomic(const queue_mpmc_atomic&);
+    queue_mpmc_atomic& operator = (const queue_mpmc_atomic&);
+
+    /// The slots used in the queue_mpmc_atomic.
+    typename base_t::cell_t cells[MAX_SIZE];
+  };
+}
+
+#endif
+
+#endif
@@ -42,6 +42,7 @@ SOFTWARE.
 #include "mutex.h"
 #include "memory_model.h"
 #include "integral_limits.h"
+#include "private/queue_wait.h"
 
 #undef ETL_FILE
 #define ETL_FILE "48"
@@ -161,6 +162,8 @@ namespace etl
 
       access.unlock();
 
+      notify_pushed(result);
+
       return result;
     }
 
@@ -178,6 +181,8 @@ namespace etl
 
       access.unlock();
 
+      notify_pushed(result);
+
       return result;
     }
 #else
@@ -194,6 +199,8 @@ namespace etl
 
       access.unlock();
 
+      notify_pushed(result);
+
       return result;
     }
 
@@ -210,6 +217,8 @@ namespace etl
 
       access.unlock();
 
+      notify_pushed(result);
+
       return result;
     }
 
@@ -226,6 +235,8 @@ namespace etl
 
       access.unlock();
 
+      notify_pushed(result);
+
       return result;
     }
 
@@ -242,6 +253,8 @@ namespace etl
 
       access.unlock();
 
+      notify_pushed(result);
+
       return result;
     }
 #endif
@@ -257,6 +270,8 @@ namespace etl
 
       access.unlock();
 
+      notify_popped(result);
+
       return result;
     }
 
@@ -271,9 +286,35 @@ namespace etl
 
       access.unlock();
 
+      notify_popped(result);
+
       return result;
     }
 
+#if ETL_HAS_QUEUE_WAIT
+    //*************************************************************************
+    /// Push a value to the queue, waiting up to 'timeout' for space.
+    /// Only available when ETL_QUEUE_WAIT is defined.
+    /// \return <b>true</b> if the value was pushed.
+    //*************************************************************************
+    template <typename TRep, typename TPeriod>
+    bool push_wait(parameter_t value, const std::chrono::duration<TRep, TPeriod>& timeout)
+    {
+      return not_full.wait([&]() { return push(value); }, timeout);
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue, waiting up to 'timeout' for one to arrive.
+    /// Only available when ETL_QUEUE_WAIT is defined.
+    /// \return <b>true</b> if a value was popped.
+    //*************************************************************************
+    template <typename TRep, typename TPeriod>
+    bool pop_wait(reference value, const std::chrono::duration<TRep, TPeriod>& timeout)
+    {
+      return not_empty.wait([&]() { return pop(value); }, timeout);
+    }
+#endif
+
     //*************************************************************************
     /// Clear the queue.
     //*************************************************************************
@@ -287,6 +328,8 @@ namespace etl
       }
 
       access.unlock();
+
+      notify_popped(true);
     }
 
     //*************************************************************************
@@ -533,6 +576,41 @@ namespace etl
     T* p_buffer; ///< The internal buffer.
 
     mutable etl::mutex access; ///< The object that locks/unlocks access.
+
+#if ETL_HAS_QUEUE_WAIT
+    //*************************************************************************
+    /// Wakes any threads waiting in pop_wait.
+    //*************************************************************************
+    void notify_pushed(bool result)
+    {
+      if (result)
+      {
+        not_empty.notify();
+      }
+    }
+
+    //*************************************************************************
+    /// Wakes any threads waiting in push_wait.
+    //*************************************************************************
+    void notify_popped(bool result)
+    {
+      if (result)
+      {
+        not_full.notify();
+      }
+    }
+
+    etl::private_queue_wait::event not_empty; ///< Signalled when a value is pushed.
+    etl::private_queue_wait::event not_full;  ///< Signalled when a value is popped.
+#else
+    void notify_pushed(bool)
+    {
+    }
+
+    void notify_popped(bool)
+    {
+    }
+#endif
   };
 
   //***************************************************************************
@@ -42,6 +42,7 @@ SOFTWARE.
 #include "atomic.h"
 #include "memory_model.h"
 #include "integral_limits.h"
+#include "private/queue_wait.h"
 
 #undef ETL_FILE
 #define ETL_FILE "47"
@@ -217,6 +218,8 @@ namespace etl
 
         write.store(next_index, etl::memory_order_release);
 
+        notify_pushed();
+
         return true;
       }
 
@@ -241,6 +244,8 @@ namespace etl
 
         write.store(next_index, etl::memory_order_release);
 
+        notify_pushed();
+
         return true;
       }
 
@@ -264,6 +269,8 @@ namespace etl
 
         write.store(next_index, etl::memory_order_release);
 
+        notify_pushed();
+
         return true;
       }
 
@@ -287,6 +294,8 @@ namespace etl
 
         write.store(next_index, etl::memory_order_release);
 
+        notify_pushed();
+
         return true;
       }
 
@@ -310,6 +319,8 @@ namespace etl
 
         write.store(next_index, etl::memory_order_release);
 
+        notify_pushed();
+
         return true;
       }
 
@@ -333,6 +344,8 @@ namespace etl
 
         write.store(next_index, etl::memory_order_release);
 
+        notify_pushed();
+
         return true;
       }
 
@@ -361,6 +374,8 @@ namespace etl
 
       read.store(next_index, etl::memory_order_release);
 
+      notify_popped();
+
       return true;
     }
 
@@ -383,9 +398,35 @@ namespace etl
 
       read.store(next_index, etl::memory_order_release);
 
+      notify_popped();
+
       return true;
     }
 
+#if ETL_HAS_QUEUE_WAIT
+    //*************************************************************************
+    /// Push a value to the queue, waiting up to 'timeout' for space.
+    /// Only available when ETL_QUEUE_WAIT is defined.
+    /// \return <b>true</b> if the value was pushed.
+    //*************************************************************************
+    template <typename TRep, typename TPeriod>
+    bool push_wait(parameter_t value, const std::chrono::duration<TRep, TPeriod>& timeout)
+    {
+      return not_full.wait([&]() { return push(value); }, timeout);
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue, waiting up to 'timeout' for one to arrive.
+    /// Only available when ETL_QUEUE_WAIT is defined.
+    /// \return <b>true</b> if a value was popped.
+    //*************************************************************************
+    template <typename TRep, typename TPeriod>
+    bool pop_wait(reference value, const std::chrono::duration<TRep, TPeriod>& timeout)
+    {
+      return not_empty.wait([&]() { return pop(value); }, timeout);
+    }
+#endif
+
     //*************************************************************************
     /// Clear the queue.
     /// Must be called from thread that pops the queue or when there is no
@@ -417,6 +458,35 @@ namespace etl
     iqueue_spsc_atomic& operator =(const iqueue_spsc_atomic&);
 
     T* p_buffer; ///< The internal buffer.
+
+#if ETL_HAS_QUEUE_WAIT
+    //*************************************************************************
+    /// Wakes any threads waiting in pop_wait.
+    //*************************************************************************
+    void notify_pushed()
+    {
+      not_empty.notify();
+    }
+
+    //*************************************************************************
+    /// Wakes any threads waiting in push_wait.
+    //*************************************************************************
+    void notify_popped()
+    {
+      not_full.notify();
+    }
+
+    etl::private_queue_wait::event not_empty; ///< Signalled when a value is pushed.
+    etl::private_queue_wait::event not_full;  ///< Signalled when a value is popped.
+#else
+    void notify_pushed()
+    {
+    }
+
+    void notify_popped()
+    {
+    }
+#endif
   };
 
   //***************************************************************************
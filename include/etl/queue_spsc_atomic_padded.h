@@ -0,0 +1,683 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_QUEUE_SPSC_ATOMIC_PADDED_INCLUDED
+#define ETL_QUEUE_SPSC_ATOMIC_PADDED_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+
+#include "platform.h"
+#include "alignment.h"
+#include "parameter_type.h"
+#include "atomic.h"
+#include "memory_model.h"
+#include "integral_limits.h"
+#include "array_view.h"
+#include "static_assert.h"
+
+#if ETL_HAS_ATOMIC
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup queue_spsc_atomic
+  ///\brief A single producer, single consumer queue that avoids false sharing.
+  ///\details The producer's and consumer's indexes are kept on separate cache lines.
+  /// Each side keeps a cached copy of the other side's index and only reloads it
+  /// when the cached copy says that the queue is full (or empty).
+  /// Items may be pushed and popped in batches, or written and read in place
+  /// through reserve_write / commit and peek_read / release.
+  ///\code
+  /// etl::queue_spsc_atomic_padded<int, 10> myQueue;
+  /// etl::iqueue_spsc_atomic_padded<int>& iQueue = myQueue;
+  ///\endcode
+  /// This queue supports concurrent access by one producer and one consumer.
+  /// \tparam T The type of value that the queue holds.
+  //***************************************************************************
+  template <typename T, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class iqueue_spsc_atomic_padded
+  {
+  private:
+
+    typedef typename etl::parameter_type<T>::type parameter_t;
+
+  public:
+
+    typedef T                                                      value_type;      ///< The type stored in the queue.
+    typedef T&                                                     reference;       ///< A reference to the type used in the queue.
+    typedef const T&                                               const_reference; ///< A const reference to the type used in the queue.
+    typedef typename etl::size_type_lookup<MEMORY_MODEL>::type     size_type;       ///< The type used for determining the size of the queue.
+    typedef etl::array_view<T>                                     span_type;       ///< A contiguous run of items in the queue.
+
+    //*************************************************************************
+    /// Push a value to the queue.
+    /// Producer only.
+    //*************************************************************************
+    bool push(parameter_t value)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type next_index  = get_next_index(write_index, RESERVED);
+
+      if (can_write(next_index))
+      {
+        ::new (&p_buffer[write_index]) T(value);
+
+        write.store(next_index, etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_QUEUE_ATOMIC_FORCE_CPP03)
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    /// Producer only.
+    //*************************************************************************
+    template <typename ... Args>
+    bool emplace(Args&&... args)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type next_index  = get_next_index(write_index, RESERVED);
+
+      if (can_write(next_index))
+      {
+        ::new (&p_buffer[write_index]) T(std::forward<Args>(args)...);
+
+        write.store(next_index, etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#else
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    /// Producer only.
+    //*************************************************************************
+    template <typename T1>
+    bool emplace(const T1& value1)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type next_index  = get_next_index(write_index, RESERVED);
+
+      if (can_write(next_index))
+      {
+        ::new (&p_buffer[write_index]) T(value1);
+
+        write.store(next_index, etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    /// Producer only.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    bool emplace(const T1& value1, const T2& value2)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type next_index  = get_next_index(write_index, RESERVED);
+
+      if (can_write(next_index))
+      {
+        ::new (&p_buffer[write_index]) T(value1, value2);
+
+        write.store(next_index, etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    /// Producer only.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type next_index  = get_next_index(write_index, RESERVED);
+
+      if (can_write(next_index))
+      {
+        ::new (&p_buffer[write_index]) T(value1, value2, value3);
+
+        write.store(next_index, etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    /// Producer only.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type next_index  = get_next_index(write_index, RESERVED);
+
+      if (can_write(next_index))
+      {
+        ::new (&p_buffer[write_index]) T(value1, value2, value3, value4);
+
+        write.store(next_index, etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#endif
+
+    //*************************************************************************
+    /// Push up to 'n' values to the queue.
+    /// Producer only.
+    /// \return The number of values pushed.
+    //*************************************************************************
+    size_type push_n(const T* p_values, size_type n)
+    {
+      size_type count = 0;
+
+      // At most two passes; one either side of the end of the buffer.
+      while (count < n)
+      {
+        span_type span = reserve_write(n - count);
+
+        if (span.empty())
+        {
+          break;
+        }
+
+        for (size_t i = 0; i < span.size(); ++i)
+        {
+          ::new (&span[i]) T(p_values[count + i]);
+        }
+
+        commit(size_type(span.size()));
+        count += size_type(span.size());
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Reserve up to 'n' contiguous items at the back of the queue.
+    /// The items are uninitialised storage; types that are not trivial must be
+    /// constructed with placement new. The span may be shorter than 'n' if the
+    /// queue is nearly full or the space wraps around the end of the buffer.
+    /// Nothing is visible to the consumer until commit is called.
+    /// Producer only.
+    //*************************************************************************
+    span_type reserve_write(size_type n)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type count       = writable(write_index);
+
+      if (count < n)
+      {
+        read_cache = read.load(etl::memory_order_acquire);
+        count      = writable(write_index);
+      }
+
+      if (count > n)
+      {
+        count = n;
+      }
+
+      return span_type(p_buffer + write_index, p_buffer + write_index + count);
+    }
+
+    //*************************************************************************
+    /// Publish the first 'n' items of the last reserve_write.
+    /// Producer only.
+    //*************************************************************************
+    void commit(size_type n)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed) + n;
+
+      if (write_index == RESERVED)
+      {
+        write_index = 0;
+      }
+
+      write.store(write_index, etl::memory_order_release);
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue.
+    /// Consumer only.
+    //*************************************************************************
+    bool pop(reference value)
+    {
+      size_type read_index = read.load(etl::memory_order_relaxed);
+
+      if (!can_read(read_index))
+      {
+        // Queue is empty
+        return false;
+      }
+
+      value = p_buffer[read_index];
+      p_buffer[read_index].~T();
+
+      read.store(get_next_index(read_index, RESERVED), etl::memory_order_release);
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue and discard.
+    /// Consumer only.
+    //*************************************************************************
+    bool pop()
+    {
+      size_type read_index = read.load(etl::memory_order_relaxed);
+
+      if (!can_read(read_index))
+      {
+        // Queue is empty
+        return false;
+      }
+
+      p_buffer[read_index].~T();
+
+      read.store(get_next_index(read_index, RESERVED), etl::memory_order_release);
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Pop up to 'n' values from the queue.
+    /// Consumer only.
+    /// \return The number of values popped.
+    //*************************************************************************
+    size_type pop_n(T* p_values, size_type n)
+    {
+      size_type count = 0;
+
+      // At most two passes; one either side of the end of the buffer.
+      while (count < n)
+      {
+        span_type span = peek_read(n - count);
+
+        if (span.empty())
+        {
+          break;
+        }
+
+        for (size_t i = 0; i < span.size(); ++i)
+        {
+          p_values[count + i] = span[i];
+        }
+
+        release(size_type(span.size()));
+        count += size_type(span.size());
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Returns up to 'n' contiguous items from the front of the queue, in place.
+    /// The span may be shorter than 'n' if the items wrap around the end of the buffer.
+    /// The items stay in the queue until release is called.
+    /// Consumer only.
+    //*************************************************************************
+    span_type peek_read(size_type n = etl::integral_limits<size_type>::max)
+    {
+      size_type read_index = read.load(etl::memory_order_relaxed);
+      size_type count      = readable(read_index);
+
+      if (count < n)
+      {
+        write_cache = write.load(etl::memory_order_acquire);
+        count       = readable(read_index);
+      }
+
+      if (count > n)
+      {
+        count = n;
+      }
+
+      return span_type(p_buffer + read_index, p_buffer + read_index + count);
+    }
+
+    //*************************************************************************
+    /// Destroys and removes the first 'n' items of the last peek_read.
+    /// Consumer only.
+    //*************************************************************************
+    void release(size_type n)
+    {
+      size_type read_index = read.load(etl::memory_order_relaxed);
+
+      for (size_type i = 0; i < n; ++i)
+      {
+        p_buffer[read_index + i].~T();
+      }
+
+      read_index += n;
+
+      if (read_index == RESERVED)
+      {
+        read_index = 0;
+      }
+
+      read.store(read_index, etl::memory_order_release);
+    }
+
+    //*************************************************************************
+    /// Clear the queue.
+    /// Must be called from thread that pops the queue or when there is no
+    /// possibility of concurrent access.
+    //*************************************************************************
+    void clear()
+    {
+      span_type span = peek_read();
+
+      while (!span.empty())
+      {
+        release(size_type(span.size()));
+        span = peek_read();
+      }
+    }
+
+    //*************************************************************************
+    /// Is the queue empty?
+    /// Accurate from the 'pop' thread.
+    /// 'Not empty' is a guess from the 'push' thread.
+    //*************************************************************************
+    bool empty() const
+    {
+      return read.load(etl::memory_order_acquire) == write.load(etl::memory_order_acquire);
+    }
+
+    //*************************************************************************
+    /// Is the queue full?
+    /// Accurate from the 'push' thread.
+    /// 'Not full' is a guess from the 'pop' thread.
+    //*************************************************************************
+    bool full() const
+    {
+      size_type next_index = get_next_index(write.load(etl::memory_order_acquire), RESERVED);
+
+      return (next_index == read.load(etl::memory_order_acquire));
+    }
+
+    //*************************************************************************
+    /// How many items in the queue?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type size() const
+    {
+      size_type write_index = write.load(etl::memory_order_acquire);
+      size_type read_index  = read.load(etl::memory_order_acquire);
+
+      if (write_index >= read_index)
+      {
+        return write_index - read_index;
+      }
+      else
+      {
+        return RESERVED - read_index + write_index;
+      }
+    }
+
+    //*************************************************************************
+    /// How much free space available in the queue.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type available() const
+    {
+      return RESERVED - size() - 1;
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return RESERVED - 1;
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return RESERVED - 1;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// The constructor that is called from derived classes.
+    //*************************************************************************
+    iqueue_spsc_atomic_padded(T* p_buffer_, size_type reserved_)
+      : p_buffer(p_buffer_),
+        RESERVED(reserved_),
+        write(0),
+        read_cache(0),
+        read(0),
+        write_cache(0)
+    {
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Calculate the next index.
+    //*************************************************************************
+    static size_type get_next_index(size_type index, size_type maximum)
+    {
+      ++index;
+
+      if (index == maximum)
+      {
+        index = 0;
+      }
+
+      return index;
+    }
+
+    //*************************************************************************
+    /// Is there space for the item before 'next_index'?
+    /// Only reloads the read index if the cached copy says the queue is full.
+    //*************************************************************************
+    bool can_write(size_type next_index)
+    {
+      if (next_index == read_cache)
+      {
+        read_cache = read.load(etl::memory_order_acquire);
+      }
+
+      return next_index != read_cache;
+    }
+
+    //*************************************************************************
+    /// Is there an item at 'read_index'?
+    /// Only reloads the write index if the cached copy says the queue is empty.
+    //*************************************************************************
+    bool can_read(size_type read_index)
+    {
+      if (read_index == write_cache)
+      {
+        write_cache = write.load(etl::memory_order_acquire);
+      }
+
+      return read_index != write_cache;
+    }
+
+    //*************************************************************************
+    /// The number of contiguous free items from 'write_index', according to the cached read index.
+    //*************************************************************************
+    size_type writable(size_type write_index) const
+    {
+      if (read_cache > write_index)
+      {
+        return read_cache - write_index - 1;
+      }
+      else
+      {
+        // Up to the end of the buffer. The last free item is never used if the read index is at the start.
+        return RESERVED - write_index - ((read_cache == 0) ? 1 : 0);
+      }
+    }
+
+    //*************************************************************************
+    /// The number of contiguous items from 'read_index', according to the cached write index.
+    //*************************************************************************
+    size_type readable(size_type read_index) const
+    {
+      if (write_cache >= read_index)
+      {
+        return write_cache - read_index;
+      }
+      else
+      {
+        return RESERVED - read_index;
+      }
+    }
+
+    // Disable copy construction and assignment.
+    iqueue_spsc_atomic_padded(const iqueue_spsc_atomic_padded&);
+    iqueue_spsc_atomic_padded& operator =(const iqueue_spsc_atomic_padded&);
+
+    // Shared, read only.
+    T* const        p_buffer; ///< The internal buffer.
+    const size_type RESERVED; ///< The number of items in the buffer.
+
+    char padding0[ETL_CACHE_LINE_SIZE];
+
+    // Written by the producer.
+    etl::atomic<size_type> write;      ///< Where to input new data.
+    size_type              read_cache; ///< The producer's copy of 'read'.
+
+    char padding1[ETL_CACHE_LINE_SIZE];
+
+    // Written by the consumer.
+    etl::atomic<size_type> read;        ///< Where to get the oldest data.
+    size_type              write_cache; ///< The consumer's copy of 'write'.
+
+    char padding2[ETL_CACHE_LINE_SIZE];
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_SPSC_QUEUE_ATOMIC) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iqueue_spsc_atomic_padded()
+    {
+    }
+#else
+  protected:
+    ~iqueue_spsc_atomic_padded()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  ///\ingroup queue_spsc_atomic
+  /// A fixed capacity spsc queue that keeps the producer's and consumer's data
+  /// on separate cache lines.
+  /// This queue supports concurrent access by one producer and one consumer.
+  /// \tparam T            The type this queue should support.
+  /// \tparam SIZE         The maximum capacity of the queue.
+  /// \tparam MEMORY_MODEL The memory model for the queue. Determines the type of the internal counter variables.
+  //***************************************************************************
+  template <typename T, size_t SIZE, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_spsc_atomic_padded : public iqueue_spsc_atomic_padded<T, MEMORY_MODEL>
+  {
+  private:
+
+    typedef typename etl::iqueue_spsc_atomic_padded<T, MEMORY_MODEL> base_t;
+
+  public:
+
+    typedef typename base_t::size_type size_type;
+
+  private:
+
+    static const size_type RESERVED_SIZE = size_type(SIZE + 1);
+
+  public:
+
+    ETL_STATIC_ASSERT((SIZE <= (etl::integral_limits<size_type>::max - 1)), "Size too large for memory model");
+
+    static const size_type MAX_SIZE = size_type(SIZE);
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    queue_spsc_atomic_padded()
+      : base_t(reinterpret_cast<T*>(&buffer[0]), RESERVED_SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~queue_spsc_atomic_padded()
+    {
+      base_t::clear();
+    }
+
+  private:
+
+    /// The uninitialised buffer of T used in the queue.
+    typename etl::aligned_storage<sizeof(T), etl::alignment_of<T>::value>::type buffer[RESERVED_SIZE];
+  };
+}
+
+#endif
+
+#endif
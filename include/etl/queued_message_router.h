@@ -0,0 +1,361 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_QUEUED_MESSAGE_ROUTER_INCLUDED
+#define ETL_QUEUED_MESSAGE_ROUTER_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "message.h"
+#include "message_router.h"
+#include "message_pool.h"
+#include "queue_spsc_atomic.h"
+#include "intrusive_mpsc_queue.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "nullptr.h"
+
+#undef ETL_FILE
+#define ETL_FILE "57"
+
+#if ETL_HAS_ATOMIC && ETL_CPP11_SUPPORTED && !defined(ETL_NO_STL)
+
+//*****************************************************************************
+///\defgroup queued_message_router queued_message_router
+/// A message router that queues messages to be handled later, usually by
+/// another thread.
+///\ingroup messaging
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// Base exception class for queued message router
+  //***************************************************************************
+  class queued_message_router_exception : public etl::message_router_exception
+  {
+  public:
+
+    queued_message_router_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : message_router_exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The message queue is full.
+  //***************************************************************************
+  class queued_message_router_full : public etl::queued_message_router_exception
+  {
+  public:
+
+    queued_message_router_full(string_type file_name_, numeric_type line_number_)
+      : queued_message_router_exception(ETL_ERROR_TEXT("queued message router:full", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// A shared message was posted.
+  //***************************************************************************
+  class queued_message_router_shared_message : public etl::queued_message_router_exception
+  {
+  public:
+
+    queued_message_router_shared_message(string_type file_name_, numeric_type line_number_)
+      : queued_message_router_exception(ETL_ERROR_TEXT("queued message router:shared message", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// A message queue for one producer thread and one consumer thread.
+  /// Holds up to SIZE messages.
+  ///\ingroup queued_message_router
+  //***************************************************************************
+  template <size_t SIZE>
+  class message_queue_spsc
+  {
+  public:
+
+    bool push(etl::message_node& node)
+    {
+      return queue.push(&node);
+    }
+
+    etl::message_node* pop()
+    {
+      etl::message_node* p_node;
+
+      return queue.pop(p_node) ? p_node : nullptr;
+    }
+
+    bool empty() const
+    {
+      return queue.empty();
+    }
+
+  private:
+
+    etl::queue_spsc_atomic<etl::message_node*, SIZE> queue;
+  };
+
+  //***************************************************************************
+  /// A message queue for many producer threads and one consumer thread.
+  /// The messages are linked through their headers, so the queue is only
+  /// limited by the size of the message pool.
+  ///\ingroup queued_message_router
+  //***************************************************************************
+  class message_queue_mpsc
+  {
+  public:
+
+    bool push(etl::message_node& node)
+    {
+      queue.push(node);
+
+      return true;
+    }
+
+    etl::message_node* pop()
+    {
+      return queue.pop();
+    }
+
+    bool empty() const
+    {
+      return queue.empty();
+    }
+
+  private:
+
+    etl::intrusive_mpsc_queue<etl::message_node, etl::message_node::link_type> queue;
+  };
+
+  //***************************************************************************
+  /// A message router that stores the messages that it accepts in a message
+  /// pool and queues handles to them. process_queue() passes them on to the
+  /// on_receive handlers, usually in another thread.
+  /// Each message takes an item of the smallest size class that will hold it,
+  /// and is copied once, rather than into a packet sized for the largest type.
+  /// Messages already in the pool are queued with post() without being copied,
+  /// and a handler may take_message() to pass one on in the same way.
+  /// Messages that the router does not accept are passed to the successor, or
+  /// to on_receive_unknown, straight away.
+  ///\code
+  /// class Router : public etl::queued_message_router<Router, etl::message_queue_mpsc, Message1, Message2>
+  ///\endcode
+  ///\tparam TDerived      The derived router.
+  ///\tparam TQueue        etl::message_queue_spsc<SIZE> or etl::message_queue_mpsc.
+  ///\tparam TMessageTypes The message types that the router handles.
+  ///\ingroup queued_message_router
+  //***************************************************************************
+  template <typename TDerived, typename TQueue, typename... TMessageTypes>
+  class queued_message_router : public etl::message_router<TDerived, TMessageTypes...>
+  {
+  public:
+
+    typedef etl::message_router<TDerived, TMessageTypes...> message_router_type;
+
+    using message_router_type::receive;
+    using message_router_type::accepts;
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    queued_message_router(etl::message_router_id_t id_, etl::imessage_pool& pool_)
+      : message_router_type(id_),
+        pool(pool_)
+    {
+    }
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    queued_message_router(etl::message_router_id_t id_, etl::imessage_pool& pool_, etl::imessage_router& successor_)
+      : message_router_type(id_, successor_),
+        pool(pool_)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    /// Releases any messages that have not been processed.
+    /// May only be called from the consumer thread, once the producers have
+    /// stopped posting.
+    //*************************************************************************
+    ~queued_message_router()
+    {
+      clear();
+    }
+
+    //*************************************************************************
+    /// Copies an accepted message in to the pool and queues it.
+    /// If asserts or exceptions are enabled and the pool or queue is full an
+    /// etl::message_pool_no_allocation or etl::queued_message_router_full is
+    /// thrown. Otherwise the message is dropped.
+    //*************************************************************************
+    void receive(etl::imessage_router& source, const etl::imessage& msg)
+    {
+      if (accepts(msg.message_id))
+      {
+        etl::message_handle handle = pool.template clone<TMessageTypes...>(msg);
+
+        if (handle.has_value() && !post(source, std::move(handle)))
+        {
+          ETL_ASSERT(false, ETL_ERROR(queued_message_router_full));
+        }
+      }
+      else
+      {
+        message_router_type::receive(source, msg);
+      }
+    }
+
+    //*************************************************************************
+    /// Queues a message from the pool without copying it.
+    /// \return <b>true</b> if queued, otherwise <b>false</b> and the handle
+    /// keeps the message.
+    //*************************************************************************
+    bool post(etl::message_handle&& handle)
+    {
+      return post(etl::null_message_router::instance(), std::move(handle));
+    }
+
+    //*************************************************************************
+    /// Queues a message from the pool without copying it.
+    /// The queue links the message's node, so the handle must be the only one
+    /// to the message. If asserts or exceptions are enabled and it is shared an
+    /// etl::queued_message_router_shared_message is thrown.
+    /// \return <b>true</b> if queued, otherwise <b>false</b> and the handle
+    /// keeps the message.
+    //*************************************************************************
+    bool post(etl::imessage_router& source, etl::message_handle&& handle)
+    {
+      if (!handle.has_value())
+      {
+        return false;
+      }
+
+      if (!handle.is_unique())
+      {
+        ETL_ASSERT(false, ETL_ERROR(queued_message_router_shared_message));
+        return false;
+      }
+
+      etl::message_node* p_node = handle.release();
+
+      p_node->p_source = &source;
+
+      if (!queue.push(*p_node))
+      {
+        handle = etl::message_handle(p_node);
+        return false;
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Passes the queued messages to the handlers.
+    /// A message whose post is still in progress is left for the next call.
+    /// May only be called from the consumer thread.
+    /// \return The number of messages processed.
+    //*************************************************************************
+    size_t process_queue()
+    {
+      size_t count = 0U;
+
+      etl::message_node* p_node;
+
+      while ((p_node = queue.pop()) != nullptr)
+      {
+        current = etl::message_handle(p_node);
+        message_router_type::receive(*p_node->p_source, *p_node->p_message);
+        current.reset();
+
+        ++count;
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Takes the message that is being handled, so that it may be posted on
+    /// without being copied.
+    /// May only be called from an on_receive handler.
+    //*************************************************************************
+    etl::message_handle take_message()
+    {
+      return std::move(current);
+    }
+
+    //*************************************************************************
+    /// Releases the queued messages without handling them.
+    /// Waits for posts that are in progress to finish, so no new posts may be
+    /// started while it runs.
+    /// May only be called from the consumer thread.
+    //*************************************************************************
+    void clear()
+    {
+      while (!queue.empty())
+      {
+        etl::message_node* p_node = queue.pop();
+
+        if (p_node != nullptr)
+        {
+          etl::message_handle(p_node).reset();
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Gets the message pool.
+    //*************************************************************************
+    etl::imessage_pool& get_pool()
+    {
+      return pool;
+    }
+
+  private:
+
+    etl::imessage_pool& pool;
+    TQueue              queue;
+    etl::message_handle current; ///< The message being handled.
+  };
+}
+
+#endif
+
+#undef ETL_FILE
+
+#endif
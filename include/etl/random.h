@@ -501,6 +501,338 @@ namespace etl
     uint64_t value;
   };
 
+  namespace private_random
+  {
+    //***************************************************************************
+    /// Unbiased inclusive range using Lemire's multiply and reject method.
+    /// Uses the top 32 bits of the 64 bit generator output.
+    /// https://arxiv.org/abs/1805.10941
+    //***************************************************************************
+    template <typename TGenerator>
+    uint32_t range(TGenerator& generator, uint32_t low, uint32_t high)
+    {
+      const uint32_t r = high - low + 1U;
+
+      if (r == 0U)
+      {
+        // The full 32 bit range.
+        return static_cast<uint32_t>(generator() >> 32);
+      }
+
+      uint64_t m = uint64_t(static_cast<uint32_t>(generator() >> 32)) * r;
+      uint32_t l = static_cast<uint32_t>(m);
+
+      if (l < r)
+      {
+        const uint32_t threshold = static_cast<uint32_t>(0U - r) % r;
+
+        while (l < threshold)
+        {
+          m = uint64_t(static_cast<uint32_t>(generator() >> 32)) * r;
+          l = static_cast<uint32_t>(m);
+        }
+      }
+
+      return low + static_cast<uint32_t>(m >> 32);
+    }
+
+    //***************************************************************************
+    /// Converts the top 53 bits to a double in the range [0, 1).
+    //***************************************************************************
+    inline double to_double(uint64_t n)
+    {
+      return double(n >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    //***************************************************************************
+    /// Converts the top 24 bits to a float in the range [0, 1).
+    //***************************************************************************
+    inline float to_float(uint64_t n)
+    {
+      return float(n >> 40) * (1.0f / 16777216.0f);
+    }
+  }
+
+  //***************************************************************************
+  /// A 64 bit random number generator.
+  /// Uses the splitmix64 algorithm.
+  /// Non-virtual; does not derive from etl::random.
+  /// http://prng.di.unimi.it/splitmix64.c
+  //***************************************************************************
+  class random_splitmix64
+  {
+  public:
+
+    typedef uint64_t result_type;
+
+    //***************************************************************************
+    /// Default constructor.
+    /// Attempts to come up with a unique seed.
+    //***************************************************************************
+    random_splitmix64()
+    {
+      // An attempt to come up with a unique seed,
+      // based on the address of the instance.
+      uintptr_t n = reinterpret_cast<uintptr_t>(this);
+      initialise(static_cast<uint64_t>(n));
+    }
+
+    //***************************************************************************
+    /// Constructor with seed value.
+    ///\param seed The new seed value.
+    //***************************************************************************
+    random_splitmix64(uint64_t seed)
+    {
+      initialise(seed);
+    }
+
+    //***************************************************************************
+    /// Initialises the sequence with a new seed value.
+    ///\param seed The new seed value.
+    //***************************************************************************
+    void initialise(uint64_t seed)
+    {
+      value = seed;
+    }
+
+    //***************************************************************************
+    /// Get the next random_splitmix64 number.
+    //***************************************************************************
+    uint64_t operator()()
+    {
+      uint64_t z = (value += 0x9E3779B97F4A7C15ULL);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+      return z ^ (z >> 31);
+    }
+
+    //***************************************************************************
+    /// Fills a range with random_splitmix64 numbers.
+    //***************************************************************************
+    template <typename TIterator>
+    void generate(TIterator first, TIterator last)
+    {
+      while (first != last)
+      {
+        *first++ = operator()();
+      }
+    }
+
+    //***************************************************************************
+    /// Get the next random_splitmix64 number in a specified inclusive range.
+    /// The distribution is unbiased.
+    //***************************************************************************
+    uint32_t range(uint32_t low, uint32_t high)
+    {
+      return private_random::range(*this, low, high);
+    }
+
+    //***************************************************************************
+    /// Get the next random_splitmix64 number as a double in the range [0, 1).
+    //***************************************************************************
+    double real()
+    {
+      return private_random::to_double(operator()());
+    }
+
+    //***************************************************************************
+    /// Get the next random_splitmix64 number as a float in the range [0, 1).
+    //***************************************************************************
+    float real_float()
+    {
+      return private_random::to_float(operator()());
+    }
+
+  private:
+
+    uint64_t value;
+  };
+
+  //***************************************************************************
+  /// A 64 bit random number generator.
+  /// Uses the xoshiro256** algorithm.
+  /// Non-virtual; does not derive from etl::random.
+  /// The state is seeded from splitmix64.
+  /// http://prng.di.unimi.it/xoshiro256starstar.c
+  //***************************************************************************
+  class random_xoshiro256ss
+  {
+  public:
+
+    typedef uint64_t result_type;
+
+    //***************************************************************************
+    /// Default constructor.
+    /// Attempts to come up with a unique seed.
+    //***************************************************************************
+    random_xoshiro256ss()
+    {
+      // An attempt to come up with a unique seed,
+      // based on the address of the instance.
+      uintptr_t n = reinterpret_cast<uintptr_t>(this);
+      initialise(static_cast<uint64_t>(n));
+    }
+
+    //***************************************************************************
+    /// Constructor with seed value.
+    ///\param seed The new seed value.
+    //***************************************************************************
+    random_xoshiro256ss(uint64_t seed)
+    {
+      initialise(seed);
+    }
+
+    //***************************************************************************
+    /// Initialises the sequence with a new seed value.
+    /// The state is expanded from the seed by splitmix64, so is never all zero.
+    ///\param seed The new seed value.
+    //***************************************************************************
+    void initialise(uint64_t seed)
+    {
+      etl::random_splitmix64 splitmix(seed);
+
+      state[0] = splitmix();
+      state[1] = splitmix();
+      state[2] = splitmix();
+      state[3] = splitmix();
+    }
+
+    //***************************************************************************
+    /// Get the next random_xoshiro256ss number.
+    //***************************************************************************
+    uint64_t operator()()
+    {
+      const uint64_t result = etl::rotate_left(state[1] * 5U, 7U) * 9U;
+      const uint64_t t      = state[1] << 17;
+
+      state[2] ^= state[0];
+      state[3] ^= state[1];
+      state[1] ^= state[2];
+      state[0] ^= state[3];
+      state[2] ^= t;
+      state[3]  = etl::rotate_left(state[3], 45U);
+
+      return result;
+    }
+
+    //***************************************************************************
+    /// Fills a range with random_xoshiro256ss numbers.
+    /// The state is held in locals for the duration of the fill.
+    //***************************************************************************
+    template <typename TIterator>
+    void generate(TIterator first, TIterator last)
+    {
+      uint64_t s0 = state[0];
+      uint64_t s1 = state[1];
+      uint64_t s2 = state[2];
+      uint64_t s3 = state[3];
+
+      while (first != last)
+      {
+        *first++ = etl::rotate_left(s1 * 5U, 7U) * 9U;
+
+        const uint64_t t = s1 << 17;
+
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3  = etl::rotate_left(s3, 45U);
+      }
+
+      state[0] = s0;
+      state[1] = s1;
+      state[2] = s2;
+      state[3] = s3;
+    }
+
+    //***************************************************************************
+    /// Get the next random_xoshiro256ss number in a specified inclusive range.
+    /// The distribution is unbiased.
+    //***************************************************************************
+    uint32_t range(uint32_t low, uint32_t high)
+    {
+      return private_random::range(*this, low, high);
+    }
+
+    //***************************************************************************
+    /// Get the next random_xoshiro256ss number as a double in the range [0, 1).
+    //***************************************************************************
+    double real()
+    {
+      return private_random::to_double(operator()());
+    }
+
+    //***************************************************************************
+    /// Get the next random_xoshiro256ss number as a float in the range [0, 1).
+    //***************************************************************************
+    float real_float()
+    {
+      return private_random::to_float(operator()());
+    }
+
+    //***************************************************************************
+    /// Advances the sequence by 2^128 calls.
+    /// Generates 2^128 non-overlapping sub-sequences for parallel use.
+    /// i.e. Copy the generator, then call jump() once per additional thread.
+    //***************************************************************************
+    void jump()
+    {
+      static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+
+      apply_jump(JUMP);
+    }
+
+    //***************************************************************************
+    /// Advances the sequence by 2^192 calls.
+    /// Generates 2^64 starting points, each of which may be jump()ed 2^64 times.
+    //***************************************************************************
+    void long_jump()
+    {
+      static const uint64_t LONG_JUMP[] = { 0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL };
+
+      apply_jump(LONG_JUMP);
+    }
+
+  private:
+
+    //***************************************************************************
+    /// Applies a jump polynomial.
+    //***************************************************************************
+    void apply_jump(const uint64_t (&polynomial)[4])
+    {
+      uint64_t s0 = 0U;
+      uint64_t s1 = 0U;
+      uint64_t s2 = 0U;
+      uint64_t s3 = 0U;
+
+      for (int i = 0; i < 4; ++i)
+      {
+        for (int b = 0; b < 64; ++b)
+        {
+          if (polynomial[i] & (uint64_t(1U) << b))
+          {
+            s0 ^= state[0];
+            s1 ^= state[1];
+            s2 ^= state[2];
+            s3 ^= state[3];
+          }
+
+          operator()();
+        }
+      }
+
+      state[0] = s0;
+      state[1] = s1;
+      state[2] = s2;
+      state[3] = s3;
+    }
+
+    uint64_t state[4];
+  };
+
 #if ETL_8BIT_SUPPORT
   //***************************************************************************
   /// A 32 bit random number generator.
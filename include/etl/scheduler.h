@@ -39,6 +39,9 @@ SOFTWARE.
 #include "task.h"
 #include "type_traits.h"
 #include "function.h"
+#include "atomic.h"
+#include "binary.h"
+#include "static_assert.h"
 
 #undef ETL_FILE
 #define ETL_FILE "36"
@@ -219,6 +222,120 @@ namespace etl
     }
   };
 
+#if ETL_HAS_ATOMIC
+  //***************************************************************************
+  /// Ready Bitmap.
+  /// A policy the scheduler can use to decide what to do next.
+  /// Tasks call task.notify() when they have work, which may be done from
+  /// other threads or an ISR. Each notification sets the task's bit in a
+  /// bitmap. Bits are in task list order, so the lowest set bit is the
+  /// highest priority ready task, which is found with a count of trailing
+  /// zeros instead of polling every task.
+  /// The selected task is called to process work once. If it still reports
+  /// work afterwards it stays ready, so it need not notify itself.
+  /// The scheduler is idle when the bitmap is empty, so the idle callback may
+  /// put the processor to sleep until an interrupt notifies a task.
+  /// Tasks must be added before the scheduler is started.
+  /// \tparam MAX_TASKS The maximum number of tasks. At least that of the scheduler.
+  //***************************************************************************
+  template <const size_t MAX_TASKS>
+  class scheduler_policy_ready_bitmap
+  {
+  public:
+
+    scheduler_policy_ready_bitmap()
+      : notifier(*this),
+        initialised(false)
+    {
+      for (size_t i = 0; i < N_WORDS; ++i)
+      {
+        ready[i].store(0, etl::memory_order_relaxed);
+      }
+    }
+
+    bool schedule_tasks(etl::ivector<etl::task*>& task_list)
+    {
+      if (!initialised)
+      {
+        initialise(task_list);
+      }
+
+      for (size_t word = 0; word < N_WORDS; ++word)
+      {
+        uint32_t bits = ready[word].load(etl::memory_order_acquire);
+
+        if (bits != 0)
+        {
+          const size_t index = (word * BITS_PER_WORD) + etl::count_trailing_zeros(bits);
+
+          // Clear before calling the task so that a notification during the call is kept.
+          ready[word].fetch_and(~bit_of(index), etl::memory_order_acq_rel);
+
+          etl::task& task = *(task_list[index]);
+
+          if (task.task_request_work() > 0)
+          {
+            task.task_process_work();
+
+            if (task.task_request_work() > 0)
+            {
+              task_ready(index);
+            }
+          }
+
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+  private:
+
+    ETL_STATIC_ASSERT((MAX_TASKS > 0), "MAX_TASKS must be greater than zero");
+
+    static const size_t BITS_PER_WORD = 32;
+    static const size_t N_WORDS       = (MAX_TASKS + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    //*******************************************
+    /// Called by etl::task::notify().
+    //*******************************************
+    void task_ready(size_t index)
+    {
+      ready[index / BITS_PER_WORD].fetch_or(bit_of(index), etl::memory_order_release);
+    }
+
+    //*******************************************
+    /// Connects the tasks and marks those that already have work.
+    //*******************************************
+    void initialise(etl::ivector<etl::task*>& task_list)
+    {
+      ETL_ASSERT(task_list.size() <= MAX_TASKS, ETL_ERROR(etl::scheduler_too_many_tasks_exception));
+
+      for (size_t index = 0; (index < task_list.size()) && (index < MAX_TASKS); ++index)
+      {
+        task_list[index]->set_task_notifier(notifier, index);
+
+        if (task_list[index]->task_request_work() > 0)
+        {
+          task_ready(index);
+        }
+      }
+
+      initialised = true;
+    }
+
+    static uint32_t bit_of(size_t index)
+    {
+      return uint32_t(1) << (index % BITS_PER_WORD);
+    }
+
+    etl::function_mp<scheduler_policy_ready_bitmap, size_t, &scheduler_policy_ready_bitmap::task_ready> notifier;
+    etl::atomic<uint32_t> ready[N_WORDS];
+    bool initialised;
+  };
+#endif
+
   //***************************************************************************
   /// Scheduler base.
   //***************************************************************************
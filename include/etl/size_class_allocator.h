@@ -0,0 +1,453 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_SIZE_CLASS_ALLOCATOR_INCLUDED
+#define ETL_SIZE_CLASS_ALLOCATOR_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "error_handler.h"
+#include "nullptr.h"
+#include "static_assert.h"
+#include "alignment.h"
+#include "pool.h"
+
+#if ETL_CPP17_SUPPORTED && !defined(ETL_NO_STL) && defined(__has_include)
+  #if __has_include(<memory_resource>)
+    #include <memory_resource>
+    #include <new>
+    #define ETL_HAS_SIZE_CLASS_MEMORY_RESOURCE 1
+  #endif
+#endif
+
+#if !defined(ETL_HAS_SIZE_CLASS_MEMORY_RESOURCE)
+  #define ETL_HAS_SIZE_CLASS_MEMORY_RESOURCE 0
+#endif
+
+#undef ETL_FILE
+#define ETL_FILE "53"
+
+//*****************************************************************************
+///\defgroup size_class_allocator size_class_allocator
+/// A variable size allocator built from a set of fixed size pools.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base of all size class allocators.
+  /// An allocation is taken from the smallest size class that is large enough
+  /// and aligned enough. If that class is exhausted, the next larger class is tried.
+  /// Not thread safe.
+  ///\ingroup size_class_allocator
+  //***************************************************************************
+  class isize_class_allocator
+  {
+  public:
+
+    //*************************************************************************
+    /// Allocate memory from the smallest suitable size class.
+    /// If asserts or exceptions are enabled and the size is larger than the largest
+    /// size class an etl::pool_element_size is thrown. If all of the suitable
+    /// classes are exhausted an etl::pool_no_allocation is thrown.
+    /// Otherwise a nullptr is returned.
+    /// \param size      The number of bytes required.
+    /// \param alignment The alignment required. Must be a power of two.
+    //*************************************************************************
+    void* allocate(size_t size, size_t alignment)
+    {
+      if (size > max_allocation())
+      {
+        ETL_ASSERT(false, ETL_ERROR(pool_element_size));
+        return nullptr;
+      }
+
+      for (size_t i = class_index(size); i < N_CLASSES; ++i)
+      {
+        if (p_alignments[i] >= alignment)
+        {
+          void* p;
+
+          if (p_pools[i]->allocate_batch(&p, 1U) != 0U)
+          {
+            return p;
+          }
+        }
+      }
+
+      ETL_ASSERT(false, ETL_ERROR(pool_no_allocation));
+      return nullptr;
+    }
+
+    //*************************************************************************
+    /// Return memory to its size class.
+    /// If asserts or exceptions are enabled and the memory was not allocated from
+    /// this allocator then an etl::pool_object_not_in_pool is thrown.
+    /// \param p    The memory to release.
+    /// \param size The size that was passed to allocate.
+    //*************************************************************************
+    void deallocate(const void* p, size_t size)
+    {
+      if (size <= max_allocation())
+      {
+        for (size_t i = class_index(size); i < N_CLASSES; ++i)
+        {
+          if (p_pools[i]->is_in_pool(p))
+          {
+            p_pools[i]->release(p);
+            return;
+          }
+        }
+      }
+
+      ETL_ASSERT(false, ETL_ERROR(pool_object_not_in_pool));
+    }
+
+    //*************************************************************************
+    /// Checks to see if the memory belongs to one of the size classes.
+    //*************************************************************************
+    bool is_in_pool(const void* p) const
+    {
+      for (size_t i = 0U; i < N_CLASSES; ++i)
+      {
+        if (p_pools[i]->is_in_pool(p))
+        {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    //*************************************************************************
+    /// Returns the number of size classes.
+    //*************************************************************************
+    size_t size_classes() const
+    {
+      return N_CLASSES;
+    }
+
+    //*************************************************************************
+    /// Returns the size of the largest allocation that can be made.
+    //*************************************************************************
+    size_t max_allocation() const
+    {
+      return p_sizes[N_CLASSES - 1U];
+    }
+
+    //*************************************************************************
+    /// Returns the pool for a size class.
+    //*************************************************************************
+    const etl::ipool& get_pool(size_t index) const
+    {
+      return *p_pools[index];
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor.
+    /// The arrays are filled in by the derived class.
+    //*************************************************************************
+    isize_class_allocator(etl::ipool** p_pools_,
+                          size_t*      p_sizes_,
+                          size_t*      p_alignments_,
+                          uint8_t*     p_lookup_,
+                          size_t       n_classes_,
+                          size_t       granule_)
+      : p_pools(p_pools_),
+        p_sizes(p_sizes_),
+        p_alignments(p_alignments_),
+        p_lookup(p_lookup_),
+        N_CLASSES(n_classes_),
+        GRANULE(granule_)
+    {
+    }
+
+    //*************************************************************************
+    /// Builds the size to class lookup table from the pools and sizes.
+    /// Each entry holds the smallest class for a multiple of the granule.
+    //*************************************************************************
+    void initialise()
+    {
+      size_t index = 0U;
+
+      for (size_t i = 0U; i <= (max_allocation() / GRANULE); ++i)
+      {
+        while (p_sizes[index] < (i * GRANULE))
+        {
+          ++index;
+        }
+
+        p_lookup[i] = uint8_t(index);
+      }
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~isize_class_allocator()
+    {
+    }
+
+  private:
+
+    //*************************************************************************
+    /// The smallest size class that will hold 'size' bytes.
+    //*************************************************************************
+    size_t class_index(size_t size) const
+    {
+      return p_lookup[(size + GRANULE - 1U) / GRANULE];
+    }
+
+    // Disable copy construction and assignment.
+    isize_class_allocator(const isize_class_allocator&);
+    isize_class_allocator& operator =(const isize_class_allocator&);
+
+    etl::ipool** p_pools;      ///< The pool for each size class.
+    size_t*      p_sizes;      ///< The item size of each size class.
+    size_t*      p_alignments; ///< The alignment of each size class.
+    uint8_t*     p_lookup;     ///< Size in granules to size class.
+
+    const size_t N_CLASSES; ///< The number of size classes.
+    const size_t GRANULE;   ///< The size of the smallest class.
+  };
+
+#if ETL_CPP11_SUPPORTED
+  namespace private_size_class_allocator
+  {
+    //*************************************************************************
+    /// Holds one of each of the pools.
+    //*************************************************************************
+    template <typename... TPools>
+    struct pool_list;
+
+    template <typename THead, typename... TTail>
+    struct pool_list<THead, TTail...>
+    {
+      static const size_t GRANULE = THead::TYPE_SIZE;
+
+      // The alignment that the pool can actually provide.
+      static const size_t ALIGNMENT = etl::alignment_of<typename etl::type_with_alignment<THead::ALIGNMENT>::type>::value;
+
+      // Ascending sizes that are all multiples of the smallest.
+      static const bool valid = pool_list<TTail...>::template is_valid_tail<THead::TYPE_SIZE>::value;
+
+      template <size_t PREVIOUS_SIZE>
+      struct is_valid_tail
+      {
+        static const bool value = (THead::TYPE_SIZE > PREVIOUS_SIZE) &&
+                                  pool_list<TTail...>::template is_valid_tail<THead::TYPE_SIZE>::value;
+      };
+
+      template <size_t GRANULE_>
+      struct is_granular
+      {
+        static const bool value = ((THead::TYPE_SIZE % GRANULE_) == 0U) &&
+                                  pool_list<TTail...>::template is_granular<GRANULE_>::value;
+      };
+
+      void get(etl::ipool** p_pools, size_t* p_sizes, size_t* p_alignments)
+      {
+        *p_pools      = &head;
+        *p_sizes      = THead::TYPE_SIZE;
+        *p_alignments = ALIGNMENT;
+
+        tail.get(p_pools + 1, p_sizes + 1, p_alignments + 1);
+      }
+
+      THead               head;
+      pool_list<TTail...> tail;
+    };
+
+    template <>
+    struct pool_list<>
+    {
+      template <size_t PREVIOUS_SIZE>
+      struct is_valid_tail
+      {
+        static const bool value = true;
+      };
+
+      template <size_t GRANULE_>
+      struct is_granular
+      {
+        static const bool value = true;
+      };
+
+      void get(etl::ipool**, size_t*, size_t*)
+      {
+      }
+    };
+
+    //*************************************************************************
+    /// The size of the last pool.
+    //*************************************************************************
+    template <typename THead, typename... TTail>
+    struct last_size
+    {
+      static const size_t value = last_size<TTail...>::value;
+    };
+
+    template <typename THead>
+    struct last_size<THead>
+    {
+      static const size_t value = THead::TYPE_SIZE;
+    };
+  }
+
+  //***************************************************************************
+  /// A variable size allocator built from a list of etl::generic_pool size classes.
+  /// The pools must be listed in ascending size, and every size must be a multiple
+  /// of the smallest. Sizes are mapped to a size class with one table lookup.
+  ///\code
+  /// etl::size_class_allocator<etl::generic_pool<16,  8, 64>,
+  ///                           etl::generic_pool<64,  8, 32>,
+  ///                           etl::generic_pool<256, 8, 8>> allocator;
+  ///\endcode
+  ///\tparam TPools The size class pools.
+  ///\ingroup size_class_allocator
+  //***************************************************************************
+  template <typename... TPools>
+  class size_class_allocator : public etl::isize_class_allocator
+  {
+  private:
+
+    typedef private_size_class_allocator::pool_list<TPools...> pool_list_t;
+
+  public:
+
+    static const size_t SIZE_CLASSES   = sizeof...(TPools);
+    static const size_t GRANULE        = pool_list_t::GRANULE;
+    static const size_t MAX_ALLOCATION = private_size_class_allocator::last_size<TPools...>::value;
+
+    ETL_STATIC_ASSERT(SIZE_CLASSES <= 255U, "Too many size classes");
+    ETL_STATIC_ASSERT(pool_list_t::valid, "Size classes must be in ascending order of size");
+    ETL_STATIC_ASSERT(pool_list_t::template is_granular<GRANULE>::value, "Size classes must be multiples of the smallest");
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    size_class_allocator()
+      : isize_class_allocator(pool_pointers, sizes, alignments, lookup, SIZE_CLASSES, GRANULE)
+    {
+      pools.get(pool_pointers, sizes, alignments);
+      isize_class_allocator::initialise();
+    }
+
+  private:
+
+    pool_list_t pools;
+    etl::ipool* pool_pointers[SIZE_CLASSES];
+    size_t      sizes[SIZE_CLASSES];
+    size_t      alignments[SIZE_CLASSES];
+    uint8_t     lookup[(MAX_ALLOCATION / GRANULE) + 1U];
+  };
+
+  template <typename... TPools>
+  const size_t size_class_allocator<TPools...>::SIZE_CLASSES;
+
+  template <typename... TPools>
+  const size_t size_class_allocator<TPools...>::GRANULE;
+
+  template <typename... TPools>
+  const size_t size_class_allocator<TPools...>::MAX_ALLOCATION;
+#endif
+
+#if ETL_HAS_SIZE_CLASS_MEMORY_RESOURCE
+  //***************************************************************************
+  /// Adapts a size class allocator to std::pmr::memory_resource.
+  /// Allocation failures are reported through the ETL error handler.
+  /// If the allocator then returns nullptr and exceptions are enabled,
+  /// std::bad_alloc is thrown, as std::pmr::memory_resource requires.
+  /// When built without exceptions, nullptr is returned.
+  ///\code
+  /// etl::size_class_memory_resource resource(allocator);
+  /// std::pmr::vector<int> v(&resource);
+  ///\endcode
+  ///\ingroup size_class_allocator
+  //***************************************************************************
+  class size_class_memory_resource : public std::pmr::memory_resource
+  {
+  public:
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    explicit size_class_memory_resource(etl::isize_class_allocator& allocator_)
+      : allocator(allocator_)
+    {
+    }
+
+    //*************************************************************************
+    /// Returns the underlying allocator.
+    //*************************************************************************
+    etl::isize_class_allocator& get_allocator()
+    {
+      return allocator;
+    }
+
+  private:
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+      void* p = allocator.allocate(bytes, alignment);
+
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+      if (p == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+#endif
+
+      return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t) override
+    {
+      allocator.deallocate(p, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+      return this == &other;
+    }
+
+    etl::isize_class_allocator& allocator;
+  };
+#endif
+}
+
+#undef ETL_FILE
+
+#endif
@@ -0,0 +1,711 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_STATIC_FSM_INCLUDED
+#define ETL_STATIC_FSM_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "type_traits.h"
+#include "static_assert.h"
+#include "smallest.h"
+#include "message.h"
+#include "message_router.h"
+
+#undef ETL_FILE
+#define ETL_FILE "59"
+
+#if ETL_CPP14_SUPPORTED
+
+//*****************************************************************************
+///\defgroup static_fsm static_fsm
+/// A finite state machine with the states and transitions declared as types.
+///\ingroup fsm
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// Derive a state from this to nest it inside a parent state.
+  /// Transitions from the parent apply to it if it has none of its own for
+  /// the event.
+  ///\ingroup static_fsm
+  //***************************************************************************
+  template <typename TParent>
+  struct fsm_substate
+  {
+    typedef TParent parent_state;
+  };
+
+  //***************************************************************************
+  /// The action for a transition that has none.
+  ///\ingroup static_fsm
+  //***************************************************************************
+  struct fsm_no_action
+  {
+    template <typename TContext, typename TEvent>
+    void operator ()(TContext&, const TEvent&) const
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The guard for a transition that is always taken.
+  ///\ingroup static_fsm
+  //***************************************************************************
+  struct fsm_no_guard
+  {
+    template <typename TContext, typename TEvent>
+    bool operator ()(const TContext&, const TEvent&) const
+    {
+      return true;
+    }
+  };
+
+  //***************************************************************************
+  /// A transition from TFrom to TTo on TEvent.
+  /// TAction is a function object called as action(context, event).
+  /// TGuard is a function object called as guard(context, event); the
+  /// transition is only taken if it returns true.
+  /// A TTo of void is an internal transition, which runs the action without
+  /// changing state.
+  ///\ingroup static_fsm
+  //***************************************************************************
+  template <typename TFrom,
+            typename TEvent,
+            typename TTo,
+            typename TAction = etl::fsm_no_action,
+            typename TGuard  = etl::fsm_no_guard>
+  struct fsm_transition
+  {
+    typedef TFrom   from_state;
+    typedef TEvent  event_type;
+    typedef TTo     to_state;
+    typedef TAction action_type;
+    typedef TGuard  guard_type;
+  };
+
+  //***************************************************************************
+  /// The list of states. The first is the initial state.
+  ///\ingroup static_fsm
+  //***************************************************************************
+  template <typename... TStates>
+  struct fsm_states
+  {
+  };
+
+  //***************************************************************************
+  /// The list of transitions. For each event, the first transition from the
+  /// active state whose guard passes is taken.
+  ///\ingroup static_fsm
+  //***************************************************************************
+  template <typename... TTransitions>
+  struct fsm_transitions
+  {
+  };
+
+  namespace private_static_fsm
+  {
+    //*************************************************************************
+    template <typename T>
+    struct make_void
+    {
+      typedef void type;
+    };
+
+    //*************************************************************************
+    /// The parent of a state, or void.
+    //*************************************************************************
+    template <typename TState, typename = void>
+    struct parent_of
+    {
+      typedef void type;
+    };
+
+    template <typename TState>
+    struct parent_of<TState, typename make_void<typename TState::parent_state>::type>
+    {
+      typedef typename TState::parent_state type;
+    };
+
+    //*************************************************************************
+    /// Is TAncestor the state, or one that it is nested in?
+    //*************************************************************************
+    template <typename TAncestor, typename TState>
+    struct is_ancestor_or_self
+    {
+      static const bool value = etl::is_same<TAncestor, TState>::value ||
+                                is_ancestor_or_self<TAncestor, typename parent_of<TState>::type>::value;
+    };
+
+    template <typename TAncestor>
+    struct is_ancestor_or_self<TAncestor, void>
+    {
+      static const bool value = false;
+    };
+
+    //*************************************************************************
+    /// The innermost state that contains both states, or void.
+    //*************************************************************************
+    template <typename TState1, typename TState2>
+    struct common_ancestor
+    {
+      typedef typename etl::conditional<is_ancestor_or_self<TState1, TState2>::value,
+                                        TState1,
+                                        typename common_ancestor<typename parent_of<TState1>::type, TState2>::type>::type type;
+    };
+
+    template <typename TState2>
+    struct common_ancestor<void, TState2>
+    {
+      typedef void type;
+    };
+
+    //*************************************************************************
+    /// The position of a type in a list, or the length of the list.
+    //*************************************************************************
+    template <typename T, typename... TList>
+    struct index_of;
+
+    template <typename T>
+    struct index_of<T>
+    {
+      static const size_t value = 0U;
+    };
+
+    template <typename T, typename T1, typename... TRest>
+    struct index_of<T, T1, TRest...>
+    {
+      static const size_t value = etl::is_same<T, T1>::value ? 0U : 1U + index_of<T, TRest...>::value;
+    };
+
+    //*************************************************************************
+    /// The number of times a type is in a list.
+    //*************************************************************************
+    template <typename T, typename... TList>
+    struct count_of;
+
+    template <typename T>
+    struct count_of<T>
+    {
+      static const size_t value = 0U;
+    };
+
+    template <typename T, typename T1, typename... TRest>
+    struct count_of<T, T1, TRest...>
+    {
+      static const size_t value = (etl::is_same<T, T1>::value ? 1U : 0U) + count_of<T, TRest...>::value;
+    };
+
+    //*************************************************************************
+    /// The type at a position in a list.
+    //*************************************************************************
+    template <size_t INDEX, typename T1, typename... TRest>
+    struct type_at
+    {
+      typedef typename type_at<INDEX - 1U, TRest...>::type type;
+    };
+
+    template <typename T1, typename... TRest>
+    struct type_at<0U, T1, TRest...>
+    {
+      typedef T1 type;
+    };
+
+    //*************************************************************************
+    template <typename T>
+    T&& declval();
+
+    //*************************************************************************
+    /// Does the context have an on_enter or on_exit for the state?
+    //*************************************************************************
+    template <typename TContext, typename TState, typename = void>
+    struct has_on_enter : etl::false_type
+    {
+    };
+
+    template <typename TContext, typename TState>
+    struct has_on_enter<TContext, TState, typename make_void<decltype(declval<TContext&>().on_enter(declval<TState>()))>::type> : etl::true_type
+    {
+    };
+
+    template <typename TContext, typename TState, typename = void>
+    struct has_on_exit : etl::false_type
+    {
+    };
+
+    template <typename TContext, typename TState>
+    struct has_on_exit<TContext, TState, typename make_void<decltype(declval<TContext&>().on_exit(declval<TState>()))>::type> : etl::true_type
+    {
+    };
+
+    //*************************************************************************
+    constexpr bool all_of()
+    {
+      return true;
+    }
+
+    template <typename... TBools>
+    constexpr bool all_of(bool first, TBools... rest)
+    {
+      return first && all_of(rest...);
+    }
+  }
+
+  //***************************************************************************
+  /// A finite state machine whose states, events and transitions are known at
+  /// compile time. Dispatch compares the active state's index against each
+  /// state in turn, which compilers reduce to a jump table, and the guards,
+  /// actions and entry and exit handlers are called directly, so may be inlined.
+  ///
+  /// States are empty types. A state derived from etl::fsm_substate<TParent>
+  /// is nested in TParent. If the active state has no transition for an event,
+  /// those of its parents are tried, innermost first.
+  /// When a transition is taken, the states are exited from the active state
+  /// up to, but not including, the innermost state that contains both it and
+  /// the target. The action is called, then the states are entered down to
+  /// the target. The context is told with on_enter(TState) and on_exit(TState)
+  /// member functions, if it has them for the state.
+  ///
+  /// Events are etl::message types, so the FSM is also a message router.
+  /// process_event() is resolved at compile time. receive() first finds the
+  /// event type from the message id.
+  ///\code
+  /// struct Idle {};
+  /// struct Running {};
+  ///
+  /// class Motor : public etl::static_fsm<Motor,
+  ///                                      etl::fsm_states<Idle, Running>,
+  ///                                      etl::fsm_transitions<etl::fsm_transition<Idle,    Start, Running, StartMotor>,
+  ///                                                           etl::fsm_transition<Running, Stop,  Idle,    StopMotor>>>
+  ///\endcode
+  ///\tparam TDerived     The derived class, which is the context for the actions and guards.
+  ///\tparam TStates      etl::fsm_states<...>
+  ///\tparam TTransitions etl::fsm_transitions<...>
+  ///\ingroup static_fsm
+  //***************************************************************************
+  template <typename TDerived, typename TStates, typename TTransitions>
+  class static_fsm;
+
+  template <typename TDerived, typename... TStates, typename... TTransitions>
+  class static_fsm<TDerived, etl::fsm_states<TStates...>, etl::fsm_transitions<TTransitions...> > : public etl::imessage_router
+  {
+  public:
+
+    static const size_t NUMBER_OF_STATES = sizeof...(TStates);
+
+    typedef typename etl::smallest_uint_for_value<NUMBER_OF_STATES>::type state_index_t;
+
+    ETL_STATIC_ASSERT(NUMBER_OF_STATES != 0U, "No states");
+    ETL_STATIC_ASSERT(private_static_fsm::all_of((private_static_fsm::count_of<TStates, TStates...>::value == 1U)...), "States must be unique");
+    ETL_STATIC_ASSERT(private_static_fsm::all_of(etl::is_same<typename private_static_fsm::parent_of<TStates>::type, void>::value ||
+                                                 (private_static_fsm::index_of<typename private_static_fsm::parent_of<TStates>::type, TStates...>::value < NUMBER_OF_STATES)...),
+                      "A parent state is not in the list of states");
+    ETL_STATIC_ASSERT(private_static_fsm::all_of((private_static_fsm::index_of<typename TTransitions::from_state, TStates...>::value < NUMBER_OF_STATES)...),
+                      "A transition is from a state that is not in the list of states");
+    ETL_STATIC_ASSERT(private_static_fsm::all_of(etl::is_same<typename TTransitions::to_state, void>::value ||
+                                                 (private_static_fsm::index_of<typename TTransitions::to_state, TStates...>::value < NUMBER_OF_STATES)...),
+                      "A transition is to a state that is not in the list of states");
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    static_fsm(etl::message_router_id_t id)
+      : imessage_router(id),
+        current(NOT_STARTED)
+    {
+    }
+
+    //*******************************************
+    /// Starts the FSM by entering the first state, and the states that it is
+    /// nested in.
+    /// Can only be called once. Subsequent calls will do nothing.
+    //*******************************************
+    void start()
+    {
+      if (current == NOT_STARTED)
+      {
+        typedef typename private_static_fsm::type_at<0U, TStates...>::type initial_state;
+
+        current = 0U;
+        enter_from<void, initial_state>();
+      }
+    }
+
+    //*******************************************
+    /// Reset the FSM to the pre-started state.
+    ///\param call_on_exit_state If true, exits the active state and those that it is nested in.
+    //*******************************************
+    void reset(bool call_on_exit_state = false)
+    {
+      if (call_on_exit_state)
+      {
+        exit_all<0U>();
+      }
+
+      current = NOT_STARTED;
+    }
+
+    //*******************************************
+    /// Checks if the FSM has been started.
+    //*******************************************
+    bool is_started() const
+    {
+      return current != NOT_STARTED;
+    }
+
+    //*******************************************
+    /// Gets the position of the active state in the list of states.
+    //*******************************************
+    size_t get_state_index() const
+    {
+      return current;
+    }
+
+    //*******************************************
+    /// Checks if the active state is TState, or is nested in it.
+    //*******************************************
+    template <typename TState>
+    bool is_in_state() const
+    {
+      static const bool in_state[NUMBER_OF_STATES + 1U] = { private_static_fsm::is_ancestor_or_self<TState, TStates>::value..., false };
+
+      return in_state[current];
+    }
+
+    //*******************************************
+    /// Handles an event.
+    /// \return <b>true</b> if a transition was taken.
+    //*******************************************
+    template <typename TEvent>
+    bool process_event(const TEvent& event)
+    {
+      return dispatch_state<0U>(event);
+    }
+
+    //*******************************************
+    /// Top level message handler for the FSM.
+    //*******************************************
+    void receive(const etl::imessage& message)
+    {
+      dispatch_message<TTransitions...>(message);
+    }
+
+    //*******************************************
+    /// Top level message handler for the FSM.
+    //*******************************************
+    void receive(etl::imessage_router& /*source*/, const etl::imessage& message)
+    {
+      dispatch_message<TTransitions...>(message);
+    }
+
+    //*******************************************
+    /// Top level message handler for the FSM.
+    //*******************************************
+    void receive(etl::imessage_router& source, etl::message_router_id_t destination_router_id, const etl::imessage& message)
+    {
+      if ((destination_router_id == get_message_router_id()) || (destination_router_id == imessage_router::ALL_MESSAGE_ROUTERS))
+      {
+        receive(source, message);
+      }
+    }
+
+    using imessage_router::accepts;
+
+    //*******************************************
+    /// Does this FSM have a transition for the message id?
+    //*******************************************
+    bool accepts(etl::message_id_t id) const
+    {
+      return has_event<TTransitions...>(id);
+    }
+
+    //********************************************
+    bool is_null_router() const
+    {
+      return false;
+    }
+
+  private:
+
+    static const state_index_t NOT_STARTED = state_index_t(NUMBER_OF_STATES);
+
+    template <size_t INDEX>
+    using state_at = typename private_static_fsm::type_at<INDEX, TStates...>::type;
+
+    template <typename TState>
+    using parent_of = typename private_static_fsm::parent_of<TState>::type;
+
+    //*******************************************
+    TDerived& derived()
+    {
+      return static_cast<TDerived&>(*this);
+    }
+
+    //*******************************************
+    /// Finds the active state and handles the event in it.
+    //*******************************************
+    template <size_t INDEX, typename TEvent>
+    typename etl::enable_if<(INDEX < NUMBER_OF_STATES), bool>::type
+      dispatch_state(const TEvent& event)
+    {
+      if (current == INDEX)
+      {
+        return handle<state_at<INDEX>, state_at<INDEX> >(event);
+      }
+
+      return dispatch_state<INDEX + 1U>(event);
+    }
+
+    template <size_t INDEX, typename TEvent>
+    typename etl::enable_if<(INDEX == NUMBER_OF_STATES), bool>::type
+      dispatch_state(const TEvent&)
+    {
+      // Not started.
+      return false;
+    }
+
+    //*******************************************
+    /// Tries the transitions from TLevel, then those of its parents.
+    //*******************************************
+    template <typename TActive, typename TLevel, typename TEvent>
+    typename etl::enable_if<!etl::is_same<TLevel, void>::value, bool>::type
+      handle(const TEvent& event)
+    {
+      return try_transitions<TActive, TLevel, TTransitions...>(event) ||
+             handle<TActive, parent_of<TLevel> >(event);
+    }
+
+    template <typename TActive, typename TLevel, typename TEvent>
+    typename etl::enable_if<etl::is_same<TLevel, void>::value, bool>::type
+      handle(const TEvent&)
+    {
+      return false;
+    }
+
+    //*******************************************
+    /// Takes the first transition from TLevel on the event whose guard passes.
+    //*******************************************
+    template <typename TActive, typename TLevel, typename T1, typename... TRest, typename TEvent>
+    bool try_transitions(const TEvent& event)
+    {
+      typedef etl::integral_constant<bool, etl::is_same<typename T1::from_state, TLevel>::value &&
+                                           etl::is_same<typename T1::event_type, TEvent>::value> is_match;
+
+      return fire<TActive, T1>(event, is_match()) ||
+             try_transitions<TActive, TLevel, TRest...>(event);
+    }
+
+    template <typename TActive, typename TLevel, typename TEvent>
+    bool try_transitions(const TEvent&)
+    {
+      return false;
+    }
+
+    //*******************************************
+    template <typename TActive, typename TTransition, typename TEvent>
+    bool fire(const TEvent& event, etl::true_type /*is_match*/)
+    {
+      if (!typename TTransition::guard_type()(derived(), event))
+      {
+        return false;
+      }
+
+      transit<TActive, TTransition>(event, etl::is_same<typename TTransition::to_state, void>());
+
+      return true;
+    }
+
+    template <typename TActive, typename TTransition, typename TEvent>
+    bool fire(const TEvent&, etl::false_type /*is_match*/)
+    {
+      return false;
+    }
+
+    //*******************************************
+    /// An internal transition only runs the action.
+    //*******************************************
+    template <typename TActive, typename TTransition, typename TEvent>
+    void transit(const TEvent& event, etl::true_type /*is_internal*/)
+    {
+      typename TTransition::action_type()(derived(), event);
+    }
+
+    //*******************************************
+    template <typename TActive, typename TTransition, typename TEvent>
+    void transit(const TEvent& event, etl::false_type /*is_internal*/)
+    {
+      typedef typename TTransition::to_state                                          target_state;
+      typedef typename private_static_fsm::common_ancestor<TActive, target_state>::type common_state;
+
+      exit_to<TActive, common_state>();
+      typename TTransition::action_type()(derived(), event);
+
+      current = state_index_t(private_static_fsm::index_of<target_state, TStates...>::value);
+      enter_from<common_state, target_state>();
+    }
+
+    //*******************************************
+    /// Exits TState and its parents, up to TCommon.
+    //*******************************************
+    template <typename TState, typename TCommon>
+    typename etl::enable_if<!etl::is_same<TState, TCommon>::value>::type
+      exit_to()
+    {
+      call_on_exit<TState>(private_static_fsm::has_on_exit<TDerived, TState>());
+      exit_to<parent_of<TState>, TCommon>();
+    }
+
+    template <typename TState, typename TCommon>
+    typename etl::enable_if<etl::is_same<TState, TCommon>::value>::type
+      exit_to()
+    {
+    }
+
+    //*******************************************
+    /// Enters the parents of TState below TCommon, then TState.
+    //*******************************************
+    template <typename TCommon, typename TState>
+    typename etl::enable_if<!etl::is_same<TState, TCommon>::value>::type
+      enter_from()
+    {
+      enter_from<TCommon, parent_of<TState> >();
+      call_on_enter<TState>(private_static_fsm::has_on_enter<TDerived, TState>());
+    }
+
+    template <typename TCommon, typename TState>
+    typename etl::enable_if<etl::is_same<TState, TCommon>::value>::type
+      enter_from()
+    {
+    }
+
+    //*******************************************
+    template <typename TState>
+    void call_on_enter(etl::true_type)
+    {
+      derived().on_enter(TState());
+    }
+
+    template <typename TState>
+    void call_on_enter(etl::false_type)
+    {
+    }
+
+    //*******************************************
+    template <typename TState>
+    void call_on_exit(etl::true_type)
+    {
+      derived().on_exit(TState());
+    }
+
+    template <typename TState>
+    void call_on_exit(etl::false_type)
+    {
+    }
+
+    //*******************************************
+    /// Exits the active state and all of its parents.
+    //*******************************************
+    template <size_t INDEX>
+    typename etl::enable_if<(INDEX < NUMBER_OF_STATES)>::type
+      exit_all()
+    {
+      if (current == INDEX)
+      {
+        exit_to<state_at<INDEX>, void>();
+      }
+      else
+      {
+        exit_all<INDEX + 1U>();
+      }
+    }
+
+    template <size_t INDEX>
+    typename etl::enable_if<(INDEX == NUMBER_OF_STATES)>::type
+      exit_all()
+    {
+    }
+
+    //*******************************************
+    /// Finds the event type from the message id.
+    //*******************************************
+    template <typename T1, typename... TRest>
+    void dispatch_message(const etl::imessage& message)
+    {
+      typedef typename T1::event_type event_t;
+
+      if (message.message_id == event_t::ID)
+      {
+        process_event(static_cast<const event_t&>(message));
+      }
+      else
+      {
+        dispatch_message<TRest...>(message);
+      }
+    }
+
+    template <typename... TRest>
+    typename etl::enable_if<sizeof...(TRest) == 0U>::type
+      dispatch_message(const etl::imessage&)
+    {
+    }
+
+    //*******************************************
+    template <typename T1, typename... TRest>
+    static bool has_event(etl::message_id_t id)
+    {
+      return (id == T1::event_type::ID) || has_event<TRest...>(id);
+    }
+
+    template <typename... TRest>
+    static typename etl::enable_if<sizeof...(TRest) == 0U, bool>::type
+      has_event(etl::message_id_t)
+    {
+      return false;
+    }
+
+    state_index_t current; ///< The index of the active state.
+  };
+
+  template <typename TDerived, typename... TStates, typename... TTransitions>
+  const size_t static_fsm<TDerived, etl::fsm_states<TStates...>, etl::fsm_transitions<TTransitions...> >::NUMBER_OF_STATES;
+
+  template <typename TDerived, typename... TStates, typename... TTransitions>
+  const typename static_fsm<TDerived, etl::fsm_states<TStates...>, etl::fsm_transitions<TTransitions...> >::state_index_t
+    static_fsm<TDerived, etl::fsm_states<TStates...>, etl::fsm_transitions<TTransitions...> >::NOT_STARTED;
+}
+
+#endif
+
+#undef ETL_FILE
+
+#endif
@@ -547,14 +547,14 @@ namespace std
     {
       TDistance parent = (value_index - 1) / 2;
 
-      while ((value_index > top_index) && compare(first[parent], value))
+      while ((value_index > top_index) && compare(*(first + parent), value))
       {
-        first[value_index] = first[parent];
+        *(first + value_index) = *(first + parent);
         value_index = parent;
         parent = (value_index - 1) / 2;
       }
 
-      first[value_index] = value;
+      *(first + value_index) = value;
     }
 
     // Adjust Heap Helper
@@ -566,19 +566,19 @@ namespace std
 
       while (child2nd < length)
       {
-        if (compare(first[child2nd], first[child2nd - 1]))
+        if (compare(*(first + child2nd), *(first + child2nd - 1)))
         {
           child2nd--;
         }
 
-        first[value_index] = first[child2nd];
+        *(first + value_index) = *(first + child2nd);
         value_index = child2nd;
         child2nd = 2 * (child2nd + 1);
       }
 
       if (child2nd == length)
       {
-        first[value_index] = first[child2nd - 1];
+        *(first + value_index) = *(first + child2nd - 1);
         value_index = child2nd - 1;
       }
 
@@ -593,7 +593,7 @@ namespace std
 
       for (TDistance child = 1; child < n; ++child)
       {
-        if (compare(first[parent], first[child]))
+        if (compare(*(first + parent), *(first + child)))
         {
           return false;
         }
@@ -615,8 +615,8 @@ namespace std
     typedef typename ETLSTD::iterator_traits<TIterator>::value_type value_t;
     typedef typename ETLSTD::iterator_traits<TIterator>::difference_type distance_t;
 
-    value_t value = last[-1];
-    last[-1] = first[0];
+    value_t value = *(last - 1);
+    *(last - 1) = *first;
 
     private_heap::adjust_heap(first, distance_t(0), distance_t(last - first - 1), value, compare);
   }
@@ -34,6 +34,8 @@ SOFTWARE.
 #include "platform.h"
 #include "error_handler.h"
 #include "exception.h"
+#include "function.h"
+#include "nullptr.h"
 
 #undef ETL_FILE
 #define ETL_FILE "37"
@@ -67,7 +69,9 @@ namespace etl
     //*******************************************
     task(task_priority_t priority)
       : task_running(true),
-        task_priority(priority)
+        task_priority(priority),
+        p_task_notifier(nullptr),
+        task_notifier_id(0)
     {
     }
 
@@ -114,10 +118,39 @@ namespace etl
       return task_priority;
     }
 
+    //*******************************************
+    /// Signals to the scheduler that the task has work.
+    /// Only has an effect with a scheduler policy that waits for
+    /// notifications, such as etl::scheduler_policy_ready_bitmap, which
+    /// allows it to be called from other threads or an ISR.
+    /// The policy connects the tasks when the scheduler starts, so other
+    /// threads should not call it until then. Work that a task already has
+    /// at the start is found without a notification.
+    //*******************************************
+    void notify()
+    {
+      if (p_task_notifier != nullptr)
+      {
+        (*p_task_notifier)(task_notifier_id);
+      }
+    }
+
+    //*******************************************
+    /// Sets the function that notify() calls, and the id that it passes.
+    /// Called by the scheduler policy.
+    //*******************************************
+    void set_task_notifier(etl::ifunction<size_t>& notifier, size_t id)
+    {
+      p_task_notifier  = &notifier;
+      task_notifier_id = id;
+    }
+
   private:
 
     bool task_running;
     etl::task_priority_t task_priority;
+    etl::ifunction<size_t>* p_task_notifier;
+    size_t task_notifier_id;
   };
 }
 
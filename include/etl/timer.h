@@ -87,6 +87,27 @@ namespace etl
       typedef uint_least8_t type;
     };
 
+    // Timer wheel id.
+    // Timer wheels allow more timers than fit in etl::timer::id::type.
+    struct wheel_id
+    {
+      enum
+      {
+        NO_TIMER = 0xFFFFFFFF
+      };
+
+      typedef uint32_t type;
+    };
+
+    // Timer interval.
+    struct interval
+    {
+      enum
+      {
+        NO_ACTIVE_INTERVAL = 0xFFFFFFFF
+      };
+    };
+
     // Timer state.
     struct state
     {
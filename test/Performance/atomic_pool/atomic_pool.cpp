@@ -0,0 +1,103 @@
+// atomic_pool.cpp : Compares the allocate/release throughput of etl::atomic_pool
+// with etl::pool guarded by a std::mutex, for 1 to 8 threads.
+//
+// Build with optimisation, for example:
+//   g++ -O2 -std=c++11 -pthread -I../../../include -I../.. atomic_pool.cpp -o atomic_pool
+//
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+#include "etl/pool.h"
+#include "etl/atomic_pool.h"
+
+const size_t POOLSIZE        = 1024;
+const size_t TESTINTERATIONS = 1000000;
+const size_t BATCH           = 4;
+
+struct Item
+{
+  uint64_t data[4];
+};
+
+etl::pool<Item, POOLSIZE>        mutex_pool;
+std::mutex                       pool_mutex;
+etl::atomic_pool<Item, POOLSIZE> atomic_pool;
+
+void MutexPoolWorker()
+{
+  Item* items[BATCH];
+
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    for (size_t j = 0; j < BATCH; ++j)
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      items[j] = mutex_pool.allocate<Item>();
+    }
+
+    for (size_t j = 0; j < BATCH; ++j)
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      mutex_pool.release(items[j]);
+    }
+  }
+}
+
+void AtomicPoolWorker()
+{
+  Item* items[BATCH];
+
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    for (size_t j = 0; j < BATCH; ++j)
+    {
+      items[j] = atomic_pool.allocate<Item>();
+    }
+
+    for (size_t j = 0; j < BATCH; ++j)
+    {
+      atomic_pool.release(items[j]);
+    }
+  }
+}
+
+template <typename TWorker>
+uint64_t Run(TWorker worker, size_t n_threads)
+{
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < n_threads; ++i)
+  {
+    threads.push_back(std::thread(worker));
+  }
+
+  for (size_t i = 0; i < n_threads; ++i)
+  {
+    threads[i].join();
+  }
+
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main()
+{
+  for (size_t n_threads = 1; n_threads <= 8; n_threads *= 2)
+  {
+    const double operations = double(n_threads * TESTINTERATIONS * BATCH * 2);
+
+    uint64_t time = Run(MutexPoolWorker, n_threads);
+    std::cout << n_threads << " threads: pool + mutex = " << time << "ms (" << (operations / (double(time) * 1000.0)) << " Mops/s)\n";
+
+    time = Run(AtomicPoolWorker, n_threads);
+    std::cout << n_threads << " threads: atomic_pool  = " << time << "ms (" << (operations / (double(time) * 1000.0)) << " Mops/s)\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+// message_bus.cpp : Measures the cost of a broadcast on etl::message_bus for
+// different numbers of subscribers, each interested in two of 32 messages.
+// 'indexed' routers list their message ids, so the bus only calls the routers
+// that accept the message. 'unlisted' routers do not, so the bus asks every
+// router with accepts(), as it did before the index was added.
+//
+// Build with optimisation, for example:
+//   g++ -O2 -std=c++11 -I../../../include -I../.. message_bus.cpp -o message_bus
+//
+
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+
+#include "etl/message.h"
+#include "etl/message_router.h"
+#include "etl/message_bus.h"
+
+const int      N_MESSAGE_TYPES = 32;
+const uint32_t N_BROADCASTS    = 1000000;
+
+uint32_t n_received = 0;
+
+//*********************************
+template <int ID>
+struct Message : public etl::message<ID>
+{
+};
+
+//*********************************
+template <int ID>
+struct message_set
+{
+  void fill(const etl::imessage** messages)
+  {
+    messages[ID] = &message;
+    rest.fill(messages);
+  }
+
+  Message<ID>          message;
+  message_set<ID - 1> rest;
+};
+
+template <>
+struct message_set<-1>
+{
+  void fill(const etl::imessage**)
+  {
+  }
+};
+
+//*********************************
+template <int ROUTER_ID, bool LISTED>
+class Router : public etl::message_router<Router<ROUTER_ID, LISTED>,
+                                          Message<ROUTER_ID % N_MESSAGE_TYPES>,
+                                          Message<(ROUTER_ID + 11) % N_MESSAGE_TYPES> >
+{
+public:
+
+  typedef etl::message_router<Router<ROUTER_ID, LISTED>,
+                              Message<ROUTER_ID % N_MESSAGE_TYPES>,
+                              Message<(ROUTER_ID + 11) % N_MESSAGE_TYPES> > base_t;
+
+  Router()
+    : base_t(ROUTER_ID)
+  {
+  }
+
+  template <typename T>
+  void on_receive(etl::imessage_router&, const T&)
+  {
+    ++n_received;
+  }
+
+  void on_receive_unknown(etl::imessage_router&, const etl::imessage&)
+  {
+  }
+
+  bool get_message_ids(const etl::message_id_t*& p_ids, size_t& n_ids) const
+  {
+    return LISTED && base_t::get_message_ids(p_ids, n_ids);
+  }
+};
+
+//*********************************
+template <int ROUTER_ID, bool LISTED>
+struct router_set
+{
+  void subscribe(etl::imessage_bus& bus, int count)
+  {
+    if (count > ROUTER_ID)
+    {
+      bus.subscribe(router);
+    }
+
+    rest.subscribe(bus, count);
+  }
+
+  Router<ROUTER_ID, LISTED>          router;
+  router_set<ROUTER_ID - 1, LISTED> rest;
+};
+
+template <bool LISTED>
+struct router_set<-1, LISTED>
+{
+  void subscribe(etl::imessage_bus&, int)
+  {
+  }
+};
+
+message_set<N_MESSAGE_TYPES - 1> messages;
+const etl::imessage*             message_list[N_MESSAGE_TYPES];
+
+router_set<59, true>  indexed_routers;
+router_set<59, false> unlisted_routers;
+
+//*********************************
+template <typename TRouters>
+void measure(const char* name, TRouters& routers, int count)
+{
+  etl::message_bus<60, 120> bus;
+
+  routers.subscribe(bus, count);
+
+  n_received = 0;
+
+  std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < N_BROADCASTS; ++i)
+  {
+    bus.receive(*message_list[i % N_MESSAGE_TYPES]);
+  }
+
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  double ns = std::chrono::duration<double, std::nano>(end - begin).count() / N_BROADCASTS;
+
+  std::cout << name << " subscribers=" << count
+            << " ns/broadcast=" << ns
+            << " received=" << n_received << std::endl;
+}
+
+//*********************************
+int main()
+{
+  messages.fill(message_list);
+
+  const int counts[] = { 4, 16, 60 };
+
+  for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i)
+  {
+    measure("unlisted", unlisted_routers, counts[i]);
+    measure("indexed ", indexed_routers,  counts[i]);
+  }
+
+  return 0;
+}
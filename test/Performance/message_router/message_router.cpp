@@ -0,0 +1,115 @@
+// message_router.cpp : Measures etl::message_router dispatch, accepts and
+// message_packet copy for a router with 16 message types.
+// Build it twice to compare the variadic router with the generated one:
+//   g++ -O2 -std=c++11 -I../../../include -I../.. message_router.cpp -o message_router_variadic
+//   g++ -O2 -std=c++11 -DETL_MESSAGE_ROUTER_FORCE_CPP03 -I../../../include -I../.. message_router.cpp -o message_router_generated
+//
+
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+
+#include "etl/message.h"
+#include "etl/message_router.h"
+
+const uint32_t N_LOOPS = 10000000;
+
+uint32_t n_received = 0;
+
+//*********************************
+template <int ID>
+struct Message : public etl::message<ID>
+{
+  uint32_t value;
+};
+
+typedef Message<0>  M0;  typedef Message<1>  M1;  typedef Message<2>  M2;  typedef Message<3>  M3;
+typedef Message<4>  M4;  typedef Message<5>  M5;  typedef Message<6>  M6;  typedef Message<7>  M7;
+typedef Message<8>  M8;  typedef Message<9>  M9;  typedef Message<10> M10; typedef Message<11> M11;
+typedef Message<12> M12; typedef Message<13> M13; typedef Message<14> M14; typedef Message<15> M15;
+
+//*********************************
+class Router : public etl::message_router<Router, M0, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15>
+{
+public:
+
+  Router()
+    : message_router(1)
+  {
+  }
+
+  template <typename T>
+  void on_receive(etl::imessage_router&, const T& msg)
+  {
+    n_received += msg.value + T::ID;
+  }
+
+  void on_receive_unknown(etl::imessage_router&, const etl::imessage&)
+  {
+  }
+};
+
+M0 m0; M1 m1; M2 m2;   M3 m3;   M4 m4;   M5 m5;   M6 m6;   M7 m7;
+M8 m8; M9 m9; M10 m10; M11 m11; M12 m12; M13 m13; M14 m14; M15 m15;
+
+const etl::imessage* messages[16] = { &m0, &m1, &m2,  &m3,  &m4,  &m5,  &m6,  &m7,
+                                      &m8, &m9, &m10, &m11, &m12, &m13, &m14, &m15 };
+
+//*********************************
+double elapsed_ns(std::chrono::high_resolution_clock::time_point begin)
+{
+  return std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count() / N_LOOPS;
+}
+
+//*********************************
+int main()
+{
+#if ETL_CPP11_SUPPORTED && !defined(ETL_MESSAGE_ROUTER_FORCE_CPP03)
+  const char* name = "variadic";
+#else
+  const char* name = "generated";
+#endif
+
+  Router router;
+  etl::imessage_router& irouter = router;
+
+  // Dispatch.
+  std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < N_LOOPS; ++i)
+  {
+    irouter.receive(*messages[(i * 7) & 15]);
+  }
+
+  double receive_ns = elapsed_ns(begin);
+
+  // Accepts.
+  uint32_t n_accepted = 0;
+  begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < N_LOOPS; ++i)
+  {
+    n_accepted += irouter.accepts(etl::message_id_t(i & 31)) ? 1 : 0;
+  }
+
+  double accepts_ns = elapsed_ns(begin);
+
+  // Packet copy and destroy.
+  begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < N_LOOPS; ++i)
+  {
+    Router::message_packet packet(*messages[(i * 7) & 15]);
+    n_received += packet.get().message_id;
+  }
+
+  double packet_ns = elapsed_ns(begin);
+
+  std::cout << name
+            << " ns/receive=" << receive_ns
+            << " ns/accepts=" << accepts_ns
+            << " ns/packet="  << packet_ns
+            << " (" << n_received << ", " << n_accepted << ")" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+// numeric.cpp : Compares etl::reduce, etl::transform_reduce and etl::inclusive_scan
+// with std::accumulate, std::inner_product and std::partial_sum.
+//
+// Build with optimisation, for example:
+//   g++ -O2 -std=c++11 -I../../../include -I../.. numeric.cpp -o numeric
+// Add -mavx2 to use the AVX2 kernels rather than SSE2.
+//
+
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <stdint.h>
+
+#include "etl/numeric.h"
+
+std::chrono::steady_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::steady_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+const size_t TESTSIZE        = 65536;
+const size_t TESTINTERATIONS = 2000;
+
+std::vector<int32_t> data_i(TESTSIZE);
+std::vector<int32_t> result_i(TESTSIZE);
+std::vector<float>   data_f(TESTSIZE);
+
+// Stops the optimiser discarding the results.
+volatile int64_t sink;
+
+int main()
+{
+  for (size_t i = 0; i < TESTSIZE; ++i)
+  {
+    data_i[i] = int32_t((i * 7919) % 1000);
+    data_f[i] = float(i % 100) * 0.01f;
+  }
+
+  uint64_t time;
+
+  //*************************************
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    sink = std::accumulate(data_i.begin(), data_i.end(), int32_t(0));
+  }
+  time = StopTimer();
+  std::cout << "STD accumulate int32       = " << time << "us\n";
+
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    sink = etl::reduce(data_i.data(), data_i.data() + TESTSIZE, int32_t(0));
+  }
+  time = StopTimer();
+  std::cout << "ETL reduce int32           = " << time << "us\n";
+
+  //*************************************
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    sink = int64_t(std::accumulate(data_f.begin(), data_f.end(), 0.0f));
+  }
+  time = StopTimer();
+  std::cout << "STD accumulate float       = " << time << "us\n";
+
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    sink = int64_t(etl::reduce(data_f.data(), data_f.data() + TESTSIZE, 0.0f));
+  }
+  time = StopTimer();
+  std::cout << "ETL reduce float           = " << time << "us\n";
+
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    sink = int64_t(etl::reduce(etl::execution::chunked, data_f.data(), data_f.data() + TESTSIZE, 0.0f));
+  }
+  time = StopTimer();
+  std::cout << "ETL reduce chunked float   = " << time << "us\n";
+
+  //*************************************
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    sink = int64_t(std::inner_product(data_f.begin(), data_f.end(), data_f.begin(), 0.0f));
+  }
+  time = StopTimer();
+  std::cout << "STD inner_product float    = " << time << "us\n";
+
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    sink = int64_t(etl::transform_reduce(data_f.data(), data_f.data() + TESTSIZE, data_f.data(), 0.0f));
+  }
+  time = StopTimer();
+  std::cout << "ETL transform_reduce float = " << time << "us\n";
+
+  //*************************************
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    std::partial_sum(data_i.begin(), data_i.end(), result_i.begin());
+    sink = result_i.back();
+  }
+  time = StopTimer();
+  std::cout << "STD partial_sum int32      = " << time << "us\n";
+
+  StartTimer();
+  for (size_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    etl::inclusive_scan(data_i.data(), data_i.data() + TESTSIZE, result_i.data());
+    sink = result_i.back();
+  }
+  time = StopTimer();
+  std::cout << "ETL inclusive_scan int32   = " << time << "us\n";
+
+  return 0;
+}
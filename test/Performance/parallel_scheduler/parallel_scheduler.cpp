@@ -0,0 +1,132 @@
+// parallel_scheduler.cpp : Measures the throughput of etl::scheduler and
+// etl::parallel_scheduler with 1 to 8 workers.
+// Each task has a fixed number of work items, and each item is a short CPU
+// bound loop. The scheduler exits from the idle callback when all of the work
+// has been done.
+//
+// Build with optimisation, for example:
+//   g++ -O2 -std=c++11 -pthread -I../../../include -I../.. parallel_scheduler.cpp -o parallel_scheduler
+//
+
+#include <chrono>
+#include <iostream>
+#include <atomic>
+#include <stdint.h>
+
+#include "etl/scheduler.h"
+#include "etl/parallel_scheduler.h"
+#include "etl/function.h"
+
+const size_t   N_TASKS        = 32;
+const uint32_t ITEMS_PER_TASK = 2000;
+const uint32_t ITEM_COST      = 5000;
+
+//*********************************
+class work_task : public etl::task
+{
+public:
+
+  work_task()
+    : task(0),
+      remaining(ITEMS_PER_TASK),
+      result(0)
+  {
+  }
+
+  uint32_t task_request_work() const
+  {
+    return remaining.load(std::memory_order_relaxed);
+  }
+
+  void task_process_work()
+  {
+    uint32_t hash = result;
+
+    for (uint32_t i = 0; i < ITEM_COST; ++i)
+    {
+      hash = (hash ^ i) * 16777619U;
+    }
+
+    result = hash;
+    remaining.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint32_t> remaining;
+  uint32_t              result;
+};
+
+work_task tasks[N_TASKS];
+
+//*********************************
+template <typename TScheduler>
+struct exit_when_done
+{
+  exit_when_done(TScheduler& scheduler_)
+    : scheduler(scheduler_)
+  {
+  }
+
+  void idle()
+  {
+    for (size_t i = 0; i < N_TASKS; ++i)
+    {
+      if (tasks[i].task_request_work() > 0)
+      {
+        return;
+      }
+    }
+
+    scheduler.exit_scheduler();
+  }
+
+  TScheduler& scheduler;
+};
+
+//*********************************
+template <typename TScheduler>
+uint64_t Run(TScheduler& scheduler)
+{
+  for (size_t i = 0; i < N_TASKS; ++i)
+  {
+    tasks[i].remaining = ITEMS_PER_TASK;
+    scheduler.add_task(tasks[i]);
+  }
+
+  exit_when_done<TScheduler> callbacks(scheduler);
+  etl::function_mv<exit_when_done<TScheduler>, &exit_when_done<TScheduler>::idle> idle_callback(callbacks);
+  scheduler.set_idle_callback(idle_callback);
+
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+  scheduler.start();
+
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+//*********************************
+template <size_t N_WORKERS>
+void RunParallel()
+{
+  static etl::parallel_scheduler<N_TASKS, N_WORKERS> scheduler;
+
+  uint64_t time = Run(scheduler);
+  std::cout << "parallel_scheduler, " << N_WORKERS << " workers = " << time << "ms (" << (N_TASKS * ITEMS_PER_TASK) / (time + 1) << " items/ms)\n";
+}
+
+//*********************************
+int main()
+{
+  static etl::scheduler<etl::scheduler_policy_sequencial_single, N_TASKS> scheduler;
+
+  uint64_t time = Run(scheduler);
+  std::cout << "scheduler                     = " << time << "ms (" << (N_TASKS * ITEMS_PER_TASK) / (time + 1) << " items/ms)\n";
+
+  RunParallel<1>();
+  RunParallel<2>();
+  RunParallel<4>();
+  RunParallel<8>();
+
+  std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n";
+
+  return 0;
+}
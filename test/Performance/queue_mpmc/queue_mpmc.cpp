@@ -0,0 +1,90 @@
+// queue_mpmc.cpp : Compares etl::queue_mpmc_mutex with etl::queue_mpmc_atomic
+// for 1 to 8 producer threads and the same number of consumer threads.
+// The waiting loops yield so that the test also completes on a single core.
+//
+// Build with optimisation, for example:
+//   g++ -O2 -std=c++11 -pthread -I../../../include -I../.. queue_mpmc.cpp -o queue_mpmc
+//
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+
+#include "etl/queue_mpmc_mutex.h"
+#include "etl/queue_mpmc_atomic.h"
+
+const size_t TESTSIZE   = 2000000;
+const size_t QUEUESIZE  = 1024;
+const size_t MAXTHREADS = 8;
+
+etl::queue_mpmc_mutex<uint32_t, QUEUESIZE>  mutex_queue;
+etl::queue_mpmc_atomic<uint32_t, QUEUESIZE> atomic_queue;
+
+//*********************************
+template <typename TQueue>
+uint64_t Run(TQueue& queue, size_t n_threads)
+{
+  const size_t items_per_producer = TESTSIZE / n_threads;
+
+  std::atomic<size_t> n_popped(0);
+
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < n_threads; ++t)
+  {
+    threads.push_back(std::thread([&]()
+    {
+      for (size_t i = 0; i < items_per_producer; ++i)
+      {
+        while (!queue.push(uint32_t(i)))
+        {
+          std::this_thread::yield();
+        }
+      }
+    }));
+
+    threads.push_back(std::thread([&]()
+    {
+      uint32_t value;
+
+      while (n_popped.load(std::memory_order_relaxed) < (items_per_producer * n_threads))
+      {
+        if (queue.pop(value))
+        {
+          n_popped.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    }));
+  }
+
+  for (size_t t = 0; t < threads.size(); ++t)
+  {
+    threads[t].join();
+  }
+
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+//*********************************
+int main()
+{
+  for (size_t n_threads = 1; n_threads <= MAXTHREADS; n_threads *= 2)
+  {
+    uint64_t time = Run(mutex_queue, n_threads);
+    std::cout << n_threads << " producers, " << n_threads << " consumers: queue_mpmc_mutex  = " << time << "ms (" << (TESTSIZE / (time + 1)) / 1000 << " Mitems/s)\n";
+
+    time = Run(atomic_queue, n_threads);
+    std::cout << n_threads << " producers, " << n_threads << " consumers: queue_mpmc_atomic = " << time << "ms (" << (TESTSIZE / (time + 1)) / 1000 << " Mitems/s)\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,245 @@
+// queue_spsc.cpp : Compares etl::queue_spsc_atomic with etl::queue_spsc_atomic_padded.
+//
+// Throughput: one thread pushes TESTSIZE items while another pops them.
+// Latency:    two threads bounce one item back and forth through a pair of queues.
+// The waiting loops yield so that the test also completes on a single core.
+//
+// Build with optimisation, for example:
+//   g++ -O2 -std=c++11 -pthread -I../../../include -I../.. queue_spsc.cpp -o queue_spsc
+//
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <stdint.h>
+
+#include "etl/queue_spsc_atomic.h"
+#include "etl/queue_spsc_atomic_padded.h"
+
+const size_t TESTSIZE        = 10000000;
+const size_t TESTINTERATIONS = 100000;
+const size_t QUEUESIZE       = 1024;
+const size_t BATCH           = 32;
+
+typedef etl::queue_spsc_atomic<uint32_t, QUEUESIZE>        Queue;
+typedef etl::queue_spsc_atomic_padded<uint32_t, QUEUESIZE> PaddedQueue;
+
+Queue       queue1;
+Queue       queue2;
+PaddedQueue padded_queue1;
+PaddedQueue padded_queue2;
+
+std::chrono::steady_clock::time_point begin;
+
+//*********************************
+void StartTimer()
+{
+  begin = std::chrono::steady_clock::now();
+}
+
+//*********************************
+uint64_t StopTimer()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+//*********************************
+template <typename TQueue>
+void PushSingle(TQueue& queue)
+{
+  for (uint32_t i = 0; i < TESTSIZE; ++i)
+  {
+    while (!queue.push(i))
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+//*********************************
+template <typename TQueue>
+void PopSingle(TQueue& queue)
+{
+  uint32_t value;
+
+  for (uint32_t i = 0; i < TESTSIZE; ++i)
+  {
+    while (!queue.pop(value))
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+//*********************************
+void PushBatch(PaddedQueue& queue)
+{
+  uint32_t values[BATCH];
+  uint32_t next = 0;
+
+  while (next < TESTSIZE)
+  {
+    size_t n = ((TESTSIZE - next) < BATCH) ? (TESTSIZE - next) : BATCH;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      values[i] = uint32_t(next + i);
+    }
+
+    size_t pushed = queue.push_n(values, PaddedQueue::size_type(n));
+
+    if (pushed == 0)
+    {
+      std::this_thread::yield();
+    }
+
+    next += uint32_t(pushed);
+  }
+}
+
+//*********************************
+void PopBatch(PaddedQueue& queue)
+{
+  uint32_t values[BATCH];
+  size_t   count = 0;
+
+  while (count < TESTSIZE)
+  {
+    size_t popped = queue.pop_n(values, BATCH);
+
+    if (popped == 0)
+    {
+      std::this_thread::yield();
+    }
+
+    count += popped;
+  }
+}
+
+//*********************************
+void PushInPlace(PaddedQueue& queue)
+{
+  uint32_t next = 0;
+
+  while (next < TESTSIZE)
+  {
+    etl::array_view<uint32_t> span = queue.reserve_write(BATCH);
+
+    if (span.empty())
+    {
+      std::this_thread::yield();
+    }
+
+    size_t n = ((TESTSIZE - next) < span.size()) ? (TESTSIZE - next) : span.size();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      span[i] = next++;
+    }
+
+    queue.commit(PaddedQueue::size_type(n));
+  }
+}
+
+//*********************************
+void PopInPlace(PaddedQueue& queue)
+{
+  size_t count = 0;
+
+  while (count < TESTSIZE)
+  {
+    etl::array_view<uint32_t> span = queue.peek_read();
+
+    if (span.empty())
+    {
+      std::this_thread::yield();
+    }
+    count += span.size();
+    queue.release(PaddedQueue::size_type(span.size()));
+  }
+}
+
+//*********************************
+template <typename TPush, typename TPop>
+uint64_t Throughput(TPush push, TPop pop)
+{
+  StartTimer();
+
+  std::thread producer(push);
+  std::thread consumer(pop);
+
+  producer.join();
+  consumer.join();
+
+  return StopTimer();
+}
+
+//*********************************
+template <typename TQueue>
+uint64_t Latency(TQueue& ping, TQueue& pong)
+{
+  StartTimer();
+
+  std::thread responder([&]()
+  {
+    uint32_t value;
+
+    for (size_t i = 0; i < TESTINTERATIONS; ++i)
+    {
+      while (!ping.pop(value))
+      {
+        std::this_thread::yield();
+      }
+
+      while (!pong.push(value))
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t value;
+
+  for (uint32_t i = 0; i < TESTINTERATIONS; ++i)
+  {
+    while (!ping.push(i))
+    {
+      std::this_thread::yield();
+    }
+
+    while (!pong.pop(value))
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  responder.join();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+//*********************************
+int main()
+{
+  uint64_t time;
+
+  time = Throughput([]() { PushSingle(queue1); }, []() { PopSingle(queue1); });
+  std::cout << "queue_spsc_atomic        push/pop     = " << time << "ms (" << (TESTSIZE / (time + 1)) / 1000 << " Mitems/s)\n";
+
+  time = Throughput([]() { PushSingle(padded_queue1); }, []() { PopSingle(padded_queue1); });
+  std::cout << "queue_spsc_atomic_padded push/pop     = " << time << "ms (" << (TESTSIZE / (time + 1)) / 1000 << " Mitems/s)\n";
+
+  time = Throughput([]() { PushBatch(padded_queue1); }, []() { PopBatch(padded_queue1); });
+  std::cout << "queue_spsc_atomic_padded push_n/pop_n = " << time << "ms (" << (TESTSIZE / (time + 1)) / 1000 << " Mitems/s)\n";
+
+  time = Throughput([]() { PushInPlace(padded_queue1); }, []() { PopInPlace(padded_queue1); });
+  std::cout << "queue_spsc_atomic_padded reserve/peek = " << time << "ms (" << (TESTSIZE / (time + 1)) / 1000 << " Mitems/s)\n";
+
+  time = Latency(queue1, queue2);
+  std::cout << "queue_spsc_atomic        round trip   = " << (time * 1000) / TESTINTERATIONS << "ns\n";
+
+  time = Latency(padded_queue1, padded_queue2);
+  std::cout << "queue_spsc_atomic_padded round trip   = " << (time * 1000) / TESTINTERATIONS << "ns\n";
+
+  return 0;
+}
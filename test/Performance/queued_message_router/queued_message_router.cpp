@@ -0,0 +1,153 @@
+// queued_message_router.cpp : Compares queueing messages as message_packets
+// in an etl::queue (examples/QueuedMessageRouter) with etl::queued_message_router.
+// Measures the queue memory, and the time to queue and handle small and large
+// messages, including handing over a large message that is already in the pool.
+//   g++ -O2 -std=c++11 -pthread -I../../../include -I../.. queued_message_router.cpp -o queued_message_router
+//
+
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+
+#include "etl/queue.h"
+#include "etl/message_router.h"
+#include "etl/queued_message_router.h"
+
+const uint32_t N_LOOPS  = 2000000;
+const size_t   N_QUEUED = 16;
+
+uint32_t total = 0;
+
+//*********************************
+struct Small : public etl::message<1>
+{
+  Small(uint32_t value_) : value(value_) {}
+  uint32_t value;
+};
+
+struct Large : public etl::message<2>
+{
+  Large(uint32_t value_) : value(value_) { data[0] = 0; }
+  uint32_t value;
+  uint8_t  data[1020];
+};
+
+//*********************************
+// The pattern from examples/QueuedMessageRouter.
+class PacketRouter : public etl::message_router<PacketRouter, Small, Large>
+{
+public:
+
+  typedef etl::message_router<PacketRouter, Small, Large> base_t;
+
+  using base_t::receive;
+
+  PacketRouter()
+    : message_router(1)
+  {
+  }
+
+  void receive(etl::imessage_router& sender, const etl::imessage& msg)
+  {
+    queue.emplace(&sender, msg);
+  }
+
+  void process_queue()
+  {
+    while (!queue.empty())
+    {
+      Item& item = queue.front();
+      base_t::receive(*item.sender, item.packet.get());
+      queue.pop();
+    }
+  }
+
+  void on_receive(etl::imessage_router&, const Small& msg) { total += msg.value; }
+  void on_receive(etl::imessage_router&, const Large& msg) { total += msg.value; }
+  void on_receive_unknown(etl::imessage_router&, const etl::imessage&) {}
+
+  struct Item
+  {
+    Item(etl::imessage_router* sender_, const etl::imessage& msg_)
+      : sender(sender_),
+        packet(msg_)
+    {
+    }
+
+    etl::imessage_router* sender;
+    message_packet        packet;
+  };
+
+  etl::queue<Item, N_QUEUED> queue;
+};
+
+//*********************************
+typedef etl::message_pool<etl::generic_atomic_pool<64,   8, N_QUEUED>,
+                          etl::generic_atomic_pool<1088, 8, 2> > Pool;
+
+class PoolRouter : public etl::queued_message_router<PoolRouter, etl::message_queue_spsc<N_QUEUED>, Small, Large>
+{
+public:
+
+  PoolRouter(Pool& pool)
+    : queued_message_router(1, pool)
+  {
+  }
+
+  void on_receive(etl::imessage_router&, const Small& msg) { total += msg.value; }
+  void on_receive(etl::imessage_router&, const Large& msg) { total += msg.value; }
+  void on_receive_unknown(etl::imessage_router&, const etl::imessage&) {}
+};
+
+//*********************************
+template <typename TRouter, typename TMessage>
+double run(TRouter& router, const TMessage& msg)
+{
+  std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < N_LOOPS; ++i)
+  {
+    for (size_t j = 0; j < N_QUEUED; ++j)
+    {
+      router.receive(msg);
+    }
+
+    router.process_queue();
+  }
+
+  return std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count() / (N_LOOPS * N_QUEUED);
+}
+
+//*********************************
+int main()
+{
+  PacketRouter packet_router;
+
+  Pool       pool;
+  PoolRouter pool_router(pool);
+
+  Small small(1);
+  Large large(1);
+
+  double packet_small_ns = run(packet_router, small);
+  double pool_small_ns   = run(pool_router, small);
+  double packet_large_ns = run(packet_router, large);
+
+  // Zero copy hand over of a message that is already in the pool.
+  std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < N_LOOPS; ++i)
+  {
+    pool_router.post(pool.create<Large>(1));
+    pool_router.process_queue();
+  }
+
+  double post_ns = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count() / N_LOOPS;
+
+  std::cout << "message_packet queue  : " << sizeof(packet_router.queue) << " bytes, small " << packet_small_ns << " ns, large " << packet_large_ns << " ns" << std::endl;
+  std::cout << "queued_message_router : " << sizeof(pool) + sizeof(pool_router) << " bytes, small " << pool_small_ns << " ns" << std::endl;
+  std::cout << "post large from pool  : " << post_ns << " ns" << std::endl;
+  std::cout << "(" << total << ")" << std::endl;
+
+  return 0;
+}
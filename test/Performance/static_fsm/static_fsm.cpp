@@ -0,0 +1,244 @@
+// static_fsm.cpp : Compares the cost of an event for etl::fsm and etl::static_fsm
+// for a motor control state machine with three states.
+// Each loop sends Start, SetSpeed, Stop and Stopped, so takes three transitions
+// with enter and exit handlers, and one internal transition.
+//   g++ -O2 -std=c++14 -I../../../include -I../.. static_fsm.cpp -o static_fsm
+//
+
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+
+#include "etl/fsm.h"
+#include "etl/static_fsm.h"
+
+const uint32_t N_LOOPS = 10000000;
+
+//*********************************
+enum
+{
+  START,
+  STOP,
+  STOPPED,
+  SET_SPEED
+};
+
+struct Start    : public etl::message<START>     {};
+struct Stop     : public etl::message<STOP>      {};
+struct Stopped  : public etl::message<STOPPED>   {};
+struct SetSpeed : public etl::message<SET_SPEED> { int speed; };
+
+Start    start;
+Stop     stop;
+Stopped  stopped;
+SetSpeed set_speed;
+
+const etl::imessage* messages[4] = { &start, &set_speed, &stop, &stopped };
+
+//*********************************
+double elapsed_ns(std::chrono::high_resolution_clock::time_point begin)
+{
+  return std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count() / (N_LOOPS * 4);
+}
+
+//*****************************************************************************
+// etl::fsm
+//*****************************************************************************
+namespace dynamic
+{
+  enum
+  {
+    IDLE,
+    RUNNING,
+    WINDING_DOWN
+  };
+
+  class MotorControl : public etl::fsm
+  {
+  public:
+
+    MotorControl()
+      : fsm(1),
+        speed(0),
+        n_calls(0)
+    {
+    }
+
+    int      speed;
+    uint32_t n_calls;
+  };
+
+  class Idle : public etl::fsm_state<MotorControl, Idle, IDLE, Start>
+  {
+  public:
+
+    etl::fsm_state_id_t on_event(etl::imessage_router&, const Start&)
+    {
+      return RUNNING;
+    }
+
+    etl::fsm_state_id_t on_event_unknown(etl::imessage_router&, const etl::imessage&)
+    {
+      return STATE_ID;
+    }
+
+    etl::fsm_state_id_t on_enter_state()
+    {
+      ++get_fsm_context().n_calls;
+      return STATE_ID;
+    }
+  };
+
+  class Running : public etl::fsm_state<MotorControl, Running, RUNNING, Stop, SetSpeed>
+  {
+  public:
+
+    etl::fsm_state_id_t on_event(etl::imessage_router&, const Stop&)
+    {
+      return WINDING_DOWN;
+    }
+
+    etl::fsm_state_id_t on_event(etl::imessage_router&, const SetSpeed& event)
+    {
+      get_fsm_context().speed += event.speed + 1;
+      return STATE_ID;
+    }
+
+    etl::fsm_state_id_t on_event_unknown(etl::imessage_router&, const etl::imessage&)
+    {
+      return STATE_ID;
+    }
+
+    etl::fsm_state_id_t on_enter_state()
+    {
+      ++get_fsm_context().n_calls;
+      return STATE_ID;
+    }
+
+    void on_exit_state()
+    {
+      ++get_fsm_context().n_calls;
+    }
+  };
+
+  class WindingDown : public etl::fsm_state<MotorControl, WindingDown, WINDING_DOWN, Stopped>
+  {
+  public:
+
+    etl::fsm_state_id_t on_event(etl::imessage_router&, const Stopped&)
+    {
+      return IDLE;
+    }
+
+    etl::fsm_state_id_t on_event_unknown(etl::imessage_router&, const etl::imessage&)
+    {
+      return STATE_ID;
+    }
+  };
+}
+
+//*****************************************************************************
+// etl::static_fsm
+//*****************************************************************************
+namespace fixed
+{
+  struct Idle        {};
+  struct Running     {};
+  struct WindingDown {};
+
+  struct ChangeSpeed
+  {
+    template <typename TContext>
+    void operator ()(TContext& context, const SetSpeed& event) const
+    {
+      context.speed += event.speed + 1;
+    }
+  };
+
+  typedef etl::fsm_states<Idle, Running, WindingDown> States;
+
+  typedef etl::fsm_transitions<etl::fsm_transition<Idle,        Start,    Running>,
+                               etl::fsm_transition<Running,     SetSpeed, void, ChangeSpeed>,
+                               etl::fsm_transition<Running,     Stop,     WindingDown>,
+                               etl::fsm_transition<WindingDown, Stopped,  Idle> > Transitions;
+
+  class MotorControl : public etl::static_fsm<MotorControl, States, Transitions>
+  {
+  public:
+
+    MotorControl()
+      : static_fsm(1),
+        speed(0),
+        n_calls(0)
+    {
+    }
+
+    void on_enter(Idle)    { ++n_calls; }
+    void on_enter(Running) { ++n_calls; }
+    void on_exit(Running)  { ++n_calls; }
+
+    int      speed;
+    uint32_t n_calls;
+  };
+}
+
+//*********************************
+int main()
+{
+  // etl::fsm, through imessage_router::receive.
+  dynamic::MotorControl dynamic_motor;
+  dynamic::Idle         idle;
+  dynamic::Running      running;
+  dynamic::WindingDown  winding_down;
+
+  etl::ifsm_state* states[] = { &idle, &running, &winding_down };
+  dynamic_motor.set_states(states, 3);
+  dynamic_motor.start();
+
+  etl::imessage_router& dynamic_router = dynamic_motor;
+
+  std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < (N_LOOPS * 4); ++i)
+  {
+    dynamic_router.receive(*messages[i & 3]);
+  }
+
+  double fsm_ns = elapsed_ns(begin);
+
+  // etl::static_fsm, through imessage_router::receive.
+  fixed::MotorControl fixed_motor;
+  fixed_motor.start();
+
+  etl::imessage_router& fixed_router = fixed_motor;
+
+  begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < (N_LOOPS * 4); ++i)
+  {
+    fixed_router.receive(*messages[i & 3]);
+  }
+
+  double static_fsm_receive_ns = elapsed_ns(begin);
+
+  // etl::static_fsm, through process_event with the event types known.
+  begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < N_LOOPS; ++i)
+  {
+    fixed_motor.process_event(start);
+    fixed_motor.process_event(set_speed);
+    fixed_motor.process_event(stop);
+    fixed_motor.process_event(stopped);
+  }
+
+  double static_fsm_process_ns = elapsed_ns(begin);
+
+  std::cout << "fsm ns/event="                        << fsm_ns
+            << " static_fsm ns/event (receive)="       << static_fsm_receive_ns
+            << " static_fsm ns/event (process_event)=" << static_fsm_process_ns
+            << " (" << dynamic_motor.n_calls << ", " << fixed_motor.n_calls << ", "
+            << dynamic_motor.speed << ", " << fixed_motor.speed << ")" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+// timer_wheel.cpp : Compares etl::callback_timer with etl::callback_timer_wheel.
+// Each timer is started with a pseudo random repeating period, then the
+// controller is ticked one tick at a time. The time per tick and the time to
+// stop and restart every timer are reported.
+// etl::callback_timer is limited to 254 timers, so it is only measured for
+// the smaller counts.
+//
+// Build with optimisation, for example:
+//   g++ -O2 -std=c++11 -I../../../include -I../.. timer_wheel.cpp -o timer_wheel
+//
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+#include "etl/callback_timer.h"
+#include "etl/callback_timer_wheel.h"
+#include "etl/function.h"
+
+const uint32_t N_TICKS    = 100000;
+const uint32_t MAX_PERIOD = 5000;
+
+uint32_t n_callbacks = 0;
+
+//*********************************
+void on_timer()
+{
+  ++n_callbacks;
+}
+
+etl::function_fv<on_timer> callback;
+
+//*********************************
+uint32_t next_period(uint32_t& seed)
+{
+  seed = (seed * 1664525U) + 1013904223U;
+
+  return ((seed >> 8) % MAX_PERIOD) + 1;
+}
+
+//*********************************
+template <typename TController, typename TId>
+void measure(const char* name, TController& controller, uint32_t n_timers)
+{
+  std::vector<TId> ids;
+  uint32_t seed = 1;
+
+  controller.clear();
+
+  for (uint32_t i = 0; i < n_timers; ++i)
+  {
+    ids.push_back(controller.register_timer(callback, next_period(seed), etl::timer::mode::REPEATING));
+    controller.start(ids.back());
+  }
+
+  controller.enable(true);
+  n_callbacks = 0;
+
+  std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t t = 0; t < N_TICKS; ++t)
+  {
+    controller.tick(1);
+  }
+
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  double tick_ns = std::chrono::duration<double, std::nano>(end - begin).count() / N_TICKS;
+
+  begin = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < n_timers; ++i)
+  {
+    controller.stop(ids[i]);
+    controller.start(ids[i]);
+  }
+
+  end = std::chrono::high_resolution_clock::now();
+
+  double restart_ns = std::chrono::duration<double, std::nano>(end - begin).count() / n_timers;
+
+  std::cout << name << " timers=" << n_timers
+            << " ns/tick=" << tick_ns
+            << " ns/restart=" << restart_ns
+            << " callbacks=" << n_callbacks << std::endl;
+}
+
+etl::callback_timer<10>             list_10;
+etl::callback_timer<254>            list_254;
+etl::callback_timer_wheel<10>       wheel_10;
+etl::callback_timer_wheel<254>      wheel_254;
+etl::callback_timer_wheel<1000>     wheel_1k;
+etl::callback_timer_wheel<100000>   wheel_100k;
+
+//*********************************
+int main()
+{
+  measure<etl::icallback_timer, etl::timer::id::type>("callback_timer      ", list_10, 10);
+  measure<etl::icallback_timer_wheel, etl::timer::wheel_id::type>("callback_timer_wheel", wheel_10, 10);
+
+  measure<etl::icallback_timer, etl::timer::id::type>("callback_timer      ", list_254, 254);
+  measure<etl::icallback_timer_wheel, etl::timer::wheel_id::type>("callback_timer_wheel", wheel_254, 254);
+
+  std::cout << "callback_timer       timers=1000 not supported (maximum 254)" << std::endl;
+  measure<etl::icallback_timer_wheel, etl::timer::wheel_id::type>("callback_timer_wheel", wheel_1k, 1000);
+
+  std::cout << "callback_timer       timers=100000 not supported (maximum 254)" << std::endl;
+  measure<etl::icallback_timer_wheel, etl::timer::wheel_id::type>("callback_timer_wheel", wheel_100k, 100000);
+
+  return 0;
+}
@@ -43,6 +43,8 @@ SOFTWARE.
 #define ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK
 #define ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK
 
+#define ETL_QUEUE_WAIT
+
 #define ETL_POLYMORPHIC_BITSET
 #define ETL_POLYMORPHIC_DEQUE
 #define ETL_POLYMORPHIC_FLAT_MAP
@@ -30,12 +30,15 @@ SOFTWARE.
 
 #include "etl/algorithm.h"
 #include "etl/container.h"
+#include "etl/vector.h"
+#include "etl/deque.h"
 
 #include <vector>
 #include <list>
 #include <algorithm>
 #include <functional>
 #include <numeric>
+#include <limits>
 
 namespace
 {
@@ -69,12 +72,100 @@ namespace
     }
   };
 
+  template <typename T>
+  struct StructDataSortCompare
+  {
+    bool operator ()(const T& lhs, const T& rhs) const
+    {
+      return lhs < rhs;
+    }
+  };
+
   std::ostream& operator << (std::ostream& os, const StructData& data_)
   {
     os << data_.a << "," << data_.b;
     return os;
   }
 
+  //***************************************************************************
+  // Checks the pointer (vectorised) forms against the standard algorithms for
+  // all lengths up to a few vectors and for unaligned starting addresses.
+  //***************************************************************************
+  template <typename T>
+  bool check_vectorised_algorithms(int range)
+  {
+    std::vector<T> buffer1(140);
+    std::vector<T> buffer2(140);
+
+    unsigned seed = 1;
+
+    for (size_t i = 0; i < buffer1.size(); ++i)
+    {
+      seed = (seed * 1103515245U) + 12345U;
+      buffer1[i] = T((seed >> 16) % range) - T(range / 2);
+    }
+
+    for (size_t offset = 0; offset < 4; ++offset)
+    {
+      for (size_t length = 0; length < (buffer1.size() - offset); ++length)
+      {
+        const T* first = buffer1.data() + offset;
+        const T* last  = first + length;
+
+        for (int v = -(range / 2) - 1; v <= (range / 2); ++v)
+        {
+          const T value = T(v);
+
+          if ((etl::find(first, last, value) != std::find(first, last, value)) ||
+              (etl::count(first, last, value) != std::count(first, last, value)))
+          {
+            return false;
+          }
+        }
+
+        // First smallest and first largest.
+        const T* expected_min = std::min_element(first, last);
+        const T* expected_max = std::max_element(first, last);
+
+        std::pair<const T*, const T*> result = etl::minmax_element(first, last);
+
+        if ((etl::min_element(first, last) != expected_min) ||
+            (etl::max_element(first, last) != expected_max) ||
+            (result.first  != expected_min) ||
+            (result.second != expected_max))
+        {
+          return false;
+        }
+
+        // Differ at each position in turn.
+        buffer2 = buffer1;
+
+        for (size_t i = 0; i <= length; ++i)
+        {
+          T* first2 = buffer2.data() + offset;
+
+          if (i < length)
+          {
+            first2[i] = T(first2[i] + 1);
+          }
+
+          if ((etl::mismatch(first, last, first2).first != std::mismatch(first, last, first2).first) ||
+              (etl::equal(first, last, first2) != std::equal(first, last, first2)))
+          {
+            return false;
+          }
+
+          if (i < length)
+          {
+            first2[i] = first[i];
+          }
+        }
+      }
+    }
+
+    return true;
+  }
+
   SUITE(test_algorithm)
   {
     //=========================================================================
@@ -910,6 +1001,370 @@ namespace
       }
     }
 
+    //=========================================================================
+    TEST(sort_small_sizes)
+    {
+      // Covers the sorting networks.
+      for (int n = 0; n <= 20; ++n)
+      {
+        std::vector<int> data(n);
+        std::iota(data.begin(), data.end(), 0);
+
+        for (int i = 0; i < 100; ++i)
+        {
+          std::random_shuffle(data.begin(), data.end());
+
+          std::vector<int> data1 = data;
+          std::vector<int> data2 = data;
+          std::vector<int> data3 = data;
+
+          std::sort(data1.begin(), data1.end());
+          etl::sort(data2.begin(), data2.end());
+          etl::sort(data3.begin(), data3.end(), StructDataSortCompare<int>());
+
+          CHECK(data1 == data2);
+          CHECK(data1 == data3);
+        }
+      }
+    }
+
+    //=========================================================================
+    TEST(sort_patterns)
+    {
+      const size_t SIZE = 10000;
+
+      std::vector<std::vector<int> > patterns;
+      std::vector<int> data(SIZE);
+
+      std::iota(data.begin(), data.end(), 0);
+      patterns.push_back(data);                                // Sorted
+      std::reverse(data.begin(), data.end());
+      patterns.push_back(data);                                // Reverse sorted
+      std::fill(data.begin(), data.end(), 42);
+      patterns.push_back(data);                                // All equal
+      for (size_t i = 0; i < SIZE; ++i) data[i] = int(i < SIZE / 2 ? i : SIZE - i);
+      patterns.push_back(data);                                // Organ pipe
+      for (size_t i = 0; i < SIZE; ++i) data[i] = int(i % 16);
+      patterns.push_back(data);                                // Many duplicates
+      for (size_t i = 0; i < SIZE; ++i) data[i] = int((i * 2654435761U) % 100003);
+      patterns.push_back(data);                                // Random
+      std::iota(data.begin(), data.end(), 0);
+      std::swap(data[10], data[SIZE - 10]);
+      patterns.push_back(data);                                // Nearly sorted
+
+      for (size_t p = 0; p < patterns.size(); ++p)
+      {
+        std::vector<int> data1 = patterns[p];
+        std::vector<int> data2 = patterns[p];
+        std::vector<int> data3 = patterns[p];
+        std::vector<int> data4 = patterns[p];
+
+        std::sort(data1.begin(), data1.end());
+        etl::sort(data2.begin(), data2.end());
+        etl::sort(data3.begin(), data3.end(), StructDataSortCompare<int>());
+
+        CHECK(data1 == data2);
+        CHECK(data1 == data3);
+
+        std::sort(data1.begin(), data1.end(), std::greater<int>());
+        etl::sort(data4.begin(), data4.end(), std::greater<int>());
+
+        CHECK(data1 == data4);
+      }
+    }
+
+    //=========================================================================
+    TEST(sort_structs)
+    {
+      std::vector<StructData> data;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        StructData item = { (i * 7919) % 1009, i };
+        data.push_back(item);
+      }
+
+      std::vector<StructData> data1 = data;
+      std::vector<StructData> data2 = data;
+
+      std::sort(data1.begin(), data1.end(), StructDataPredicate());
+      etl::sort(data2.begin(), data2.end(), StructDataPredicate());
+
+      bool is_same = std::equal(data1.begin(), data1.end(), data2.begin(), StructDataEquality());
+      CHECK(is_same);
+    }
+
+    //=========================================================================
+    TEST(sort_etl_containers)
+    {
+      etl::vector<int, 1000> vdata;
+      etl::deque<int, 1000>  ddata;
+      std::vector<int>       compare;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        int value = (i * 7919) % 1009 - 500;
+        vdata.push_back(value);
+        ddata.push_front(value);
+        compare.push_back(value);
+      }
+
+      std::sort(compare.begin(), compare.end());
+      etl::sort(vdata.begin(), vdata.end());
+      etl::sort(ddata.begin(), ddata.end());
+
+      CHECK(std::equal(compare.begin(), compare.end(), vdata.begin()));
+      CHECK(std::equal(compare.begin(), compare.end(), ddata.begin()));
+    }
+
+    //=========================================================================
+    TEST(partial_sort)
+    {
+      for (size_t middle = 0; middle <= 100; middle += 10)
+      {
+        std::vector<int> data(100);
+        std::iota(data.begin(), data.end(), 0);
+        std::random_shuffle(data.begin(), data.end());
+
+        std::vector<int> data1 = data;
+        std::vector<int> data2 = data;
+
+        std::partial_sort(data1.begin(), data1.begin() + middle, data1.end());
+        etl::partial_sort(data2.begin(), data2.begin() + middle, data2.end());
+
+        CHECK(std::equal(data1.begin(), data1.begin() + middle, data2.begin()));
+
+        std::partial_sort(data1.begin(), data1.begin() + middle, data1.end(), std::greater<int>());
+        etl::partial_sort(data2.begin(), data2.begin() + middle, data2.end(), std::greater<int>());
+
+        CHECK(std::equal(data1.begin(), data1.begin() + middle, data2.begin()));
+      }
+    }
+
+    //=========================================================================
+    TEST(nth_element)
+    {
+      std::vector<int> data(1000);
+
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        data[i] = int((i * 2654435761U) % 513);
+      }
+
+      for (size_t n = 0; n < data.size(); n += 37)
+      {
+        std::vector<int> data1 = data;
+        std::vector<int> data2 = data;
+
+        std::sort(data1.begin(), data1.end());
+        etl::nth_element(data2.begin(), data2.begin() + n, data2.end());
+
+        CHECK_EQUAL(data1[n], data2[n]);
+        CHECK(std::find_if(data2.begin(), data2.begin() + n, std::bind2nd(std::greater<int>(), data2[n])) == data2.begin() + n);
+        CHECK(std::find_if(data2.begin() + n, data2.end(), std::bind2nd(std::less<int>(), data2[n])) == data2.end());
+      }
+    }
+
+    //=========================================================================
+    TEST(radix_sort_unsigned)
+    {
+      std::vector<uint32_t> data(10000);
+      std::vector<uint32_t> scratch(data.size());
+
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        data[i] = uint32_t(i * 2654435761U);
+      }
+
+      std::vector<uint32_t> data1 = data;
+      std::vector<uint32_t> data2 = data;
+      std::vector<uint32_t> data3 = data;
+
+      std::sort(data1.begin(), data1.end());
+      etl::radix_sort(data2.begin(), data2.end(), scratch.begin());
+      etl::radix_sort<11>(data3.begin(), data3.end(), scratch.begin());
+
+      CHECK(data1 == data2);
+      CHECK(data1 == data3);
+    }
+
+    //=========================================================================
+    TEST(radix_sort_signed)
+    {
+      std::vector<int64_t> data(1000);
+      std::vector<int64_t> scratch(data.size());
+
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        data[i] = int64_t(i * 0x9E3779B97F4A7C15ULL);
+      }
+
+      data[0] = std::numeric_limits<int64_t>::min();
+      data[1] = std::numeric_limits<int64_t>::max();
+      data[2] = 0;
+      data[3] = -1;
+
+      std::vector<int64_t> data1 = data;
+      std::vector<int64_t> data2 = data;
+      std::vector<int64_t> data3 = data;
+
+      std::sort(data1.begin(), data1.end());
+      etl::radix_sort(data2.begin(), data2.end(), scratch.begin());
+      etl::radix_sort<11>(data3.begin(), data3.end(), scratch.begin());
+
+      CHECK(data1 == data2);
+      CHECK(data1 == data3);
+
+      int8_t small[]         = { 5, -3, 127, -128, 0, -1, 1 };
+      int8_t small_scratch[] = { 0, 0, 0, 0, 0, 0, 0 };
+      int8_t small_compare[] = { -128, -3, -1, 0, 1, 5, 127 };
+
+      etl::radix_sort(std::begin(small), std::end(small), std::begin(small_scratch));
+      CHECK_ARRAY_EQUAL(small_compare, small, 7);
+    }
+
+    //=========================================================================
+    TEST(radix_sort_float)
+    {
+      std::vector<double> data = { 3.5, -0.0, 0.0, -1.25, 1e300, -1e300, 2.0, -2.0, 1e-300, -1e-300, 42.0, -7.5 };
+      std::vector<double> scratch(data.size());
+
+      std::vector<double> data1 = data;
+      std::vector<double> data2 = data;
+
+      std::stable_sort(data1.begin(), data1.end());
+      etl::radix_sort(data2.begin(), data2.end(), scratch.begin());
+
+      CHECK(data1 == data2);
+
+      float fdata[]    = { 1.5f, -1.5f, 0.25f, -100.0f, 100.0f };
+      float fscratch[] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+      float fcompare[] = { -100.0f, -1.5f, 0.25f, 1.5f, 100.0f };
+
+      etl::radix_sort(std::begin(fdata), std::end(fdata), std::begin(fscratch));
+      CHECK_ARRAY_EQUAL(fcompare, fdata, 5);
+    }
+
+    //=========================================================================
+    struct RadixKey
+    {
+      int operator()(const StructData& data_) const
+      {
+        return data_.a;
+      }
+    };
+
+    TEST(radix_sort_key_extractor_is_stable)
+    {
+      std::vector<StructData> data;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        StructData item = { (i * 7919) % 37 - 18, i };
+        data.push_back(item);
+      }
+
+      std::vector<StructData> scratch(data.size());
+      std::vector<StructData> data1 = data;
+      std::vector<StructData> data2 = data;
+
+      std::stable_sort(data1.begin(), data1.end(), StructDataPredicate());
+      etl::radix_sort(data2.begin(), data2.end(), scratch.begin(), RadixKey());
+
+      CHECK(data1 == data2);
+    }
+
+    //=========================================================================
+    TEST(radix_sort_empty_and_single)
+    {
+      uint32_t data[1]    = { 5 };
+      uint32_t scratch[1] = { 0 };
+
+      etl::radix_sort(data, data, scratch);
+      etl::radix_sort(data, data + 1, scratch);
+
+      CHECK_EQUAL(5U, data[0]);
+    }
+
+    //=========================================================================
+    TEST(vectorised_algorithms)
+    {
+      CHECK(check_vectorised_algorithms<int8_t>(11));
+      CHECK(check_vectorised_algorithms<uint8_t>(200));
+      CHECK(check_vectorised_algorithms<char>(11));
+      CHECK(check_vectorised_algorithms<int16_t>(11));
+      CHECK(check_vectorised_algorithms<uint16_t>(11));
+      CHECK(check_vectorised_algorithms<int32_t>(11));
+      CHECK(check_vectorised_algorithms<uint32_t>(11));
+      CHECK(check_vectorised_algorithms<int64_t>(11));
+      CHECK(check_vectorised_algorithms<uint64_t>(11));
+      CHECK(check_vectorised_algorithms<float>(11));
+      CHECK(check_vectorised_algorithms<double>(11));
+    }
+
+    //=========================================================================
+    TEST(vectorised_algorithms_extremes)
+    {
+      uint32_t u[40];
+      int16_t  s[40];
+
+      for (size_t i = 0; i < 40; ++i)
+      {
+        u[i] = 0x80000000UL;
+        s[i] = 0;
+      }
+
+      u[25] = 0xFFFFFFFFUL;
+      u[30] = 0x7FFFFFFFUL;
+      s[17] = -32768;
+      s[35] = 32767;
+
+      CHECK_EQUAL(30, std::distance(u, etl::min_element(u, u + 40)));
+      CHECK_EQUAL(25, std::distance(u, etl::max_element(u, u + 40)));
+      CHECK_EQUAL(17, std::distance(s, etl::minmax_element(s, s + 40).first));
+      CHECK_EQUAL(35, std::distance(s, etl::minmax_element(s, s + 40).second));
+    }
+
+    //=========================================================================
+    TEST(vectorised_algorithms_float_semantics)
+    {
+      float f[20] = { 0.0f };
+      f[9]  = -0.0f;
+      f[12] = std::numeric_limits<float>::quiet_NaN();
+
+      float g[20] = { 0.0f };
+      g[12] = std::numeric_limits<float>::quiet_NaN();
+
+      // -0.0 == 0.0, NaN != NaN.
+      CHECK_EQUAL(19, etl::count(f, f + 20, 0.0f));
+      CHECK_EQUAL(20, std::distance(f, etl::find(f, f + 20, std::numeric_limits<float>::quiet_NaN())));
+      CHECK_EQUAL(12, std::distance(f, etl::mismatch(f, f + 20, g).first));
+      CHECK(!etl::equal(f, f + 20, g));
+    }
+
+    //=========================================================================
+    TEST(vectorised_algorithms_etl_containers)
+    {
+      etl::vector<int16_t, 100> v;
+
+      for (int i = 0; i < 100; ++i)
+      {
+        v.push_back(int16_t((i * 37) % 101));
+      }
+
+      CHECK_EQUAL(std::distance(v.begin(), std::find(v.begin(), v.end(), int16_t(50))), std::distance(v.begin(), etl::find(v.begin(), v.end(), int16_t(50))));
+      CHECK_EQUAL(std::count(v.begin(), v.end(), int16_t(50)), etl::count(v.begin(), v.end(), int16_t(50)));
+      CHECK_EQUAL(*std::min_element(v.begin(), v.end()), *etl::min_element(v.begin(), v.end()));
+      CHECK_EQUAL(*std::max_element(v.begin(), v.end()), *etl::max_element(v.begin(), v.end()));
+      CHECK(etl::equal(v.begin(), v.end(), v.cbegin()));
+
+      // Not vectorised.
+      etl::deque<int, 100> d(v.begin(), v.end());
+      CHECK_EQUAL(std::distance(d.begin(), std::find(d.begin(), d.end(), 50)), std::distance(d.begin(), etl::find(d.begin(), d.end(), 50)));
+      CHECK_EQUAL(std::count(d.begin(), d.end(), 50), etl::count(d.begin(), d.end(), 50));
+      CHECK(etl::equal(d.begin(), d.end(), v.begin()));
+    }
+
     //=========================================================================
     TEST(multimax)
     {
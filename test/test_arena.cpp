@@ -0,0 +1,219 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <vector>
+#include <string>
+#include <map>
+
+#include "etl/arena.h"
+
+namespace
+{
+  typedef std::basic_string<char, std::char_traits<char>, etl::arena_allocator<char>> arena_string;
+
+  SUITE(test_arena)
+  {
+    //*************************************************************************
+    TEST(test_allocate)
+    {
+      etl::arena_buffer<256> arena;
+
+      CHECK(arena.empty());
+      CHECK_EQUAL(256U, arena.capacity());
+      CHECK_EQUAL(256U, arena.available());
+
+      char*   p1 = static_cast<char*>(arena.allocate(3, 1));
+      double* p2 = arena.allocate<double>(2);
+      char*   p3 = static_cast<char*>(arena.allocate(1, 1));
+
+      CHECK(arena.is_in_arena(p1));
+      CHECK(arena.is_in_arena(p2));
+      CHECK(arena.is_in_arena(p3));
+      CHECK_EQUAL(0U, reinterpret_cast<uintptr_t>(p2) % etl::alignment_of<double>::value);
+      CHECK(reinterpret_cast<char*>(p2) >= (p1 + 3));
+      CHECK_EQUAL(reinterpret_cast<char*>(p2 + 2), p3);
+      CHECK_EQUAL(size_t(p3 + 1 - p1), arena.size());
+    }
+
+    //*************************************************************************
+    TEST(test_full)
+    {
+      char buffer[64];
+      etl::arena arena(buffer, sizeof(buffer));
+
+      CHECK(arena.allocate(60, 1) != nullptr);
+      CHECK_THROW(arena.allocate(5, 1), etl::arena_no_allocation);
+      CHECK_THROW(arena.allocate(size_t(-1), 1), etl::arena_no_allocation);
+      CHECK_EQUAL(60U, arena.size());
+      CHECK(arena.allocate(4, 1) != nullptr);
+      CHECK_EQUAL(0U, arena.available());
+
+      int data;
+      CHECK(!arena.is_in_arena(&data));
+    }
+
+    //*************************************************************************
+    TEST(test_allocate_count_overflow)
+    {
+      char buffer[64];
+      etl::arena arena(buffer, sizeof(buffer));
+
+      // n * sizeof(uint32_t) wraps to 4 bytes.
+      const size_t n = (size_t(-1) / sizeof(uint32_t)) + 2U;
+
+      CHECK_THROW(arena.allocate<uint32_t>(n), etl::arena_no_allocation);
+      CHECK_EQUAL(0U, arena.size());
+      CHECK(arena.allocate<uint32_t>(16) != nullptr);
+    }
+
+    //*************************************************************************
+    TEST(test_mark_rewind_reset)
+    {
+      etl::arena_buffer<256> arena;
+
+      arena.allocate(10, 1);
+      etl::arena::marker marker = arena.mark();
+      CHECK_EQUAL(10U, marker);
+
+      void* p1 = arena.allocate(100, 1);
+      arena.allocate(100, 1);
+      CHECK_EQUAL(210U, arena.size());
+
+      arena.rewind(marker);
+      CHECK_EQUAL(10U, arena.size());
+
+      // The space is reused.
+      CHECK_EQUAL(p1, arena.allocate(100, 1));
+
+      CHECK_THROW(arena.rewind(200), etl::arena_invalid_marker);
+      CHECK_EQUAL(110U, arena.size());
+
+      arena.reset();
+      CHECK(arena.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_deallocate_last)
+    {
+      etl::arena_buffer<256> arena;
+
+      void* p1 = arena.allocate(16, 1);
+      void* p2 = arena.allocate(16, 1);
+
+      // Not the last allocation, so is kept.
+      arena.deallocate(p1, 16);
+      CHECK_EQUAL(32U, arena.size());
+
+      arena.deallocate(p2, 16);
+      CHECK_EQUAL(16U, arena.size());
+
+      arena.deallocate(p1, 16);
+      CHECK(arena.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_arena_allocator_vector)
+    {
+      etl::arena_buffer<4096> arena;
+
+      size_t capacity;
+      size_t used;
+
+      {
+        std::vector<int, etl::arena_allocator<int>> v((etl::arena_allocator<int>(arena)));
+
+        for (int i = 0; i < 100; ++i)
+        {
+          v.push_back(i);
+        }
+
+        CHECK_EQUAL(100U, v.size());
+        CHECK_EQUAL(99, v.back());
+        CHECK(arena.is_in_arena(v.data()));
+
+        capacity = v.capacity();
+        used     = arena.size();
+      }
+
+      // The final buffer was the last allocation so was reclaimed.
+      CHECK_EQUAL(used - (capacity * sizeof(int)), arena.size());
+    }
+
+    //*************************************************************************
+    TEST(test_arena_allocator_string_and_map)
+    {
+      etl::arena_buffer<4096> arena;
+      etl::arena_allocator<char> allocator(arena);
+
+      arena_string text("A string that is too long for the small string buffer", allocator);
+      CHECK(arena.is_in_arena(text.data()));
+
+      typedef std::pair<const int, int> value_t;
+      std::map<int, int, std::less<int>, etl::arena_allocator<value_t>> m((std::less<int>()), etl::arena_allocator<value_t>(arena));
+
+      m[1] = 2;
+      m[3] = 4;
+      CHECK_EQUAL(2, m[1]);
+      CHECK_EQUAL(4, m[3]);
+
+      CHECK(etl::arena_allocator<int>(arena) == allocator);
+
+      etl::arena_buffer<16> other;
+      CHECK(etl::arena_allocator<int>(other) != allocator);
+    }
+
+    //*************************************************************************
+    TEST(test_arena_vector)
+    {
+      etl::arena_buffer<256> arena;
+
+      const int data[] = { 1, 2, 3, 4 };
+
+      etl::arena_vector<int> v1(arena, 10);
+      etl::arena_vector<int> v2(arena, 8, data, data + 4);
+
+      CHECK_EQUAL(10U, v1.max_size());
+      CHECK(v1.empty());
+      CHECK_EQUAL(4U, v2.size());
+      CHECK_EQUAL(18 * sizeof(int), arena.size());
+
+      v1 = v2;
+      CHECK_EQUAL(4U, v1.size());
+      CHECK(std::equal(v1.begin(), v1.end(), data));
+      CHECK(arena.is_in_arena(&v1[0]));
+      CHECK(arena.is_in_arena(&v2[0]));
+
+      // Works as an ivector.
+      etl::ivector<int>& iv = v1;
+      iv.push_back(5);
+      CHECK_EQUAL(5, v1.back());
+    }
+  };
+}
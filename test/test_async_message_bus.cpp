@@ -0,0 +1,473 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "etl/async_message_bus.h"
+
+namespace
+{
+  enum
+  {
+    MESSAGE1,
+    MESSAGE2,
+    MESSAGE3
+  };
+
+  enum
+  {
+    ROUTER1 = 1,
+    ROUTER2 = 2
+  };
+
+  //***************************************************************************
+  struct Message1 : public etl::message<MESSAGE1>
+  {
+    Message1(int value_)
+      : value(value_)
+    {
+      ++instances;
+    }
+
+    Message1(const Message1& other)
+      : etl::message<MESSAGE1>(),
+        value(other.value)
+    {
+      ++instances;
+      ++copies;
+    }
+
+    ~Message1()
+    {
+      --instances;
+    }
+
+    int value;
+
+    static std::atomic<int> instances;
+    static std::atomic<int> copies;
+  };
+
+  std::atomic<int> Message1::instances(0);
+  std::atomic<int> Message1::copies(0);
+
+  //***************************************************************************
+  struct Message2 : public etl::message<MESSAGE2>
+  {
+  };
+
+  //***************************************************************************
+  struct Message3 : public etl::message<MESSAGE3>
+  {
+  };
+
+  typedef etl::message_pool<etl::generic_atomic_pool<64, 8, 16> > Pool;
+  typedef etl::async_message_bus<4, Message1, Message2>            Bus;
+
+  //***************************************************************************
+  // Handles Message1 and, optionally, Message2.
+  //***************************************************************************
+  class Router : public etl::imessage_router
+  {
+  public:
+
+    Router(etl::message_router_id_t id, bool accepts_message2_ = true)
+      : imessage_router(id),
+        accepts_message2(accepts_message2_),
+        sum(0),
+        p_last(nullptr),
+        p_source(nullptr),
+        thread_id()
+    {
+    }
+
+    using etl::imessage_router::receive;
+    using etl::imessage_router::accepts;
+
+    void receive(const etl::imessage& msg)
+    {
+      receive(etl::null_message_router::instance(), msg);
+    }
+
+    void receive(etl::imessage_router& source, etl::message_router_id_t, const etl::imessage& msg)
+    {
+      receive(source, msg);
+    }
+
+    void receive(etl::imessage_router& source, const etl::imessage& msg)
+    {
+      ids.push_back(msg.message_id);
+      p_last   = &msg;
+      p_source = &source;
+      thread_id = std::this_thread::get_id();
+
+      if (msg.message_id == MESSAGE1)
+      {
+        sum += static_cast<const Message1&>(msg).value;
+      }
+    }
+
+    bool accepts(etl::message_id_t id) const
+    {
+      return (id == MESSAGE1) || ((id == MESSAGE2) && accepts_message2) || (id == MESSAGE3);
+    }
+
+    bool is_null_router() const
+    {
+      return false;
+    }
+
+    bool                  accepts_message2;
+    std::vector<int>      ids;
+    int                   sum;
+    const etl::imessage*  p_last;
+    etl::imessage_router* p_source;
+    std::thread::id       thread_id;
+  };
+
+  SUITE(test_async_message_bus)
+  {
+    //*************************************************************************
+    TEST(test_message_is_copied_once_for_all_subscribers)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1);
+      Router router2(ROUTER2);
+
+      etl::mailbox<4> mailbox1(router1);
+      etl::mailbox<4> mailbox2(router2);
+
+      bus.subscribe(mailbox1);
+      bus.subscribe(mailbox2);
+      CHECK_EQUAL(2U, bus.size());
+
+      Message1::copies = 0;
+
+      etl::send_message(router1, bus, Message1(1));
+
+      CHECK_EQUAL(1, Message1::copies.load());
+      CHECK_EQUAL(1, Message1::instances.load());
+      CHECK_EQUAL(1U, mailbox1.size());
+      CHECK_EQUAL(1U, mailbox2.size());
+      CHECK(router1.ids.empty());
+
+      CHECK_EQUAL(1U, mailbox1.process());
+      CHECK_EQUAL(1, Message1::instances.load());
+
+      CHECK_EQUAL(1U, mailbox2.process());
+      CHECK_EQUAL(0, Message1::instances.load());
+
+      CHECK_EQUAL(router1.p_last, router2.p_last);
+      CHECK_EQUAL(&router1, router2.p_source);
+      CHECK_EQUAL(1, router2.sum);
+      CHECK_EQUAL(16U, pool.get_pool(0).available());
+    }
+
+    //*************************************************************************
+    TEST(test_only_accepting_subscribers_get_the_message)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1, false);
+      Router router2(ROUTER2);
+
+      etl::mailbox<4> mailbox1(router1);
+      etl::mailbox<4> mailbox2(router2);
+
+      bus.subscribe(mailbox1);
+      bus.subscribe(mailbox2);
+
+      etl::send_message(bus, Message2());
+      etl::send_message(bus, ROUTER1, Message1(1));
+
+      CHECK_EQUAL(1U, mailbox1.size());
+      CHECK_EQUAL(1U, mailbox2.size());
+
+      mailbox1.process();
+      mailbox2.process();
+
+      CHECK_EQUAL(1U, router1.ids.size());
+      CHECK_EQUAL(MESSAGE1, router1.ids[0]);
+      CHECK_EQUAL(1U, router2.ids.size());
+      CHECK_EQUAL(MESSAGE2, router2.ids[0]);
+
+      // Nobody wants it, so it is never copied.
+      bus.unsubscribe(mailbox2);
+      etl::send_message(bus, Message2());
+      CHECK_EQUAL(16U, pool.get_pool(0).available());
+    }
+
+    //*************************************************************************
+    TEST(test_unknown_message_type)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1);
+      etl::mailbox<4> mailbox1(router1);
+
+      bus.subscribe(mailbox1);
+
+      CHECK(!bus.accepts(MESSAGE3));
+      CHECK_THROW(etl::send_message(bus, Message3()), etl::unhandled_message_exception);
+    }
+
+    //*************************************************************************
+    TEST(test_publish_does_not_copy)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1);
+      Router router2(ROUTER2);
+
+      etl::mailbox<4> mailbox1(router1);
+      etl::mailbox<4> mailbox2(router2);
+
+      bus.subscribe(mailbox1);
+      bus.subscribe(mailbox2);
+
+      Message1::copies = 0;
+
+      {
+        etl::message_handle handle = pool.create<Message1>(5);
+        CHECK_EQUAL(2U, bus.publish(handle));
+      }
+
+      CHECK_EQUAL(0, Message1::copies.load());
+      CHECK_EQUAL(1, Message1::instances.load());
+
+      mailbox1.process();
+      mailbox2.process();
+
+      CHECK_EQUAL(5, router1.sum);
+      CHECK_EQUAL(5, router2.sum);
+      CHECK_EQUAL(0, Message1::instances.load());
+    }
+
+    //*************************************************************************
+    TEST(test_policy_drop)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1);
+      etl::mailbox<2> mailbox1(router1, etl::mailbox_policy::DROP);
+
+      bus.subscribe(mailbox1);
+
+      etl::send_message(bus, Message1(1));
+      etl::send_message(bus, Message1(2));
+      etl::send_message(bus, Message1(4));
+
+      CHECK_EQUAL(1U, mailbox1.dropped());
+      CHECK_EQUAL(2U, mailbox1.process());
+      CHECK_EQUAL(1 + 2, router1.sum);
+      CHECK_EQUAL(16U, pool.get_pool(0).available());
+    }
+
+    //*************************************************************************
+    TEST(test_policy_overwrite)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1);
+      etl::mailbox<2> mailbox1(router1, etl::mailbox_policy::OVERWRITE);
+
+      bus.subscribe(mailbox1);
+
+      etl::send_message(bus, Message1(1));
+      etl::send_message(bus, Message1(2));
+      etl::send_message(bus, Message1(4));
+
+      CHECK_EQUAL(1U, mailbox1.dropped());
+      CHECK_EQUAL(2U, mailbox1.process());
+      CHECK_EQUAL(2 + 4, router1.sum);
+      CHECK_EQUAL(16U, pool.get_pool(0).available());
+    }
+
+    //*************************************************************************
+    TEST(test_policy_block)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1);
+      etl::mailbox<2> mailbox1(router1, etl::mailbox_policy::BLOCK);
+
+      bus.subscribe(mailbox1);
+
+      std::atomic<bool> done(false);
+
+      std::thread producer([&]()
+      {
+        for (int i = 1; i <= 10; ++i)
+        {
+          etl::send_message(bus, Message1(i));
+        }
+
+        done = true;
+      });
+
+      while (!done || !mailbox1.empty())
+      {
+        mailbox1.process();
+        std::this_thread::yield();
+      }
+
+      producer.join();
+
+      CHECK_EQUAL(0U, mailbox1.dropped());
+      CHECK_EQUAL(10U, router1.ids.size());
+      CHECK_EQUAL(55, router1.sum);
+    }
+
+    //*************************************************************************
+    TEST(test_mailbox_is_a_task)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1);
+      etl::mailbox<4> mailbox1(router1, etl::mailbox_policy::DROP, 3);
+      etl::task& task = mailbox1;
+
+      bus.subscribe(mailbox1);
+
+      CHECK_EQUAL(3, task.get_task_priority());
+      CHECK_EQUAL(0U, task.task_request_work());
+
+      etl::send_message(bus, Message1(1));
+      etl::send_message(bus, Message1(2));
+
+      CHECK_EQUAL(2U, task.task_request_work());
+      task.task_process_work();
+      CHECK_EQUAL(0U, task.task_request_work());
+      CHECK_EQUAL(3, router1.sum);
+    }
+
+    //*************************************************************************
+    TEST(test_destructor_releases_queued_messages)
+    {
+      Pool pool;
+      Bus  bus(pool);
+
+      Router router1(ROUTER1);
+
+      {
+        etl::mailbox<4> mailbox1(router1);
+        bus.subscribe(mailbox1);
+
+        etl::send_message(bus, Message1(1));
+        etl::send_message(bus, Message1(2));
+
+        CHECK_EQUAL(2, Message1::instances.load());
+
+        bus.unsubscribe(ROUTER1);
+        CHECK_EQUAL(0U, bus.size());
+      }
+
+      CHECK_EQUAL(0, Message1::instances.load());
+      CHECK_EQUAL(16U, pool.get_pool(0).available());
+    }
+
+    //*************************************************************************
+    TEST(test_threads)
+    {
+      const int N_PUBLISHERS = 4;
+      const int N_ITEMS      = 10000;
+
+      typedef etl::message_pool<etl::generic_atomic_pool<64, 8, 64> > BigPool;
+
+      BigPool pool;
+      Bus     bus(pool);
+
+      Router router1(ROUTER1);
+      Router router2(ROUTER2);
+
+      etl::mailbox<16> mailbox1(router1, etl::mailbox_policy::BLOCK);
+      etl::mailbox<16> mailbox2(router2, etl::mailbox_policy::BLOCK);
+
+      bus.subscribe(mailbox1);
+      bus.subscribe(mailbox2);
+
+      std::atomic<int> n_publishing(N_PUBLISHERS);
+      std::vector<std::thread> threads;
+
+      for (int p = 0; p < N_PUBLISHERS; ++p)
+      {
+        threads.push_back(std::thread([&]()
+        {
+          for (int i = 0; i < N_ITEMS; ++i)
+          {
+            etl::send_message(bus, Message1(1));
+          }
+
+          --n_publishing;
+        }));
+      }
+
+      etl::imailbox* mailboxes[2] = { &mailbox1, &mailbox2 };
+
+      for (int s = 0; s < 2; ++s)
+      {
+        etl::imailbox& mailbox = *mailboxes[s];
+
+        threads.push_back(std::thread([&]()
+        {
+          while ((n_publishing != 0) || !mailbox.empty())
+          {
+            if (mailbox.process() == 0U)
+            {
+              std::this_thread::yield();
+            }
+          }
+        }));
+      }
+
+      for (size_t t = 0; t < threads.size(); ++t)
+      {
+        threads[t].join();
+      }
+
+      CHECK_EQUAL(N_PUBLISHERS * N_ITEMS, router1.sum);
+      CHECK_EQUAL(N_PUBLISHERS * N_ITEMS, router2.sum);
+      CHECK(router1.thread_id != router2.thread_id);
+      CHECK_EQUAL(64U, pool.get_pool(0).available());
+      CHECK_EQUAL(0, Message1::instances.load());
+    }
+  };
+}
@@ -0,0 +1,280 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <set>
+#include <atomic>
+
+#include "etl/atomic_pool.h"
+
+namespace
+{
+  struct Data
+  {
+    Data()
+      : a(0),
+        b(0)
+    {
+    }
+
+    Data(int a_, int b_)
+      : a(a_),
+        b(b_)
+    {
+      ++instances;
+    }
+
+    ~Data()
+    {
+      --instances;
+    }
+
+    int a;
+    int b;
+
+    static std::atomic<int> instances;
+  };
+
+  std::atomic<int> Data::instances(0);
+
+  SUITE(test_atomic_pool)
+  {
+    //*************************************************************************
+    TEST(test_allocate_release)
+    {
+      etl::atomic_pool<Data, 4> pool;
+
+      CHECK_EQUAL(4U, pool.max_size());
+      CHECK_EQUAL(4U, pool.available());
+      CHECK(pool.empty());
+
+      std::set<Data*> allocated;
+
+      for (size_t i = 0; i < 4; ++i)
+      {
+        Data* p = pool.allocate<Data>();
+        CHECK(pool.is_in_pool(p));
+        allocated.insert(p);
+      }
+
+      CHECK_EQUAL(4U, allocated.size());
+      CHECK(pool.full());
+      CHECK_THROW(pool.allocate<Data>(), etl::pool_no_allocation);
+
+      Data* p = *allocated.begin();
+      pool.release(p);
+      CHECK_EQUAL(3U, pool.size());
+
+      // The most recently released is reused first.
+      CHECK_EQUAL(p, pool.allocate<Data>());
+
+      for (std::set<Data*>::iterator itr = allocated.begin(); itr != allocated.end(); ++itr)
+      {
+        pool.release(*itr);
+      }
+
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_create_destroy)
+    {
+      etl::atomic_pool<Data, 4> pool;
+
+      Data* p = pool.create<Data>(1, 2);
+      CHECK_EQUAL(1, p->a);
+      CHECK_EQUAL(2, p->b);
+      CHECK_EQUAL(1, Data::instances.load());
+
+      pool.destroy<Data>(p);
+      CHECK_EQUAL(0, Data::instances.load());
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_release_not_in_pool)
+    {
+      etl::atomic_pool<Data, 4> pool;
+      Data data;
+
+      CHECK(!pool.is_in_pool(&data));
+      CHECK_THROW(pool.release(&data), etl::pool_object_not_in_pool);
+    }
+
+    //*************************************************************************
+    TEST(test_allocate_release_batch)
+    {
+      etl::atomic_pool<Data, 4> pool;
+      void* items[6];
+
+      CHECK_EQUAL(3U, pool.allocate_batch(items, 3));
+      CHECK_EQUAL(3U, pool.size());
+      CHECK_EQUAL(1U, pool.allocate_batch(items + 3, 3));
+      CHECK(pool.full());
+      CHECK_EQUAL(0U, pool.allocate_batch(items + 4, 2));
+
+      std::set<void*> unique(items, items + 4);
+      CHECK_EQUAL(4U, unique.size());
+
+      pool.release_batch(items, 4);
+      CHECK(pool.empty());
+
+      // All items are back on the free list.
+      CHECK_EQUAL(4U, pool.allocate_batch(items, 6));
+      CHECK_EQUAL(4U, std::set<void*>(items, items + 4).size());
+    }
+
+    //*************************************************************************
+    TEST(test_generic_atomic_pool)
+    {
+      etl::generic_atomic_pool<sizeof(double), etl::alignment_of<double>::value, 3> pool;
+
+      double* p1 = pool.create<double>(1.5);
+      int*    p2 = pool.create<int>(2);
+
+      CHECK_EQUAL(1.5, *p1);
+      CHECK_EQUAL(2,   *p2);
+      CHECK_EQUAL(0U, reinterpret_cast<uintptr_t>(p1) % etl::alignment_of<double>::value);
+
+      pool.destroy<double>(p1);
+      pool.destroy<int>(p2);
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_threads)
+    {
+      static const int Threads    = 4;
+      static const int Iterations = 100000;
+
+      etl::atomic_pool<Data, 16> pool;
+      std::atomic<bool> failed(false);
+
+      // Each thread stamps its items and checks that no other thread has been handed them.
+      auto worker = [&](int id)
+      {
+        Data* held[3];
+
+        for (int i = 0; i < Iterations; ++i)
+        {
+          for (int j = 0; j < 3; ++j)
+          {
+            held[j] = pool.create<Data>(id, i);
+          }
+
+          for (int j = 0; j < 3; ++j)
+          {
+            if ((held[j]->a != id) || (held[j]->b != i))
+            {
+              failed = true;
+            }
+
+            pool.destroy<Data>(held[j]);
+          }
+        }
+      };
+
+      std::vector<std::thread> threads;
+
+      for (int t = 0; t < Threads; ++t)
+      {
+        threads.push_back(std::thread(worker, t));
+      }
+
+      for (size_t t = 0; t < threads.size(); ++t)
+      {
+        threads[t].join();
+      }
+
+      CHECK(!failed);
+      CHECK(pool.empty());
+
+      // Every item is still on the free list.
+      std::set<Data*> allocated;
+
+      while (!pool.full())
+      {
+        allocated.insert(pool.allocate<Data>());
+      }
+
+      CHECK_EQUAL(16U, allocated.size());
+    }
+
+    //*************************************************************************
+    TEST(test_threads_size_never_exceeds_max)
+    {
+      static const int Threads    = 4;
+      static const int Iterations = 100000;
+
+      etl::atomic_pool<Data, 2> pool;
+      std::atomic<bool> failed(false);
+
+      // More threads than items, so that released items are taken again straight away.
+      auto worker = [&]()
+      {
+        for (int i = 0; i < Iterations; ++i)
+        {
+          void* p;
+
+          if (pool.allocate_batch(&p, 1U) == 1U)
+          {
+            if ((pool.size() > pool.max_size()) || (pool.available() > pool.max_size()))
+            {
+              failed = true;
+            }
+
+            pool.release_batch(&p, 1U);
+          }
+
+          if ((pool.size() > pool.max_size()) || (pool.available() > pool.max_size()))
+          {
+            failed = true;
+          }
+        }
+      };
+
+      std::vector<std::thread> threads;
+
+      for (int t = 0; t < Threads; ++t)
+      {
+        threads.push_back(std::thread(worker));
+      }
+
+      for (size_t t = 0; t < threads.size(); ++t)
+      {
+        threads[t].join();
+      }
+
+      CHECK(!failed);
+      CHECK(pool.empty());
+    }
+  };
+}
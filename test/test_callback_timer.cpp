@@ -646,6 +646,132 @@ namespace
       CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
     }
 
+    //=========================================================================
+    TEST(callback_timer_time_to_next_expiry)
+    {
+      etl::callback_timer<3> timer_controller;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(free_callback1, 37, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id2 = timer_controller.register_timer(free_callback2, 23, etl::timer::mode::REPEATING);
+
+      CHECK_EQUAL(uint32_t(etl::timer::interval::NO_ACTIVE_INTERVAL), timer_controller.time_to_next_expiry());
+
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.enable(true);
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+
+      CHECK_EQUAL(23U, timer_controller.time_to_next_expiry());
+
+      // Only tick when something is due.
+      ticks = 0;
+      int wakeups = 0;
+
+      while (ticks < 100U)
+      {
+        uint32_t next = timer_controller.time_to_next_expiry();
+
+        ticks += next;
+        timer_controller.tick(next);
+        ++wakeups;
+      }
+
+      std::vector<uint64_t> compare1 = { 37 };
+      std::vector<uint64_t> compare2 = { 23, 46, 69, 92, 115 };
+
+      CHECK_EQUAL(6, wakeups);
+      CHECK_EQUAL(compare1.size(), free_tick_list1.size());
+      CHECK_EQUAL(compare2.size(), free_tick_list2.size());
+
+      CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list2.data(), compare2.size());
+
+      timer_controller.stop(id2);
+      CHECK_EQUAL(uint32_t(etl::timer::interval::NO_ACTIVE_INTERVAL), timer_controller.time_to_next_expiry());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_slack_coalesces_deadlines)
+    {
+      etl::callback_timer<3> timer_controller;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(free_callback1,         10, etl::timer::mode::REPEATING);
+      etl::timer::id::type id2 = timer_controller.register_timer(free_callback2,         14, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id3 = timer_controller.register_timer(free_function_callback, 40, etl::timer::mode::SINGLE_SHOT);
+
+      CHECK(timer_controller.set_slack(id1, 5));
+      CHECK(!timer_controller.set_slack(etl::timer::id::NO_TIMER, 5));
+
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.enable(true);
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+      timer_controller.start(id3);
+
+      // The first timer may wait for the second.
+      CHECK_EQUAL(14U, timer_controller.time_to_next_expiry());
+
+      ticks = 14;
+      timer_controller.tick(14);
+
+      std::vector<uint64_t> compare1 = { 14 };
+      std::vector<uint64_t> compare2 = { 14 };
+
+      CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list2.data(), compare2.size());
+
+      // The repeating timer keeps its phase, and is now due at 20 with slack to 25.
+      CHECK_EQUAL(11U, timer_controller.time_to_next_expiry());
+
+      // Without slack it is due on time.
+      CHECK(timer_controller.set_slack(id1, 0));
+      CHECK_EQUAL(6U, timer_controller.time_to_next_expiry());
+    }
+
+    //=========================================================================
+    etl::icallback_timer* p_nested_controller;
+    bool nested_tick_result;
+
+    void nested_tick_callback()
+    {
+      // A tick that arrives while the timers are being processed.
+      nested_tick_result = p_nested_controller->tick(5);
+    }
+
+    TEST(callback_timer_tick_during_update_is_held)
+    {
+      etl::callback_timer<3> timer_controller;
+
+      p_nested_controller = &timer_controller;
+      nested_tick_result  = false;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(free_callback1,       10, etl::timer::mode::REPEATING);
+      etl::timer::id::type id2 = timer_controller.register_timer(nested_tick_callback, 1,  etl::timer::mode::SINGLE_SHOT);
+
+      free_tick_list1.clear();
+
+      timer_controller.enable(true);
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+
+      ticks = 1;
+      CHECK(timer_controller.tick(1));
+      CHECK(nested_tick_result);
+
+      // The nested ticks have been processed.
+      CHECK_EQUAL(4U, timer_controller.time_to_next_expiry());
+
+      ticks = 10;
+      timer_controller.tick(4);
+
+      CHECK_EQUAL(1U, free_tick_list1.size());
+      CHECK_EQUAL(10U, timer_controller.time_to_next_expiry());
+    }
+
     //=========================================================================
 #if REALTIME_TEST
 
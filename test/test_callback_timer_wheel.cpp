@@ -0,0 +1,1043 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+#include "ExtraCheckMacros.h"
+
+#include "etl/callback_timer_wheel.h"
+#include "etl/function.h"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+  uint64_t ticks = 0;
+
+  //***************************************************************************
+  // Class callback via etl::function
+  //***************************************************************************
+  class Test
+  {
+  public:
+
+    Test()
+    {
+    }
+
+    void callback()
+    {
+      tick_list.push_back(ticks);
+    }
+
+    void callback2()
+    {
+      tick_list.push_back(ticks);
+
+      p_controller->start(2);
+      p_controller->start(1);
+    }
+
+    void set_controller(etl::callback_timer_wheel<3>& controller)
+    {
+      p_controller = &controller;
+    }
+
+    std::vector<uint64_t> tick_list;
+
+    etl::callback_timer_wheel<3>* p_controller;
+  };
+
+  Test test;
+  etl::function_imv<Test, test, &Test::callback>  member_callback;
+  etl::function_imv<Test, test, &Test::callback2> member_callback2;
+
+  //***************************************************************************
+  // Free function callback via etl::function
+  //***************************************************************************
+  std::vector<uint64_t> free_tick_list1;
+
+  void free_callback1()
+  {
+    free_tick_list1.push_back(ticks);
+  }
+
+  etl::function_fv<free_callback1> free_function_callback;
+
+  //***************************************************************************
+  // Free function callback via function pointer
+  //***************************************************************************
+  std::vector<uint64_t> free_tick_list2;
+
+  void free_callback2()
+  {
+    free_tick_list2.push_back(ticks);
+  }
+
+  SUITE(test_callback_timer_wheel)
+  {
+    //=========================================================================
+    TEST(callback_timer_wheel_too_many_timers)
+    {
+      etl::callback_timer_wheel<2> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback,        37, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_function_callback, 23, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_callback2,         11, etl::timer::mode::SINGLE_SHOT);
+
+      CHECK(id1 != etl::timer::wheel_id::NO_TIMER);
+      CHECK(id2 != etl::timer::wheel_id::NO_TIMER);
+      CHECK(id3 == etl::timer::wheel_id::NO_TIMER);
+
+      timer_controller.clear();
+      id3 = timer_controller.register_timer(free_callback2, 11, etl::timer::mode::SINGLE_SHOT);
+      CHECK(id3 != etl::timer::wheel_id::NO_TIMER);
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_one_shot)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback,        37, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_function_callback, 23, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_callback2,         11, etl::timer::mode::SINGLE_SHOT);
+
+      test.tick_list.clear();
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.start(id1);
+      timer_controller.start(id3);
+      timer_controller.start(id2);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 1;
+
+      while (ticks <= 100U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 37 };
+      std::vector<uint64_t> compare2 = { 23 };
+      std::vector<uint64_t> compare3 = { 11 };
+
+      CHECK(test.tick_list.size() != 0);
+      CHECK(free_tick_list1.size() != 0);
+      CHECK(free_tick_list2.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(),  compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list1.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), free_tick_list2.data(), compare3.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_one_shot_after_timeout)
+    {
+      etl::callback_timer_wheel<1> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback, 37, etl::timer::mode::SINGLE_SHOT);
+      test.tick_list.clear();
+
+      timer_controller.start(id1);
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 1;
+
+      while (ticks <= 100U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      // Timer should have timed out.
+
+      CHECK(timer_controller.set_period(id1, 50));
+      timer_controller.start(id1);
+
+      test.tick_list.clear();
+
+      ticks = 0;
+
+      while (ticks <= 100U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      // Timer should have timed out.
+
+      CHECK_EQUAL(50U, *test.tick_list.data());
+
+      CHECK(timer_controller.unregister_timer(id1));
+      CHECK(!timer_controller.unregister_timer(id1));
+      CHECK(!timer_controller.start(id1));
+      CHECK(!timer_controller.stop(id1));
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_repeating)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback,        37, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_function_callback, 23, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_callback2,         11, etl::timer::mode::REPEATING);
+
+      test.tick_list.clear();
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.start(id1);
+      timer_controller.start(id3);
+      timer_controller.start(id2);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 1;
+
+      while (ticks <= 100U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 37, 74 };
+      std::vector<uint64_t> compare2 = { 23, 46, 69, 92 };
+      std::vector<uint64_t> compare3 = { 11, 22, 33, 44, 55, 66, 77, 88, 99 };
+
+      CHECK(test.tick_list.size() != 0);
+      CHECK(free_tick_list1.size() != 0);
+      CHECK(free_tick_list2.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(),  compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list1.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), free_tick_list2.data(), compare3.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_repeating_bigger_step)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback,        37, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_function_callback, 23, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_callback2,         11, etl::timer::mode::REPEATING);
+
+      test.tick_list.clear();
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.start(id1);
+      timer_controller.start(id3);
+      timer_controller.start(id2);
+
+      CHECK(!timer_controller.is_running());
+
+      timer_controller.enable(true);
+
+      CHECK(timer_controller.is_running());
+
+      ticks = 0;
+
+      const uint32_t step = 5;
+
+      while (ticks <= 100U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 40, 75 };
+      std::vector<uint64_t> compare2 = { 25, 50, 70, 95 };
+      std::vector<uint64_t> compare3 = { 15, 25, 35, 45, 55, 70, 80, 90, 100 };
+
+      CHECK(test.tick_list.size() != 0);
+      CHECK(free_tick_list1.size() != 0);
+      CHECK(free_tick_list2.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(),  compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list1.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), free_tick_list2.data(), compare3.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_repeating_stop_start)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback,        37, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_function_callback, 23, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_callback2,         11, etl::timer::mode::REPEATING);
+
+      test.tick_list.clear();
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.start(id3);
+      timer_controller.start(id2);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 1;
+
+      while (ticks <= 100U)
+      {
+        if (ticks == 40)
+        {
+          timer_controller.start(id1);
+          timer_controller.stop(id2);
+        }
+
+        if (ticks == 80)
+        {
+          timer_controller.stop(id1);
+          timer_controller.start(id2);
+        }
+
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 77 };
+      std::vector<uint64_t> compare2 = { 23 };
+      std::vector<uint64_t> compare3 = { 11, 22, 33, 44, 55, 66, 77, 88, 99 };
+
+      CHECK(test.tick_list.size() != 0);
+      CHECK(free_tick_list1.size() != 0);
+      CHECK(free_tick_list2.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(),  compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list1.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), free_tick_list2.data(), compare3.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_timer_starts_timer_small_step)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback2, 100, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(member_callback, 10, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(member_callback, 22, etl::timer::mode::SINGLE_SHOT);
+
+      (void)id2;
+      (void)id3;
+
+      test.set_controller(timer_controller);
+
+      test.tick_list.clear();
+
+      timer_controller.start(id1);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 1;
+
+      while (ticks <= 200U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 100, 110, 122 };
+
+      CHECK(test.tick_list.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(), compare1.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_timer_starts_timer_big_step)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback2, 100, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(member_callback,   10, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(member_callback,   22, etl::timer::mode::SINGLE_SHOT);
+
+      (void)id2;
+      (void)id3;
+
+      test.set_controller(timer_controller);
+
+      test.tick_list.clear();
+
+      timer_controller.start(id1);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 3;
+
+      while (ticks <= 200U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 102, 111, 123 };
+
+      CHECK(test.tick_list.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(),  compare1.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_repeating_register_unregister)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1;
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_function_callback, 23, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_callback2,         11, etl::timer::mode::REPEATING);
+
+      test.tick_list.clear();
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.start(id3);
+      timer_controller.start(id2);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 1;
+
+      while (ticks <= 100U)
+      {
+        if (ticks == 40)
+        {
+          timer_controller.unregister_timer(id2);
+
+          id1 = timer_controller.register_timer(member_callback, 37, etl::timer::mode::REPEATING);
+          timer_controller.start(id1);
+        }
+
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 77 };
+      std::vector<uint64_t> compare2 = { 23 };
+      std::vector<uint64_t> compare3 = { 11, 22, 33, 44, 55, 66, 77, 88, 99 };
+
+      CHECK(test.tick_list.size() != 0);
+      CHECK(free_tick_list1.size() != 0);
+      CHECK(free_tick_list2.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(),  compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list1.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), free_tick_list2.data(), compare3.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_repeating_clear)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback,        37, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_function_callback, 23, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_callback2,         11, etl::timer::mode::REPEATING);
+
+      test.tick_list.clear();
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.start(id1);
+      timer_controller.start(id3);
+      timer_controller.start(id2);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 1;
+
+      while (ticks <= 100U)
+      {
+        ticks += step;
+
+        if (ticks == 40)
+        {
+          timer_controller.clear();
+        }
+
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 37 };
+      std::vector<uint64_t> compare2 = { 23 };
+      std::vector<uint64_t> compare3 = { 11, 22, 33 };
+
+      CHECK(test.tick_list.size() != 0);
+      CHECK(free_tick_list1.size() != 0);
+      CHECK(free_tick_list2.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(),  compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list1.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), free_tick_list2.data(), compare3.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_delayed_immediate)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(member_callback,        37, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_function_callback, 23, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_callback2,         11, etl::timer::mode::REPEATING);
+
+      test.tick_list.clear();
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.enable(true);
+
+      ticks = 5;
+      timer_controller.tick(uint32_t(ticks));
+
+      timer_controller.start(id1, etl::timer::start::IMMEDIATE);
+      timer_controller.start(id2, etl::timer::start::IMMEDIATE);
+      timer_controller.start(id3, etl::timer::start::DELAYED);
+
+      const uint32_t step = 1;
+
+      while (ticks <= 100U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 6, 42, 79 };
+      std::vector<uint64_t> compare2 = { 6, 28, 51, 74, 97 };
+      std::vector<uint64_t> compare3 = { 16, 27, 38, 49, 60, 71, 82, 93 };
+
+      CHECK(test.tick_list.size() != 0);
+      CHECK(free_tick_list1.size() != 0);
+      CHECK(free_tick_list2.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), test.tick_list.data(),  compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list1.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), free_tick_list2.data(), compare3.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_one_shot_big_step_short_delay_insert)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(free_callback1, 15, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_callback2, 5,  etl::timer::mode::REPEATING);
+
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 11;
+
+      ticks += step;
+      timer_controller.tick(step);
+
+      ticks += step;
+      timer_controller.tick(step);
+
+      std::vector<uint64_t> compare1 = { 22 };
+      std::vector<uint64_t> compare2 = { 11, 11, 22, 22 };
+
+      CHECK(free_tick_list1.size() != 0);
+      CHECK(free_tick_list2.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list2.data(), compare2.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_one_shot_empty_list_huge_tick_before_insert)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(free_callback1, 5, etl::timer::mode::SINGLE_SHOT);
+
+      free_tick_list1.clear();
+
+      timer_controller.start(id1);
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      const uint32_t step = 5;
+
+      for (uint32_t i = 0; i < step; ++i)
+      {
+        ++ticks;
+        timer_controller.tick(1);
+      }
+
+      // Huge tick count.
+      timer_controller.tick(UINT32_MAX - step + 1);
+
+      timer_controller.start(id1);
+
+      for (uint32_t i = 0; i < step; ++i)
+      {
+        ++ticks;
+        timer_controller.tick(1);
+      }
+      std::vector<uint64_t> compare1 = { 5, 10 };
+
+      CHECK(free_tick_list1.size() != 0);
+
+      CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
+    }
+
+
+    //=========================================================================
+    TEST(callback_timer_wheel_beyond_top_level)
+    {
+      // Two levels of four slots only reach 16 ticks.
+      etl::callback_timer_wheel<3, 2, 4> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(free_callback1, 100, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_callback2, 17,  etl::timer::mode::SINGLE_SHOT);
+
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.enable(true);
+
+      ticks = 3;
+      timer_controller.tick(uint32_t(ticks));
+
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+
+      const uint32_t step = 1;
+
+      while (ticks <= 400U)
+      {
+        ticks += step;
+        timer_controller.tick(step);
+      }
+
+      std::vector<uint64_t> compare1 = { 103, 203, 303 };
+      std::vector<uint64_t> compare2 = { 20 };
+
+      CHECK_EQUAL(compare1.size(), free_tick_list1.size());
+      CHECK_EQUAL(compare2.size(), free_tick_list2.size());
+
+      CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list2.data(), compare2.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_beyond_span_random)
+    {
+      // The smallest wheel, two levels of eight slots, only reaches 64 ticks.
+      uint32_t seed = 1;
+
+      for (int trial = 0; trial < 200; ++trial)
+      {
+        etl::callback_timer_wheel<1, 2, 8> timer_controller;
+
+        seed = (seed * 1664525U) + 1013904223U;
+
+        const uint32_t start  = (seed >> 8) % 64;
+        const uint32_t period = 64U + ((seed >> 16) % 1000);
+
+        etl::timer::wheel_id::type id = timer_controller.register_timer(free_callback1, period, etl::timer::mode::SINGLE_SHOT);
+
+        free_tick_list1.clear();
+
+        timer_controller.enable(true);
+
+        ticks = start;
+        timer_controller.tick(start);
+        timer_controller.start(id);
+
+        while (ticks < (start + period + 64U))
+        {
+          ++ticks;
+          timer_controller.tick(1U);
+        }
+
+        CHECK_EQUAL(1U, free_tick_list1.size());
+
+        if (free_tick_list1.size() == 1U)
+        {
+          CHECK_EQUAL(start + period, free_tick_list1[0]);
+        }
+      }
+    }
+
+    //=========================================================================
+    std::vector<std::pair<uint64_t, int> > many_fired;
+
+    struct many_callback
+    {
+      many_callback()
+        : index(0)
+      {
+      }
+
+      void callback()
+      {
+        many_fired.push_back(std::make_pair(ticks, index));
+      }
+
+      int index;
+    };
+
+    TEST(callback_timer_wheel_many_timers)
+    {
+      const int N_TIMERS = 1000;
+
+      static etl::callback_timer_wheel<N_TIMERS> timer_controller;
+      timer_controller.clear();
+
+      std::vector<many_callback> callbacks(N_TIMERS);
+      std::vector<etl::function_mv<many_callback, &many_callback::callback> > functions;
+      std::vector<std::pair<uint64_t, int> > expected;
+
+      // Reserved, as the timers hold references to the functions.
+      functions.reserve(N_TIMERS);
+
+      uint32_t period = 1;
+
+      for (int i = 0; i < N_TIMERS; ++i)
+      {
+        callbacks[i].index = i;
+        functions.emplace_back(callbacks[i]);
+
+        // A spread of periods that crosses all of the levels.
+        period = ((period * 7919U) + 13U) % 300000U + 1U;
+
+        etl::timer::wheel_id::type id = timer_controller.register_timer(functions.back(), period, etl::timer::mode::SINGLE_SHOT);
+        CHECK(id != etl::timer::wheel_id::NO_TIMER);
+        timer_controller.start(id);
+
+        expected.push_back(std::make_pair(uint64_t(period), i));
+      }
+
+      CHECK(timer_controller.register_timer(functions.back(), 1, etl::timer::mode::SINGLE_SHOT) == etl::timer::wheel_id::NO_TIMER);
+
+      many_fired.clear();
+      timer_controller.enable(true);
+
+      // Ticks of varying size.
+      ticks = 0;
+      uint32_t step = 1;
+
+      // The callbacks record the tick at the start of the step.
+      while (ticks <= 300000U)
+      {
+        timer_controller.tick(step);
+        ticks += step;
+        step = (step % 97) + 1;
+      }
+
+      CHECK_EQUAL(expected.size(), many_fired.size());
+
+      // Each timer fires once, in order of expiry, and in the step that contains its expiry.
+      std::vector<int> fired_count(N_TIMERS, 0);
+      bool in_order = true;
+      bool on_time  = true;
+
+      for (size_t i = 0; i < many_fired.size(); ++i)
+      {
+        ++fired_count[many_fired[i].second];
+
+        uint64_t expiry = expected[many_fired[i].second].first;
+
+        if ((i > 0) && (expiry < expected[many_fired[i - 1].second].first))
+        {
+          in_order = false;
+        }
+
+        if ((many_fired[i].first >= expiry) || ((many_fired[i].first + 97) < expiry))
+        {
+          on_time = false;
+        }
+      }
+
+      CHECK(in_order);
+      CHECK(on_time);
+      CHECK(std::count(fired_count.begin(), fired_count.end(), 1) == N_TIMERS);
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_time_to_next_expiry)
+    {
+      // Small levels, so that timers cascade and wait beyond the top level.
+      const uint32_t N_TIMERS = 20;
+
+      etl::callback_timer_wheel<N_TIMERS, 3, 4> timer_controller;
+
+      std::vector<etl::timer::wheel_id::type> ids;
+      std::vector<uint64_t> deadlines(N_TIMERS, 0);
+
+      CHECK_EQUAL(uint32_t(etl::timer::interval::NO_ACTIVE_INTERVAL), timer_controller.time_to_next_expiry());
+
+      for (uint32_t i = 0; i < N_TIMERS; ++i)
+      {
+        ids.push_back(timer_controller.register_timer(free_callback2, 1, etl::timer::mode::SINGLE_SHOT));
+      }
+
+      timer_controller.enable(true);
+
+      uint32_t seed = 1;
+      ticks = 0;
+
+      bool all_match = true;
+
+      for (int step = 0; step < 5000; ++step)
+      {
+        seed = (seed * 1664525U) + 1013904223U;
+
+        const uint32_t index = (seed >> 8) % N_TIMERS;
+        const uint32_t delay = (seed >> 16) % 200;
+
+        if ((seed & 0x07) == 0)
+        {
+          timer_controller.stop(ids[index]);
+          deadlines[index] = 0;
+        }
+        else
+        {
+          timer_controller.set_period(ids[index], delay);
+          timer_controller.start(ids[index]);
+          deadlines[index] = ticks + delay;
+        }
+
+        const uint32_t count = (seed >> 24) % 40;
+
+        ticks += count;
+        timer_controller.tick(count);
+
+        // The expected time from the remaining deadlines.
+        uint64_t expected = etl::timer::interval::NO_ACTIVE_INTERVAL;
+
+        for (uint32_t i = 0; i < N_TIMERS; ++i)
+        {
+          if (deadlines[i] != 0)
+          {
+            if (deadlines[i] <= ticks)
+            {
+              deadlines[i] = 0;
+            }
+            else
+            {
+              expected = std::min(expected, deadlines[i] - ticks);
+            }
+          }
+        }
+
+        all_match = all_match && (expected == timer_controller.time_to_next_expiry());
+      }
+
+      CHECK(all_match);
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_slack_coalesces_deadlines)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(free_callback1,         10, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(free_callback2,         14, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::wheel_id::type id3 = timer_controller.register_timer(free_function_callback, 40, etl::timer::mode::SINGLE_SHOT);
+
+      CHECK(timer_controller.set_slack(id1, 5));
+      CHECK(!timer_controller.set_slack(etl::timer::wheel_id::NO_TIMER, 5));
+
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.enable(true);
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+      timer_controller.start(id3);
+
+      // The first timer may wait for the second.
+      CHECK_EQUAL(14U, timer_controller.time_to_next_expiry());
+
+      ticks = 14;
+      timer_controller.tick(14);
+
+      std::vector<uint64_t> compare1 = { 14 };
+      std::vector<uint64_t> compare2 = { 14 };
+
+      CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list2.data(), compare2.size());
+
+      // The repeating timer keeps its phase, and is now due at 20 with slack to 25.
+      CHECK_EQUAL(11U, timer_controller.time_to_next_expiry());
+
+      // Without slack it is due on time.
+      CHECK(timer_controller.set_slack(id1, 0));
+      CHECK_EQUAL(6U, timer_controller.time_to_next_expiry());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_wheel_time_to_next_expiry_with_slack)
+    {
+      // Small levels, so that timers cascade and wait beyond the top level.
+      const uint32_t N_TIMERS = 20;
+
+      etl::callback_timer_wheel<N_TIMERS, 3, 4> timer_controller;
+
+      std::vector<etl::timer::wheel_id::type> ids;
+      std::vector<uint64_t> deadlines(N_TIMERS, 0);
+      std::vector<uint32_t> slacks(N_TIMERS, 0);
+
+      for (uint32_t i = 0; i < N_TIMERS; ++i)
+      {
+        ids.push_back(timer_controller.register_timer(free_callback2, 1, etl::timer::mode::SINGLE_SHOT));
+        slacks[i] = (i * 37U) % 150U;
+        CHECK(timer_controller.set_slack(ids[i], slacks[i]));
+      }
+
+      timer_controller.enable(true);
+
+      uint32_t seed = 1;
+      ticks = 0;
+
+      bool all_match = true;
+
+      for (int step = 0; step < 5000; ++step)
+      {
+        seed = (seed * 1664525U) + 1013904223U;
+
+        const uint32_t index = (seed >> 8) % N_TIMERS;
+        const uint32_t delay = (seed >> 16) % 200;
+
+        if ((seed & 0x07) == 0)
+        {
+          timer_controller.stop(ids[index]);
+          deadlines[index] = 0;
+        }
+        else
+        {
+          timer_controller.set_period(ids[index], delay);
+          timer_controller.start(ids[index]);
+          deadlines[index] = ticks + delay;
+        }
+
+        const uint32_t count = (seed >> 24) % 40;
+
+        ticks += count;
+        timer_controller.tick(count);
+
+        // The expected time from the remaining deadlines and their slack.
+        uint64_t expected = etl::timer::interval::NO_ACTIVE_INTERVAL;
+
+        for (uint32_t i = 0; i < N_TIMERS; ++i)
+        {
+          if (deadlines[i] != 0)
+          {
+            if (deadlines[i] <= ticks)
+            {
+              deadlines[i] = 0;
+            }
+            else
+            {
+              expected = std::min(expected, deadlines[i] + slacks[i] - ticks);
+            }
+          }
+        }
+
+        all_match = all_match && (expected == timer_controller.time_to_next_expiry());
+      }
+
+      CHECK(all_match);
+    }
+
+    //=========================================================================
+    etl::icallback_timer_wheel* p_nested_controller;
+    bool nested_tick_result;
+
+    void nested_tick_callback()
+    {
+      // A tick that arrives while the timers are being processed.
+      nested_tick_result = p_nested_controller->tick(5);
+    }
+
+    TEST(callback_timer_wheel_tick_during_update_is_held)
+    {
+      etl::callback_timer_wheel<3> timer_controller;
+
+      p_nested_controller = &timer_controller;
+      nested_tick_result  = false;
+
+      etl::timer::wheel_id::type id1 = timer_controller.register_timer(free_callback1,       10, etl::timer::mode::REPEATING);
+      etl::timer::wheel_id::type id2 = timer_controller.register_timer(nested_tick_callback, 1,  etl::timer::mode::SINGLE_SHOT);
+
+      free_tick_list1.clear();
+
+      timer_controller.enable(true);
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+
+      ticks = 1;
+      CHECK(timer_controller.tick(1));
+      CHECK(nested_tick_result);
+
+      // The nested ticks have been processed.
+      CHECK_EQUAL(4U, timer_controller.time_to_next_expiry());
+
+      ticks = 10;
+      timer_controller.tick(4);
+
+      CHECK_EQUAL(1U, free_tick_list1.size());
+      CHECK_EQUAL(10U, timer_controller.time_to_next_expiry());
+    }
+  };
+}
@@ -0,0 +1,127 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+#include "UnitTest++.h"
+
+#include <string>
+#include <stdint.h>
+
+#include "etl/constexpr_hash.h"
+#include "etl/fnv_1.h"
+#include "etl/crc8_ccitt.h"
+#include "etl/crc16.h"
+#include "etl/crc16_ccitt.h"
+#include "etl/crc16_kermit.h"
+#include "etl/crc16_modbus.h"
+#include "etl/crc32.h"
+#include "etl/crc32_c.h"
+#include "etl/crc64_ecma.h"
+#include "etl/murmur3.h"
+
+using namespace etl::literals;
+
+namespace
+{
+  const char* texts[] = { "", "a", "ab", "abc", "abcd", "abcde", "123456789", "The quick brown fox jumps over the lazy dog" };
+
+  //***************************************************************************
+  int lookup(uint32_t id)
+  {
+    switch (id)
+    {
+      case "start"_hash: return 1;
+      case "stop"_hash:  return 2;
+      case "reset"_hash: return 3;
+      default:           return 0;
+    }
+  }
+
+  SUITE(test_constexpr_hash)
+  {
+    //*************************************************************************
+    TEST(test_compile_time)
+    {
+      static_assert(etl::constexpr_hash::fnv_1_32("123456789")  == 0x24148816UL, "fnv_1_32 failed");
+      static_assert(etl::constexpr_hash::fnv_1a_32("123456789") == 0xBB86B11CUL, "fnv_1a_32 failed");
+      static_assert(etl::constexpr_hash::crc32("123456789")     == 0xCBF43926UL, "crc32 failed");
+      static_assert("123456789"_crc32 == 0xCBF43926UL,                             "_crc32 failed");
+      static_assert("123456789"_hash  == 0xBB86B11CUL,                             "_hash failed");
+
+      std::string start("start");
+
+      CHECK_EQUAL(1, lookup(etl::fnv_1a_32(start.begin(), start.end())));
+      CHECK_EQUAL(2, lookup("stop"_hash));
+      CHECK_EQUAL(0, lookup("unknown"_hash));
+    }
+
+    //*************************************************************************
+    TEST(test_fnv_1)
+    {
+      for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i)
+      {
+        std::string data(texts[i]);
+
+        CHECK_EQUAL(uint32_t(etl::fnv_1_32(data.begin(), data.end())),  etl::constexpr_hash::fnv_1_32(texts[i]));
+        CHECK_EQUAL(uint32_t(etl::fnv_1a_32(data.begin(), data.end())), etl::constexpr_hash::fnv_1a_32(texts[i]));
+        CHECK_EQUAL(uint64_t(etl::fnv_1_64(data.begin(), data.end())),  etl::constexpr_hash::fnv_1_64(texts[i]));
+        CHECK_EQUAL(uint64_t(etl::fnv_1a_64(data.begin(), data.end())), etl::constexpr_hash::fnv_1a_64(texts[i]));
+        CHECK_EQUAL(uint64_t(etl::fnv_1a_64(data.begin(), data.end())), etl::constexpr_hash::fnv_1a_64(data.c_str(), data.size()));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_crc)
+    {
+      for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i)
+      {
+        std::string data(texts[i]);
+
+        CHECK_EQUAL(int(etl::crc8_ccitt(data.begin(), data.end())),   int(etl::constexpr_hash::crc8_ccitt(texts[i])));
+        CHECK_EQUAL(int(etl::crc16(data.begin(), data.end())),        int(etl::constexpr_hash::crc16(texts[i])));
+        CHECK_EQUAL(int(etl::crc16_ccitt(data.begin(), data.end())),  int(etl::constexpr_hash::crc16_ccitt(texts[i])));
+        CHECK_EQUAL(int(etl::crc16_kermit(data.begin(), data.end())), int(etl::constexpr_hash::crc16_kermit(texts[i])));
+        CHECK_EQUAL(int(etl::crc16_modbus(data.begin(), data.end())), int(etl::constexpr_hash::crc16_modbus(texts[i])));
+        CHECK_EQUAL(uint32_t(etl::crc32(data.begin(), data.end())),   etl::constexpr_hash::crc32(texts[i]));
+        CHECK_EQUAL(uint32_t(etl::crc32_c(data.begin(), data.end())), etl::constexpr_hash::crc32_c(texts[i]));
+        CHECK_EQUAL(uint64_t(etl::crc64_ecma(data.begin(), data.end())), etl::constexpr_hash::crc64_ecma(texts[i]));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_murmur3)
+    {
+      for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i)
+      {
+        std::string data(texts[i]);
+
+        CHECK_EQUAL(uint32_t(etl::murmur3<uint32_t>(data.begin(), data.end())),     etl::constexpr_hash::murmur3_32(texts[i]));
+        CHECK_EQUAL(uint32_t(etl::murmur3<uint32_t>(data.begin(), data.end(), 42)), etl::constexpr_hash::murmur3_32(data.c_str(), data.size(), 42));
+        CHECK_EQUAL(uint64_t(etl::murmur3<uint64_t>(data.begin(), data.end())),     etl::constexpr_hash::murmur3_64(texts[i]));
+      }
+    }
+  };
+}
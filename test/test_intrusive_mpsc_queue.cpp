@@ -0,0 +1,229 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "etl/intrusive_mpsc_queue.h"
+#include "etl/intrusive_queue.h"
+#include "etl/intrusive_links.h"
+
+namespace
+{
+  typedef etl::forward_link<0> link0;
+  typedef etl::forward_link<1> link1;
+
+  struct Data : public link0, public link1
+  {
+    Data(int i_ = 0)
+      : i(i_)
+    {
+    }
+
+    int i;
+  };
+
+  SUITE(test_intrusive_mpsc_queue)
+  {
+    //*************************************************************************
+    TEST(test_constructor)
+    {
+      etl::intrusive_mpsc_queue<Data, link0> queue;
+
+      CHECK(queue.empty());
+      CHECK(queue.pop() == nullptr);
+    }
+
+    //*************************************************************************
+    TEST(test_push_pop)
+    {
+      etl::intrusive_mpsc_queue<Data, link0> queue;
+
+      Data data1(1);
+      Data data2(2);
+      Data data3(3);
+
+      queue.push(data1);
+      CHECK(!queue.empty());
+
+      queue.push(data2);
+      queue.push(data3);
+
+      CHECK_EQUAL(&data1, queue.pop());
+      CHECK_EQUAL(&data2, queue.pop());
+      CHECK_EQUAL(&data3, queue.pop());
+      CHECK(queue.pop() == nullptr);
+      CHECK(queue.empty());
+
+      // Values may be pushed again once popped.
+      queue.push(data3);
+      queue.push(data1);
+
+      CHECK_EQUAL(&data3, queue.pop());
+
+      queue.push(data2);
+
+      CHECK_EQUAL(&data1, queue.pop());
+      CHECK_EQUAL(&data2, queue.pop());
+      CHECK(queue.pop() == nullptr);
+      CHECK(queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_single_value_repeated)
+    {
+      etl::intrusive_mpsc_queue<Data, link0> queue;
+
+      Data data(1);
+
+      for (int i = 0; i < 10; ++i)
+      {
+        queue.push(data);
+        CHECK_EQUAL(&data, queue.pop());
+        CHECK(queue.pop() == nullptr);
+      }
+
+      CHECK(queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_pop_into)
+    {
+      etl::intrusive_mpsc_queue<Data, link0> queue;
+      etl::intrusive_queue<Data, link0>      destination;
+
+      Data data1(1);
+      Data data2(2);
+
+      queue.push(data1);
+      queue.push(data2);
+
+      while (queue.pop_into(destination))
+      {
+      }
+
+      CHECK(queue.empty());
+      CHECK_EQUAL(2U, destination.size());
+      CHECK_EQUAL(1, destination.front().i);
+      CHECK_EQUAL(2, destination.back().i);
+    }
+
+    //*************************************************************************
+    TEST(test_independent_links)
+    {
+      etl::intrusive_mpsc_queue<Data, link0> queue0;
+      etl::intrusive_mpsc_queue<Data, link1> queue1;
+
+      Data data1(1);
+      Data data2(2);
+
+      queue0.push(data1);
+      queue0.push(data2);
+      queue1.push(data2);
+      queue1.push(data1);
+
+      CHECK_EQUAL(&data1, queue0.pop());
+      CHECK_EQUAL(&data2, queue0.pop());
+      CHECK_EQUAL(&data2, queue1.pop());
+      CHECK_EQUAL(&data1, queue1.pop());
+    }
+
+    //*************************************************************************
+    TEST(test_threads)
+    {
+      const int N_PRODUCERS = 4;
+      const int N_ITEMS     = 20000;
+
+      etl::intrusive_mpsc_queue<Data, link0> queue;
+
+      std::vector<Data> items(N_PRODUCERS * N_ITEMS);
+
+      for (size_t i = 0; i < items.size(); ++i)
+      {
+        items[i].i = int(i);
+      }
+
+      std::vector<std::thread> producers;
+
+      for (int p = 0; p < N_PRODUCERS; ++p)
+      {
+        producers.push_back(std::thread([&, p]()
+        {
+          for (int i = 0; i < N_ITEMS; ++i)
+          {
+            queue.push(items[(p * N_ITEMS) + i]);
+          }
+        }));
+      }
+
+      std::vector<int> received(items.size(), 0);
+      int  last[N_PRODUCERS] = { -1, -1, -1, -1 };
+      bool out_of_order      = false;
+      int  n_received        = 0;
+
+      while (n_received < int(items.size()))
+      {
+        Data* p_data = queue.pop();
+
+        if (p_data != nullptr)
+        {
+          ++received[p_data->i];
+          ++n_received;
+
+          // Each producer's values arrive in order.
+          int producer = p_data->i / N_ITEMS;
+          out_of_order = out_of_order || (p_data->i < last[producer]);
+          last[producer] = p_data->i;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+
+      for (size_t t = 0; t < producers.size(); ++t)
+      {
+        producers[t].join();
+      }
+
+      bool all_once = true;
+
+      for (size_t i = 0; i < received.size(); ++i)
+      {
+        all_once = all_once && (received[i] == 1);
+      }
+
+      CHECK(all_once);
+      CHECK(!out_of_order);
+      CHECK(queue.empty());
+    }
+  };
+}
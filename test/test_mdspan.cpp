@@ -0,0 +1,301 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include "etl/mdspan.h"
+#include "etl/multi_array.h"
+
+#include <type_traits>
+
+namespace
+{
+  SUITE(test_mdspan)
+  {
+    using Data = etl::multi_array<int, 4, 3>;
+
+    //*************************************************************************
+    TEST(test_extents)
+    {
+      using Extents = etl::extents<4, 3, 2>;
+
+      CHECK_EQUAL(3U,  Extents::rank());
+      CHECK_EQUAL(4U,  Extents::extent(0));
+      CHECK_EQUAL(3U,  Extents::extent(1));
+      CHECK_EQUAL(2U,  Extents::extent(2));
+      CHECK_EQUAL(24U, Extents::size());
+    }
+
+    //*************************************************************************
+    TEST(test_make_mdspan_from_multi_array)
+    {
+      Data data = { { { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 }, { 9, 10, 11 } } };
+
+      auto view = etl::make_mdspan(data);
+
+      static_assert(std::is_same<decltype(view), etl::mdspan<int, etl::extents<4, 3>>>::value, "Wrong view type");
+
+      CHECK_EQUAL(2U,  view.rank());
+      CHECK_EQUAL(12U, view.size());
+      CHECK_EQUAL(3U,  view.stride(0));
+      CHECK_EQUAL(1U,  view.stride(1));
+      CHECK_EQUAL(12U, view.required_span_size());
+
+      for (size_t i = 0; i < 4; ++i)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          CHECK_EQUAL(data[i][j], view(i, j));
+          CHECK_EQUAL(data[i][j], (view[{ { i, j } }]));
+        }
+      }
+
+      view(2, 1) = 99;
+      CHECK_EQUAL(99, data[2][1]);
+
+      const Data& cdata = data;
+      auto cview = etl::make_mdspan(cdata);
+      static_assert(std::is_same<decltype(cview), etl::mdspan<const int, etl::extents<4, 3>>>::value, "Wrong view type");
+      CHECK_EQUAL(99, cview(2, 1));
+
+      etl::mdspan<const int, etl::extents<4, 3>> converted = view;
+      CHECK_EQUAL(view.data(), converted.data());
+    }
+
+    //*************************************************************************
+    TEST(test_layout_left)
+    {
+      int buffer[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+      etl::mdspan<int, etl::extents<4, 3>, etl::layout_left> view(buffer);
+
+      CHECK_EQUAL(1U, view.stride(0));
+      CHECK_EQUAL(4U, view.stride(1));
+
+      for (size_t i = 0; i < 4; ++i)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          CHECK_EQUAL(int(i + (j * 4)), view(i, j));
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_submdspan_column)
+    {
+      Data data = { { { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 }, { 9, 10, 11 } } };
+
+      auto column = etl::submdspan(etl::make_mdspan(data), etl::full_extent, 1);
+
+      static_assert(std::is_same<decltype(column), etl::mdspan<int, etl::extents<4>, etl::layout_stride<3>>>::value, "Wrong view type");
+
+      CHECK_EQUAL(1, column(0));
+      CHECK_EQUAL(4, column(1));
+      CHECK_EQUAL(7, column(2));
+      CHECK_EQUAL(10, column(3));
+      CHECK_EQUAL(10U, column.required_span_size());
+    }
+
+    //*************************************************************************
+    TEST(test_submdspan_row)
+    {
+      Data data = { { { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 }, { 9, 10, 11 } } };
+
+      auto row = etl::submdspan(etl::make_mdspan(data), 2, etl::full_extent);
+
+      CHECK_EQUAL(1U, row.rank());
+      CHECK_EQUAL(&data[2][0], row.data());
+      CHECK_EQUAL(8, row(2));
+    }
+
+    //*************************************************************************
+    TEST(test_submdspan_strided_slice)
+    {
+      Data data = { { { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 }, { 9, 10, 11 } } };
+
+      // Rows 1 and 3, columns 0 and 2.
+      auto corners = etl::submdspan(etl::make_mdspan(data), etl::strided_slice<1, 2, 2>(), etl::strided_slice<0, 2, 2>());
+
+      static_assert(std::is_same<decltype(corners), etl::mdspan<int, etl::extents<2, 2>, etl::layout_stride<6, 2>>>::value, "Wrong view type");
+
+      CHECK_EQUAL(3,  corners(0, 0));
+      CHECK_EQUAL(5,  corners(0, 1));
+      CHECK_EQUAL(9,  corners(1, 0));
+      CHECK_EQUAL(11, corners(1, 1));
+
+      // A slice of a slice.
+      auto corner = etl::submdspan(corners, 1, etl::strided_slice<1, 1>());
+      CHECK_EQUAL(11, corner(0));
+    }
+
+    //*************************************************************************
+    TEST(test_submdspan_extent_slice_blocks)
+    {
+      etl::multi_array<int, 8, 8> data;
+      auto view = etl::make_mdspan(data);
+
+      for (size_t i = 0; i < 8; ++i)
+      {
+        for (size_t j = 0; j < 8; ++j)
+        {
+          view(i, j) = int((i * 8) + j);
+        }
+      }
+
+      // Sum each 4 x 4 block.
+      int sums[2][2] = { { 0, 0 }, { 0, 0 } };
+
+      for (size_t bi = 0; bi < 2; ++bi)
+      {
+        for (size_t bj = 0; bj < 2; ++bj)
+        {
+          auto block = etl::submdspan(view, etl::extent_slice<4>(bi * 4), etl::extent_slice<4>(bj * 4));
+
+          for (size_t i = 0; i < 4; ++i)
+          {
+            for (size_t j = 0; j < 4; ++j)
+            {
+              sums[bi][bj] += block(i, j);
+            }
+          }
+        }
+      }
+
+      CHECK_EQUAL(216, sums[0][0]);
+      CHECK_EQUAL(280, sums[0][1]);
+      CHECK_EQUAL(728, sums[1][0]);
+      CHECK_EQUAL(792, sums[1][1]);
+    }
+
+    //*************************************************************************
+    TEST(test_submdspan_out_of_range)
+    {
+      etl::multi_array<int, 8, 8> data;
+      auto view = etl::make_mdspan(data);
+
+      view(7, 7) = 1;
+      CHECK_EQUAL(1, etl::submdspan(view, etl::extent_slice<4>(4), 7)(3));
+      CHECK_THROW(etl::submdspan(view, etl::extent_slice<4>(5), etl::full_extent), etl::mdspan_out_of_range);
+      CHECK_THROW(etl::submdspan(view, etl::full_extent, 8), etl::mdspan_out_of_range);
+    }
+
+    //*************************************************************************
+    TEST(test_submdspan_three_dimensions)
+    {
+      etl::multi_array<int, 2, 3, 4> data;
+      auto view = etl::make_mdspan(data);
+
+      for (size_t i = 0; i < 2; ++i)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          for (size_t k = 0; k < 4; ++k)
+          {
+            data[i][j][k] = int((i * 100) + (j * 10) + k);
+          }
+        }
+      }
+
+      auto plane = etl::submdspan(view, etl::full_extent, 1, etl::full_extent);
+
+      static_assert(std::is_same<decltype(plane), etl::mdspan<int, etl::extents<2, 4>, etl::layout_stride<12, 1>>>::value, "Wrong view type");
+
+      CHECK_EQUAL(13,  plane(0, 3));
+      CHECK_EQUAL(112, plane(1, 2));
+    }
+
+    //*************************************************************************
+    TEST(test_transpose)
+    {
+      Data data = { { { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 }, { 9, 10, 11 } } };
+
+      auto transposed = etl::transpose(etl::make_mdspan(data));
+
+      static_assert(std::is_same<decltype(transposed), etl::mdspan<int, etl::extents<3, 4>, etl::layout_stride<1, 3>>>::value, "Wrong view type");
+
+      for (size_t i = 0; i < 4; ++i)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          CHECK_EQUAL(data[i][j], transposed(j, i));
+        }
+      }
+
+      // A row of the transpose is a column of the original.
+      auto column = etl::submdspan(transposed, 2, etl::full_extent);
+      CHECK_EQUAL(8, column(2));
+    }
+
+    //*************************************************************************
+    TEST(test_layout_tiled)
+    {
+      etl::multi_array<int, 4, 6> data;
+      auto row_major = etl::make_mdspan(data);
+
+      for (size_t i = 0; i < 4; ++i)
+      {
+        for (size_t j = 0; j < 6; ++j)
+        {
+          row_major(i, j) = int((i * 6) + j);
+        }
+      }
+
+      int buffer[24];
+      etl::mdspan<int, etl::extents<4, 6>, etl::layout_tiled<2, 3>> tiled(buffer);
+
+      CHECK(!tiled.is_strided());
+      CHECK_EQUAL(24U, tiled.required_span_size());
+
+      etl::copy(row_major, tiled);
+
+      for (size_t i = 0; i < 4; ++i)
+      {
+        for (size_t j = 0; j < 6; ++j)
+        {
+          CHECK_EQUAL(row_major(i, j), tiled(i, j));
+        }
+      }
+
+      // Each tile is contiguous.
+      const int expected[] = { 0, 1, 2, 6, 7, 8, 3, 4, 5, 9, 10, 11, 12, 13, 14, 18, 19, 20, 15, 16, 17, 21, 22, 23 };
+      CHECK_ARRAY_EQUAL(expected, buffer, 24);
+
+      auto tile = etl::tile(tiled, 1, 1);
+      static_assert(std::is_same<decltype(tile), etl::mdspan<int, etl::extents<2, 3>>>::value, "Wrong view type");
+      CHECK_EQUAL(buffer + 18, tile.data());
+      CHECK_EQUAL(15, tile(0, 0));
+      CHECK_EQUAL(23, tile(1, 2));
+
+      // And back.
+      etl::multi_array<int, 4, 6> copy;
+      etl::copy(tiled, etl::make_mdspan(copy));
+      CHECK(copy == data);
+    }
+  };
+}
@@ -205,6 +205,53 @@ namespace
     int message_unknown_count;
   };
 
+  //***************************************************************************
+  // Router that accepts messages 1 and 2, but does not list them.
+  //***************************************************************************
+  class RouterC : public etl::imessage_router
+  {
+  public:
+
+    RouterC(etl::message_router_id_t id)
+      : imessage_router(id),
+        message_count(0),
+        order(0)
+    {
+    }
+
+    void receive(const etl::imessage& msg)
+    {
+      receive(etl::null_message_router::instance(), msg);
+    }
+
+    void receive(etl::imessage_router& source, etl::message_router_id_t destination_router_id, const etl::imessage& msg)
+    {
+      if ((destination_router_id == get_message_router_id()) || (destination_router_id == imessage_router::ALL_MESSAGE_ROUTERS))
+      {
+        receive(source, msg);
+      }
+    }
+
+    void receive(etl::imessage_router&, const etl::imessage&)
+    {
+      ++message_count;
+      order = call_order++;
+    }
+
+    bool accepts(etl::message_id_t id) const
+    {
+      return (id == MESSAGE1) || (id == MESSAGE2);
+    }
+
+    bool is_null_router() const
+    {
+      return false;
+    }
+
+    int message_count;
+    int order;
+  };
+
   SUITE(test_message_router)
   {
     //=========================================================================
@@ -722,5 +769,76 @@ namespace
       CHECK_EQUAL(3, router4a.order);
       CHECK_EQUAL(4, router3.order);
     }
+
+    //=========================================================================
+    TEST(message_bus_broadcast_unlisted_router_order)
+    {
+      etl::message_bus<3> bus1;
+
+      RouterA router1(ROUTER1);
+      RouterC router2(ROUTER2);
+      RouterA router3(ROUTER3);
+
+      // Subscribe out of order.
+      bus1.subscribe(router3);
+      bus1.subscribe(router2);
+      bus1.subscribe(router1);
+
+      call_order = 0;
+
+      bus1.receive(message1);
+
+      CHECK_EQUAL(0, router1.order);
+      CHECK_EQUAL(1, router2.order);
+      CHECK_EQUAL(2, router3.order);
+
+      bus1.receive(message3);
+
+      CHECK_EQUAL(1, router1.message3_count);
+      CHECK_EQUAL(1, router2.message_count);
+      CHECK_EQUAL(1, router3.message3_count);
+
+      bus1.unsubscribe(router1);
+      bus1.receive(message2);
+
+      CHECK_EQUAL(0, router1.message2_count);
+      CHECK_EQUAL(2, router2.message_count);
+      CHECK_EQUAL(1, router3.message2_count);
+    }
+
+    //=========================================================================
+    TEST(message_bus_broadcast_index_full)
+    {
+      // Room in the index for four message ids.
+      etl::message_bus<2, 4> bus1;
+
+      RouterA router1(ROUTER1);
+      RouterB router2(ROUTER2);
+
+      // RouterA has five message ids, so does not fit.
+      bus1.subscribe(router1);
+      bus1.subscribe(router2);
+
+      bus1.receive(message1);
+      bus1.receive(message3);
+      bus1.receive(message4);
+
+      CHECK_EQUAL(1, router1.message1_count);
+      CHECK_EQUAL(1, router1.message3_count);
+      CHECK_EQUAL(1, router1.message4_count);
+      CHECK_EQUAL(0, router1.message_unknown_count);
+
+      CHECK_EQUAL(1, router2.message1_count);
+      CHECK_EQUAL(1, router2.message4_count);
+      CHECK_EQUAL(0, router2.message_unknown_count);
+
+      bus1.clear();
+      CHECK_EQUAL(0U, bus1.size());
+
+      bus1.receive(message1);
+
+      CHECK_EQUAL(1, router1.message1_count);
+      CHECK_EQUAL(1, router2.message1_count);
+    }
   };
 }
@@ -199,6 +199,99 @@ namespace
 
   etl::imessage_router* p_router;
 
+#if ETL_CPP11_SUPPORTED && !defined(ETL_MESSAGE_ROUTER_FORCE_CPP03)
+  //***************************************************************************
+  // More message types than the generated routers allow, with spread out ids.
+  //***************************************************************************
+  template <int ID>
+  struct ManyMessage : public etl::message<ID>
+  {
+  };
+
+  class RouterMany : public etl::message_router<RouterMany,
+                                                ManyMessage<10>,  ManyMessage<17>,  ManyMessage<24>,  ManyMessage<31>,
+                                                ManyMessage<38>,  ManyMessage<45>,  ManyMessage<52>,  ManyMessage<59>,
+                                                ManyMessage<66>,  ManyMessage<73>,  ManyMessage<80>,  ManyMessage<87>,
+                                                ManyMessage<94>,  ManyMessage<101>, ManyMessage<108>, ManyMessage<115>,
+                                                ManyMessage<122>, ManyMessage<129>, ManyMessage<136>, ManyMessage<143>>
+  {
+  public:
+
+    RouterMany()
+      : message_router(1),
+        message_unknown_count(0)
+    {
+      for (int i = 0; i < 256; ++i)
+      {
+        received[i] = 0;
+      }
+    }
+
+    template <typename T>
+    void on_receive(etl::imessage_router&, const T&)
+    {
+      ++received[T::ID];
+    }
+
+    void on_receive_unknown(etl::imessage_router&, const etl::imessage&)
+    {
+      ++message_unknown_count;
+    }
+
+    int received[256];
+    int message_unknown_count;
+  };
+
+  //***************************************************************************
+  // A message that counts its instances.
+  //***************************************************************************
+  struct CountedMessage : public etl::message<200>
+  {
+    CountedMessage(int value_ = 0)
+      : value(value_)
+    {
+      ++instances;
+    }
+
+    CountedMessage(const CountedMessage& other)
+      : etl::message<200>(),
+        value(other.value)
+    {
+      ++instances;
+    }
+
+    ~CountedMessage()
+    {
+      --instances;
+    }
+
+    int value;
+
+    static int instances;
+  };
+
+  int CountedMessage::instances = 0;
+
+  class RouterCounted : public etl::message_router<RouterCounted, ManyMessage<10>, CountedMessage>
+  {
+  public:
+
+    RouterCounted()
+      : message_router(2)
+    {
+    }
+
+    template <typename T>
+    void on_receive(etl::imessage_router&, const T&)
+    {
+    }
+
+    void on_receive_unknown(etl::imessage_router&, const etl::imessage&)
+    {
+    }
+  };
+#endif
+
   SUITE(test_message_router)
   {
     //=========================================================================
@@ -350,6 +443,25 @@ namespace
       CHECK(r2.accepts(message5.message_id));
     }
 
+    //=========================================================================
+    TEST(message_router_get_message_ids)
+    {
+      Router2 r2;
+      etl::null_message_router nmr;
+
+      const etl::message_id_t* p_ids = nullptr;
+      size_t n_ids = 0;
+
+      CHECK(r2.get_message_ids(p_ids, n_ids));
+
+      etl::message_id_t compare[] = { MESSAGE1, MESSAGE2, MESSAGE4, MESSAGE5 };
+
+      CHECK_EQUAL(4U, n_ids);
+      CHECK_ARRAY_EQUAL(compare, p_ids, 4U);
+
+      CHECK(!nmr.get_message_ids(p_ids, n_ids));
+    }
+
     //=========================================================================
     TEST(message_router_queue)
     {
@@ -474,5 +586,116 @@ namespace
       CHECK_EQUAL(0, r1.message4_count);
       CHECK_EQUAL(0, r1.message_unknown_count);
     }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_MESSAGE_ROUTER_FORCE_CPP03)
+    //=========================================================================
+    TEST(message_router_more_than_16_types)
+    {
+      RouterMany router;
+
+      ManyMessage<10>  m10;
+      ManyMessage<73>  m73;
+      ManyMessage<143> m143;
+      ManyMessage<11>  m11;
+
+      router.receive(m10);
+      router.receive(m73);
+      router.receive(m143);
+      router.receive(m143);
+      router.receive(m11);
+      router.receive(message1);
+
+      CHECK_EQUAL(1, router.received[10]);
+      CHECK_EQUAL(1, router.received[73]);
+      CHECK_EQUAL(2, router.received[143]);
+      CHECK_EQUAL(0, router.received[11]);
+      CHECK_EQUAL(2, router.message_unknown_count);
+
+      CHECK(router.accepts(10));
+      CHECK(router.accepts(143));
+      CHECK(!router.accepts(11));
+      CHECK(!router.accepts(144));
+      CHECK(!router.accepts(9));
+
+      const etl::message_id_t* p_ids = nullptr;
+      size_t n_ids = 0;
+
+      CHECK(router.get_message_ids(p_ids, n_ids));
+      CHECK_EQUAL(20U, n_ids);
+      CHECK_EQUAL(10,  p_ids[0]);
+      CHECK_EQUAL(143, p_ids[19]);
+
+      // The packet switches on the ids in blocks of 16 types.
+      RouterMany::message_packet packet1(static_cast<const etl::imessage&>(m143));
+      RouterMany::message_packet packet2(packet1);
+      CHECK_EQUAL(143, packet2.get().message_id);
+
+      packet2 = RouterMany::message_packet(static_cast<const etl::imessage&>(m73));
+      CHECK_EQUAL(73, packet2.get().message_id);
+    }
+
+    //=========================================================================
+    TEST(message_router_message_packet_copy_destroy)
+    {
+      CountedMessage::instances = 0;
+
+      {
+        CountedMessage message(42);
+        const etl::imessage& imessage = message;
+
+        RouterCounted::message_packet packet1(imessage);
+        CHECK_EQUAL(2, CountedMessage::instances);
+        CHECK_EQUAL(42, static_cast<const CountedMessage&>(packet1.get()).value);
+
+        RouterCounted::message_packet packet2(packet1);
+        CHECK_EQUAL(3, CountedMessage::instances);
+        CHECK_EQUAL(42, static_cast<const CountedMessage&>(packet2.get()).value);
+
+        ManyMessage<10> m10;
+        RouterCounted::message_packet packet3(m10);
+        CHECK_EQUAL(3, CountedMessage::instances);
+
+        // Replaces a ManyMessage with a CountedMessage, then the reverse.
+        packet3 = packet2;
+        CHECK_EQUAL(4, CountedMessage::instances);
+
+        packet2 = RouterCounted::message_packet(m10);
+        CHECK_EQUAL(3, CountedMessage::instances);
+        CHECK_EQUAL(10, packet2.get().message_id);
+      }
+
+      CHECK_EQUAL(0, CountedMessage::instances);
+    }
+
+    //=========================================================================
+    TEST(message_router_sparse_id_hash)
+    {
+      // Ids that are too far apart for a table indexed by id are hashed.
+      // 5, 200 and 17 leave different remainders when divided by 7.
+      typedef etl::private_message_router::id_lookup<false, 5, 200, 17> lookup_t;
+
+      CHECK_EQUAL(7U, etl::private_message_router::find_modulus(3U, 3U + ETL_MESSAGE_ROUTER_MAX_TABLE_SIZE, 5, 200, 17));
+
+      CHECK_EQUAL(0U, lookup_t::find(5));
+      CHECK_EQUAL(1U, lookup_t::find(200));
+      CHECK_EQUAL(2U, lookup_t::find(17));
+      CHECK_EQUAL(3U, lookup_t::find(6));
+
+      // Leaves the same remainder as 5.
+      CHECK_EQUAL(3U, lookup_t::find(12));
+    }
+
+    //=========================================================================
+    TEST(message_router_sparse_id_search)
+    {
+      // Without a modulus, the ids are searched.
+      typedef etl::private_message_router::hashed_lookup<0U, 5, 200, 17> lookup_t;
+
+      CHECK_EQUAL(0U, lookup_t::find(5));
+      CHECK_EQUAL(1U, lookup_t::find(200));
+      CHECK_EQUAL(2U, lookup_t::find(17));
+      CHECK_EQUAL(3U, lookup_t::find(6));
+    }
+#endif
   };
 }
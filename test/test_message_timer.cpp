@@ -594,6 +594,49 @@ namespace
       CHECK_ARRAY_EQUAL(compare1.data(), router1.message1.data(), compare1.size());
     }
 
+    //=========================================================================
+    TEST(message_timer_time_to_next_expiry_with_slack)
+    {
+      etl::message_timer<3> timer_controller;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(message1, router1, 10, etl::timer::mode::REPEATING);
+      etl::timer::id::type id2 = timer_controller.register_timer(message2, router1, 14, etl::timer::mode::SINGLE_SHOT);
+
+      CHECK_EQUAL(uint32_t(etl::timer::interval::NO_ACTIVE_INTERVAL), timer_controller.time_to_next_expiry());
+
+      router1.clear();
+
+      timer_controller.enable(true);
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+
+      CHECK_EQUAL(10U, timer_controller.time_to_next_expiry());
+
+      // The first timer may wait for the second.
+      CHECK(timer_controller.set_slack(id1, 5));
+      CHECK_EQUAL(14U, timer_controller.time_to_next_expiry());
+
+      // Only tick when something is due.
+      ticks = 0;
+
+      while (ticks < 40U)
+      {
+        uint32_t next = timer_controller.time_to_next_expiry();
+
+        ticks += next;
+        timer_controller.tick(next);
+      }
+
+      std::vector<uint64_t> compare1 = { 14, 25, 35, 45 };
+      std::vector<uint64_t> compare2 = { 14 };
+
+      CHECK_EQUAL(compare1.size(), router1.message1.size());
+      CHECK_EQUAL(compare2.size(), router1.message2.size());
+
+      CHECK_ARRAY_EQUAL(compare1.data(), router1.message1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), router1.message2.data(), compare2.size());
+    }
+
     //=========================================================================
 #if REALTIME_TEST
 
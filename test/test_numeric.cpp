@@ -32,9 +32,90 @@ SOFTWARE.
 
 #include <algorithm>
 #include <numeric>
+#include <vector>
+#include <list>
+#include <string>
+#include <functional>
+#include <stdint.h>
 
 namespace
-{		
+{
+  //***************************************************************************
+  // Fills a buffer with values in [-range / 2, range / 2).
+  //***************************************************************************
+  template <typename T>
+  std::vector<T> make_data(size_t size, int range)
+  {
+    std::vector<T> data(size);
+
+    unsigned seed = 1;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      seed = (seed * 1103515245U) + 12345U;
+      data[i] = T(int((seed >> 16) % range) - (range / 2));
+    }
+
+    return data;
+  }
+
+  //***************************************************************************
+  // Checks the scans and reductions against the sequential standard versions
+  // for all lengths up to a few vectors and unaligned starting addresses.
+  //***************************************************************************
+  template <typename T>
+  bool check_reduce_and_scan(int range)
+  {
+    const std::vector<T> data1 = make_data<T>(150, range);
+    const std::vector<T> data2 = make_data<T>(151, range);
+
+    std::vector<T> expected(data1.size());
+    std::vector<T> result(data1.size());
+
+    for (size_t offset = 0; offset < 4; ++offset)
+    {
+      for (size_t length = 0; length < (data1.size() - offset); ++length)
+      {
+        const T* first = data1.data() + offset;
+        const T* last  = first + length;
+
+        if ((etl::reduce(first, last, T(3)) != std::accumulate(first, last, T(3))) ||
+            (etl::reduce(etl::execution::chunked_policy<7>(), first, last, T(3)) != std::accumulate(first, last, T(3))) ||
+            (etl::transform_reduce(first, last, data2.data(), T(3)) != std::inner_product(first, last, data2.data(), T(3))))
+        {
+          return false;
+        }
+
+        std::partial_sum(first, last, expected.begin());
+        etl::inclusive_scan(first, last, result.begin());
+
+        if (!std::equal(expected.begin(), expected.begin() + length, result.begin()))
+        {
+          return false;
+        }
+
+        // Exclusive, in place.
+        T sum = T(3);
+
+        for (size_t i = 0; i < length; ++i)
+        {
+          expected[i] = sum;
+          sum = T(sum + first[i]);
+        }
+
+        std::copy(first, last, result.begin());
+        etl::exclusive_scan(result.data(), result.data() + length, result.data(), T(3));
+
+        if (!std::equal(expected.begin(), expected.begin() + length, result.begin()))
+        {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
   SUITE(test_numeric)
   {
     //*************************************************************************
@@ -49,5 +130,162 @@ namespace
 
       CHECK(are_same);
     }
+
+    //*************************************************************************
+    TEST(test_reduce_and_scan_types)
+    {
+      CHECK(check_reduce_and_scan<int8_t>(9));
+      CHECK(check_reduce_and_scan<uint8_t>(9));
+      CHECK(check_reduce_and_scan<int16_t>(1000));
+      CHECK(check_reduce_and_scan<uint16_t>(1000));
+      CHECK(check_reduce_and_scan<int32_t>(100000));
+      CHECK(check_reduce_and_scan<uint32_t>(100000));
+      CHECK(check_reduce_and_scan<int64_t>(100000));
+      CHECK(check_reduce_and_scan<uint64_t>(100000));
+      CHECK(check_reduce_and_scan<float>(64));   // Small integers are exact in any order.
+      CHECK(check_reduce_and_scan<double>(64));
+    }
+
+    //*************************************************************************
+    TEST(test_reduce)
+    {
+      std::vector<int> data = make_data<int>(1000, 100);
+
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 0), etl::reduce(data.begin(), data.end()));
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 10), etl::reduce(data.begin(), data.end(), 10));
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 10L), etl::reduce(data.begin(), data.end(), 10L));
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 10, std::bit_xor<int>()), etl::reduce(data.begin(), data.end(), 10, std::bit_xor<int>()));
+
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 0), etl::reduce(etl::execution::seq, data.begin(), data.end()));
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 10), etl::reduce(etl::execution::unseq, data.begin(), data.end(), 10));
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 10, std::bit_xor<int>()), etl::reduce(etl::execution::chunked, data.begin(), data.end(), 10, std::bit_xor<int>()));
+
+      // Not random access.
+      std::list<int> list(data.begin(), data.end());
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 10), etl::reduce(list.begin(), list.end(), 10));
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 10), etl::reduce(etl::execution::chunked_policy<33>(), list.begin(), list.end(), 10));
+    }
+
+    //*************************************************************************
+    TEST(test_reduce_sequenced_is_accumulate)
+    {
+      std::vector<float> data;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        data.push_back(1.0f / float(i + 1));
+      }
+
+      CHECK_EQUAL(std::accumulate(data.begin(), data.end(), 0.0f), etl::reduce(etl::execution::seq, data.begin(), data.end(), 0.0f));
+      CHECK_CLOSE(std::accumulate(data.begin(), data.end(), 0.0), double(etl::reduce(data.data(), data.data() + data.size(), 0.0f)), 1e-4);
+    }
+
+    //*************************************************************************
+    TEST(test_reduce_non_commutative_sequenced)
+    {
+      const char* text[] = { "a", "b", "c", "d", "e", "f", "g" };
+
+      CHECK_EQUAL(std::string("xabcdefg"), etl::reduce(etl::execution::seq, std::begin(text), std::end(text), std::string("x"), std::plus<std::string>()));
+      CHECK_EQUAL(std::string("xabcdefg"), etl::reduce(etl::execution::chunked_policy<3>(), std::begin(text), std::end(text), std::string("x"), std::plus<std::string>()));
+    }
+
+    //*************************************************************************
+    TEST(test_transform_reduce)
+    {
+      std::vector<int> data1 = make_data<int>(1000, 100);
+      std::vector<int> data2 = make_data<int>(1001, 100);
+
+      CHECK_EQUAL(std::inner_product(data1.begin(), data1.end(), data2.begin(), 5), etl::transform_reduce(data1.begin(), data1.end(), data2.begin(), 5));
+      CHECK_EQUAL(std::inner_product(data1.begin(), data1.end(), data2.begin(), 5), etl::transform_reduce(etl::execution::chunked_policy<10>(), data1.begin(), data1.end(), data2.begin(), 5));
+      CHECK_EQUAL(std::inner_product(data1.begin(), data1.end(), data2.begin(), 5, std::plus<int>(), std::minus<int>()),
+                  etl::transform_reduce(data1.begin(), data1.end(), data2.begin(), 5, std::plus<int>(), std::minus<int>()));
+      CHECK_EQUAL(std::inner_product(data1.begin(), data1.end(), data2.begin(), 5, std::plus<int>(), std::minus<int>()),
+                  etl::transform_reduce(etl::execution::seq, data1.begin(), data1.end(), data2.begin(), 5, std::plus<int>(), std::minus<int>()));
+
+      // Unary, sum of squares.
+      long expected = 0;
+
+      for (size_t i = 0; i < data1.size(); ++i)
+      {
+        expected += long(data1[i]) * data1[i];
+      }
+
+      struct Square
+      {
+        long operator()(int value) const
+        {
+          return long(value) * value;
+        }
+      };
+
+      CHECK_EQUAL(expected, etl::transform_reduce(data1.begin(), data1.end(), 0L, std::plus<long>(), Square()));
+      CHECK_EQUAL(expected, etl::transform_reduce(etl::execution::chunked, data1.begin(), data1.end(), 0L, std::plus<long>(), Square()));
+    }
+
+    //*************************************************************************
+    TEST(test_inclusive_scan)
+    {
+      std::vector<int> data = make_data<int>(100, 100);
+      std::vector<int> expected(data.size());
+      std::vector<int> result(data.size());
+
+      std::partial_sum(data.begin(), data.end(), expected.begin());
+
+      CHECK(etl::inclusive_scan(data.begin(), data.end(), result.begin()) == result.end());
+      CHECK(expected == result);
+
+      std::fill(result.begin(), result.end(), 0);
+      etl::inclusive_scan(etl::execution::chunked_policy<7>(), data.begin(), data.end(), result.begin());
+      CHECK(expected == result);
+
+      std::partial_sum(data.begin(), data.end(), expected.begin(), std::multiplies<int>());
+      etl::inclusive_scan(data.begin(), data.end(), result.begin(), std::multiplies<int>());
+      CHECK(expected == result);
+
+      // With an initial value, to a list.
+      std::list<long> list;
+      etl::inclusive_scan(etl::execution::seq, data.begin(), data.end(), std::back_inserter(list), std::plus<long>(), 1000L);
+
+      long sum = 1000L;
+      std::list<long>::const_iterator itr = list.begin();
+
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        sum += data[i];
+        CHECK_EQUAL(sum, *itr++);
+      }
+
+      // Empty.
+      CHECK(etl::inclusive_scan(data.begin(), data.begin(), result.begin()) == result.begin());
+    }
+
+    //*************************************************************************
+    TEST(test_exclusive_scan)
+    {
+      std::vector<int> data = make_data<int>(100, 100);
+      std::vector<int> expected(data.size());
+      std::vector<int> result(data.size());
+
+      int product = 2;
+
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        expected[i] = product;
+        product *= (data[i] | 1);
+        data[i] |= 1;
+      }
+
+      etl::exclusive_scan(data.begin(), data.end(), result.begin(), 2, std::multiplies<int>());
+      CHECK(expected == result);
+
+      std::fill(result.begin(), result.end(), 0);
+      etl::exclusive_scan(etl::execution::chunked_policy<9>(), data.begin(), data.end(), result.begin(), 2, std::multiplies<int>());
+      CHECK(expected == result);
+
+      std::partial_sum(data.begin(), data.end() - 1, expected.begin() + 1);
+      expected[0] = 0;
+      etl::exclusive_scan(etl::execution::seq, data.begin(), data.end(), result.begin(), 0);
+      CHECK(expected == result);
+    }
   };
 }
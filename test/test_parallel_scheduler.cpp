@@ -0,0 +1,265 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <atomic>
+#include <vector>
+#include <memory>
+
+#include "etl/parallel_scheduler.h"
+#include "etl/function.h"
+
+namespace
+{
+  //***************************************************************************
+  class counting_task : public etl::task
+  {
+  public:
+
+    counting_task(etl::task_priority_t priority, int work_)
+      : task(priority),
+        work(work_),
+        processed(0),
+        in_use(false),
+        overlapped(false)
+    {
+    }
+
+    uint32_t task_request_work() const
+    {
+      return work.load();
+    }
+
+    void task_process_work()
+    {
+      if (in_use.exchange(true))
+      {
+        overlapped = true;
+      }
+
+      --work;
+      ++processed;
+
+      in_use = false;
+    }
+
+    std::atomic<int>  work;
+    std::atomic<int>  processed;
+    std::atomic<bool> in_use;
+    std::atomic<bool> overlapped;
+  };
+
+  //***************************************************************************
+  class recording_task : public etl::task
+  {
+  public:
+
+    recording_task(etl::task_priority_t priority, std::vector<int>& order_)
+      : task(priority),
+        work(1),
+        order(order_)
+    {
+    }
+
+    uint32_t task_request_work() const
+    {
+      return work;
+    }
+
+    void task_process_work()
+    {
+      --work;
+      order.push_back(get_task_priority());
+    }
+
+    int work;
+    std::vector<int>& order;
+  };
+
+  //***************************************************************************
+  template <typename TScheduler, typename TTask>
+  struct exit_when_done
+  {
+    exit_when_done(TScheduler& scheduler_, TTask** p_tasks_, size_t n_tasks_)
+      : scheduler(scheduler_),
+        p_tasks(p_tasks_),
+        n_tasks(n_tasks_),
+        n_idle(0),
+        n_watchdog(0)
+    {
+    }
+
+    void idle()
+    {
+      ++n_idle;
+
+      for (size_t i = 0; i < n_tasks; ++i)
+      {
+        if (p_tasks[i]->task_request_work() > 0)
+        {
+          return;
+        }
+      }
+
+      scheduler.exit_scheduler();
+    }
+
+    void watchdog()
+    {
+      ++n_watchdog;
+    }
+
+    TScheduler& scheduler;
+    TTask**     p_tasks;
+    size_t      n_tasks;
+    int         n_idle;
+    int         n_watchdog;
+  };
+
+  SUITE(test_parallel_scheduler)
+  {
+    //*************************************************************************
+    TEST(test_all_work_done_once)
+    {
+      typedef etl::parallel_scheduler<8, 4> scheduler_t;
+      typedef exit_when_done<scheduler_t, counting_task> callbacks_t;
+
+      const int WORK = 1000;
+
+      scheduler_t scheduler;
+
+      const size_t N_TASKS = 8;
+
+      std::unique_ptr<counting_task> storage[N_TASKS];
+      counting_task* tasks[N_TASKS];
+
+      for (size_t i = 0; i < N_TASKS; ++i)
+      {
+        storage[i].reset(new counting_task(etl::task_priority_t(i % 4), WORK));
+        tasks[i] = storage[i].get();
+        scheduler.add_task(*tasks[i]);
+      }
+
+      callbacks_t callbacks(scheduler, tasks, N_TASKS);
+
+      etl::function_mv<callbacks_t, &callbacks_t::idle>     idle_callback(callbacks);
+      etl::function_mv<callbacks_t, &callbacks_t::watchdog> watchdog_callback(callbacks);
+
+      scheduler.set_idle_callback(idle_callback);
+      scheduler.set_watchdog_callback(watchdog_callback);
+
+      scheduler.start();
+
+      for (size_t i = 0; i < N_TASKS; ++i)
+      {
+        CHECK_EQUAL(0, tasks[i]->work.load());
+        CHECK_EQUAL(WORK, tasks[i]->processed.load());
+        CHECK(!tasks[i]->overlapped);
+      }
+
+      CHECK(callbacks.n_idle > 0);
+      CHECK(callbacks.n_watchdog >= callbacks.n_idle);
+    }
+
+    //*************************************************************************
+    TEST(test_priority_order_single_worker)
+    {
+      typedef etl::parallel_scheduler<4, 1> scheduler_t;
+      typedef exit_when_done<scheduler_t, recording_task> callbacks_t;
+
+      scheduler_t scheduler;
+
+      std::vector<int> order;
+
+      recording_task task1(2, order);
+      recording_task task2(4, order);
+      recording_task task3(1, order);
+      recording_task task4(3, order);
+
+      recording_task* tasks[]     = { &task1, &task2, &task3, &task4 };
+      etl::task*      task_list[] = { &task1, &task2, &task3, &task4 };
+
+      scheduler.add_task_list(task_list, 4);
+
+      callbacks_t callbacks(scheduler, tasks, 4);
+
+      etl::function_mv<callbacks_t, &callbacks_t::idle> idle_callback(callbacks);
+      scheduler.set_idle_callback(idle_callback);
+
+      scheduler.start();
+
+      CHECK_EQUAL(4U, order.size());
+      CHECK_EQUAL(4, order[0]);
+      CHECK_EQUAL(3, order[1]);
+      CHECK_EQUAL(2, order[2]);
+      CHECK_EQUAL(1, order[3]);
+    }
+
+    //*************************************************************************
+    TEST(test_exit_from_task)
+    {
+      typedef etl::parallel_scheduler<2, 3> scheduler_t;
+
+      struct exit_task : public etl::task
+      {
+        exit_task(scheduler_t& scheduler_)
+          : task(0),
+            scheduler(scheduler_),
+            calls(0)
+        {
+        }
+
+        uint32_t task_request_work() const
+        {
+          return 1;
+        }
+
+        void task_process_work()
+        {
+          if (++calls == 100)
+          {
+            scheduler.exit_scheduler();
+          }
+        }
+
+        scheduler_t&     scheduler;
+        std::atomic<int> calls;
+      };
+
+      scheduler_t scheduler;
+      exit_task   task(scheduler);
+
+      scheduler.add_task(task);
+      scheduler.start();
+
+      CHECK(task.calls >= 100);
+      CHECK(scheduler.scheduler_is_running());
+    }
+  };
+}
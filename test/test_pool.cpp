@@ -413,6 +413,23 @@ namespace
       CHECK_NO_THROW(p3 = pool.allocate<double>());
       CHECK_NO_THROW(p4 = pool.allocate<Test_Data>());
     }
+
+    //*************************************************************************
+    TEST(test_allocate_release_batch)
+    {
+      etl::pool<Test_Data, 4> pool;
+      void* items[6];
+
+      CHECK_EQUAL(3U, pool.allocate_batch(items, 3));
+      CHECK_EQUAL(3U, pool.size());
+      CHECK_EQUAL(1U, pool.allocate_batch(items + 3, 3));
+      CHECK(pool.full());
+      CHECK_EQUAL(0U, pool.allocate_batch(items + 4, 2));
+
+      pool.release_batch(items, 4);
+      CHECK(pool.empty());
+      CHECK_EQUAL(4U, pool.allocate_batch(items, 6));
+    }
   };
 
   //*************************************************************************
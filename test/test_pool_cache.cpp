@@ -0,0 +1,280 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <set>
+#include <atomic>
+
+#include "etl/pool_cache.h"
+#include "etl/pool.h"
+#include "etl/atomic_pool.h"
+
+namespace
+{
+  struct Data
+  {
+    Data(int a_, int b_)
+      : a(a_),
+        b(b_)
+    {
+      ++instances;
+    }
+
+    ~Data()
+    {
+      --instances;
+    }
+
+    int a;
+    int b;
+
+    static int instances;
+  };
+
+  int Data::instances = 0;
+
+  typedef etl::pool_cache<etl::ipool, 4>        Cache;
+  typedef etl::pool_cache<etl::iatomic_pool, 8> AtomicCache;
+
+  SUITE(test_pool_cache)
+  {
+    //*************************************************************************
+    TEST(test_allocate_fetches_whole_magazines)
+    {
+      etl::pool<Data, 16> pool;
+      Cache cache(pool);
+
+      std::set<Data*> allocated;
+
+      for (int i = 0; i < 9; ++i)
+      {
+        Data* p = cache.allocate<Data>();
+        CHECK(pool.is_in_pool(p));
+        allocated.insert(p);
+      }
+
+      CHECK_EQUAL(9U, allocated.size());
+
+      // Three magazines of four have been fetched from the pool.
+      CHECK_EQUAL(3U, cache.allocate_misses());
+      CHECK_EQUAL(6U, cache.allocate_hits());
+      CHECK_EQUAL(12U, pool.size());
+      CHECK_EQUAL(3U, cache.cached());
+    }
+
+    //*************************************************************************
+    TEST(test_release_returns_whole_magazines)
+    {
+      etl::pool<Data, 16> pool;
+      Cache cache(pool);
+
+      std::vector<Data*> allocated;
+
+      for (int i = 0; i < 16; ++i)
+      {
+        allocated.push_back(cache.allocate<Data>());
+      }
+
+      CHECK(pool.full());
+      CHECK_EQUAL(0U, cache.cached());
+
+      for (size_t i = 0; i < allocated.size(); ++i)
+      {
+        cache.release(allocated[i]);
+      }
+
+      // Two magazines are kept, the rest went back to the pool.
+      CHECK_EQUAL(2U, cache.release_misses());
+      CHECK_EQUAL(14U, cache.release_hits());
+      CHECK_EQUAL(8U, cache.cached());
+      CHECK_EQUAL(8U, pool.size());
+
+      cache.flush();
+
+      CHECK_EQUAL(0U, cache.cached());
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_alternating_allocate_release_stays_local)
+    {
+      etl::pool<Data, 16> pool;
+      Cache cache(pool);
+
+      for (int i = 0; i < 100; ++i)
+      {
+        Data* p1 = cache.allocate<Data>();
+        Data* p2 = cache.allocate<Data>();
+        cache.release(p1);
+        cache.release(p2);
+      }
+
+      CHECK_EQUAL(1U, cache.allocate_misses());
+      CHECK_EQUAL(0U, cache.release_misses());
+
+      cache.clear_statistics();
+
+      CHECK_EQUAL(0U, cache.allocate_hits());
+      CHECK_EQUAL(0U, cache.allocate_misses());
+      CHECK_EQUAL(0U, cache.release_hits());
+      CHECK_EQUAL(0U, cache.release_misses());
+    }
+
+    //*************************************************************************
+    TEST(test_create_destroy)
+    {
+      etl::pool<Data, 16> pool;
+      Cache cache(pool);
+
+      Data* p = cache.create<Data>(1, 2);
+
+      CHECK_EQUAL(1, Data::instances);
+      CHECK_EQUAL(1, p->a);
+      CHECK_EQUAL(2, p->b);
+
+      cache.destroy<Data>(p);
+
+      CHECK_EQUAL(0, Data::instances);
+    }
+
+    //*************************************************************************
+    TEST(test_destructor_flushes)
+    {
+      etl::pool<Data, 16> pool;
+
+      {
+        Cache cache(pool);
+        cache.release(cache.allocate<Data>());
+        CHECK_EQUAL(4U, pool.size());
+      }
+
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_exhausted)
+    {
+      etl::pool<Data, 6> pool;
+      Cache cache(pool);
+
+      for (int i = 0; i < 6; ++i)
+      {
+        cache.allocate<Data>();
+      }
+
+      // The second magazine was only partly filled.
+      CHECK_EQUAL(2U, cache.allocate_misses());
+      CHECK_THROW(cache.allocate<Data>(), etl::pool_no_allocation);
+    }
+
+    //*************************************************************************
+    TEST(test_release_not_in_pool)
+    {
+      etl::pool<Data, 16> pool;
+      Cache cache(pool);
+
+      Data data(1, 2);
+
+      CHECK_THROW(cache.release(&data), etl::pool_object_not_in_pool);
+    }
+
+    //*************************************************************************
+    TEST(test_allocate_too_large)
+    {
+      struct Large
+      {
+        Data data[2];
+      };
+
+      etl::pool<Data, 16> pool;
+      Cache cache(pool);
+
+      CHECK_THROW(cache.allocate<Large>(), etl::pool_element_size);
+      CHECK_EQUAL(0U, cache.allocate_misses());
+    }
+
+    //*************************************************************************
+    TEST(test_threads)
+    {
+      const size_t N_THREADS   = 4;
+      const size_t ITERATIONS  = 100000;
+      const size_t BATCH       = 12;
+
+      static etl::atomic_pool<Data, N_THREADS * (BATCH + (2 * AtomicCache::MAGAZINE_SIZE))> pool;
+
+      std::atomic<bool> failed(false);
+
+      // Each thread stamps its items and checks that no other thread has been handed them.
+      auto worker = [&](int id)
+      {
+        AtomicCache cache(pool);
+        Data* items[BATCH];
+
+        for (size_t i = 0; i < ITERATIONS; ++i)
+        {
+          size_t n = (i % BATCH) + 1;
+
+          for (size_t j = 0; j < n; ++j)
+          {
+            items[j] = cache.allocate<Data>();
+            items[j]->a = id;
+            items[j]->b = int(j);
+          }
+
+          for (size_t j = 0; j < n; ++j)
+          {
+            if ((items[j]->a != id) || (items[j]->b != int(j)))
+            {
+              failed = true;
+            }
+
+            cache.release(items[j]);
+          }
+        }
+      };
+
+      std::vector<std::thread> threads;
+
+      for (size_t t = 0; t < N_THREADS; ++t)
+      {
+        threads.push_back(std::thread(worker, int(t)));
+      }
+
+      for (size_t t = 0; t < threads.size(); ++t)
+      {
+        threads[t].join();
+      }
+
+      CHECK(!failed);
+      CHECK(pool.empty());
+    }
+  };
+}
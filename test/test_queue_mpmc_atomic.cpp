@@ -0,0 +1,267 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "etl/queue_mpmc_atomic.h"
+
+namespace
+{
+  struct Data
+  {
+    Data(int a_ = 0, int b_ = 0)
+      : a(a_),
+        b(b_)
+    {
+      ++instances;
+    }
+
+    Data(const Data& other)
+      : a(other.a),
+        b(other.b)
+    {
+      ++instances;
+    }
+
+    Data& operator =(const Data& other)
+    {
+      a = other.a;
+      b = other.b;
+      return *this;
+    }
+
+    ~Data()
+    {
+      --instances;
+    }
+
+    int a;
+    int b;
+
+    static int instances;
+  };
+
+  int Data::instances = 0;
+
+  SUITE(test_queue_mpmc_atomic)
+  {
+    //*************************************************************************
+    TEST(test_constructor)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      CHECK_EQUAL(4U, queue.max_size());
+      CHECK_EQUAL(4U, queue.capacity());
+      CHECK_EQUAL(4U, queue.available());
+      CHECK(queue.empty());
+      CHECK(!queue.full());
+    }
+
+    //*************************************************************************
+    TEST(test_size_push_pop)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+      etl::iqueue_mpmc_atomic<int>&  iqueue = queue;
+
+      int value;
+
+      CHECK(iqueue.push(1));
+      CHECK(iqueue.push(2));
+      CHECK(iqueue.push(3));
+      CHECK(iqueue.push(4));
+      CHECK_EQUAL(4U, iqueue.size());
+      CHECK(iqueue.full());
+      CHECK(!iqueue.push(5));
+
+      CHECK(iqueue.pop(value));
+      CHECK_EQUAL(1, value);
+      CHECK(iqueue.pop(value));
+      CHECK_EQUAL(2, value);
+      CHECK_EQUAL(2U, iqueue.available());
+
+      CHECK(iqueue.push(5));
+      CHECK(iqueue.pop());
+      CHECK(iqueue.pop(value));
+      CHECK_EQUAL(4, value);
+      CHECK(iqueue.pop(value));
+      CHECK_EQUAL(5, value);
+      CHECK(!iqueue.pop(value));
+      CHECK(!iqueue.pop());
+      CHECK(iqueue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_positions_wrap)
+    {
+      // The positions are 8 bit, so wrap many times.
+      etl::queue_mpmc_atomic<int, 64, etl::memory_model::MEMORY_MODEL_SMALL> queue;
+
+      int value;
+      int next     = 0;
+      int expected = 0;
+
+      // Fill, then keep the queue nearly full while the positions go round many times.
+      while (queue.push(next))
+      {
+        ++next;
+      }
+
+      CHECK_EQUAL(64, next);
+      CHECK(queue.full());
+
+      for (int i = 0; i < 2000; ++i)
+      {
+        CHECK(queue.pop(value));
+        CHECK_EQUAL(expected, value);
+        ++expected;
+
+        CHECK(queue.push(next++));
+        CHECK(!queue.push(next));
+      }
+
+      CHECK_EQUAL(64U, queue.size());
+
+      while (queue.pop(value))
+      {
+        CHECK_EQUAL(expected, value);
+        ++expected;
+      }
+
+      CHECK(queue.empty());
+      CHECK_EQUAL(next, expected);
+    }
+
+    //*************************************************************************
+    TEST(test_emplace_clear)
+    {
+      {
+        etl::queue_mpmc_atomic<Data, 4> queue;
+
+        CHECK(queue.emplace(1, 2));
+        CHECK(queue.emplace(3, 4));
+        CHECK_EQUAL(2, Data::instances);
+
+        Data data;
+        CHECK(queue.pop(data));
+        CHECK_EQUAL(1, data.a);
+        CHECK_EQUAL(2, data.b);
+
+        queue.clear();
+        CHECK(queue.empty());
+        CHECK_EQUAL(1, Data::instances);
+
+        CHECK(queue.emplace(5, 6));
+      }
+
+      // The destructor clears the queue.
+      CHECK_EQUAL(0, Data::instances);
+    }
+
+    //*************************************************************************
+    TEST(test_threads)
+    {
+      const int N_PRODUCERS = 4;
+      const int N_CONSUMERS = 4;
+      const int N_ITEMS     = 100000;
+
+      static etl::queue_mpmc_atomic<int, 64> queue;
+
+      std::vector<std::atomic<int>> received(N_PRODUCERS * N_ITEMS);
+      std::atomic<int> n_received(0);
+      std::atomic<bool> out_of_order(false);
+
+      std::vector<std::thread> threads;
+
+      for (int p = 0; p < N_PRODUCERS; ++p)
+      {
+        threads.push_back(std::thread([&, p]()
+        {
+          for (int i = 0; i < N_ITEMS; ++i)
+          {
+            while (!queue.push((p * N_ITEMS) + i))
+            {
+              std::this_thread::yield();
+            }
+          }
+        }));
+      }
+
+      for (int c = 0; c < N_CONSUMERS; ++c)
+      {
+        threads.push_back(std::thread([&]()
+        {
+          int value;
+          int last[N_PRODUCERS] = { -1, -1, -1, -1 };
+
+          while (n_received < (N_PRODUCERS * N_ITEMS))
+          {
+            if (queue.pop(value))
+            {
+              ++received[value];
+              ++n_received;
+
+              // Each consumer sees each producer's items in order.
+              int producer = value / N_ITEMS;
+
+              if (value < last[producer])
+              {
+                out_of_order = true;
+              }
+
+              last[producer] = value;
+            }
+            else
+            {
+              std::this_thread::yield();
+            }
+          }
+        }));
+      }
+
+      for (size_t t = 0; t < threads.size(); ++t)
+      {
+        threads[t].join();
+      }
+
+      bool all_once = true;
+
+      for (size_t i = 0; i < received.size(); ++i)
+      {
+        all_once = all_once && (received[i] == 1);
+      }
+
+      CHECK(all_once);
+      CHECK(!out_of_order);
+      CHECK(queue.empty());
+    }
+  };
+}
@@ -299,6 +299,102 @@ namespace
       CHECK(queue.full());
     }
 
+#if ETL_HAS_QUEUE_WAIT
+    //*************************************************************************
+    TEST(test_pop_wait_timeout)
+    {
+      etl::queue_spsc_atomic<int, 4> queue;
+
+      int value;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+      CHECK(!queue.pop_wait(value, std::chrono::milliseconds(20)));
+      CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+      CHECK(queue.push(1));
+      CHECK(queue.pop_wait(value, std::chrono::milliseconds(0)));
+      CHECK_EQUAL(1, value);
+    }
+
+    //*************************************************************************
+    TEST(test_pop_wait_woken_by_push)
+    {
+      etl::queue_spsc_atomic<int, 4> queue;
+
+      std::thread producer([&]()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push(42);
+      });
+
+      int value = 0;
+
+      CHECK(queue.pop_wait(value, std::chrono::seconds(10)));
+      CHECK_EQUAL(42, value);
+
+      producer.join();
+    }
+
+    //*************************************************************************
+    TEST(test_push_wait_woken_by_pop)
+    {
+      etl::queue_spsc_atomic<int, 4> queue;
+
+      while (queue.push(0))
+      {
+      }
+
+      CHECK(!queue.push_wait(1, std::chrono::milliseconds(1)));
+
+      std::thread consumer([&]()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        int value;
+        queue.pop(value);
+      });
+
+      CHECK(queue.push_wait(1, std::chrono::seconds(10)));
+
+      consumer.join();
+    }
+
+    //*************************************************************************
+    TEST(test_push_wait_pop_wait_threads)
+    {
+      // A producer and a consumer that both wait, on a queue of one item,
+      // so that each is regularly woken by the other.
+      etl::queue_spsc_atomic<int, 1> queue;
+
+      const int N = 20000;
+      long long sum = 0;
+      int       n_popped = 0;
+
+      std::thread consumer([&]()
+      {
+        int value;
+
+        while ((n_popped < N) && queue.pop_wait(value, std::chrono::seconds(10)))
+        {
+          CHECK_EQUAL(n_popped, value);
+          sum += value;
+          ++n_popped;
+        }
+      });
+
+      for (int i = 0; i < N; ++i)
+      {
+        CHECK(queue.push_wait(i, std::chrono::seconds(10)));
+      }
+
+      consumer.join();
+
+      CHECK_EQUAL(N, n_popped);
+      CHECK_EQUAL((long long)(N - 1) * N / 2, sum);
+    }
+#endif
+
     //=========================================================================
 #if REALTIME_TEST && defined(ETL_COMPILER_MICROSOFT)
     #if defined(ETL_TARGET_OS_WINDOWS) // Only Windows priority is currently supported
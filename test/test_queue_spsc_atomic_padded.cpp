@@ -0,0 +1,337 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+#include "etl/queue_spsc_atomic_padded.h"
+
+namespace
+{
+  struct Data
+  {
+    Data(int a_ = 0, int b_ = 0)
+      : a(a_),
+        b(b_)
+    {
+      ++instances;
+    }
+
+    Data(const Data& other)
+      : a(other.a),
+        b(other.b)
+    {
+      ++instances;
+    }
+
+    Data& operator =(const Data& other)
+    {
+      a = other.a;
+      b = other.b;
+      return *this;
+    }
+
+    ~Data()
+    {
+      --instances;
+    }
+
+    int a;
+    int b;
+
+    static int instances;
+  };
+
+  int Data::instances = 0;
+
+  SUITE(test_queue_spsc_atomic_padded)
+  {
+    //*************************************************************************
+    TEST(test_constructor)
+    {
+      etl::queue_spsc_atomic_padded<int, 5> queue;
+
+      CHECK_EQUAL(5U, queue.max_size());
+      CHECK_EQUAL(5U, queue.capacity());
+      CHECK_EQUAL(5U, queue.available());
+      CHECK_EQUAL(0U, queue.size());
+      CHECK(queue.empty());
+      CHECK(!queue.full());
+    }
+
+    //*************************************************************************
+    TEST(test_size_push_pop)
+    {
+      etl::queue_spsc_atomic_padded<int, 4> queue;
+      etl::iqueue_spsc_atomic_padded<int>&  iqueue = queue;
+
+      int value;
+
+      // Go round the buffer a few times.
+      for (int i = 0; i < 10; ++i)
+      {
+        CHECK(iqueue.push(i));
+        CHECK(iqueue.push(i + 100));
+        CHECK(iqueue.push(i + 200));
+        CHECK_EQUAL(3U, iqueue.size());
+        CHECK_EQUAL(1U, iqueue.available());
+
+        CHECK(iqueue.pop(value));
+        CHECK_EQUAL(i, value);
+        CHECK(iqueue.pop(value));
+        CHECK_EQUAL(i + 100, value);
+        CHECK(iqueue.pop());
+        CHECK(!iqueue.pop(value));
+        CHECK(iqueue.empty());
+      }
+
+      CHECK(queue.push(1));
+      CHECK(queue.push(2));
+      CHECK(queue.push(3));
+      CHECK(queue.push(4));
+      CHECK(queue.full());
+      CHECK(!queue.push(5));
+      CHECK_EQUAL(4U, queue.size());
+    }
+
+    //*************************************************************************
+    TEST(test_emplace_clear)
+    {
+      {
+        etl::queue_spsc_atomic_padded<Data, 4> queue;
+
+        CHECK(queue.emplace(1, 2));
+        CHECK(queue.emplace(3, 4));
+        CHECK_EQUAL(2, Data::instances);
+
+        Data data;
+        CHECK(queue.pop(data));
+        CHECK_EQUAL(1, data.a);
+        CHECK_EQUAL(2, data.b);
+        CHECK_EQUAL(2, Data::instances);
+
+        CHECK(queue.emplace(5, 6));
+        CHECK(queue.emplace(7, 8));
+        queue.clear();
+        CHECK(queue.empty());
+        CHECK_EQUAL(1, Data::instances);
+
+        CHECK(queue.emplace(9, 10));
+      }
+
+      // The destructor clears the queue.
+      CHECK_EQUAL(0, Data::instances);
+    }
+
+    //*************************************************************************
+    TEST(test_push_n_pop_n)
+    {
+      etl::queue_spsc_atomic_padded<int, 7> queue;
+
+      const int input[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+      int output[9];
+
+      CHECK_EQUAL(5U, queue.push_n(input, 5));
+      CHECK_EQUAL(3U, queue.pop_n(output, 3));
+      CHECK_EQUAL(1, output[0]);
+      CHECK_EQUAL(3, output[2]);
+
+      // Wraps around the end of the buffer and stops when full.
+      CHECK_EQUAL(5U, queue.push_n(input, 9));
+      CHECK(queue.full());
+
+      CHECK_EQUAL(7U, queue.pop_n(output, 9));
+      const int expected[] = { 4, 5, 1, 2, 3, 4, 5 };
+      CHECK_ARRAY_EQUAL(expected, output, 7);
+      CHECK(queue.empty());
+      CHECK_EQUAL(0U, queue.pop_n(output, 9));
+    }
+
+    //*************************************************************************
+    TEST(test_reserve_commit_peek_release)
+    {
+      etl::queue_spsc_atomic_padded<int, 7> queue;
+
+      etl::array_view<int> span = queue.reserve_write(5);
+      CHECK_EQUAL(5U, span.size());
+
+      for (size_t i = 0; i < span.size(); ++i)
+      {
+        span[i] = int(i);
+      }
+
+      // Not visible until committed.
+      CHECK(queue.empty());
+      CHECK(queue.peek_read().empty());
+
+      queue.commit(5);
+      CHECK_EQUAL(5U, queue.size());
+
+      span = queue.peek_read(2);
+      CHECK_EQUAL(2U, span.size());
+      CHECK_EQUAL(0, span[0]);
+      CHECK_EQUAL(1, span[1]);
+      queue.release(2);
+
+      // Only three contiguous items are free before the end of the buffer.
+      span = queue.reserve_write(5);
+      CHECK_EQUAL(3U, span.size());
+      span[0] = 5;
+      span[1] = 6;
+      queue.commit(2);
+
+      span = queue.peek_read();
+      CHECK_EQUAL(5U, span.size());
+      CHECK_EQUAL(2, span[0]);
+      CHECK_EQUAL(6, span[4]);
+      queue.release(5);
+      CHECK(queue.empty());
+
+      // Runs to the end of the buffer, then restarts at the beginning.
+      span = queue.reserve_write(5);
+      CHECK_EQUAL(1U, span.size());
+      span[0] = 7;
+      queue.commit(1);
+
+      span = queue.reserve_write(5);
+      CHECK_EQUAL(5U, span.size());
+      span[0] = 8;
+      queue.commit(1);
+
+      int value;
+      CHECK(queue.pop(value));
+      CHECK_EQUAL(7, value);
+      CHECK(queue.pop(value));
+      CHECK_EQUAL(8, value);
+    }
+
+    //*************************************************************************
+    TEST(test_threads)
+    {
+      const int N_ITEMS = 1000000;
+
+      static etl::queue_spsc_atomic_padded<int, 100> queue;
+
+      std::atomic<bool> failed(false);
+
+      // Mixes the single, batch and in place interfaces.
+      std::thread producer([&]()
+      {
+        int next = 0;
+        int values[8];
+
+        while (next < N_ITEMS)
+        {
+          switch (next % 3)
+          {
+            case 0:
+            {
+              if (queue.push(next))
+              {
+                ++next;
+              }
+              break;
+            }
+
+            case 1:
+            {
+              int n = std::min(8, N_ITEMS - next);
+
+              for (int i = 0; i < n; ++i)
+              {
+                values[i] = next + i;
+              }
+
+              next += queue.push_n(values, n);
+              break;
+            }
+
+            default:
+            {
+              etl::array_view<int> span = queue.reserve_write(std::min(16, N_ITEMS - next));
+
+              for (size_t i = 0; i < span.size(); ++i)
+              {
+                span[i] = next++;
+              }
+
+              queue.commit(span.size());
+              break;
+            }
+          }
+        }
+      });
+
+      std::thread consumer([&]()
+      {
+        int expected = 0;
+        int value;
+        int values[8];
+
+        while (expected < N_ITEMS)
+        {
+          if ((expected % 2) == 0)
+          {
+            size_t n = queue.pop_n(values, 8);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+              failed = failed || (values[i] != expected++);
+            }
+          }
+          else
+          {
+            etl::array_view<int> span = queue.peek_read();
+
+            for (size_t i = 0; i < span.size(); ++i)
+            {
+              failed = failed || (span[i] != expected++);
+            }
+
+            queue.release(span.size());
+          }
+
+          if (queue.pop(value))
+          {
+            failed = failed || (value != expected++);
+          }
+        }
+      });
+
+      producer.join();
+      consumer.join();
+
+      CHECK(!failed);
+      CHECK(queue.empty());
+    }
+  };
+}
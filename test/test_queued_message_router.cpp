@@ -0,0 +1,454 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "etl/queued_message_router.h"
+
+namespace
+{
+  enum
+  {
+    MESSAGE1,
+    MESSAGE2,
+    MESSAGE3,
+    MESSAGE4
+  };
+
+  //***************************************************************************
+  struct Message1 : public etl::message<MESSAGE1>
+  {
+    Message1(int value_)
+      : value(value_)
+    {
+    }
+
+    int value;
+  };
+
+  //***************************************************************************
+  struct Message2 : public etl::message<MESSAGE2>
+  {
+    Message2(int value_)
+      : value(value_)
+    {
+      data[0] = value_;
+    }
+
+    int value;
+    int data[32];
+  };
+
+  //***************************************************************************
+  // Counts the copies and the live instances.
+  struct Message3 : public etl::message<MESSAGE3>
+  {
+    Message3()
+    {
+      ++instances;
+    }
+
+    Message3(const Message3&)
+      : etl::message<MESSAGE3>()
+    {
+      ++instances;
+      ++copies;
+    }
+
+    ~Message3()
+    {
+      --instances;
+    }
+
+    static int instances;
+    static int copies;
+  };
+
+  int Message3::instances = 0;
+  int Message3::copies    = 0;
+
+  //***************************************************************************
+  struct Message4 : public etl::message<MESSAGE4>
+  {
+  };
+
+  typedef etl::message_pool<etl::generic_atomic_pool<64,  8, 4>,
+                            etl::generic_atomic_pool<256, 8, 2> > Pool;
+
+  //***************************************************************************
+  template <typename TQueue>
+  class Router : public etl::queued_message_router<Router<TQueue>, TQueue, Message1, Message2, Message3>
+  {
+  public:
+
+    typedef etl::queued_message_router<Router<TQueue>, TQueue, Message1, Message2, Message3> base_t;
+
+    Router(etl::imessage_pool& pool)
+      : base_t(1, pool),
+        p_next(nullptr),
+        sum(0),
+        message3_count(0),
+        unknown_count(0),
+        p_last(nullptr)
+    {
+    }
+
+    void on_receive(etl::imessage_router&, const Message1& msg)
+    {
+      order.push_back(msg.message_id);
+      sum += msg.value;
+    }
+
+    void on_receive(etl::imessage_router&, const Message2& msg)
+    {
+      order.push_back(msg.message_id);
+      sum += msg.value + msg.data[0];
+    }
+
+    void on_receive(etl::imessage_router&, const Message3& msg)
+    {
+      order.push_back(msg.message_id);
+      ++message3_count;
+      p_last = &msg;
+
+      if (p_next != nullptr)
+      {
+        p_next->post(*this, this->take_message());
+      }
+    }
+
+    void on_receive_unknown(etl::imessage_router&, const etl::imessage&)
+    {
+      ++unknown_count;
+    }
+
+    Router*             p_next;
+    std::vector<int>    order;
+    int                 sum;
+    int                 message3_count;
+    int                 unknown_count;
+    const etl::imessage* p_last;
+  };
+
+  typedef Router<etl::message_queue_spsc<4> > RouterSpsc;
+  typedef Router<etl::message_queue_mpsc>     RouterMpsc;
+
+  SUITE(test_queued_message_router)
+  {
+    //*************************************************************************
+    TEST(test_message_pool_size_classes)
+    {
+      Pool pool;
+
+      CHECK_EQUAL(2U, pool.size_classes());
+
+      {
+        etl::message_handle small = pool.create<Message1>(1);
+        etl::message_handle large = pool.create<Message2>(2);
+
+        CHECK(small.has_value());
+        CHECK(large.has_value());
+        CHECK_EQUAL(MESSAGE1, small.get().message_id);
+        CHECK_EQUAL(MESSAGE2, large.get().message_id);
+
+        // Each message takes an item from the smallest class that holds it.
+        CHECK_EQUAL(3U, pool.get_pool(0).available());
+        CHECK_EQUAL(1U, pool.get_pool(1).available());
+      }
+
+      CHECK_EQUAL(4U, pool.get_pool(0).available());
+      CHECK_EQUAL(2U, pool.get_pool(1).available());
+    }
+
+    //*************************************************************************
+    TEST(test_message_pool_spills_to_larger_class)
+    {
+      Pool pool;
+
+      etl::message_handle handles[6];
+
+      for (int i = 0; i < 6; ++i)
+      {
+        handles[i] = pool.create<Message1>(i);
+      }
+
+      CHECK_EQUAL(0U, pool.get_pool(0).available());
+      CHECK_EQUAL(0U, pool.get_pool(1).available());
+
+      CHECK_THROW(pool.create<Message1>(6), etl::message_pool_no_allocation);
+
+      handles[5].reset();
+      CHECK_EQUAL(1U, pool.get_pool(1).available());
+    }
+
+    //*************************************************************************
+    TEST(test_message_handle_move)
+    {
+      Pool pool;
+
+      etl::message_handle handle1 = pool.create<Message3>();
+      const etl::imessage* p_message = &handle1.get();
+
+      etl::message_handle handle2(std::move(handle1));
+
+      CHECK(!handle1);
+      CHECK(handle2);
+      CHECK_EQUAL(p_message, &handle2.get());
+      CHECK_EQUAL(1, Message3::instances);
+
+      handle2 = pool.create<Message1>(1);
+      CHECK_EQUAL(0, Message3::instances);
+      CHECK_EQUAL(MESSAGE1, handle2.get().message_id);
+    }
+
+    //*************************************************************************
+    TEST(test_receive_is_queued_until_processed)
+    {
+      Pool pool;
+      RouterSpsc router(pool);
+
+      etl::send_message(router, Message1(1));
+      etl::send_message(router, Message2(2));
+      etl::send_message(router, Message1(3));
+
+      CHECK(router.order.empty());
+      CHECK_EQUAL(2U, pool.get_pool(0).available());
+      CHECK_EQUAL(1U, pool.get_pool(1).available());
+
+      CHECK_EQUAL(3U, router.process_queue());
+
+      CHECK_EQUAL(3U, router.order.size());
+      CHECK_EQUAL(MESSAGE1, router.order[0]);
+      CHECK_EQUAL(MESSAGE2, router.order[1]);
+      CHECK_EQUAL(MESSAGE1, router.order[2]);
+      CHECK_EQUAL(1 + 2 + 2 + 3, router.sum);
+
+      CHECK_EQUAL(4U, pool.get_pool(0).available());
+      CHECK_EQUAL(2U, pool.get_pool(1).available());
+      CHECK_EQUAL(0U, router.process_queue());
+    }
+
+    //*************************************************************************
+    TEST(test_unknown_message_is_not_queued)
+    {
+      Pool pool;
+      RouterSpsc router(pool);
+
+      etl::send_message(router, Message4());
+
+      CHECK_EQUAL(1, router.unknown_count);
+      CHECK_EQUAL(4U, pool.get_pool(0).available());
+      CHECK_EQUAL(0U, router.process_queue());
+    }
+
+    //*************************************************************************
+    TEST(test_post_does_not_copy)
+    {
+      Pool pool;
+      RouterMpsc router(pool);
+
+      Message3::copies = 0;
+
+      etl::message_handle handle = pool.create<Message3>();
+      const etl::imessage* p_message = &handle.get();
+
+      CHECK(router.post(std::move(handle)));
+      CHECK(!handle);
+
+      router.process_queue();
+
+      CHECK_EQUAL(1, router.message3_count);
+      CHECK_EQUAL(p_message, router.p_last);
+      CHECK_EQUAL(0, Message3::copies);
+      CHECK_EQUAL(0, Message3::instances);
+    }
+
+    //*************************************************************************
+    TEST(test_post_shared_message)
+    {
+      Pool pool;
+      RouterMpsc router1(pool);
+      RouterMpsc router2(pool);
+
+      etl::message_handle handle1 = pool.create<Message3>();
+      etl::message_handle handle2 = handle1.share();
+
+      CHECK(!handle1.is_unique());
+
+      // One node cannot be linked in to two queues.
+      CHECK_THROW(router1.post(std::move(handle1)), etl::queued_message_router_shared_message);
+      CHECK_THROW(router2.post(std::move(handle2)), etl::queued_message_router_shared_message);
+      CHECK(handle1);
+      CHECK(handle2);
+
+      // Once it is no longer shared it may be posted.
+      handle2.reset();
+      CHECK(handle1.is_unique());
+      CHECK(router1.post(std::move(handle1)));
+
+      CHECK_EQUAL(1U, router1.process_queue());
+      CHECK_EQUAL(0U, router2.process_queue());
+      CHECK_EQUAL(1, router1.message3_count);
+      CHECK_EQUAL(0, Message3::instances);
+    }
+
+    //*************************************************************************
+    TEST(test_take_message_forwards_without_copy)
+    {
+      Pool pool;
+      RouterMpsc router1(pool);
+      RouterMpsc router2(pool);
+
+      router1.p_next = &router2;
+
+      Message3::copies = 0;
+
+      etl::send_message(router1, Message3());
+      CHECK_EQUAL(1, Message3::copies);
+
+      router1.process_queue();
+      CHECK_EQUAL(1, Message3::instances);
+
+      router2.process_queue();
+
+      CHECK_EQUAL(1, router1.message3_count);
+      CHECK_EQUAL(1, router2.message3_count);
+      CHECK_EQUAL(router1.p_last, router2.p_last);
+      CHECK_EQUAL(1, Message3::copies);
+      CHECK_EQUAL(0, Message3::instances);
+    }
+
+    //*************************************************************************
+    TEST(test_spsc_queue_full)
+    {
+      typedef etl::message_pool<etl::generic_atomic_pool<64, 8, 8> > BigPool;
+
+      BigPool pool;
+      RouterSpsc router(pool);
+
+      for (int i = 0; i < 4; ++i)
+      {
+        etl::send_message(router, Message1(i));
+      }
+
+      CHECK_THROW(etl::send_message(router, Message1(4)), etl::queued_message_router_full);
+
+      // The message that was not queued went back to the pool.
+      CHECK_EQUAL(4U, pool.get_pool(0).available());
+
+      etl::message_handle handle = pool.create<Message1>(5);
+      CHECK(!router.post(std::move(handle)));
+      CHECK(handle);
+    }
+
+    //*************************************************************************
+    TEST(test_destructor_releases_queued_messages)
+    {
+      Pool pool;
+
+      {
+        RouterMpsc router(pool);
+
+        router.post(pool.create<Message3>());
+        router.post(pool.create<Message3>());
+
+        CHECK_EQUAL(2, Message3::instances);
+      }
+
+      CHECK_EQUAL(0, Message3::instances);
+      CHECK_EQUAL(4U, pool.get_pool(0).available());
+    }
+
+    //*************************************************************************
+    TEST(test_mpsc_threads)
+    {
+      const int N_PRODUCERS = 4;
+      const int N_ITEMS     = 20000;
+
+      typedef etl::message_pool<etl::generic_atomic_pool<64, 8, 64> > BigPool;
+
+      BigPool pool;
+      RouterMpsc router(pool);
+
+      std::atomic<bool> done(false);
+      std::vector<std::thread> producers;
+
+      for (int p = 0; p < N_PRODUCERS; ++p)
+      {
+        producers.push_back(std::thread([&, p]()
+        {
+          for (int i = 1; i <= N_ITEMS; ++i)
+          {
+            etl::message_handle handle;
+
+            // Wait for the consumer to free some space.
+            while (!handle)
+            {
+              try
+              {
+                handle = pool.create<Message1>(p + 1);
+              }
+              catch (etl::message_pool_no_allocation&)
+              {
+                std::this_thread::yield();
+              }
+            }
+
+            router.post(std::move(handle));
+          }
+        }));
+      }
+
+      std::thread consumer([&]()
+      {
+        while (!done)
+        {
+          router.process_queue();
+        }
+
+        router.process_queue();
+      });
+
+      for (size_t t = 0; t < producers.size(); ++t)
+      {
+        producers[t].join();
+      }
+
+      done = true;
+      consumer.join();
+
+      CHECK_EQUAL(size_t(N_PRODUCERS * N_ITEMS), router.order.size());
+      CHECK_EQUAL((1 + 2 + 3 + 4) * N_ITEMS, router.sum);
+      CHECK_EQUAL(64U, pool.get_pool(0).available());
+    }
+  };
+}
@@ -412,5 +412,169 @@ namespace
       }
     }
 
+    //=========================================================================
+    TEST(test_random_splitmix64_sequence)
+    {
+      // Reference values from http://prng.di.unimi.it/splitmix64.c
+      etl::random_splitmix64 r(1234567ULL);
+
+      CHECK_EQUAL(6457827717110365317ULL,  r());
+      CHECK_EQUAL(3203168211198807973ULL,  r());
+      CHECK_EQUAL(9817491932198370423ULL,  r());
+      CHECK_EQUAL(4593380528125082431ULL,  r());
+      CHECK_EQUAL(16408922859458223821ULL, r());
+    }
+
+    //=========================================================================
+    TEST(test_random_splitmix64_range)
+    {
+      etl::random_splitmix64 r;
+
+      uint32_t low  = 1234;
+      uint32_t high = 9876;
+
+      for (int i = 0; i < 100000; ++i)
+      {
+        uint32_t n = r.range(low, high);
+
+        CHECK(n >= low);
+        CHECK(n <= high);
+      }
+    }
+
+    //=========================================================================
+    TEST(test_random_xoshiro256ss_sequence)
+    {
+      etl::random_xoshiro256ss r(1234567ULL);
+
+      // The state is seeded from splitmix64; the first result is derived from state[1].
+      uint64_t state1 = 3203168211198807973ULL;
+      uint64_t first  = ((state1 * 5U) << 7 | (state1 * 5U) >> 57) * 9U;
+
+      CHECK_EQUAL(first, r());
+    }
+
+    //=========================================================================
+    TEST(test_random_xoshiro256ss_generate)
+    {
+      etl::random_xoshiro256ss r1(42U);
+      etl::random_xoshiro256ss r2(42U);
+
+      std::vector<uint64_t> out1(1000);
+      std::vector<uint64_t> out2(1000);
+
+      r1.generate(out1.begin(), out1.end());
+
+      for (size_t i = 0; i < out2.size(); ++i)
+      {
+        out2[i] = r2();
+      }
+
+      CHECK(out1 == out2);
+
+      // The generators continue in step.
+      CHECK_EQUAL(r2(), r1());
+    }
+
+    //=========================================================================
+    TEST(test_random_xoshiro256ss_jump)
+    {
+      etl::random_xoshiro256ss r1(42U);
+      etl::random_xoshiro256ss r2(r1);
+      etl::random_xoshiro256ss r3(r1);
+
+      r2.jump();
+      r3.long_jump();
+
+      std::vector<uint64_t> out1(1000);
+      std::vector<uint64_t> out2(1000);
+      std::vector<uint64_t> out3(1000);
+
+      r1.generate(out1.begin(), out1.end());
+      r2.generate(out2.begin(), out2.end());
+      r3.generate(out3.begin(), out3.end());
+
+      std::sort(out1.begin(), out1.end());
+      std::sort(out2.begin(), out2.end());
+
+      for (size_t i = 0; i < out2.size(); ++i)
+      {
+        CHECK(!std::binary_search(out1.begin(), out1.end(), out2[i]));
+        CHECK(!std::binary_search(out1.begin(), out1.end(), out3[i]));
+      }
+
+      // Jumping is deterministic.
+      etl::random_xoshiro256ss r4(42U);
+      r4.jump();
+      std::vector<uint64_t> out4(1000);
+      r4.generate(out4.begin(), out4.end());
+      std::sort(out4.begin(), out4.end());
+
+      CHECK(out2 == out4);
+    }
+
+    //=========================================================================
+    TEST(test_random_xoshiro256ss_range)
+    {
+      etl::random_xoshiro256ss r;
+
+      uint32_t low  = 1234;
+      uint32_t high = 9876;
+
+      for (int i = 0; i < 100000; ++i)
+      {
+        uint32_t n = r.range(low, high);
+
+        CHECK(n >= low);
+        CHECK(n <= high);
+      }
+    }
+
+    //=========================================================================
+    TEST(test_random_xoshiro256ss_range_distribution)
+    {
+      etl::random_xoshiro256ss r(1U);
+
+      const int Buckets = 6;
+      const int Samples = 600000;
+      int count[Buckets] = { 0 };
+
+      for (int i = 0; i < Samples; ++i)
+      {
+        ++count[r.range(10, 15) - 10];
+      }
+
+      for (int i = 0; i < Buckets; ++i)
+      {
+        CHECK_CLOSE(Samples / Buckets, count[i], (Samples / Buckets) / 50);
+      }
+
+      // Full range.
+      uint32_t n = r.range(0, 0xFFFFFFFFUL);
+      (void)n;
+    }
+
+    //=========================================================================
+    TEST(test_random_xoshiro256ss_real)
+    {
+      etl::random_xoshiro256ss r;
+
+      double total = 0.0;
+
+      for (int i = 0; i < 100000; ++i)
+      {
+        double d = r.real();
+        float  f = r.real_float();
+
+        CHECK(d >= 0.0);
+        CHECK(d < 1.0);
+        CHECK(f >= 0.0f);
+        CHECK(f < 1.0f);
+
+        total += d;
+      }
+
+      CHECK_CLOSE(0.5, total / 100000, 0.01);
+    }
   };
 }
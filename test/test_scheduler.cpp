@@ -0,0 +1,239 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "etl/scheduler.h"
+#include "etl/function.h"
+
+namespace
+{
+  //***************************************************************************
+  class notified_task : public etl::task
+  {
+  public:
+
+    notified_task(etl::task_priority_t priority, std::vector<int>& order_)
+      : task(priority),
+        work(0),
+        request_calls(0),
+        order(order_)
+    {
+    }
+
+    uint32_t task_request_work() const
+    {
+      ++request_calls;
+      return work.load();
+    }
+
+    void task_process_work()
+    {
+      --work;
+      order.push_back(get_task_priority());
+    }
+
+    void add_work()
+    {
+      ++work;
+      notify();
+    }
+
+    std::atomic<int>  work;
+    mutable int       request_calls;
+    std::vector<int>& order;
+  };
+
+  typedef etl::scheduler<etl::scheduler_policy_ready_bitmap<40>, 40> scheduler_t;
+
+  //***************************************************************************
+  struct idle_handler
+  {
+    idle_handler(scheduler_t& scheduler_)
+      : scheduler(scheduler_),
+        p_producer_done(nullptr),
+        producer_was_done(false),
+        n_idle(0),
+        started(false)
+    {
+    }
+
+    void watchdog()
+    {
+      started = true;
+    }
+
+    void idle()
+    {
+      ++n_idle;
+
+      // Exit once a pass that started after the producer finished finds nothing to do.
+      if ((p_producer_done == nullptr) || producer_was_done)
+      {
+        scheduler.exit_scheduler();
+      }
+
+      producer_was_done = (p_producer_done != nullptr) && p_producer_done->load();
+    }
+
+    scheduler_t&       scheduler;
+    std::atomic<bool>* p_producer_done;
+    bool               producer_was_done;
+    int                n_idle;
+    std::atomic<bool>  started;
+  };
+
+  SUITE(test_scheduler)
+  {
+    //*************************************************************************
+    TEST(test_ready_bitmap_priority_order)
+    {
+      std::vector<int> order;
+
+      notified_task task1(1, order);
+      notified_task task2(3, order);
+      notified_task task3(2, order);
+
+      scheduler_t scheduler;
+      scheduler.add_task(task1);
+      scheduler.add_task(task2);
+      scheduler.add_task(task3);
+
+      idle_handler handler(scheduler);
+      etl::function_mv<idle_handler, &idle_handler::idle> idle_callback(handler);
+      scheduler.set_idle_callback(idle_callback);
+
+      // Work before the start is found when the scheduler starts.
+      task1.work = 2;
+      task3.add_work();
+      task2.add_work();
+
+      scheduler.start();
+
+      CHECK_EQUAL(4U, order.size());
+      CHECK_EQUAL(3, order[0]);
+      CHECK_EQUAL(2, order[1]);
+      CHECK_EQUAL(1, order[2]);
+      CHECK_EQUAL(1, order[3]);
+      CHECK_EQUAL(1, handler.n_idle);
+    }
+
+    //*************************************************************************
+    TEST(test_ready_bitmap_only_polls_ready_tasks)
+    {
+      std::vector<int> order;
+      std::vector<notified_task*> tasks;
+
+      scheduler_t scheduler;
+
+      // More tasks than there are bits in one word.
+      for (int i = 0; i < 40; ++i)
+      {
+        tasks.push_back(new notified_task(etl::task_priority_t(i), order));
+        scheduler.add_task(*tasks.back());
+      }
+
+      idle_handler handler(scheduler);
+      etl::function_mv<idle_handler, &idle_handler::idle> idle_callback(handler);
+      scheduler.set_idle_callback(idle_callback);
+
+      tasks[0]->add_work();
+      tasks[39]->add_work();
+      tasks[35]->add_work();
+
+      scheduler.start();
+
+      CHECK_EQUAL(3U, order.size());
+      CHECK_EQUAL(39, order[0]);
+      CHECK_EQUAL(35, order[1]);
+      CHECK_EQUAL(0, order[2]);
+
+      // Once when the scheduler starts, and twice more for each task that ran.
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        bool ran = (i == 0) || (i == 35) || (i == 39);
+        CHECK_EQUAL(ran ? 3 : 1, tasks[i]->request_calls);
+        delete tasks[i];
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_ready_bitmap_notify_from_thread)
+    {
+      const int N_ITEMS = 10000;
+
+      std::vector<int> order;
+      order.reserve(N_ITEMS);
+
+      notified_task task(1, order);
+
+      scheduler_t scheduler;
+      scheduler.add_task(task);
+
+      std::atomic<bool> producer_done(false);
+
+      idle_handler handler(scheduler);
+      handler.p_producer_done = &producer_done;
+      etl::function_mv<idle_handler, &idle_handler::idle> idle_callback(handler);
+      etl::function_mv<idle_handler, &idle_handler::watchdog> watchdog_callback(handler);
+      scheduler.set_idle_callback(idle_callback);
+      scheduler.set_watchdog_callback(watchdog_callback);
+
+      std::thread producer([&]()
+      {
+        // Tasks are connected to the policy when the scheduler starts.
+        while (!handler.started)
+        {
+          std::this_thread::yield();
+        }
+
+        for (int i = 0; i < N_ITEMS; ++i)
+        {
+          task.add_work();
+
+          if ((i % 64) == 0)
+          {
+            std::this_thread::yield();
+          }
+        }
+
+        producer_done = true;
+      });
+
+      scheduler.start();
+      producer.join();
+
+      CHECK_EQUAL(size_t(N_ITEMS), order.size());
+      CHECK_EQUAL(0, task.work.load());
+    }
+  };
+}
@@ -0,0 +1,186 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <set>
+#include <vector>
+
+#include "etl/size_class_allocator.h"
+
+#if ETL_HAS_SIZE_CLASS_MEMORY_RESOURCE
+  #include <memory_resource>
+  #include <vector>
+  #include <list>
+  #include <string>
+#endif
+
+namespace
+{
+  typedef etl::size_class_allocator<etl::generic_pool<16,  2, 8>,
+                                    etl::generic_pool<32,  4, 4>,
+                                    etl::generic_pool<64,  8, 4>,
+                                    etl::generic_pool<256, 8, 2>> Allocator;
+
+  SUITE(test_size_class_allocator)
+  {
+    //*************************************************************************
+    TEST(test_properties)
+    {
+      Allocator allocator;
+
+      CHECK_EQUAL(4U,   Allocator::SIZE_CLASSES);
+      CHECK_EQUAL(16U,  Allocator::GRANULE);
+      CHECK_EQUAL(256U, Allocator::MAX_ALLOCATION);
+      CHECK_EQUAL(4U,   allocator.size_classes());
+      CHECK_EQUAL(256U, allocator.max_allocation());
+    }
+
+    //*************************************************************************
+    TEST(test_size_to_class)
+    {
+      Allocator allocator;
+
+      const size_t sizes[]   = { 0, 1, 16, 17, 32, 33, 64, 65, 200, 256 };
+      const size_t classes[] = { 0, 0, 0,  1,  1,  2,  2,  3,  3,   3 };
+
+      for (size_t i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); ++i)
+      {
+        void* p = allocator.allocate(sizes[i], 1);
+        CHECK(allocator.get_pool(classes[i]).is_in_pool(p));
+        allocator.deallocate(p, sizes[i]);
+      }
+
+      for (size_t i = 0; i < allocator.size_classes(); ++i)
+      {
+        CHECK(allocator.get_pool(i).empty());
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_alignment_selects_larger_class)
+    {
+      Allocator allocator;
+
+      // Class 0 is only 2 byte aligned and class 1 is only 4 byte aligned.
+      void* p = allocator.allocate(8, 8);
+
+      CHECK(allocator.get_pool(2).is_in_pool(p));
+      CHECK_EQUAL(0U, reinterpret_cast<uintptr_t>(p) % 8);
+
+      allocator.deallocate(p, 8);
+      CHECK(allocator.get_pool(2).empty());
+    }
+
+    //*************************************************************************
+    TEST(test_exhausted_class_falls_through)
+    {
+      Allocator allocator;
+      std::set<void*> allocated;
+
+      // 4 from class 1, then 4 from class 2, then 2 from class 3.
+      for (int i = 0; i < 10; ++i)
+      {
+        void* p = allocator.allocate(20, 1);
+        CHECK(p != nullptr);
+        allocated.insert(p);
+      }
+
+      CHECK_EQUAL(10U, allocated.size());
+      CHECK(allocator.get_pool(1).full());
+      CHECK(allocator.get_pool(2).full());
+      CHECK(allocator.get_pool(3).full());
+
+      CHECK_THROW(allocator.allocate(20, 1), etl::pool_no_allocation);
+
+      for (std::set<void*>::iterator itr = allocated.begin(); itr != allocated.end(); ++itr)
+      {
+        allocator.deallocate(*itr, 20);
+      }
+
+      for (size_t i = 0; i < allocator.size_classes(); ++i)
+      {
+        CHECK(allocator.get_pool(i).empty());
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_errors)
+    {
+      Allocator allocator;
+      int data;
+
+      CHECK_THROW(allocator.allocate(257, 1), etl::pool_element_size);
+      CHECK_THROW(allocator.deallocate(&data, 4), etl::pool_object_not_in_pool);
+      CHECK(!allocator.is_in_pool(&data));
+
+      // Released with a size from a larger class than it was allocated from.
+      void* p = allocator.allocate(4, 1);
+      CHECK(allocator.is_in_pool(p));
+      CHECK_THROW(allocator.deallocate(p, 100), etl::pool_object_not_in_pool);
+    }
+
+#if ETL_HAS_SIZE_CLASS_MEMORY_RESOURCE
+    //*************************************************************************
+    TEST(test_memory_resource)
+    {
+      typedef etl::size_class_allocator<etl::generic_pool<32,   8, 128>,
+                                        etl::generic_pool<128,  8, 16>,
+                                        etl::generic_pool<1024, 8, 4>> PmrAllocator;
+
+      PmrAllocator allocator;
+      etl::size_class_memory_resource resource(allocator);
+
+      {
+        std::pmr::vector<int> v(&resource);
+        std::pmr::list<int>   l(&resource);
+
+        for (int i = 0; i < 100; ++i)
+        {
+          v.push_back(i);
+          l.push_back(i);
+        }
+
+        CHECK_EQUAL(100U, v.size());
+        CHECK_EQUAL(99, v.back());
+        CHECK_EQUAL(100U, l.size());
+        CHECK(allocator.is_in_pool(v.data()));
+        CHECK(!allocator.get_pool(0).empty());
+      }
+
+      for (size_t i = 0; i < allocator.size_classes(); ++i)
+      {
+        CHECK(allocator.get_pool(i).empty());
+      }
+
+      CHECK(resource.is_equal(resource));
+      CHECK(!resource.is_equal(*std::pmr::new_delete_resource()));
+    }
+#endif
+  };
+}
@@ -0,0 +1,341 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include "etl/static_fsm.h"
+
+#include <string>
+#include <vector>
+
+#if ETL_CPP14_SUPPORTED
+
+namespace
+{
+  //***************************************************************************
+  // Events
+  enum
+  {
+    START,
+    STOP,
+    STOPPED,
+    SET_SPEED,
+    UNSUPPORTED
+  };
+
+  struct Start : public etl::message<START>
+  {
+  };
+
+  struct Stop : public etl::message<STOP>
+  {
+    Stop(bool emergency_ = false)
+      : emergency(emergency_)
+    {
+    }
+
+    bool emergency;
+  };
+
+  struct Stopped : public etl::message<STOPPED>
+  {
+  };
+
+  struct SetSpeed : public etl::message<SET_SPEED>
+  {
+    SetSpeed(int speed_)
+      : speed(speed_)
+    {
+    }
+
+    int speed;
+  };
+
+  struct Unsupported : public etl::message<UNSUPPORTED>
+  {
+  };
+
+  //***************************************************************************
+  // States
+  // Running and WindingDown are nested in Active.
+  struct Idle {};
+  struct Active {};
+  struct Running     : etl::fsm_substate<Active> {};
+  struct WindingDown : etl::fsm_substate<Active> {};
+
+  //***************************************************************************
+  // Actions and guards
+  struct StartMotor
+  {
+    template <typename TContext>
+    void operator ()(TContext& context, const Start&) const
+    {
+      context.log.push_back("start motor");
+    }
+  };
+
+  struct ChangeSpeed
+  {
+    template <typename TContext>
+    void operator ()(TContext& context, const SetSpeed& event) const
+    {
+      context.speed = event.speed;
+    }
+  };
+
+  struct StopMotor
+  {
+    template <typename TContext>
+    void operator ()(TContext& context, const Stop&) const
+    {
+      context.log.push_back("stop motor");
+    }
+  };
+
+  struct IsEmergency
+  {
+    template <typename TContext>
+    bool operator ()(const TContext&, const Stop& event) const
+    {
+      return event.emergency;
+    }
+  };
+
+  struct IsNotEmergency
+  {
+    template <typename TContext>
+    bool operator ()(const TContext&, const Stop& event) const
+    {
+      return !event.emergency;
+    }
+  };
+
+  //***************************************************************************
+  // The motor control FSM.
+  // The emergency stop is declared on Active, so applies to both substates.
+  //***************************************************************************
+  typedef etl::fsm_states<Idle, Active, Running, WindingDown> MotorStates;
+
+  typedef etl::fsm_transitions<etl::fsm_transition<Idle,        Start,    Running,     StartMotor>,
+                               etl::fsm_transition<Running,     SetSpeed, void,        ChangeSpeed>,
+                               etl::fsm_transition<Running,     Stop,     WindingDown, etl::fsm_no_action, IsNotEmergency>,
+                               etl::fsm_transition<WindingDown, Stopped,  Idle>,
+                               etl::fsm_transition<Active,      Stop,     Idle,        StopMotor,          IsEmergency> > MotorTransitions;
+
+  class MotorControl : public etl::static_fsm<MotorControl, MotorStates, MotorTransitions>
+  {
+  public:
+
+    MotorControl()
+      : static_fsm(1),
+        speed(0)
+    {
+    }
+
+    void on_enter(Idle)        { log.push_back("enter idle"); }
+    void on_exit(Idle)         { log.push_back("exit idle"); }
+    void on_enter(Active)      { log.push_back("enter active"); }
+    void on_exit(Active)       { log.push_back("exit active"); }
+    void on_enter(Running)     { log.push_back("enter running"); }
+    void on_exit(Running)      { log.push_back("exit running"); }
+    // WindingDown has no handlers.
+
+    std::vector<std::string> log;
+    int speed;
+  };
+
+  typedef std::vector<std::string> Log;
+
+  SUITE(test_static_fsm)
+  {
+    //*************************************************************************
+    TEST(test_start)
+    {
+      MotorControl motor;
+
+      CHECK(!motor.is_started());
+      CHECK(!motor.is_in_state<Idle>());
+      CHECK(!motor.process_event(Start()));
+
+      motor.start();
+
+      CHECK(motor.is_started());
+      CHECK(motor.is_in_state<Idle>());
+      CHECK_EQUAL(0U, motor.get_state_index());
+      CHECK(motor.log == Log({ "enter idle" }));
+
+      // Only starts once.
+      motor.start();
+      CHECK_EQUAL(1U, motor.log.size());
+    }
+
+    //*************************************************************************
+    TEST(test_transition_into_substate)
+    {
+      MotorControl motor;
+      motor.start();
+      motor.log.clear();
+
+      CHECK(motor.process_event(Start()));
+
+      CHECK(motor.is_in_state<Running>());
+      CHECK(motor.is_in_state<Active>());
+      CHECK(!motor.is_in_state<Idle>());
+      CHECK_EQUAL(2U, motor.get_state_index());
+      CHECK(motor.log == Log({ "exit idle", "start motor", "enter active", "enter running" }));
+    }
+
+    //*************************************************************************
+    TEST(test_internal_transition)
+    {
+      MotorControl motor;
+      motor.start();
+      motor.process_event(Start());
+      motor.log.clear();
+
+      CHECK(motor.process_event(SetSpeed(100)));
+
+      CHECK_EQUAL(100, motor.speed);
+      CHECK(motor.is_in_state<Running>());
+      CHECK(motor.log.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_transition_between_substates)
+    {
+      MotorControl motor;
+      motor.start();
+      motor.process_event(Start());
+      motor.log.clear();
+
+      CHECK(motor.process_event(Stop()));
+
+      // Active is not exited.
+      CHECK(motor.is_in_state<WindingDown>());
+      CHECK(motor.is_in_state<Active>());
+      CHECK(motor.log == Log({ "exit running" }));
+
+      motor.log.clear();
+      CHECK(motor.process_event(Stopped()));
+
+      CHECK(motor.is_in_state<Idle>());
+      CHECK(motor.log == Log({ "exit active", "enter idle" }));
+    }
+
+    //*************************************************************************
+    TEST(test_transition_from_parent_state)
+    {
+      MotorControl motor;
+      motor.start();
+      motor.process_event(Start());
+      motor.log.clear();
+
+      // Running's own Stop is guarded out, so Active's is taken.
+      CHECK(motor.process_event(Stop(true)));
+
+      CHECK(motor.is_in_state<Idle>());
+      CHECK(motor.log == Log({ "exit running", "exit active", "stop motor", "enter idle" }));
+
+      // And from the other substate.
+      motor.process_event(Start());
+      motor.process_event(Stop());
+      motor.log.clear();
+
+      CHECK(motor.process_event(Stop(true)));
+      CHECK(motor.is_in_state<Idle>());
+      CHECK(motor.log == Log({ "exit active", "stop motor", "enter idle" }));
+    }
+
+    //*************************************************************************
+    TEST(test_unhandled_event)
+    {
+      MotorControl motor;
+      motor.start();
+      motor.log.clear();
+
+      CHECK(!motor.process_event(Stop()));
+      CHECK(!motor.process_event(SetSpeed(10)));
+      CHECK(!motor.process_event(Unsupported()));
+
+      CHECK(motor.is_in_state<Idle>());
+      CHECK(motor.log.empty());
+      CHECK_EQUAL(0, motor.speed);
+    }
+
+    //*************************************************************************
+    TEST(test_receive_messages)
+    {
+      MotorControl motor;
+      etl::imessage_router& router = motor;
+
+      motor.start();
+
+      CHECK(router.accepts(START));
+      CHECK(router.accepts(STOPPED));
+      CHECK(!router.accepts(UNSUPPORTED));
+
+      etl::send_message(router, Start());
+      etl::send_message(router, SetSpeed(50));
+      etl::send_message(router, Unsupported());
+
+      CHECK(motor.is_in_state<Running>());
+      CHECK_EQUAL(50, motor.speed);
+
+      // Sent to another router.
+      etl::null_message_router source;
+      router.receive(source, 2, Stop(true));
+      CHECK(motor.is_in_state<Running>());
+
+      router.receive(source, 1, Stop(true));
+      CHECK(motor.is_in_state<Idle>());
+    }
+
+    //*************************************************************************
+    TEST(test_reset)
+    {
+      MotorControl motor;
+      motor.start();
+      motor.process_event(Start());
+      motor.log.clear();
+
+      motor.reset(true);
+
+      CHECK(!motor.is_started());
+      CHECK(motor.log == Log({ "exit running", "exit active" }));
+
+      motor.log.clear();
+      motor.start();
+      motor.reset();
+
+      CHECK(!motor.is_started());
+      CHECK(motor.log == Log({ "enter idle" }));
+    }
+  };
+}
+
+#endif